@@ -0,0 +1,41 @@
+/// \file
+/// Benchmarks for the AST construction and hashing.
+
+#include <ilang/ila/hash_ast.h>
+
+#include "bench-include/synth_ila.h"
+
+namespace ilang {
+
+static void BM_AstConstruct(benchmark::State& state) {
+  auto config = SynthIlaArgs(state);
+  size_t nodes = 0;
+  for (auto _ : state) {
+    auto m = SynthIla(config);
+    benchmark::DoNotOptimize(m);
+    state.PauseTiming();
+    nodes = SynthIlaNodeNum(m);
+    state.ResumeTiming();
+  }
+  state.counters["nodes"] = nodes;
+  state.counters["nodes_rate"] =
+      benchmark::Counter(static_cast<double>(nodes),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_AstConstruct)->Apply(SynthIlaArgSets);
+
+static void BM_ExprMngrHash(benchmark::State& state) {
+  auto m = SynthIla(SynthIlaArgs(state));
+  auto updates = SynthIlaUpdates(m);
+  // the nodes are shared in place by the first run
+  state.counters["nodes"] = SynthIlaNodeNum(m);
+  for (auto _ : state) {
+    auto mngr = ExprMngr::New();
+    for (const auto& e : updates) {
+      benchmark::DoNotOptimize(mngr->GetRep(e));
+    }
+  }
+}
+BENCHMARK(BM_ExprMngrHash)->Apply(SynthIlaArgSets);
+
+} // namespace ilang
@@ -0,0 +1,59 @@
+/// \file
+/// Benchmarks for the JSON Ser/Des and the code generation.
+
+#include <sstream>
+
+#include <ilang/target-json/interface.h>
+#include <ilang/target-sc/ilator.h>
+#include <ilang/util/fs.h>
+#include <ilang/verilog-out/verilog_gen.h>
+
+#include "bench-include/synth_ila.h"
+
+namespace ilang {
+
+static void BM_JsonSerialize(benchmark::State& state) {
+  auto m = SynthIla(SynthIlaArgs(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(IlaSerDesMngr::Serialize(m));
+  }
+}
+BENCHMARK(BM_JsonSerialize)->Apply(SynthIlaArgSets);
+
+static void BM_JsonDeserialize(benchmark::State& state) {
+  auto j = IlaSerDesMngr::Serialize(SynthIla(SynthIlaArgs(state)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(IlaSerDesMngr::Deserialize(j));
+  }
+}
+BENCHMARK(BM_JsonDeserialize)->Apply(SynthIlaArgSets);
+
+static void BM_VerilogExport(benchmark::State& state) {
+  auto m = SynthIla(SynthIlaArgs(state));
+  for (auto _ : state) {
+    VerilogGenerator gen;
+    gen.ExportIla(m);
+    std::ostringstream out;
+    gen.DumpToFile(out);
+    benchmark::DoNotOptimize(out.str());
+  }
+}
+BENCHMARK(BM_VerilogExport)->Apply(SynthIlaArgSets);
+
+static void BM_IlatorGenerate(benchmark::State& state) {
+  auto m = SynthIla(SynthIlaArgs(state));
+  os_portable_mkdir(ILANG_BENCH_OUT_DIR);
+  auto dst = os_portable_append_dir(ILANG_BENCH_OUT_DIR, "ilator");
+  for (auto _ : state) {
+    Ilator gen(m);
+    gen.Generate(dst, false);
+    state.PauseTiming();
+    os_portable_remove_directory(dst);
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_IlatorGenerate)
+    ->Apply(SynthIlaArgSets)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace ilang
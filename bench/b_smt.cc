@@ -0,0 +1,61 @@
+/// \file
+/// Benchmarks for the z3 translation and unrolling.
+
+#include <ilang/ila-mngr/u_unroller.h>
+#include <ilang/target-smt/z3_expr_adapter.h>
+
+#include "bench-include/synth_ila.h"
+
+namespace ilang {
+
+static void BM_Z3ExprAdapter(benchmark::State& state) {
+  auto m = SynthIla(SynthIlaArgs(state));
+  auto updates = SynthIlaUpdates(m);
+  z3::context ctx;
+  for (auto _ : state) {
+    Z3ExprAdapter adapter(ctx);
+    for (const auto& e : updates) {
+      benchmark::DoNotOptimize(adapter.GetExpr(e));
+    }
+  }
+  state.counters["nodes"] = SynthIlaNodeNum(m);
+}
+BENCHMARK(BM_Z3ExprAdapter)->Apply(SynthIlaArgSets);
+
+static void BM_MonoUnroll(benchmark::State& state) {
+  auto config = SynthIlaConfig();
+  config.num_instr = static_cast<int>(state.range(0));
+  auto len = static_cast<int>(state.range(1));
+  auto m = SynthIla(config);
+  z3::context ctx;
+  for (auto _ : state) {
+    MonoUnroll unroller(ctx);
+    benchmark::DoNotOptimize(unroller.MonoAssn(m, len));
+  }
+}
+BENCHMARK(BM_MonoUnroll)
+    ->ArgNames({"instr", "len"})
+    ->ArgsProduct({{8, 64}, {1, 4, 16}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_PathUnroll(benchmark::State& state) {
+  auto config = SynthIlaConfig();
+  config.num_instr = static_cast<int>(state.range(0));
+  auto len = static_cast<size_t>(state.range(1));
+  auto m = SynthIla(config);
+  std::vector<InstrPtr> seq;
+  for (size_t i = 0; i != len; i++) {
+    seq.push_back(m->instr(i % m->instr_num()));
+  }
+  z3::context ctx;
+  for (auto _ : state) {
+    PathUnroll unroller(ctx);
+    benchmark::DoNotOptimize(unroller.PathAssn(seq));
+  }
+}
+BENCHMARK(BM_PathUnroll)
+    ->ArgNames({"instr", "len"})
+    ->ArgsProduct({{8, 64}, {1, 4, 16}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace ilang
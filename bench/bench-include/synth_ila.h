@@ -0,0 +1,60 @@
+/// \file
+/// Synthetic ILA models for the benchmarks.
+
+#ifndef BENCH_INCLUDE_SYNTH_ILA_H__
+#define BENCH_INCLUDE_SYNTH_ILA_H__
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ilang/ila/instr_lvl_abs.h>
+
+namespace ilang {
+
+/// Shape of a synthetic ILA.
+struct SynthIlaConfig {
+  /// Number of instructions.
+  int num_instr = 8;
+  /// Number of bit-vector states.
+  int num_state = 8;
+  /// Bit-width of the bit-vector states.
+  int state_width = 32;
+  /// Number of memory states.
+  int num_mem = 1;
+  /// Address width of the memories.
+  int mem_addr_width = 8;
+  /// Data width of the memories.
+  int mem_data_width = 32;
+  /// \brief DAG sharing factor, i.e., number of instructions sharing each
+  /// sub-expression of the state updates (1 for no sharing).
+  int sharing = 1;
+  /// Number of operators in each (unshared) sub-expression.
+  int depth = 4;
+  /// Seed of the pseudo-random generator.
+  unsigned seed = 0;
+};
+
+/// \brief Generate a flat ILA of the given shape. Each instruction is decoded
+/// by a unique opcode and updates all the states, including a store to each
+/// memory, with the sub-expressions shared among instructions.
+InstrLvlAbsPtr SynthIla(const SynthIlaConfig& config,
+                        const std::string& name = "synth");
+
+/// Return the number of unique AST nodes in the updates of the ILA.
+size_t SynthIlaNodeNum(const InstrLvlAbsPtr& m);
+
+/// Return all the state updates of the ILA.
+std::vector<ExprPtr> SynthIlaUpdates(const InstrLvlAbsPtr& m);
+
+/// \brief Return the config from the benchmark arguments, i.e., number of
+/// instructions, states, sharing factor, and memory data width.
+SynthIlaConfig SynthIlaArgs(const benchmark::State& state);
+
+/// Register the default argument sets of SynthIlaArgs.
+void SynthIlaArgSets(benchmark::internal::Benchmark* b);
+
+} // namespace ilang
+
+#endif // BENCH_INCLUDE_SYNTH_ILA_H__
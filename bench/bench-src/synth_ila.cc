@@ -0,0 +1,167 @@
+/// \file
+/// Synthetic ILA models for the benchmarks.
+
+#include "../bench-include/synth_ila.h"
+
+#include <random>
+#include <unordered_set>
+
+#include <ilang/ila/ast_hub.h>
+#include <ilang/util/log.h>
+
+namespace ilang {
+
+// truncate or zero-extend the bit-vector to the width
+static ExprPtr Fit(const ExprPtr& bv, const int& width) {
+  auto bv_width = bv->sort()->bit_width();
+  if (bv_width == width) {
+    return bv;
+  }
+  return (bv_width < width) ? asthub::ZExt(bv, width)
+                            : asthub::Extract(bv, width - 1, 0);
+}
+
+InstrLvlAbsPtr SynthIla(const SynthIlaConfig& config, const std::string& name) {
+  ILA_ASSERT(config.num_instr > 0 && config.num_state > 0);
+  ILA_ASSERT(config.sharing > 0 && config.depth > 0);
+
+  auto m = InstrLvlAbs::New(name);
+  auto gen = std::mt19937(config.seed);
+  auto Pick = [&gen](const size_t& n) {
+    return std::uniform_int_distribution<size_t>(0, n - 1)(gen);
+  };
+
+  // inputs
+  auto opcode_width = 1;
+  while ((1 << opcode_width) < config.num_instr) {
+    opcode_width++;
+  }
+  auto opcode = m->NewBvInput("opcode", opcode_width);
+  auto data = m->NewBvInput("data", config.state_width);
+  m->SetFetch(opcode);
+  m->SetValid(asthub::BoolConst(true));
+
+  // states
+  std::vector<ExprPtr> states;
+  for (auto i = 0; i != config.num_state; i++) {
+    auto s_name = "s" + std::to_string(i);
+    states.push_back(m->NewBvState(s_name, config.state_width));
+  }
+  std::vector<ExprPtr> mems;
+  for (auto i = 0; i != config.num_mem; i++) {
+    mems.push_back(m->NewMemState("mem" + std::to_string(i),
+                                  config.mem_addr_width,
+                                  config.mem_data_width));
+  }
+
+  // a random expression over the states, inputs, and memory reads
+  auto NewTerm = [&]() {
+    auto leaf = [&]() {
+      auto k = Pick(states.size() + mems.size() + 1);
+      if (k < states.size()) {
+        return states[k];
+      } else if (k == states.size()) {
+        return data;
+      }
+      auto addr = Fit(states[Pick(states.size())], config.mem_addr_width);
+      return Fit(asthub::Load(mems[k - states.size() - 1], addr),
+                 config.state_width);
+    };
+    auto term = leaf();
+    for (auto i = 0; i != config.depth; i++) {
+      switch (Pick(5)) {
+      case 0:
+        term = asthub::Add(term, leaf());
+        break;
+      case 1:
+        term = asthub::Xor(term, leaf());
+        break;
+      case 2:
+        term = asthub::Sub(term, Pick(256));
+        break;
+      case 3:
+        term = asthub::Ite(asthub::Ult(term, leaf()), term, leaf());
+        break;
+      default:
+        term = asthub::And(term, leaf());
+        break;
+      };
+    }
+    return term;
+  };
+
+  // sub-expressions, each shared by "sharing" instructions
+  auto num_shared = (config.num_instr + config.sharing - 1) / config.sharing;
+  std::vector<std::vector<ExprPtr>> shared(states.size() + mems.size());
+  for (auto& pool : shared) {
+    for (auto i = 0; i != num_shared; i++) {
+      pool.push_back(NewTerm());
+    }
+  }
+
+  for (auto i = 0; i != config.num_instr; i++) {
+    auto instr = m->NewInstr("i" + std::to_string(i));
+    instr->set_decode(asthub::Eq(opcode, static_cast<BvValType>(i)));
+    auto k = static_cast<size_t>(i / config.sharing);
+    for (size_t j = 0; j != states.size(); j++) {
+      instr->set_update(states[j], asthub::Add(shared[j][k], i));
+    }
+    for (size_t j = 0; j != mems.size(); j++) {
+      auto addr = Fit(states[(i + j) % states.size()], config.mem_addr_width);
+      auto val = Fit(shared[states.size() + j][k], config.mem_data_width);
+      instr->set_update(mems[j], asthub::Store(mems[j], addr, val));
+    }
+  }
+
+  return m;
+}
+
+std::vector<ExprPtr> SynthIlaUpdates(const InstrLvlAbsPtr& m) {
+  std::vector<ExprPtr> updates;
+  for (size_t i = 0; i != m->instr_num(); i++) {
+    auto instr = m->instr(i);
+    updates.push_back(instr->decode());
+    for (const auto& s : instr->updated_states()) {
+      updates.push_back(instr->update(s));
+    }
+  }
+  return updates;
+}
+
+size_t SynthIlaNodeNum(const InstrLvlAbsPtr& m) {
+  std::unordered_set<ExprPtr> nodes;
+  auto Collect = [&nodes](const ExprPtr& e) { nodes.insert(e); };
+  for (const auto& e : SynthIlaUpdates(m)) {
+    e->DepthFirstVisit(Collect);
+  }
+  return nodes.size();
+}
+
+SynthIlaConfig SynthIlaArgs(const benchmark::State& state) {
+  auto config = SynthIlaConfig();
+  config.num_instr = static_cast<int>(state.range(0));
+  config.num_state = static_cast<int>(state.range(1));
+  config.sharing = static_cast<int>(state.range(2));
+  config.mem_data_width = static_cast<int>(state.range(3));
+  return config;
+}
+
+void SynthIlaArgSets(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"instr", "state", "share", "mem_w"});
+  // scale the number of instructions and states
+  for (auto instr : {8, 64, 256}) {
+    for (auto state : {8, 32}) {
+      b->Args({instr, state, 1, 32});
+    }
+  }
+  // DAG sharing
+  for (auto share : {4, 16}) {
+    b->Args({64, 8, share, 32});
+  }
+  // memory widths
+  for (auto mem_w : {8, 64}) {
+    b->Args({64, 8, 1, mem_w});
+  }
+}
+
+} // namespace ilang
@@ -7,6 +7,7 @@
 #include <functional>
 
 #include <ilang/ila/instr_lvl_abs.h>
+#include <ilang/target-smt/solver_portfolio.h>
 
 /// \namespace ilang
 namespace ilang {
@@ -34,8 +35,11 @@ bool RewriteGeneric(const InstrLvlAbsPtr& m,
 
 /// \brief Simplify instructions (across the hierarchy) semantically (z3).
 /// \param[in] m The top-level ILA.
-/// \param[in] timeout Max time (ms) for each SMT query. (-1 for default)
-bool SimplifySemantic(const InstrLvlAbsCnstPtr& m, const int& timeout = -1);
+/// \param[in] timeout Max time (ms) for each SMT query, also with the
+/// portfolio. (-1 for default)
+/// \param[in] portfolio The solver portfolio for the queries (optional).
+bool SimplifySemantic(const InstrLvlAbsCnstPtr& m, const int& timeout = -1,
+                      const SolverPortfolioPtr& portfolio = nullptr);
 
 /// \brief Simplify instructions (across the hierarchy) syntactically.
 /// (Light-weight simplification, no SMT query.)
@@ -4,6 +4,12 @@
 #ifndef ILANG_ILA_MNGR_U_ABS_KNOB_H__
 #define ILANG_ILA_MNGR_U_ABS_KNOB_H__
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ilang/ila-mngr/u_rewriter.h>
 #include <ilang/ila/instr_lvl_abs.h>
 
 /// \namespace ilang
@@ -65,6 +71,10 @@ InstrVec GetInstrTree(const InstrLvlAbsCnstPtr& top);
 /// - If leaves contain non-var nodes, will replace with no further traverse.
 ExprPtr Rewrite(const ExprPtr& e, const ExprMap& rule);
 
+/// \brief Rewrite an expression by the rule set, i.e. bottom-up until no rule
+/// applies, e.g. Rewrite(e, RewriteRuleSet::Default()).
+ExprPtr Rewrite(const ExprPtr& e, const RewriteRuleSet& rules);
+
 /// \brief Rewrite an instruction by replacing based on the rule.
 void RewriteInstr(const InstrCnstPtr instr_src, const InstrPtr& instr_dst,
                   const ExprMap& expr_map);
@@ -108,6 +118,36 @@ InstrPtr DuplInstr(const InstrCnstPtr instr_src, const InstrLvlAbsPtr& dst,
 /// Duplicate instruction sequence to dst. NOT IMPLEMENTED YET.
 void DuplInstrSeq(const InstrLvlAbsCnstPtr& src, const InstrLvlAbsPtr& dst);
 
+/****************************************************************************/
+/// Statistics of the expression graph of an ILA.
+struct ExprGraphStats {
+  /// Number of unique nodes, i.e., shared nodes counted once.
+  size_t unique_node_num = 0;
+  /// Number of nodes if expanded as trees (saturated at the max of size_t).
+  size_t tree_node_num = 0;
+  /// Number of nodes on the longest path from a root to a leaf.
+  size_t max_depth = 0;
+  /// Number of nodes of each fan-out (number of uses as an argument).
+  std::map<size_t, size_t> fanout_hist;
+  /// Number of nodes of each kind (operator name, "VAR", or "CONST").
+  std::map<std::string, size_t> op_hist;
+  /// Number of memory reads.
+  size_t load_num = 0;
+  /// Number of memory writes.
+  size_t store_num = 0;
+  /// Number of unique nodes in the decode and updates of each instruction.
+  std::vector<std::pair<std::string, size_t>> instr_cone_size;
+
+  /// Return the statistics in JSON format (compact if indent is negative).
+  std::string ToJson(const int& indent = -1) const;
+};
+
+/// \brief Compute the statistics of the expression graph of the ILA, i.e.,
+/// the decode and updates of the instructions (including child), and the
+/// valid, fetch, and initial conditions of the top. The instructions are
+/// visited in parallel.
+ExprGraphStats GetExprGraphStats(const InstrLvlAbsCnstPtr& m);
+
 }; // namespace absknob
 
 } // namespace ilang
@@ -4,6 +4,10 @@
 #ifndef ILANG_ILA_MNGR_U_REWRITER_H__
 #define ILANG_ILA_MNGR_U_REWRITER_H__
 
+#include <functional>
+#include <string>
+#include <vector>
+
 #include <ilang/ila/instr_lvl_abs.h>
 
 namespace ilang {
@@ -33,6 +37,139 @@ protected:
 
 }; // class FuncObjRewrExpr
 
+/// \brief Declarative pattern over the AST. A pattern matches any node, a
+/// constant, or an operation (by AstUidExprOp) whose leading arguments match
+/// the sub-patterns. The bit-width (and the value for constants) can be
+/// further constrained.
+class RewritePattern {
+public:
+  // ------------------------- HELPERS -------------------------------------- //
+  /// Match any node.
+  static RewritePattern Any();
+  /// Match any constant.
+  static RewritePattern Const();
+  /// Match the bit-vector/Boolean constant with the value.
+  static RewritePattern Const(const BvValType& val);
+  /// Match an operation node, with sub-patterns for (leading) arguments.
+  static RewritePattern Op(const AstUidExprOp& op,
+                           const std::vector<RewritePattern>& args = {});
+
+  // ------------------------- METHODS -------------------------------------- //
+  /// Return a copy that also requires the bit-width (0 for Boolean).
+  RewritePattern Width(const int& width) const;
+  /// Return true if the node matches the pattern.
+  bool Match(const ExprPtr& e) const;
+
+  /// Return the root operation (kInvalid if not an operation pattern).
+  inline AstUidExprOp op() const { return op_; }
+
+private:
+  /// Type of the pattern.
+  typedef enum { ANY, CONST, OP } PatternKind;
+
+  /// Type of the pattern.
+  PatternKind kind_ = ANY;
+  /// Root operation (OP only).
+  AstUidExprOp op_ = AstUidExprOp::kInvalid;
+  /// Sub-patterns of the arguments (OP only).
+  std::vector<RewritePattern> args_;
+  /// Required bit-width (-1 for don't care).
+  int width_ = -1;
+  /// Required value (CONST only).
+  bool has_val_ = false;
+  /// Required value (CONST only).
+  BvValType val_ = 0;
+
+}; // class RewritePattern
+
+/// \brief A rewrite rule: the pattern (left-hand side) and the action that
+/// builds the replacement. The action may return NULL to decline, e.g. when
+/// conditions beyond the pattern do not hold. Rules must not grow the AST, so
+/// that applying them repeatedly reaches a fixpoint.
+struct RewriteRule {
+  /// Type of the rewriting action.
+  typedef std::function<ExprPtr(const ExprPtr&)> Action;
+
+  /// Name of the rule (for statistics).
+  std::string name;
+  /// Left-hand side pattern; the root must be an operation.
+  RewritePattern lhs;
+  /// Build the right-hand side for the matched node.
+  Action rhs;
+};
+
+/// \brief A set of rewrite rules, indexed by the root operation.
+class RewriteRuleSet {
+public:
+  // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
+  /// Default constructor (empty set).
+  RewriteRuleSet() {}
+
+  // ------------------------- HELPERS -------------------------------------- //
+  /// \brief Return the standard rule set, i.e.
+  /// - constant folding (bit-vector up to 64 bits and Boolean)
+  /// - extract of concat, and full-width extract
+  /// - if-then-else with constant condition or identical branches
+  /// - load from store (forwarding)
+  /// - and/or with constant, idempotence, and absorption
+  static const RewriteRuleSet& Default();
+
+  // ------------------------- METHODS -------------------------------------- //
+  /// Add a rule (matched after the existing rules of the same root).
+  void Add(const RewriteRule& rule);
+  /// Add a rule (matched after the existing rules of the same root).
+  void Add(const std::string& name, const RewritePattern& lhs,
+           const RewriteRule::Action& rhs);
+  /// Return the number of rules.
+  inline size_t size() const { return size_; }
+
+  /// \brief Apply the first matching rule on the root of the node.
+  /// \param[in] e the node.
+  /// \param[out] name the name of the rule applied (if not NULL).
+  /// \return the replacement, or NULL if no rule applies.
+  ExprPtr Apply(const ExprPtr& e, std::string* name = NULL) const;
+
+private:
+  /// Rules indexed by the root operation.
+  std::vector<std::vector<RewriteRule>> index_;
+  /// Number of rules.
+  size_t size_ = 0;
+
+}; // class RewriteRuleSet
+
+/// \brief Function object for rewriting Expr by a rule set. Nodes are
+/// rewritten bottom-up until no rule applies, and the results are memoized so
+/// that shared sub-trees (also across different calls) are rewritten once.
+class FuncObjRuleRewr : public FuncObjRewrExpr {
+public:
+  /// Constructor.
+  FuncObjRuleRewr(const RewriteRuleSet& rules = RewriteRuleSet::Default())
+      : FuncObjRewrExpr({}), rules_(rules) {}
+
+  /// Return the rewritten (normalized) node.
+  ExprPtr Apply(const ExprPtr& e);
+
+  /// Post-process: rebuild the node with rewritten arguments and normalize.
+  void post(const ExprPtr& e);
+
+  /// Return the number of rule applications.
+  inline size_t hit_num() const { return hit_num_; }
+  /// Return the number of applications of the named rule.
+  size_t hit_num(const std::string& name) const;
+
+private:
+  /// The rule set.
+  RewriteRuleSet rules_;
+  /// Number of rule applications.
+  size_t hit_num_ = 0;
+  /// Number of rule applications per rule.
+  std::map<std::string, size_t> hits_;
+
+  /// Return the node with arguments replaced by their rewritten results.
+  ExprPtr Rebuild(const ExprPtr& e) const;
+
+}; // class FuncObjRuleRewr
+
 /// \brief  Function object for rewriting ILA tree.
 class FuncObjRewrIla {
 private:
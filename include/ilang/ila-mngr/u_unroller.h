@@ -47,6 +47,12 @@ public:
   void ClearStepPred();
   /// Clear all predicates.
   void ClearPred();
+  /// \brief Encode the memory state lazily, i.e., as read events over the
+  /// initial contents instead of arrays (see Z3LazyMemEncoder). Not applied
+  /// to the batch checking, and the model of the memory is not meaningful.
+  void AddLazyMem(const ExprPtr& mem);
+  /// Clear the memory states to encode lazily.
+  void ClearLazyMem();
 
   // ------------------------- HELPERS -------------------------------------- //
   /// Return the z3::expr representing the current state at the time.
@@ -94,6 +100,18 @@ protected:
   /// Unroll without asserting state equality between each step.
   ZExpr UnrollNone(const size_t& len, const int& pos);
 
+  /// \brief Prepare for unrolling step by step, e.g., for sharing the steps
+  /// among multiple unrollings (see StepState and StepTrans).
+  void UnrollStepBegin(const int& pos);
+  /// \brief Return the predicates on the state after k steps, i.e., global
+  /// and (external) step-specific predicates.
+  ZExpr StepState(const size_t& k, const int& pos);
+  /// \brief Return the k-th transition, i.e., the initial (if k is 0) and
+  /// step-specific predicates and the equality between the next state values
+  /// and the state vars of k + 1. As in UnrollAssn, the initial predicates
+  /// only come with the first transition (none for an empty path).
+  ZExpr StepTrans(const size_t& k, const int& pos);
+
   // ------------------------- HELPERS -------------------------------------- //
   /// Return the state update function (unchanged if not defined).
   static ExprPtr StateUpdCmpl(const InstrPtr& instr, const ExprPtr& var);
@@ -119,6 +137,8 @@ private:
   IExprVec i_pred_;
   /// The mapping of (external) step-specific predicates.
   std::map<int, IExprVec> s_pred_;
+  /// The set of memory states to encode lazily.
+  IExprVec lazy_mem_;
 
   /// The set of z3::expr representing the latest states of previous steps.
   ZExprVec k_prev_z3_;
@@ -163,6 +183,8 @@ private:
 
   /// Conjunct (AND) all the predicates in the set.
   ZExpr ConjPred(const ZExprVec& vec) const;
+  /// Encode the memories in the unrolled formula lazily, if any.
+  ZExpr EncodeMem(const ZExpr& cstr) const;
 
   /// Suffix generator for current state expressions of each step.
   inline std::string SuffCurr(const int& t) const {
@@ -205,6 +227,19 @@ public:
   /// \param[in] pos the starting time frame.
   ZExpr PathNone(const std::vector<InstrPtr>& seq, const int& pos = 0);
 
+  /// \brief Check a set of instruction sequences (unrolled as in PathAssn) in
+  /// batch. Sequences are organized as a prefix trie, where each trie edge is
+  /// unrolled and asserted once, and the trie is walked with solver push/pop.
+  /// The state variables are the union of those of all sequences.
+  /// \param[in] seqs the set of instruction sequences.
+  /// \param[in] solver the solver to check with (scopes are restored).
+  /// \param[in] props the per-sequence assumptions on the end state (optional).
+  /// \param[in] pos the starting time frame.
+  /// \return the check result of each sequence.
+  std::vector<z3::check_result>
+  PathAssnBatch(const std::vector<InstrVec>& seqs, z3::solver& solver,
+                const ExprPtrVec& props = {}, const int& pos = 0);
+
 protected:
   // ------------------------- METHODS -------------------------------------- //
   /// \brief [Application-specific] Define dependant state variables.
@@ -58,6 +58,10 @@ public:
   inline auto GetSmtFuncDecl(const FuncPtr& func) const {
     return smt_gen_.GetShimFunc(func);
   }
+  /// \brief Return the constraints of each step in the last unrolling, i.e.,
+  /// the conjunction returned by Unroll is the conjunction of these. Asserting
+  /// them separately lets incremental solvers reuse the shared steps.
+  inline const auto& GetFrameConstraints() const { return frame_holder_; }
 
 private:
   // ------------------------- MEMBERS -------------------------------------- //
@@ -97,6 +101,8 @@ protected:
   IlaExprVec update_holder_;
   /// Non-execution semantics (state update) properties
   IlaExprVec assert_holder_;
+  /// Constraints of each step (and the end state) in the last unrolling
+  SmtExprVec frame_holder_;
 
   // ------------------------- METHODS -------------------------------------- //
   /// Setup the deciding variabels
@@ -140,11 +146,7 @@ private:
   }
 
   inline SmtExpr ConjunctAll(const SmtExprVec& vec) const {
-    auto conjunct_holder = smt_gen_.GetShimExpr(asthub::BoolConst(true));
-    for (const auto& e : vec) {
-      conjunct_holder = smt_gen_.BoolAnd(conjunct_holder, e);
-    }
-    return conjunct_holder;
+    return smt_gen_.BoolAndAll(vec);
   }
 
 }; // class UnrollerSmt
@@ -9,6 +9,7 @@
 #include <z3++.h>
 
 #include <ilang/ila/instr_lvl_abs.h>
+#include <ilang/target-smt/solver_portfolio.h>
 #include <ilang/target-smt/z3_expr_adapter.h>
 #include <ilang/util/container.h>
 
@@ -34,6 +35,11 @@ public:
   /// \brief Add property of one ILA.
   void AddProperty(ExprPtr prop);
 
+  /// \brief Check the queries with the solver portfolio (nullptr to disable).
+  inline void SetPortfolio(const SolverPortfolioPtr& portfolio) {
+    portfolio_ = portfolio;
+  }
+
   /// \brief Legacy BMC where two ILAs are unrolled and compared monolithically.
   z3::check_result Check(InstrLvlAbsPtr m0, const int& k0, InstrLvlAbsPtr m1,
                          const int& k1);
@@ -55,6 +61,9 @@ private:
   /// if set to true.
   bool def_tran_ = false;
 
+  /// The solver portfolio for the queries (the default solver if not set).
+  SolverPortfolioPtr portfolio_ = nullptr;
+
   // ------------------------- HELPERS -------------------------------------- //
   /// Unroll an ILA for k steps
   /// \param[in] m pointer to the ILA to unroll.
@@ -9,6 +9,7 @@
 
 #include <ilang/ila-mngr/u_unroller.h>
 #include <ilang/ila/instr_lvl_abs.h>
+#include <ilang/target-smt/solver_portfolio.h>
 
 /// \namespace ilang
 namespace ilang {
@@ -199,6 +200,11 @@ public:
 
   bool IncCheck(const int& min = 0, const int& max = 10, const int& step = 1);
 
+  /// \brief Check the queries with the solver portfolio (nullptr to disable).
+  inline void SetPortfolio(const SolverPortfolioPtr& portfolio) {
+    portfolio_ = portfolio;
+  }
+
   typedef MonoUnroll Unroll;
 
 private:
@@ -207,6 +213,13 @@ private:
   z3::context& ctx_;
   /// The refinement relation.
   CrrPtr crr_;
+  /// The solver portfolio for the queries (the default solver if not set).
+  SolverPortfolioPtr portfolio_ = nullptr;
+
+  /// Check the assertions of the solver, with the portfolio if set.
+  z3::check_result Check(z3::solver& s) const;
+  /// Return the model of the last (sat) check.
+  z3::model GetModel(z3::solver& s) const;
 
   // ------------------------- IncCheck ------------------------------------- //
 
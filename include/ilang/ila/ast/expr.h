@@ -4,6 +4,7 @@
 #ifndef ILANG_ILA_AST_EXPR_H__
 #define ILANG_ILA_AST_EXPR_H__
 
+#include <initializer_list>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -16,6 +17,7 @@
 
 #include <ilang/ila/ast/ast.h>
 #include <ilang/ila/ast/sort.h>
+#include <ilang/util/container.h>
 
 /// \namespace ilang
 namespace ilang {
@@ -58,8 +60,12 @@ public:
   void set_sort(const SortPtr sort);
   /// Set the arguments.
   void set_args(const ExprPtrVec& args);
+  /// Set the arguments.
+  void set_args(std::initializer_list<ExprPtr> args);
   /// Set the parameters.
   void set_params(const std::vector<int> params);
+  /// Set the parameters.
+  void set_params(std::initializer_list<int> params);
   /// Replace the i-th argument.
   void replace_arg(const int& idx, const ExprPtr& arg);
   /// Replace the "a" argument with "b" argument with "exist".
@@ -125,10 +131,10 @@ private:
   // ------------------------- MEMBERS -------------------------------------- //
   /// The sort of the expr.
   SortPtr sort_;
-  /// Vector of arguments.
-  ExprPtrVec args_;
-  /// Vector of parameters.
-  std::vector<int> params_;
+  /// Arguments (inlined for up to three, e.g. ITE and Store).
+  SmallVec<ExprPtr, 3> args_;
+  /// Parameters (inlined for up to two, e.g. Extract).
+  SmallVec<int, 2> params_;
 
   // ------------------------- HELPERS -------------------------------------- //
 
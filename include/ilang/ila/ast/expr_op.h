@@ -5,6 +5,7 @@
 #define ILANG_ILA_AST_EXPR_OP_H__
 
 #include <ilang/ila/ast/expr.h>
+#include <ilang/util/log.h>
 
 /// \namespace ilang
 namespace ilang {
@@ -56,24 +57,26 @@ class ExprOp : public Expr {
 public:
   // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
   /// Constructor for unary operators.
-  ExprOp(const ExprPtr& arg);
+  ExprOp(const AstUidExprOp& uid, const ExprPtr& arg);
   /// Constructor for binary operators.
-  ExprOp(const ExprPtr& arg0, const ExprPtr& arg1);
+  ExprOp(const AstUidExprOp& uid, const ExprPtr& arg0, const ExprPtr& arg1);
   /// Constructor for ternary operators.
-  ExprOp(const ExprPtr& arg0, const ExprPtr& arg1, const ExprPtr& arg2);
+  ExprOp(const AstUidExprOp& uid, const ExprPtr& arg0, const ExprPtr& arg1,
+         const ExprPtr& arg2);
   /// Constructor for binary operators with parameters.
-  ExprOp(const ExprPtr& arg0, const int& param1);
+  ExprOp(const AstUidExprOp& uid, const ExprPtr& arg0, const int& param1);
   /// Constructor for ternary operators with parameters.
-  ExprOp(const ExprPtr& arg0, const int& param1, const int& param2);
+  ExprOp(const AstUidExprOp& uid, const ExprPtr& arg0, const int& param1,
+         const int& param2);
   /// Constructor for multiple argument operators (AppFunc).
-  ExprOp(const ExprPtrVec& args);
+  ExprOp(const AstUidExprOp& uid, const ExprPtrVec& args);
 
   /// Default destructor.
   virtual ~ExprOp();
 
   // ------------------------- ACCESSORS/MUTATORS --------------------------- //
   /// Return the unified ID of the corresponding operation.
-  virtual AstUidExprOp uid() const = 0;
+  inline AstUidExprOp uid() const { return uid_; }
 
   /// Return the name of the operation.
   std::string op_name() const;
@@ -98,7 +101,12 @@ protected:
 
 private:
   // ------------------------- MEMBERS -------------------------------------- //
-  InstrLvlAbsPtr GetHost(const ExprSet& args) const;
+  /// Unified ID of the operation, stored for dispatching without casts.
+  AstUidExprOp uid_;
+
+  // ------------------------- HELPERS -------------------------------------- //
+  /// Derive the host ILA from the arguments.
+  InstrLvlAbsPtr GetHost() const;
 
 }; // class ExprOp
 
@@ -107,31 +115,28 @@ private:
 /******************************************************************************/
 
 /// \brief The wrapper for unary negate operation "-".
-class ExprOpNeg : public ExprOp {
+class ExprOpNeg final : public ExprOp {
 public:
   /// Constructor for Negate operation.
   ExprOpNeg(const ExprPtr& arg);
-  AstUidExprOp uid() const { return AstUidExprOp::kNegate; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpNeg
 
 /// \brief The wrapper for unary not operation "!". (bool only)
-class ExprOpNot : public ExprOp {
+class ExprOpNot final : public ExprOp {
 public:
   /// Constructor for Not operation.
   ExprOpNot(const ExprPtr& arg);
-  AstUidExprOp uid() const { return AstUidExprOp::kNot; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpNot
 
 /// \brief The wrapper for unary bit-wise complement "~". (bv only)
-class ExprOpCompl : public ExprOp {
+class ExprOpCompl final : public ExprOp {
 public:
   /// Constructor for Complement operation.
   ExprOpCompl(const ExprPtr& arg);
-  AstUidExprOp uid() const { return AstUidExprOp::kComplement; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpCompl
@@ -141,121 +146,109 @@ public:
 /******************************************************************************/
 
 /// \brief The wrapper for binary logical AND operation "&".
-class ExprOpAnd : public ExprOp {
+class ExprOpAnd final : public ExprOp {
 public:
   /// Constructor for AND operation.
   ExprOpAnd(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kAnd; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpAnd
 
 /// \brief The wrapper for binary logical OR operation "|".
-class ExprOpOr : public ExprOp {
+class ExprOpOr final : public ExprOp {
 public:
   /// Constructor for OR operation.
   ExprOpOr(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kOr; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpOr
 
 /// \brief The wrapper for binary logical XOR operation "^".
-class ExprOpXor : public ExprOp {
+class ExprOpXor final : public ExprOp {
 public:
   /// Constructor for XOR operation.
   ExprOpXor(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kXor; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpXor
 
 /// \brief The wrapper for left shifting a bit-vector.
-class ExprOpShl : public ExprOp {
+class ExprOpShl final : public ExprOp {
 public:
   /// Constructor for left shifting a bit-vector.
   ExprOpShl(const ExprPtr& bv, const ExprPtr& n);
-  AstUidExprOp uid() const { return AstUidExprOp::kShiftLeft; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpShl
 
 /// \brief The wrapper for arithmetic right shifting a bit-vector.
-class ExprOpAshr : public ExprOp {
+class ExprOpAshr final : public ExprOp {
 public:
   /// Constructor for arithmetic right shifting a bit-vector.
   ExprOpAshr(const ExprPtr& bv, const ExprPtr& n);
-  AstUidExprOp uid() const { return AstUidExprOp::kArithShiftRight; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpAshr
 
 /// \brief The wrapper for logical right shifting a bit-vector.
-class ExprOpLshr : public ExprOp {
+class ExprOpLshr final : public ExprOp {
 public:
   /// Constructor for logical right shifting a bit-vector.
   ExprOpLshr(const ExprPtr& bv, const ExprPtr& n);
-  AstUidExprOp uid() const { return AstUidExprOp::kLogicShiftRight; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpLshr
 
 /// \brief The wrapper for unsigned addition.
-class ExprOpAdd : public ExprOp {
+class ExprOpAdd final : public ExprOp {
 public:
   /// Constructor for ADD operation.
   ExprOpAdd(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kAdd; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpAdd
 
 /// \brief The wrapper for unsigned subtraction.
-class ExprOpSub : public ExprOp {
+class ExprOpSub final : public ExprOp {
 public:
   /// Constructor for SUB operation.
   ExprOpSub(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kSubtract; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpSub
 
 /// \brief The wrapper for unsigned division.
-class ExprOpDiv : public ExprOp {
+class ExprOpDiv final : public ExprOp {
 public:
   /// Constructor for DIV operation.
   ExprOpDiv(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kDivide; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpDiv
 
 /// \brief The wrapper for signed remainder
-class ExprOpSRem : public ExprOp {
+class ExprOpSRem final : public ExprOp {
 public:
   /// Constructor for SREM operation.
   ExprOpSRem(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kSignedRemainder; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpSRem
 
 /// \brief The wrapper for unsigned remainder
-class ExprOpURem : public ExprOp {
+class ExprOpURem final : public ExprOp {
 public:
   /// Constructor for UREM operation.
   ExprOpURem(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kUnsignedRemainder; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpURem
 
 /// \brief The wrapper for signed remainder
-class ExprOpSMod : public ExprOp {
+class ExprOpSMod final : public ExprOp {
 public:
   /// Constructor for SREM operation.
   ExprOpSMod(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kSignedModular; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpSMod
@@ -263,11 +256,10 @@ public:
 // TODO ExprOpUMod
 
 /// \brief The wrapper for unsigned multiplication.
-class ExprOpMul : public ExprOp {
+class ExprOpMul final : public ExprOp {
 public:
   /// Constructor for MUL operation.
   ExprOpMul(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kMultiply; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpMul
@@ -277,11 +269,10 @@ public:
 /******************************************************************************/
 
 /// \brief The class wrapper for binary comparison EQ "==".
-class ExprOpEq : public ExprOp {
+class ExprOpEq final : public ExprOp {
 public:
   /// Constructor for Equal comparison.
   ExprOpEq(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kEqual; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpEq
@@ -289,21 +280,19 @@ public:
 // Not equal is implemented in asthub with Eq and Not.
 
 /// \brief The class wrapper for binary comparison signed less than "<".
-class ExprOpLt : public ExprOp {
+class ExprOpLt final : public ExprOp {
 public:
   /// Construtor for Lt comparison.
   ExprOpLt(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kLessThan; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpLt
 
 /// \brief The class wrapper for binary comparison signed greater than ">".
-class ExprOpGt : public ExprOp {
+class ExprOpGt final : public ExprOp {
 public:
   /// Constructor for Gt comparison.
   ExprOpGt(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kGreaterThan; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpGt
@@ -313,21 +302,19 @@ public:
 // Signed greater than or equal to is implemented in asthub with Eq and Gt.
 
 /// \brief The class wrapper for binary comparison unsigned less than.
-class ExprOpUlt : public ExprOp {
+class ExprOpUlt final : public ExprOp {
 public:
   /// Construtor for ULt comparison.
   ExprOpUlt(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kUnsignedLessThan; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpUlt
 
 /// \brief The class wrapper for binary comparison unsigned greater than.
-class ExprOpUgt : public ExprOp {
+class ExprOpUgt final : public ExprOp {
 public:
   /// Constructor for UGt comparison.
   ExprOpUgt(const ExprPtr& arg0, const ExprPtr& arg1);
-  AstUidExprOp uid() const { return AstUidExprOp::kUnsignedGreaterThan; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpUgt
@@ -341,21 +328,19 @@ public:
 /******************************************************************************/
 
 /// \brief The class wrapper for memory load.
-class ExprOpLoad : public ExprOp {
+class ExprOpLoad final : public ExprOp {
 public:
   /// Constructor for memory load.
   ExprOpLoad(const ExprPtr& mem, const ExprPtr& addr);
-  AstUidExprOp uid() const { return AstUidExprOp::kLoad; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpLoad
 
 /// \brief The class wrapper for memory store.
-class ExprOpStore : public ExprOp {
+class ExprOpStore final : public ExprOp {
 public:
   /// Constructor for memory store.
   ExprOpStore(const ExprPtr& mem, const ExprPtr& addr, const ExprPtr& data);
-  AstUidExprOp uid() const { return AstUidExprOp::kStore; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpStore
@@ -365,61 +350,55 @@ public:
 /******************************************************************************/
 
 /// \brief The class wrapper for bitvector concatenation.
-class ExprOpConcat : public ExprOp {
+class ExprOpConcat final : public ExprOp {
 public:
   /// Constructor for bitvector concatenation.
   ExprOpConcat(const ExprPtr& hi, const ExprPtr& lo);
-  AstUidExprOp uid() const { return AstUidExprOp::kConcatenate; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpConcat
 
 /// \brief The class wrapper for bitvector extraction.
-class ExprOpExtract : public ExprOp {
+class ExprOpExtract final : public ExprOp {
 public:
   /// Constructor for bitvector extraction.
   ExprOpExtract(const ExprPtr& bv, const int& hi, const int& lo);
-  AstUidExprOp uid() const { return AstUidExprOp::kExtract; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpExtract
 
 /// \brief The class wrapper for zero-extend.
-class ExprOpZExt : public ExprOp {
+class ExprOpZExt final : public ExprOp {
 public:
   /// Constructor for bitvector zero-extend.
   ExprOpZExt(const ExprPtr& bv, const int& bit_width);
-  AstUidExprOp uid() const { return AstUidExprOp::kZeroExtend; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpZExtend
 
 /// \brief The class wrapper for sign-extend.
-class ExprOpSExt : public ExprOp {
+class ExprOpSExt final : public ExprOp {
 public:
   /// Constructor for bitvector sign-extend.
   ExprOpSExt(const ExprPtr& bv, const int& bit_width);
-  AstUidExprOp uid() const { return AstUidExprOp::kSignedExtend; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpSExt
 
 /// \brief The class wrapper for left-rotate.
-class ExprOpLRotate : public ExprOp {
+class ExprOpLRotate final : public ExprOp {
 public:
   /// Constructor for LRotate operation.
   ExprOpLRotate(const ExprPtr& bv, const int& immediate);
-  AstUidExprOp uid() const { return AstUidExprOp::kRotateLeft; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpLRotate
 
 /// \brief The class wrapper for right-rotate.
-class ExprOpRRotate : public ExprOp {
+class ExprOpRRotate final : public ExprOp {
 public:
   /// Constructor for LRotate operation.
   ExprOpRRotate(const ExprPtr& bv, const int& immediate);
-  AstUidExprOp uid() const { return AstUidExprOp::kRotateRight; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpRRotate
@@ -429,14 +408,13 @@ public:
 /******************************************************************************/
 
 /// \brief The class wrapper for apply uninterpreted function.
-class ExprOpAppFunc : public ExprOp {
+class ExprOpAppFunc final : public ExprOp {
 public:
   /// Type for forware declaring Func.
   typedef std::shared_ptr<Func> FuncPtr;
 
   /// Constructor for apply uninterpreted function.
   ExprOpAppFunc(const FuncPtr& f, const ExprPtrVec& args);
-  AstUidExprOp uid() const { return AstUidExprOp::kApplyFunc; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
   inline FuncPtr func() const { return f; }
@@ -451,26 +429,103 @@ private:
 /******************************************************************************/
 
 /// \brief The class wrapper for logical imply.
-class ExprOpImply : public ExprOp {
+class ExprOpImply final : public ExprOp {
 public:
   /// Constructor for imply.
   ExprOpImply(const ExprPtr& ante, const ExprPtr& cons);
-  AstUidExprOp uid() const { return AstUidExprOp::kImply; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpImply
 
 /// \brief The class wrapper for if-then-else.
-class ExprOpIte : public ExprOp {
+class ExprOpIte final : public ExprOp {
 public:
   /// Constructor for if-then-else.
   ExprOpIte(const ExprPtr& cnd, const ExprPtr& true_expr,
             const ExprPtr& false_expr);
-  AstUidExprOp uid() const { return AstUidExprOp::kIfThenElse; }
   z3::expr GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
                      const std::string& suffix) const;
 }; // class ExprOpIte
 
+/******************************************************************************/
+// Dispatch
+/******************************************************************************/
+
+/// \brief Apply the function object on the operation node as its concrete
+/// class, selected by switching on the stored ID, i.e., without dynamic casts
+/// or virtual calls, e.g., DispatchExprOp(op, [](const auto& n) { ... }).
+template <class F> decltype(auto) DispatchExprOp(const ExprOp& op, F&& f) {
+  switch (op.uid()) {
+  case AstUidExprOp::kNegate:
+    return f(static_cast<const ExprOpNeg&>(op));
+  case AstUidExprOp::kNot:
+    return f(static_cast<const ExprOpNot&>(op));
+  case AstUidExprOp::kComplement:
+    return f(static_cast<const ExprOpCompl&>(op));
+  case AstUidExprOp::kAnd:
+    return f(static_cast<const ExprOpAnd&>(op));
+  case AstUidExprOp::kOr:
+    return f(static_cast<const ExprOpOr&>(op));
+  case AstUidExprOp::kXor:
+    return f(static_cast<const ExprOpXor&>(op));
+  case AstUidExprOp::kShiftLeft:
+    return f(static_cast<const ExprOpShl&>(op));
+  case AstUidExprOp::kArithShiftRight:
+    return f(static_cast<const ExprOpAshr&>(op));
+  case AstUidExprOp::kLogicShiftRight:
+    return f(static_cast<const ExprOpLshr&>(op));
+  case AstUidExprOp::kAdd:
+    return f(static_cast<const ExprOpAdd&>(op));
+  case AstUidExprOp::kSubtract:
+    return f(static_cast<const ExprOpSub&>(op));
+  case AstUidExprOp::kMultiply:
+    return f(static_cast<const ExprOpMul&>(op));
+  case AstUidExprOp::kEqual:
+    return f(static_cast<const ExprOpEq&>(op));
+  case AstUidExprOp::kLessThan:
+    return f(static_cast<const ExprOpLt&>(op));
+  case AstUidExprOp::kGreaterThan:
+    return f(static_cast<const ExprOpGt&>(op));
+  case AstUidExprOp::kUnsignedLessThan:
+    return f(static_cast<const ExprOpUlt&>(op));
+  case AstUidExprOp::kUnsignedGreaterThan:
+    return f(static_cast<const ExprOpUgt&>(op));
+  case AstUidExprOp::kLoad:
+    return f(static_cast<const ExprOpLoad&>(op));
+  case AstUidExprOp::kStore:
+    return f(static_cast<const ExprOpStore&>(op));
+  case AstUidExprOp::kConcatenate:
+    return f(static_cast<const ExprOpConcat&>(op));
+  case AstUidExprOp::kExtract:
+    return f(static_cast<const ExprOpExtract&>(op));
+  case AstUidExprOp::kZeroExtend:
+    return f(static_cast<const ExprOpZExt&>(op));
+  case AstUidExprOp::kSignedExtend:
+    return f(static_cast<const ExprOpSExt&>(op));
+  case AstUidExprOp::kApplyFunc:
+    return f(static_cast<const ExprOpAppFunc&>(op));
+  case AstUidExprOp::kImply:
+    return f(static_cast<const ExprOpImply&>(op));
+  case AstUidExprOp::kDivide:
+    return f(static_cast<const ExprOpDiv&>(op));
+  case AstUidExprOp::kRotateLeft:
+    return f(static_cast<const ExprOpLRotate&>(op));
+  case AstUidExprOp::kRotateRight:
+    return f(static_cast<const ExprOpRRotate&>(op));
+  case AstUidExprOp::kSignedRemainder:
+    return f(static_cast<const ExprOpSRem&>(op));
+  case AstUidExprOp::kUnsignedRemainder:
+    return f(static_cast<const ExprOpURem&>(op));
+  case AstUidExprOp::kSignedModular:
+    return f(static_cast<const ExprOpSMod&>(op));
+  default:
+    ILA_CHECK(false) << "Unknown operation " << op.uid();
+    [[fallthrough]];
+  case AstUidExprOp::kIfThenElse:
+    return f(static_cast<const ExprOpIte&>(op));
+  };
+}
+
 } // namespace ilang
 
 #endif // ILANG_ILA_AST_EXPR_OP_H__
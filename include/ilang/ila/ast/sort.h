@@ -18,11 +18,12 @@ namespace ilang {
 enum AstUidSort { kBool = 1, kBv, kMem };
 
 /// \brief The class for sort (type for expr, and the range/domain of
-/// functions).
+/// functions). Sorts are shared by all expressions of the same type, so they
+/// are only handed out as const, i.e., the name and host cannot be changed.
 class Sort : public Ast {
 public:
-  /// Pointer type for storing/passing Sort.
-  typedef std::shared_ptr<Sort> SortPtr;
+  /// Pointer type for storing/passing Sort (immutable).
+  typedef std::shared_ptr<const Sort> SortPtr;
 
   // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
   /// Default constructor.
@@ -31,11 +32,13 @@ public:
   virtual ~Sort();
 
   // ------------------------- HELPERS -------------------------------------- //
-  /// Create a Boolean Sort
+  /// \brief Return the Boolean Sort.
+  /// Sorts created by the factory functions are interned (thread-safe), i.e.,
+  /// each distinct sort exists only once and can be compared by pointer.
   static SortPtr MakeBoolSort();
-  /// Create a bit-vector Sort.
+  /// Return the (interned) bit-vector Sort.
   static SortPtr MakeBvSort(const int& bit_width);
-  /// Create a memory (array) Sort.
+  /// Return the (interned) memory (array) Sort.
   static SortPtr MakeMemSort(const int& addr_width, const int& data_width);
 
   // ------------------------- ACCESSORS/MUTATORS --------------------------- //
@@ -64,9 +67,9 @@ public:
 
   /// Compare two Sorts.
   virtual bool Equal(const SortPtr rhs) const = 0;
-  /// Overlaod comparison.
+  /// Overlaod comparison (pointer equality for interned sorts).
   friend bool operator==(const SortPtr lhs, const SortPtr rhs) {
-    return lhs->Equal(rhs);
+    return (lhs.get() == rhs.get()) || lhs->Equal(rhs);
   }
 
   /// Print out to output stream.
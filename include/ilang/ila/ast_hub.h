@@ -22,7 +22,8 @@ inline AstUidSort GetUidSort(const ExprPtr& expr) {
 
 /// Helper to get the unified id of expr's operation.
 inline AstUidExprOp GetUidExprOp(const ExprPtr& expr) {
-  return std::dynamic_pointer_cast<ExprOp>(expr)->uid();
+  ILA_ASSERT(expr->is_op()) << "Get operation of non-op " << expr;
+  return static_cast<const ExprOp*>(expr.get())->uid();
 }
 
 /******************************************************************************/
@@ -221,6 +222,27 @@ ExprPtr Imply(const ExprPtr& p, const ExprPtr& q);
 ExprPtr Ite(const ExprPtr& cnd, const ExprPtr& true_expr,
             const ExprPtr& false_expr);
 
+/******************************************************************************/
+// Constant folding
+/******************************************************************************/
+/// \brief Enable/disable folding operations with all-constant arguments into
+/// constants at construction (enabled by default).
+void SetConstFolding(const bool& enable);
+/// Return true if constant folding at construction is enabled.
+bool ConstFoldingEnabled();
+/// \brief Evaluate the operation over the constant arguments. Return NULL if
+/// any argument is not a constant, any bool/bv sort is wider than 64 bits, or
+/// the result is not defined locally (e.g., division, division by zero, and
+/// memory updates).
+ExprPtr FoldConst(const AstUidExprOp& op, const ExprPtrVec& args,
+                  const std::vector<int>& params = {});
+/// Return the number of nodes of the operation folded at construction.
+size_t GetConstFoldNum(const AstUidExprOp& op);
+/// Return the total number of nodes folded at construction.
+size_t GetConstFoldNum();
+/// Reset the counters of nodes folded at construction.
+void ResetConstFoldNum();
+
 /******************************************************************************/
 // Non-AST construction utilities
 /******************************************************************************/
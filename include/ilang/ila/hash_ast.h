@@ -45,10 +45,12 @@ private:
   // ------------------------- MEMBERS -------------------------------------- //
   /// The map for AST nodes.
   std::unordered_map<std::string, ExprPtr> map_;
+  /// Cache of the formatted hash of each (interned) sort.
+  std::unordered_map<SortPtr, std::string> sort_hash_;
 
   // ------------------------- HELPER FUNCTIONS ----------------------------- //
   /// Hash function.
-  static std::string Hash(const ExprPtr& node);
+  std::string Hash(const ExprPtr& node);
 
 }; // class ExprMngr
 
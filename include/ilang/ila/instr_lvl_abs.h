@@ -68,15 +68,21 @@ public:
 
   /// Return true if is specification (not implementation).
   inline bool is_spec() const { return is_spec_; }
+  /// Return true if the ILA has been frozen (read-only).
+  inline bool is_frozen() const { return frozen_; }
   /// Return the parent ILA.
   inline const InstrLvlAbsPtr parent() const { return parent_; }
   /// Return the ast simplifier.
   inline const ExprMngrPtr expr_mngr() const { return expr_mngr_; }
 
   /// Set the ILA to be specification if true.
-  inline void set_spec(bool spec) { is_spec_ = spec; }
+  inline void set_spec(bool spec) {
+    CheckMutable();
+    is_spec_ = spec;
+  }
   /// Update the ast simplifier.
   inline void set_expr_mngr(const ExprMngrPtr expr_mngr) {
+    CheckMutable();
     expr_mngr_ = expr_mngr;
   }
 
@@ -244,6 +250,11 @@ public:
   /// \brief Return the ancestor names in sequence.
   std::string GetRootName() const;
 
+  /// \brief Make the ILA (and all its child-ILAs) immutable. Any further
+  /// modification is a fatal error, while all const accessors (including
+  /// lookups by name) become lock-free and can be called concurrently.
+  void Freeze();
+
   /// Output stream function.
   std::ostream& Print(std::ostream& out) const;
 
@@ -306,6 +317,10 @@ private:
 
   /// Specification/implementation.
   bool is_spec_ = true;
+  /// Read-only after Freeze().
+  bool frozen_ = false;
+  /// The ancestor names, cached when frozen.
+  std::string root_name_ = "";
 
   /// The simplifier for expr nodes. May be shared.
   ExprMngrPtr expr_mngr_ = nullptr;
@@ -319,6 +334,8 @@ private:
   void CheckInstr(const InstrPtr& instr);
   /// Simplify instruction if not already.
   void SimplifyInstr(const InstrPtr& instr);
+  /// Abort if the ILA has been frozen.
+  void CheckMutable() const;
 
 }; // class InstrLvlAbs
 
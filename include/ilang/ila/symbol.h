@@ -4,6 +4,7 @@
 #ifndef ILANG_ILA_SYMBOL_H__
 #define ILANG_ILA_SYMBOL_H__
 
+#include <atomic>
 #include <fstream>
 #include <ostream>
 #include <string>
@@ -12,11 +13,14 @@
 namespace ilang {
 
 /// \brief The symbol is the name and ID of an object. Every object has an
-/// unique symbol.
+/// unique symbol. Names are interned in a global string pool, so each symbol
+/// only holds a handle to the shared string (and anonymous symbols hold
+/// nothing until their name is requested). Creating and reading symbols is
+/// thread-safe.
 class Symbol {
 public:
   // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
-  /// Default constructor (empty name).
+  /// Default constructor (anonymous, named after the id when first used).
   Symbol();
   /// Constructor with cstring name.
   Symbol(const char* str);
@@ -55,15 +59,23 @@ public:
   friend bool operator==(const Symbol& lhs, const Symbol& rhs);
   /// Overload comparison <.
   friend bool operator<(const Symbol& lhs, const Symbol& rhs);
+  /// Overload comparison < with a plain name (for allocation-free lookup).
+  friend bool operator<(const Symbol& lhs, const std::string& rhs);
+  /// Overload comparison < with a plain name (for allocation-free lookup).
+  friend bool operator<(const std::string& lhs, const Symbol& rhs);
 
 private:
   // ------------------------- MEMBERS -------------------------------------- //
-  /// Name of the object.
-  std::string name_;
+  /// Interned name of the object (NULL until rendered for anonymous symbols).
+  mutable std::atomic<const std::string*> name_ = NULL;
   /// The unique ID of the object.
   size_t id_;
   /// Static counter for symbols IDs.
-  static size_t counter_;
+  static std::atomic<size_t> counter_;
+
+  // ------------------------- HELPERS -------------------------------------- //
+  /// Return the pooled (unique) copy of the string.
+  static const std::string* Intern(const std::string& str);
 
 }; // class Symbol
 
@@ -5,6 +5,7 @@
 #define ILANG_ILANG_CPP_H__
 
 #include <cstdint>
+#include <iostream>
 #include <map>
 #include <memory>
 #include <string>
@@ -46,6 +47,20 @@ void EnableDebug(const std::string& tag);
 /// Remove a debug tag.
 void DisableDebug(const std::string& tag);
 
+/******************************************************************************/
+// Performance telemetry.
+/******************************************************************************/
+/// \brief Enable/disable the performance telemetry (timers, counters, and
+/// gauges of the internal stages). (Default: disabled)
+void EnableTelemetry(bool enable = true);
+/// Clear the collected telemetry records.
+void ResetTelemetry();
+/// \brief Export the telemetry records to the file in Chrome trace-event JSON
+/// format (viewable in chrome://tracing or Perfetto).
+bool ExportTelemetryTrace(const std::string& file_name);
+/// Print the telemetry summary table to the output stream.
+void PrintTelemetrySummary(std::ostream& out = std::cout);
+
 /******************************************************************************/
 // ILA Construction.
 /******************************************************************************/
@@ -63,7 +78,7 @@ class Ila;
 /// \brief The wrapper of Sort (type for different AST nodes).
 class SortRef {
 private:
-  typedef std::shared_ptr<Sort> SortPtr;
+  typedef std::shared_ptr<const Sort> SortPtr;
   // ------------------------- MEMBERS -------------------------------------- //
   /// Wrapped Sort pointer.
   SortPtr ptr_ = nullptr;
@@ -366,6 +381,10 @@ ExprRef MemConst(const NumericType& def_val,
                  const std::map<NumericType, NumericType>& vals,
                  const int& addr_width, const int& data_width);
 
+/// \brief Set whether operations with all-constant arguments are folded into
+/// constants at construction, by default, enabled.
+void SetConstFolding(bool enable);
+
 /******************************************************************************/
 // Non-AST-construction
 /******************************************************************************/
@@ -640,6 +659,36 @@ void ImportChildSynthAbstraction(const std::string& file_name, Ila& parent,
 void ExportSysCSim(const Ila& ila, const std::string& dir_path,
                    bool optimize = false);
 
+/// \brief Generate the SystemC-free standalone (trace-driven) simulator.
+/// \param [in] ila the top-level ILA to generate.
+/// \param [in] dir_path directory path of the generated simulator.
+/// \param [in] optimize set true to enable optimization.
+/// \param [in] lanes number of independent input streams simulated together.
+void ExportStandaloneSim(const Ila& ila, const std::string& dir_path,
+                         bool optimize = false, int lanes = 1);
+
+/// \brief Export the ILA as a BTOR2 transition system.
+/// \param [in] ila the top-level ILA to export.
+/// \param [in] file_name the name of the BTOR2 file.
+bool ExportBtor2(const Ila& ila, const std::string& file_name);
+
+/// \brief Bit-blast the ILA and export as a binary AIGER file.
+/// \param [in] ila the top-level ILA to export.
+/// \param [in] file_name the name of the AIGER file.
+/// \param [in] props the properties (Boolean) to check, written as outputs.
+bool ExportAiger(const Ila& ila, const std::string& file_name,
+                 const std::vector<ExprRef>& props = {});
+
+/******************************************************************************/
+// Analytics.
+/******************************************************************************/
+/// \brief Return the statistics of the expression graph of the ILA in JSON,
+/// e.g., unique vs. tree node counts, max depth, fan-out and operator
+/// histograms, memory operations, and the cone size of each instruction.
+/// \param [in] ila the top-level ILA to analyze.
+/// \param [in] indent the number of spaces to indent (compact if negative).
+std::string GetExprGraphStats(const Ila& ila, const int& indent = -1);
+
 /******************************************************************************/
 // Verification.
 /******************************************************************************/
@@ -667,6 +716,12 @@ public:
   inline void ClearInitPred() { init_pred_.clear(); }
   /// Clear the step-specific predicates.
   inline void ClearStepPred() { step_pred_.clear(); }
+  /// \brief Encode the memory state lazily (as reads over the initial contents)
+  /// instead of in the array theory. Predicates on the memory should be added
+  /// to the unroller, since the model of the memory is not meaningful.
+  inline void AddLazyMem(const ExprRef& mem) { lazy_mem_.push_back(mem); }
+  /// Clear the memory states to encode lazily.
+  inline void ClearLazyMem() { lazy_mem_.clear(); }
 
   /// \brief Unroll the ILA monolithically with each step connected.
   /// \param[in] top the top-level ILA of the hierarchy.
@@ -698,6 +753,16 @@ public:
   z3::expr UnrollPathFree(const std::vector<InstrRef>& path,
                           const int& init = 0);
 
+  /// \brief Check a set of paths (each step connected) in batch, sharing the
+  /// unrolling of common prefixes via solver push/pop.
+  /// \param[in] paths the set of instruction sequences.
+  /// \param[in] solver the solver to check with.
+  /// \param[in] init the starting time frame.
+  /// \return the check result of each path.
+  std::vector<z3::check_result>
+  CheckPathConnBatch(const std::vector<std::vector<InstrRef>>& paths,
+                     z3::solver& solver, const int& init = 0);
+
   // ------------------------- HELPERS -------------------------------------- //
   /// Return the z3::expr representing the current state at the time.
   z3::expr CurrState(const ExprRef& v, const int& t);
@@ -722,6 +787,8 @@ private:
   std::vector<ExprRef> init_pred_;
   /// The container for storing step-specific predicates when unrolling.
   std::vector<std::pair<int, ExprRef>> step_pred_;
+  /// The container for storing memory states to encode lazily.
+  std::vector<ExprRef> lazy_mem_;
   /// The extra suffix used when unrolling.
   std::string extra_suff_;
 
@@ -740,6 +807,9 @@ private:
     for (auto it = step_pred_.begin(); it != step_pred_.end(); it++) {
       unroller->AddStepPred(it->second.get(), it->first);
     }
+    for (auto it = lazy_mem_.begin(); it != lazy_mem_.end(); it++) {
+      unroller->AddLazyMem(it->get());
+    }
     // unroller->SetExtraSuffix(extra_suff_);
   }
 
@@ -14,6 +14,7 @@
 
 #include <ilang/ila/instr_lvl_abs.h>
 #include <ilang/mcm/memory_model.h>
+#include <ilang/target-smt/solver_portfolio.h>
 
 /// \namespace ilang
 namespace ilang {
@@ -120,6 +121,12 @@ public:
   /// destroyed, only for DEBUG use
   const TraceStepPtrSet& DebugAccessAllTraceStepPtrSet() const;
 
+  /// \brief Check with the solver portfolio (nullptr to disable). No unsat
+  /// core is reported when the portfolio is used.
+  inline void SetPortfolio(const SolverPortfolioPtr& portfolio) {
+    portfolio_ = portfolio;
+  }
+
   /// \brief Push the size of current set of constraints
   void Push();
   /// \brief Restore the previous set of constraints
@@ -137,6 +144,8 @@ private:
                   // destroy along with the unroller
   /// A stack to hold the position of the stack
   std::stack<size_t> zexpr_vec_pos_stack_;
+  /// The solver portfolio for CheckSat (the default solver if not set).
+  SolverPortfolioPtr portfolio_ = nullptr;
 
   // ------------------------- ACCESSORS/MUTATORS --------------------------- //
   /// Return the underlying z3::context.
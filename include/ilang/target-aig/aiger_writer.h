@@ -0,0 +1,150 @@
+/// \file
+/// Class AigerWriter - bit-blasting ILA to and-inverter graph in AIGER format.
+
+#ifndef ILANG_TARGET_AIG_AIGER_WRITER_H__
+#define ILANG_TARGET_AIG_AIGER_WRITER_H__
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ilang/ila/instr_lvl_abs.h>
+
+/// \namespace ilang
+namespace ilang {
+
+/// \brief The class for bit-blasting an ILA model to an and-inverter graph
+/// (AIG) and writing it in binary AIGER format.
+/// - Every input/state bit is an AIGER input/latch, named "<var>[<bit>]".
+/// - Memories are register files, i.e., one latch per bit of each word, named
+///   "<var>[<addr>][<bit>]". Only memories with small address space are
+///   supported (see the constructor).
+/// - The next function of a state is a priority mux over the instructions (in
+///   the order of declaration) that are valid, decoded, and update the state.
+/// - Latches are uninitialized; initial conditions are AIGER constraints
+///   guarded by an extra initial flag latch.
+/// - Properties are written as outputs, asserting their negations (bad).
+/// - AND gates are structurally hashed, and each AST node is bit-blasted once.
+class AigerWriter {
+public:
+  /// Type for AIG literals (2 * variable + complemented).
+  typedef unsigned Lit;
+  /// Type for bit-blasted bit-vectors (least significant bit first).
+  typedef std::vector<Lit> Bits;
+  /// Type for bit-blasted memories (words indexed by the address).
+  typedef std::vector<Bits> Words;
+
+  // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
+  /// \brief Constructor.
+  /// \param[in] m the ILA model to translate.
+  /// \param[in] max_addr_width the max address width of memories to blast.
+  AigerWriter(const InstrLvlAbsCnstPtr& m, const int& max_addr_width = 8);
+  /// Default destructor.
+  ~AigerWriter();
+
+  // ------------------------- ACCESSORS/MUTATORS --------------------------- //
+  /// Add a property (Boolean) that is expected to hold in all states.
+  void AddProperty(const ExprPtr& prop, const std::string& name = "");
+  /// Return the number of AND gates generated.
+  inline size_t and_num() const { return ands_.size(); }
+
+  // ------------------------- METHODS -------------------------------------- //
+  /// \brief Bit-blast and write the AIG to the output stream.
+  /// \return Return true if complete successfully.
+  bool Write(std::ostream& out);
+  /// \brief Bit-blast and write the AIG to the given file.
+  /// \return Return true if complete successfully.
+  bool WriteToFile(const std::string& file_name);
+
+  /// Check if the node is bit-blasted (for DepthFirstVisitPrePost).
+  bool pre(const ExprPtr& expr);
+  /// Bit-blast the node if not already (for DepthFirstVisitPrePost).
+  void post(const ExprPtr& expr);
+
+private:
+  /// Kind of AIG variables.
+  enum class VarKind { kConst, kInput, kLatch, kAnd };
+
+  // ------------------------- MEMBERS -------------------------------------- //
+  /// The ILA to translate.
+  InstrLvlAbsCnstPtr m_;
+  /// The max address width of memories to blast.
+  int max_addr_width_;
+  /// Properties and their names.
+  std::vector<std::pair<ExprPtr, std::string>> props_;
+  /// Set if any node fails to bit-blast.
+  bool failed_ = false;
+
+  /// Kind of each variable.
+  std::vector<VarKind> kinds_;
+  /// Fan-ins of each AND gate, in the order of creation.
+  std::vector<std::pair<Lit, Lit>> ands_;
+  /// Structural hash of AND gates.
+  std::unordered_map<uint64_t, Lit> strash_;
+  /// Input variables and their names.
+  std::vector<std::pair<unsigned, std::string>> inputs_;
+  /// Latch variables and their names.
+  std::vector<std::pair<unsigned, std::string>> latches_;
+  /// Next state function of each latch (by the order in latches_).
+  std::vector<Lit> latch_next_;
+  /// Reset value of each latch (the latch itself if uninitialized).
+  std::vector<Lit> latch_reset_;
+  /// Bit-blasted Boolean and bit-vector nodes.
+  std::unordered_map<ExprPtr, Bits, ExprHash> bits_;
+  /// Bit-blasted memory nodes.
+  std::unordered_map<ExprPtr, Words, ExprHash> words_;
+
+  // ------------------------- HELPERS -------------------------------------- //
+  /// Reset the graph.
+  void Reset();
+  /// Create a new input.
+  Lit NewInput(const std::string& name);
+  /// Create a new (uninitialized) latch.
+  Lit NewLatch(const std::string& name);
+  /// Create bits of a variable, as inputs or latches.
+  void NewVar(const ExprPtr& var, const bool& is_latch);
+  /// Set the next state function of the latch.
+  void SetNext(const Lit& latch, const Lit& next);
+
+  /// Bits of the (non-memory) expression, bit-blast if needed.
+  const Bits& BitsOf(const ExprPtr& expr);
+  /// Words of the memory expression, bit-blast if needed.
+  const Words& WordsOf(const ExprPtr& expr);
+
+  // gates
+  Lit And(const Lit& a, const Lit& b);
+  Lit Or(const Lit& a, const Lit& b);
+  Lit Xor(const Lit& a, const Lit& b);
+  Lit Mux(const Lit& c, const Lit& t, const Lit& e);
+  // word-level operators
+  Bits Const(const int& width, const uint64_t& val) const;
+  Bits Not(const Bits& a) const;
+  Bits Bitwise(const Bits& a, const Bits& b, const AstUidExprOp& op);
+  Bits Mux(const Lit& c, const Bits& t, const Bits& e);
+  Bits Add(const Bits& a, const Bits& b, const Lit& carry_in,
+           Lit* carry_out = nullptr);
+  Bits Neg(const Bits& a);
+  Bits Mul(const Bits& a, const Bits& b);
+  void UDivRem(const Bits& a, const Bits& b, Bits& quot, Bits& rem);
+  Bits Abs(const Bits& a);
+  Bits Shift(const Bits& a, const Bits& b, const AstUidExprOp& op);
+  Lit Eq(const Bits& a, const Bits& b);
+  Lit Ult(const Bits& a, const Bits& b);
+  Lit Slt(const Bits& a, const Bits& b);
+  Lit ReduceOr(const Bits& a);
+  Bits Load(const Words& mem, const Bits& addr);
+  Words Store(const Words& mem, const Bits& addr, const Bits& data);
+
+  /// Bit-blast one operator node.
+  void BlastOp(const ExprPtr& expr);
+  /// Write the graph in binary AIGER format.
+  bool WriteAiger(std::ostream& out, const std::vector<Lit>& outputs,
+                  const std::vector<std::string>& output_names,
+                  const std::vector<Lit>& constraints) const;
+
+}; // class AigerWriter
+
+} // namespace ilang
+
+#endif // ILANG_TARGET_AIG_AIGER_WRITER_H__
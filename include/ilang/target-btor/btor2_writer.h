@@ -0,0 +1,100 @@
+/// \file
+/// Class Btor2Writer - translating ILA to BTOR2 word-level transition system.
+
+#ifndef ILANG_TARGET_BTOR_BTOR2_WRITER_H__
+#define ILANG_TARGET_BTOR_BTOR2_WRITER_H__
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ilang/ila/instr_lvl_abs.h>
+
+/// \namespace ilang
+namespace ilang {
+
+/// \brief The class for writing an ILA model as a BTOR2 transition system,
+/// without going through the Verilog generator and yosys.
+/// - Inputs and states of the ILA become BTOR2 inputs and states, Boolean
+///   being bit-vector of width 1 and memories being arrays.
+/// - The decode and update functions of all instructions are emitted as one
+///   node DAG, i.e., sub-expressions shared in the ILA are shared in BTOR2,
+///   and so are the structurally equal operators and constants.
+/// - The next function of a state is a priority ite over the instructions (in
+///   the order of declaration) that are valid, decoded, and update the state.
+///   States are unchanged if no such instruction is decoded.
+/// - Initial conditions are constraints guarded by an extra initial flag.
+/// - The valid and decode functions are exported as outputs.
+class Btor2Writer {
+public:
+  // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
+  /// Constructor.
+  Btor2Writer(const InstrLvlAbsCnstPtr& m);
+  /// Default destructor.
+  ~Btor2Writer();
+
+  // ------------------------- METHODS -------------------------------------- //
+  /// \brief Write the BTOR2 transition system to the output stream.
+  /// \return Return true if complete successfully.
+  bool Write(std::ostream& out);
+  /// \brief Write the BTOR2 transition system to the given file.
+  /// \return Return true if complete successfully.
+  bool WriteToFile(const std::string& file_name);
+
+  /// Check if the node is emitted (for DepthFirstVisitPrePost).
+  bool pre(const ExprPtr& expr);
+  /// Emit the node if not already (for DepthFirstVisitPrePost).
+  void post(const ExprPtr& expr);
+
+private:
+  /// Type for BTOR2 node ids.
+  typedef size_t NodeId;
+  /// Type for cacheing the emitted expressions.
+  typedef std::unordered_map<ExprPtr, NodeId, ExprHash> ExprNodeMap;
+
+  // ------------------------- MEMBERS -------------------------------------- //
+  /// The ILA to translate.
+  InstrLvlAbsCnstPtr m_;
+  /// Output stream of the current writing.
+  std::ostream* out_ = nullptr;
+  /// Id of the last emitted line.
+  NodeId last_id_ = 0;
+  /// Container for cacheing emitted expression nodes.
+  ExprNodeMap expr_map_;
+  /// Emitted operator and constant nodes, for sharing structurally equal ones.
+  std::unordered_map<std::string, NodeId> line_map_;
+  /// Emitted bit-vector sorts, indexed by width.
+  std::map<int, NodeId> bv_sorts_;
+  /// Emitted array sorts, indexed by address and data width.
+  std::map<std::pair<int, int>, NodeId> mem_sorts_;
+  /// Set if any expression can not be translated faithfully.
+  bool approximated_ = false;
+
+  // ------------------------- HELPERS -------------------------------------- //
+  /// Emit one line and return its id.
+  NodeId Emit(const std::string& line);
+  /// Emit one line, or return the id of the same line emitted before.
+  NodeId EmitShared(const std::string& line);
+  /// Get (emit if needed) the bit-vector sort of the width.
+  NodeId BvSort(const int& width);
+  /// Get (emit if needed) the sort of the ILA sort.
+  NodeId SortOf(const SortPtr& sort);
+  /// Get the node of an expression, emitting its DAG if needed.
+  NodeId NodeOf(const ExprPtr& expr);
+  /// Emit a bit-vector constant.
+  NodeId BvConst(const int& width, const uint64_t& val);
+
+  /// Emit the node of a constant.
+  NodeId EmitConst(const ExprPtr& expr);
+  /// Emit the node of an operator.
+  NodeId EmitOp(const ExprPtr& expr, const std::vector<NodeId>& args);
+  /// Emit the next function of the state.
+  void EmitNext(const ExprPtr& state, const std::vector<NodeId>& grants);
+
+}; // class Btor2Writer
+
+} // namespace ilang
+
+#endif // ILANG_TARGET_BTOR_BTOR2_WRITER_H__
@@ -4,8 +4,13 @@
 #ifndef ILANG_TARGET_SC_ILATOR_H__
 #define ILANG_TARGET_SC_ILATOR_H__
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <fmt/format.h>
 
@@ -18,11 +23,31 @@ namespace ilang {
 #define ILATOR_PRECISE_MEM
 
 /// \brief The ILAtor class - for CMake-based SystemC simulator generation.
+///
+/// In standalone mode, the generated simulator is a plain C++ class (no
+/// SystemC kernel or signals) advanced by step(), with a header-only
+/// bit-vector type and a batch driver replaying inputs from a binary trace.
+/// With multiple lanes, every value is laid out as a structure-of-arrays over
+/// independent input streams, and instructions update the lanes selected by
+/// their per-lane decode mask. An instruction activated in any lane is
+/// evaluated over all lanes, so the same sources are also built with one lane
+/// as a scalar fallback, which the driver picks for divergent traces (low
+/// sampled lane utilization).
+///
+/// Instruction translation units are rendered in parallel, and a file is
+/// only rewritten if its content changed (tracked by a manifest in the
+/// project root), so that a rebuild after a model tweak only recompiles the
+/// affected sources.
+///
+/// Building the generated project with ILATOR_PROFILE compiles in
+/// instruction-level counters, which are dumped as JSON on destruction.
+/// All states (and the written entries of memories) can be saved to and
+/// restored from a binary checkpoint.
 class Ilator {
 public:
   // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
-  /// Constructor with a fixed ILA model.
-  Ilator(const InstrLvlAbsPtr& m);
+  /// Constructor with a fixed ILA model (and the number of lanes).
+  Ilator(const InstrLvlAbsPtr& m, bool standalone = false, int lanes = 1);
   /// Destructor.
   ~Ilator();
 
@@ -55,6 +80,10 @@ private:
   // ------------------------- MEMBERS -------------------------------------- //
   /// The ILA model to generate.
   InstrLvlAbsPtr m_;
+  /// Generate the SystemC-free standalone simulator.
+  bool standalone_ = false;
+  /// Number of lanes simulated together (standalone only).
+  int lanes_ = 1;
 
   /// Generated functions (with definition).
   std::map<std::string, CxxFunc*> functions_;
@@ -64,10 +93,38 @@ private:
   std::map<std::string, CxxFunc*> memory_updates_;
   /// Generated sources files.
   std::set<std::string> source_files_;
-  /// Constant memory that needs to be initialzied.
-  std::set<ExprPtr> const_mems_;
-  /// Global variables other than state variables.
-  std::set<ExprPtr> global_vars_;
+  /// Constant memory that needs to be initialzied (indexed by name).
+  std::map<std::string, ExprPtr> const_mems_;
+  /// Global variables other than state variables (indexed by name).
+  std::map<std::string, ExprPtr> global_vars_;
+  /// Guard of the trackers above when rendering instructions in parallel.
+  std::mutex mtx_;
+
+  /// Structural digests of the named expressions.
+  mutable std::unordered_map<ExprPtr, uint64_t, ExprHash> digests_;
+  /// Structure that each digest is taken from (to detect collisions).
+  mutable std::unordered_map<uint64_t, std::string> digest_keys_;
+  /// Guard of the digests.
+  mutable std::mutex digest_mtx_;
+
+  /// C++ identifier of each named object (by kind and original names).
+  mutable std::unordered_map<std::string, std::string> cxx_ids_;
+  /// C++ identifiers already taken.
+  mutable std::unordered_set<std::string> cxx_ids_taken_;
+  /// Guard of the identifiers.
+  mutable std::mutex cxx_id_mtx_;
+
+  /// Index of the instructions in the profiling counters.
+  std::map<InstrPtr, size_t> prof_instrs_;
+  /// Index of the memory states in the profiling counters.
+  std::map<ExprPtr, size_t> prof_mems_;
+
+  /// Root directory of the generated project.
+  std::string root_;
+  /// Content hash of the files generated in the previous run.
+  std::map<std::string, std::string> prev_manifest_;
+  /// Content hash of the files generated in this run.
+  std::map<std::string, std::string> manifest_;
 
   // ------------------------- HELPERS -------------------------------------- //
   /// Reset all internal trackers.
@@ -79,6 +136,8 @@ private:
 
   /// Interpret non-instr basics, e.g., valid.
   bool GenerateIlaBasics(const std::string& dir);
+  /// Interpret all instructions (in parallel).
+  bool GenerateInstrContents(const std::string& dir);
   /// Interpret instruction semantics (decode and state updates).
   bool GenerateInstrContent(const InstrPtr& instr, const std::string& dir);
   /// Special handle for memory updates.
@@ -89,10 +148,25 @@ private:
   bool GenerateInitialSetup(const std::string& dir);
   /// Generate the instruction scheduler and driver.
   bool GenerateExecuteKernel(const std::string& dir);
+  /// Generate the profiling counter dump and its support header.
+  bool GenerateProfile(const std::string& dir);
+  /// Generate the checkpoint save/restore functions.
+  bool GenerateCheckpoint(const std::string& dir);
   /// Generate the shared header files.
   bool GenerateGlobalHeader(const std::string& dir);
   /// Generate the CMake recipe and other placeholders.
   bool GenerateBuildSupport(const std::string& dir);
+  /// Generate the shared header files for the standalone simulator.
+  bool GenerateStandaloneHeader(const std::string& dir);
+  /// Generate the CMake recipe and trace-driven entry for standalone.
+  bool GenerateStandaloneBuildSupport(const std::string& dir);
+  /// Write the declaration of state, global vars, and functions.
+  void WriteMemberDecl(StrBuff& buff) const;
+  /// Write the declaration of the profiling counters.
+  void WriteProfileDecl(StrBuff& buff) const;
+  /// Write the statement counting accesses to the memory (if profiled).
+  void WriteMemoryAccessCount(const ExprPtr& mem, const std::string& counter,
+                              const std::string& amount, StrBuff& buff) const;
 
   /// Translate expression node to SystemC statements.
   bool RenderExpr(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut);
@@ -130,6 +204,12 @@ private:
   /// Record and write the source to file.
   void CommitSource(const std::string& file_name, const std::string& dir,
                     const StrBuff& buff);
+  /// Write the generated file unless its content is unchanged.
+  void CommitFile(const std::string& file_path, const StrBuff& buff);
+  /// Load the manifest of the previous generation (if any).
+  void LoadManifest();
+  /// Remove stale generated files and write the manifest.
+  bool WriteManifest();
 
   /// Get the project name.
   inline std::string GetProjectName() const { return m_->name().str(); }
@@ -137,22 +217,48 @@ private:
   static inline std::string GetLocalVar(const ExprVarMap& lut) {
     return fmt::format("local_var_{}", lut.size());
   }
-  /// Get the type of expr in SystemC.
-  static inline std::string GetCxxType(const ExprPtr& expr) {
+  /// Get the type of expr in SystemC (or the standalone bit-vector).
+  inline std::string GetCxxType(const ExprPtr& expr) const {
     return GetCxxType(expr->sort());
   }
-  /// Get the type of sort in SystemC.
-  static std::string GetCxxType(const SortPtr& sort);
+  /// Get the type of sort in SystemC (or the standalone bit-vector).
+  std::string GetCxxType(const SortPtr& sort) const;
+  /// Get the type of sort in a single lane.
+  std::string GetCxxElemType(const SortPtr& sort) const;
+  /// \brief Get the number of lanes in the generated code, i.e., ILATOR_LANES
+  /// (the scalar fallback builds the same sources with one lane).
+  inline std::string GetLaneNum() const {
+    return (lanes_ > 1) ? "ILATOR_LANES" : "1";
+  }
+  /// Get the extra argument passing the lane mask (empty for single lane).
+  inline std::string GetLaneMaskArg() const {
+    return (lanes_ > 1) ? ", lane_mask" : "";
+  }
+  /// \brief Write the lane mask of a valid/decode function, where all lanes
+  /// are evaluated (only used by the profiling counters).
+  void WriteFullLaneMask(StrBuff& buff) const;
+  /// Get the argument list of the memory update function.
+  std::string GetMemoryFuncArgs(const ExprPtr& mem) const;
   /// Get the variable name in SystemC.
-  static std::string GetCxxName(const ExprPtr& expr);
+  std::string GetCxxName(const ExprPtr& expr) const;
   /// Get the valid function name of the ILA.
-  static std::string GetValidFuncName(const InstrLvlAbsCnstPtr& m);
+  std::string GetValidFuncName(const InstrLvlAbsCnstPtr& m) const;
   /// Get the decode function name of the instruction.
-  static std::string GetDecodeFuncName(const InstrPtr& instr);
+  std::string GetDecodeFuncName(const InstrPtr& instr) const;
   /// Get the state update function name of the instruction.
-  static std::string GetUpdateFuncName(const InstrPtr& instr);
+  std::string GetUpdateFuncName(const InstrPtr& instr) const;
+  /// Get the source file name of the instruction.
+  std::string GetInstrFileName(const InstrPtr& instr) const;
+  /// \brief Get the C++ identifier of the object (kind, host, and name). Names
+  /// that map to the same identifier (e.g. "a.b" and "a_b") get a suffix.
+  std::string GetCxxId(const std::string& kind, const std::string& host,
+                       const std::string& name) const;
+  /// Assign the identifiers of the hierarchy in a fixed order.
+  void RegisterCxxIds();
   /// Get the memory update function name.
-  static std::string GetMemoryFuncName(const ExprPtr& expr);
+  std::string GetMemoryFuncName(const ExprPtr& expr) const;
+  /// Get the structural digest of the expression (stable across runs).
+  uint64_t GetDigest(const ExprPtr& expr) const;
   /// Helper for look up variable name in the table.
   inline std::string LookUp(const ExprPtr& e, const ExprVarMap& lut) const {
     auto pos = lut.find(e);
@@ -4,6 +4,8 @@
 #ifndef ILANG_TARGET_SMT_SMT_SHIM_H__
 #define ILANG_TARGET_SMT_SMT_SHIM_H__
 
+#include <vector>
+
 #include <ilang/ila/ast/func.h>
 #include <ilang/ila/ast_hub.h>
 
@@ -36,6 +38,10 @@ public:
   inline auto BoolAnd(const ShimExprType& a, const ShimExprType& b) {
     return gen_.BoolAnd(a, b);
   }
+  /// Unified interface to AND a vector of boolean expressions (n-ary).
+  inline auto BoolAndAll(const std::vector<ShimExprType>& vec) {
+    return gen_.BoolAndAll(vec);
+  }
   /// Unified interface to Equal two expressions.
   inline auto Equal(const ShimExprType& a, const ShimExprType& b) {
     return gen_.Equal(a, b);
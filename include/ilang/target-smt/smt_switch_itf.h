@@ -49,6 +49,14 @@ public:
   inline auto BoolAnd(const smt::Term& a, const smt::Term& b) {
     return solver_->make_term(smt::PrimOp::And, a, b);
   }
+  /// Unified SmtShim interface to AND a vector of boolean smt::Term (n-ary).
+  inline auto BoolAndAll(const smt::TermVec& vec) {
+    if (vec.empty()) {
+      return solver_->make_term(true);
+    }
+    return (vec.size() == 1) ? vec.front()
+                             : solver_->make_term(smt::PrimOp::And, vec);
+  }
   /// Unified SmtShim interface to EQUAL two smt::Term.
   inline auto Equal(const smt::Term& a, const smt::Term& b) {
     return solver_->make_term(smt::PrimOp::Equal, a, b);
@@ -0,0 +1,90 @@
+/// \file
+/// Class SolverPortfolio - checking z3 queries with several configurations in
+/// parallel.
+
+#ifndef ILANG_TARGET_SMT_SOLVER_PORTFOLIO_H__
+#define ILANG_TARGET_SMT_SOLVER_PORTFOLIO_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <z3++.h>
+
+/// \namespace ilang
+namespace ilang {
+
+/// \brief The class for checking a z3 query under several solver
+/// configurations at the same time.
+/// - Each configuration runs in its own z3 context on its own thread, with the
+///   query translated (Z3_translate) into that context.
+/// - The first definitive answer (sat/unsat) wins, and the other runs are
+///   cancelled via Z3_interrupt.
+/// - The model of a sat answer can be translated back to the caller's context.
+class SolverPortfolio {
+public:
+  /// One solver configuration.
+  struct Config {
+    /// Name of the configuration (for logging).
+    std::string name;
+    /// Tactics to combine into the solver (empty for the default solver).
+    std::vector<std::string> tactics;
+    /// Random seed.
+    unsigned seed = 0;
+  };
+
+  // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
+  /// \brief Constructor.
+  /// \param[in] configs the solver configurations to run.
+  /// \param[in] timeout max time (ms) of each query (0 for no limit).
+  SolverPortfolio(const std::vector<Config>& configs = DefaultConfigs(),
+                  const unsigned& timeout = 0);
+  /// Default destructor.
+  ~SolverPortfolio();
+
+  // ------------------------- ACCESSORS/MUTATORS --------------------------- //
+  /// Return the configurations.
+  inline const std::vector<Config>& configs() const { return configs_; }
+  /// Return the name of the configuration answering the last query.
+  inline const std::string& winner() const { return winner_; }
+
+  // ------------------------- METHODS -------------------------------------- //
+  /// \brief Default configurations, i.e., the default solver with two seeds,
+  /// the QF_BV tactic, and eager bit-blasting to SAT.
+  static std::vector<Config> DefaultConfigs();
+
+  /// \brief Check the satisfiability of the conjunction of the assertions.
+  /// \param[in] assertions the query.
+  /// \param[in] timeout max time (ms) of this query, if tighter than the
+  /// portfolio's (0 for the portfolio's).
+  z3::check_result Check(const z3::expr_vector& assertions,
+                         const unsigned& timeout = 0);
+  /// Check the satisfiability of the assertions (in all scopes) of the solver.
+  inline z3::check_result Check(const z3::solver& s,
+                                const unsigned& timeout = 0) {
+    return Check(s.assertions(), timeout);
+  }
+  /// Return the model of the last (sat) query in the given context.
+  z3::model GetModel(z3::context& ctx) const;
+
+private:
+  // ------------------------- MEMBERS -------------------------------------- //
+  /// Solver configurations.
+  std::vector<Config> configs_;
+  /// Max time (ms) of each query.
+  unsigned timeout_;
+  /// Name of the configuration answering the last query.
+  std::string winner_;
+  /// Context of the winning configuration (owning the model).
+  std::unique_ptr<z3::context> model_ctx_;
+  /// Model of the last sat query.
+  std::unique_ptr<z3::model> model_;
+
+}; // class SolverPortfolio
+
+/// Pointer type for sharing the portfolio among checkers.
+typedef std::shared_ptr<SolverPortfolio> SolverPortfolioPtr;
+
+} // namespace ilang
+
+#endif // ILANG_TARGET_SMT_SOLVER_PORTFOLIO_H__
@@ -4,7 +4,10 @@
 #ifndef ILANG_TARGET_SMT_Z3_EXPR_ADAPTER_H__
 #define ILANG_TARGET_SMT_Z3_EXPR_ADAPTER_H__
 
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <z3++.h>
 
@@ -32,6 +35,10 @@ public:
   /// Function object for getting z3 expression.
   void operator()(const ExprPtr& expr);
 
+  /// \brief Drop the cached variables of all frames, e.g. between unrollings.
+  /// Later calls regenerate them, which yields the same z3 constants.
+  void ClearCache();
+
   /// Return the underlying z3 context.
   inline z3::context& context() const { return ctx_; }
 
@@ -46,12 +53,34 @@ public:
   }
   /// Unified SmtShim interface to AND two boolean z3::expr.
   inline auto BoolAnd(const z3::expr& a, const z3::expr& b) { return a && b; }
+  /// Unified SmtShim interface to AND a vector of boolean z3::expr (n-ary).
+  inline auto BoolAndAll(const std::vector<z3::expr>& vec) {
+    auto args = z3::expr_vector(ctx_);
+    for (const auto& e : vec) {
+      args.push_back(e);
+    }
+    return z3::mk_and(args);
+  }
   /// Unified SmtShim interface to EQUAL two z3::expr.
   inline auto Equal(const z3::expr& a, const z3::expr& b) { return a == b; }
 
 private:
   /// Type for caching the generated expressions.
   typedef std::unordered_map<const ExprPtr, z3::expr, Z3AdapterHash> ExprMap;
+  /// Key for the per-frame variables, i.e., (var id, frame id).
+  typedef std::pair<size_t, size_t> VarFrameKey;
+  /// The function object for hashing VarFrameKey.
+  struct VarFrameHash {
+    size_t operator()(const VarFrameKey& k) const {
+      auto h0 = std::hash<size_t>()(k.first);
+      auto h1 = std::hash<size_t>()(k.second);
+      return h0 ^ (h1 << 1);
+    }
+  };
+  /// Cached variable, with the (interned) name it was generated from.
+  typedef std::pair<const std::string*, z3::expr> VarEntry;
+  /// Type for caching the variables over all frames.
+  typedef std::unordered_map<VarFrameKey, VarEntry, VarFrameHash> VarMap;
 
   // ------------------------- MEMBERS -------------------------------------- //
   /// The underlying z3 context.
@@ -60,6 +89,15 @@ private:
   ExprMap expr_map_;
   /// Name suffix for each expression generation (e.g. time frame)
   std::string suffix_ = "";
+  /// \brief Container for cacheing variables of each frame (suffix). Unlike the
+  /// intermediate expressions, these persist across generation calls (until
+  /// ClearCache), so that the variable names are only formatted once per
+  /// frame. An entry is regenerated if the variable was renamed since.
+  VarMap var_map_;
+  /// The id of each frame (suffix) seen so far.
+  std::unordered_map<std::string, size_t> frame_id_;
+  /// The id of the current frame.
+  size_t frame_ = 0;
 
   // ------------------------- HELPERS -------------------------------------- //
   /// Insert the z3 expression of the given node into the map.
@@ -0,0 +1,92 @@
+/// \file
+/// Class Z3LazyMemEncoder - eliminating array reasoning of memories in z3
+/// formulas.
+
+#ifndef ILANG_TARGET_SMT_Z3_LAZY_MEM_H__
+#define ILANG_TARGET_SMT_Z3_LAZY_MEM_H__
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <z3++.h>
+
+/// \namespace ilang
+namespace ilang {
+
+/// \brief The class for encoding memories (arrays) lazily, i.e., as a set of
+/// read events over the initial contents, instead of in the array theory.
+/// - Array variables defined by top-level equalities, e.g., the memory state of
+///   the next step in an unrolling, are substituted by their definition.
+/// - Reads over writes are resolved by ite chains on the addresses.
+/// - Reads of the initial (untouched) contents become fresh data symbols, with
+///   Ackermann constraints (same address implies same data) among them.
+/// Only the array variables accepted by the filter are encoded. Memories that
+/// still appear outside reads, e.g., compared as a whole, keep the array
+/// encoding. The resulting formula is equi-satisfiable to the original one,
+/// but the model of the encoded memories is no longer meaningful.
+class Z3LazyMemEncoder {
+public:
+  /// Type for selecting the array variables to encode lazily.
+  typedef std::function<bool(const z3::expr&)> MemFilter;
+
+  // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
+  /// Constructor.
+  Z3LazyMemEncoder(z3::context& ctx, const MemFilter& filter);
+  /// Default destructor.
+  ~Z3LazyMemEncoder();
+
+  // ------------------------- ACCESSORS/MUTATORS --------------------------- //
+  /// Return the number of array variables substituted by their definition.
+  inline size_t def_num() const { return def_num_; }
+  /// Return the number of initial content reads replaced by data symbols.
+  inline size_t read_num() const { return read_num_; }
+
+  // ------------------------- METHODS -------------------------------------- //
+  /// Encode the formula (usually a conjunction of constraints).
+  z3::expr Encode(const z3::expr& formula);
+
+private:
+  /// Type for cacheing expressions by the ast id.
+  typedef std::unordered_map<unsigned, z3::expr> ExprMap;
+
+  // ------------------------- MEMBERS -------------------------------------- //
+  /// The underlying z3 context.
+  z3::context& ctx_;
+  /// The filter of array variables to encode lazily.
+  MemFilter filter_;
+  /// Definition of the array variables.
+  ExprMap defs_;
+  /// Container for cacheing rewritten expressions.
+  ExprMap rewrite_map_;
+  /// Container for cacheing resolved reads, indexed by (array, address).
+  std::map<std::pair<unsigned, unsigned>, z3::expr> read_map_;
+  /// Container for cacheing if an array is rooted at a lazy variable.
+  std::unordered_map<unsigned, bool> lazy_map_;
+  /// Statistics.
+  size_t def_num_ = 0;
+  size_t read_num_ = 0;
+
+  // ------------------------- HELPERS -------------------------------------- //
+  /// Reset the internal states.
+  void Reset();
+  /// Check if the expression is an array variable to encode.
+  bool IsLazyVar(const z3::expr& e) const;
+  /// Check if the array is (a sequence of writes) on a lazy variable.
+  bool IsLazy(const z3::expr& arr);
+  /// Collect acyclic definitions from the top-level conjuncts.
+  void CollectDefs(const z3::expr_vector& conjuncts, z3::expr_vector& rest);
+  /// Substitute definitions and resolve reads over writes.
+  z3::expr Rewrite(const z3::expr& e);
+  /// Resolve the read of (rewritten) array at (rewritten) address.
+  z3::expr Read(const z3::expr& arr, const z3::expr& addr);
+  /// Replace the reads of initial contents with data symbols.
+  z3::expr Ackermannize(const z3::expr& formula);
+
+}; // class Z3LazyMemEncoder
+
+} // namespace ilang
+
+#endif // ILANG_TARGET_SMT_Z3_LAZY_MEM_H__
@@ -4,9 +4,15 @@
 #ifndef ILANG_UTIL_CONTAINER_H__
 #define ILANG_UTIL_CONTAINER_H__
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <map>
 #include <memory>
+#include <new>
 #include <set>
+#include <stdexcept>
 #include <vector>
 
 /// \namespace ilang
@@ -15,24 +21,27 @@ namespace ilang {
 /// KeyVecItVal
 typedef enum { END, FOUND } KeyVecItVal;
 
-/// \brief A pseudo-iterator for the key-search vector.
+/// \brief A pseudo-iterator for the key-search vector. It holds a copy of the
+/// entry, so modifying it does not affect the container.
 template <class Key, class T> class KeyVecIt {
 public:
-  /// Pointer type for the KeyVec iterator.
-  typedef std::shared_ptr<KeyVecIt> KeyVecItPtr;
-
   // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
-  /// Constructor
+  /// Constructor for END.
   KeyVecIt() : result(KeyVecItVal::END), first(), second() {}
+  /// Constructor for a found entry.
+  KeyVecIt(const Key& key, const T& data)
+      : result(KeyVecItVal::FOUND), first(key), second(data) {}
 
   // ------------------------- METHODS -------------------------------------- //
-  /// Overload comparison == for pointer
-  friend bool operator==(const KeyVecItPtr lhs, const KeyVecItPtr rhs) {
-    return lhs->result == rhs->result;
+  /// Member access, for the pointer-like usage (e.g. it->second).
+  const KeyVecIt* operator->() const { return this; }
+  /// Overload comparison ==.
+  friend bool operator==(const KeyVecIt& lhs, const KeyVecIt& rhs) {
+    return lhs.result == rhs.result;
   }
-  /// Overload comparison != for pointer
-  friend bool operator!=(const KeyVecItPtr lhs, const KeyVecItPtr rhs) {
-    return lhs->result != rhs->result;
+  /// Overload comparison !=.
+  friend bool operator!=(const KeyVecIt& lhs, const KeyVecIt& rhs) {
+    return lhs.result != rhs.result;
   }
 
   // ------------------------- MEMBERS -------------------------------------- //
@@ -46,17 +55,18 @@ public:
 }; // KeyVecIt
 
 /// \brief The container that support key search and index access.
+/// Lookups do not write to any shared state, so they can be issued
+/// concurrently once the container is no longer modified. Key search is
+/// transparent, i.e. any type comparable with Key (e.g. std::string for
+/// Symbol) can be used directly.
 template <class Key, class T> class KeyVec {
 public:
-  /// Iterator pointer type.
-  typedef std::shared_ptr<KeyVecIt<Key, T>> KeyVecItPtr;
+  /// Iterator type (a copy of the entry found).
+  typedef KeyVecIt<Key, T> const_iterator;
 
   // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
   /// Default constructor.
-  KeyVec() {
-    it_ = std::make_shared<KeyVecIt<Key, T>>();
-    clear();
-  }
+  KeyVec() { clear(); }
   /// Default destructor.
   ~KeyVec() { clear(); }
 
@@ -87,41 +97,29 @@ public:
   }
 
   /// Return whether the key has been registered.
-  KeyVecItPtr find(const Key& key) const {
+  template <class K> const_iterator find(const K& key) const {
     auto pos = map_.find(key);
-    if (pos == map_.end())
-      return end_;
-    else {
-      auto idx = pos->second;
-      T data = vec_[idx];
-      it_->result = KeyVecItVal::FOUND;
-      it_->first = key;
-      it_->second = data;
-      return it_;
+    if (pos == map_.end()) {
+      return end();
     }
+    return const_iterator(pos->first, vec_[pos->second]);
   }
 
   /// Return END, can be used to check whether data is found.
-  KeyVecItPtr end() const { return end_; }
+  const_iterator end() const {
+    static const const_iterator kEnd;
+    return kEnd;
+  }
 
 private:
   // ------------------------- MEMBERS -------------------------------------- //
   /// vector of data (used for random access with index).
   std::vector<T> vec_;
   /// the mapping of key (name) to vector index.
-  std::map<Key, size_t> map_;
+  std::map<Key, size_t, std::less<>> map_;
 
-  /// iterator
-  KeyVecItPtr it_;
-  /// the END for legacy interator usage.
-  static KeyVecItPtr end_;
 }; // class KeyVec
 
-/// Initialize static end interator.
-template <class Key, class T>
-std::shared_ptr<KeyVecIt<Key, T>>
-    KeyVec<Key, T>::end_ = std::make_shared<KeyVecIt<Key, T>>();
-
 /// \brief A map for sets.
 template <class Key, class T> class MapSet {
 public:
@@ -153,6 +151,149 @@ private:
 
 }; // class MapSet
 
+/// \brief A vector-like container that stores up to N elements inline and only
+/// falls back to the heap when the size exceeds N. Used for small, mostly
+/// fixed-size sequences (e.g. Expr arguments and parameters) to save one heap
+/// allocation per object. The inline buffer and the heap pointer share the
+/// same storage, so the container is no larger than N elements plus 8 bytes.
+template <class T, size_t N> class SmallVec {
+  static_assert(N > 0, "SmallVec requires a non-empty inline storage");
+
+public:
+  // ------------------------- CONSTRUCTOR/DESTRUCTOR ----------------------- //
+  /// Default constructor.
+  SmallVec() : size_(0), cap_(N) {}
+  /// Constructor from initializer list.
+  SmallVec(std::initializer_list<T> init) : size_(0), cap_(N) {
+    assign(init.begin(), init.end());
+  }
+  /// Constructor from std::vector.
+  SmallVec(const std::vector<T>& vec) : size_(0), cap_(N) {
+    assign(vec.begin(), vec.end());
+  }
+  /// Copy constructor.
+  SmallVec(const SmallVec& rhs) : size_(0), cap_(N) {
+    assign(rhs.begin(), rhs.end());
+  }
+  /// Copy assignment.
+  SmallVec& operator=(const SmallVec& rhs) {
+    if (this != &rhs) {
+      assign(rhs.begin(), rhs.end());
+    }
+    return *this;
+  }
+  /// Default destructor.
+  ~SmallVec() { clear(); }
+
+  // ------------------------- METHODS -------------------------------------- //
+  /// Replace the content with the elements in the range [first, last).
+  template <class It> void assign(It first, It last) {
+    auto num = static_cast<size_t>(std::distance(first, last));
+    clear();
+    reserve(num);
+    std::uninitialized_copy(first, last, data());
+    size_ = static_cast<uint32_t>(num);
+  }
+
+  /// Append an element at the end.
+  void push_back(const T& val) {
+    if (size_ == cap_) {
+      T copy(val); // val may refer to an element being moved
+      grow(2 * cap_);
+      new (data() + size_) T(std::move(copy));
+    } else {
+      new (data() + size_) T(val);
+    }
+    size_++;
+  }
+
+  /// Remove all elements (release the heap storage if any).
+  void clear() {
+    std::destroy(data(), data() + size_);
+    if (on_heap()) {
+      ::operator delete(heap_);
+    }
+    cap_ = N;
+    size_ = 0;
+  }
+
+  /// Return the number of elements.
+  inline size_t size() const { return size_; }
+  /// Return whether is empty.
+  inline bool empty() const { return size_ == 0; }
+
+  /// Access with bound check.
+  inline T& at(const size_t& i) {
+    if (i >= size_) {
+      throw std::out_of_range("SmallVec::at");
+    }
+    return data()[i];
+  }
+  /// Access with bound check.
+  inline const T& at(const size_t& i) const {
+    if (i >= size_) {
+      throw std::out_of_range("SmallVec::at");
+    }
+    return data()[i];
+  }
+  /// Access without bound check.
+  inline T& operator[](const size_t& i) { return data()[i]; }
+  /// Access without bound check.
+  inline const T& operator[](const size_t& i) const { return data()[i]; }
+
+  /// Return the iterator at the starting point.
+  inline T* begin() { return data(); }
+  /// Return the iterator at the ending point.
+  inline T* end() { return data() + size_; }
+  /// Return the iterator at the starting point.
+  inline const T* begin() const { return data(); }
+  /// Return the iterator at the ending point.
+  inline const T* end() const { return data() + size_; }
+
+private:
+  // ------------------------- MEMBERS -------------------------------------- //
+  union {
+    /// Inline storage (raw, only the first size_ elements are constructed).
+    alignas(T) unsigned char inline_[sizeof(T) * N];
+    /// Heap storage, used only if the capacity exceeds N.
+    T* heap_;
+  };
+  /// Number of elements.
+  uint32_t size_;
+  /// Capacity of the active storage.
+  uint32_t cap_;
+
+  // ------------------------- HELPERS -------------------------------------- //
+  /// Return whether the elements live on the heap.
+  inline bool on_heap() const { return cap_ > N; }
+  /// Pointer to the active storage.
+  inline T* data() {
+    return on_heap() ? heap_ : reinterpret_cast<T*>(inline_);
+  }
+  /// Pointer to the active storage.
+  inline const T* data() const {
+    return on_heap() ? heap_ : reinterpret_cast<const T*>(inline_);
+  }
+  /// Make sure the storage can hold at least num elements.
+  void reserve(const size_t& num) {
+    if (num > cap_) {
+      grow(num);
+    }
+  }
+  /// Move the elements to a heap storage of the given capacity.
+  void grow(const size_t& cap) {
+    auto new_heap = static_cast<T*>(::operator new(cap * sizeof(T)));
+    std::uninitialized_move(data(), data() + size_, new_heap);
+    std::destroy(data(), data() + size_);
+    if (on_heap()) {
+      ::operator delete(heap_);
+    }
+    heap_ = new_heap;
+    cap_ = static_cast<uint32_t>(cap);
+  }
+
+}; // class SmallVec
+
 } // namespace ilang
 
 #endif // ILANG_UTIL_CONTAINER_H__
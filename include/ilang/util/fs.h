@@ -8,6 +8,7 @@
 #ifndef ILANG_UTIL_FS_H__
 #define ILANG_UTIL_FS_H__
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -54,6 +55,8 @@ std::string os_portable_remove_file_name_extension(const std::string& fname);
 struct execute_result {
   /// has timeout
   bool timeout;
+  /// killed since another job won (os_portable_execute_shell_race only)
+  bool cancelled = false;
   /// failed execution
   enum _failure { PREIO = 0, FORK = 1, ALARM, ARG, EXEC, WAIT, NONE } failure;
   /// return value
@@ -75,6 +78,27 @@ os_portable_execute_shell(const std::vector<std::string>& cmdargs,
                           unsigned timeout = 0,
                           const std::string& pid_file_name = "");
 
+/// a job to be raced by os_portable_execute_shell_race
+struct execute_job {
+  /// the command and its arguments
+  std::vector<std::string> cmdargs;
+  /// the working directory of the job
+  std::string work_dir;
+  /// redirect both stdout and stderr (relative to the working directory)
+  std::string redirect_output_file;
+};
+
+/// execute the jobs concurrently, each in its own process group. When a job
+/// exits, accept(index, result) decides if it wins, and if so, the others are
+/// killed (reported as cancelled), as are all of them after timeout seconds
+/// (if not 0, reported as timeout). Jobs ignoring SIGTERM are killed with
+/// SIGKILL after a grace period. Returns the index of the winner or
+/// jobs.size() if none is accepted. (runs the jobs one by one on WINDOWS)
+size_t os_portable_execute_shell_race(
+    const std::vector<execute_job>& jobs,
+    const std::function<bool(size_t, const execute_result&)>& accept,
+    std::vector<execute_result>& results, unsigned timeout = 0);
+
 /// Extract filename from path
 /// C:\a\b\c.txt -> c.txt
 /// d/e/ghi  -> ghi
@@ -95,6 +119,10 @@ bool os_portable_chdir(const std::string& dirname);
 /// Get the current directory
 std::string os_portable_getcwd();
 
+/// Get the absolute path (relative paths are resolved against the current
+/// directory)
+std::string os_portable_absolute_path(const std::string& path);
+
 #if (defined(__unix__) || defined(unix) || defined(__APPLE__) ||               \
      defined(__MACH__) || defined(__FreeBSD__)) &&                             \
     !defined(__linux__)
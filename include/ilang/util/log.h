@@ -4,6 +4,8 @@
 #ifndef ILANG_UTIL_LOG_H__
 #define ILANG_UTIL_LOG_H__
 
+#include <atomic>
+#include <cstdint>
 #include <set>
 #include <string>
 
@@ -14,7 +16,8 @@ namespace ilang {
 // Only in Debug mode (Ignored in Release mode)
 /******************************************************************************/
 /// Log debug message to INFO if the "tag" has been enabled.
-#define ILA_DLOG(tag) DLOG_IF(INFO, DebugLog::Find(tag)) << "[" << tag << "] "
+#define ILA_DLOG(tag)                                                          \
+  DLOG_IF(INFO, ::ilang::DebugLog::Enabled(tag)) << "[" << tag << "] "
 
 /// Log the message to INFO (lvl 0). (Debug)
 #define ILA_INFO DLOG(INFO)
@@ -73,9 +76,29 @@ public:
   LogInitter();
 }; // class LogInitter
 
-/// The wrapper for enabling and disabling debug tags.
+/// \brief The wrapper for enabling and disabling debug tags.
+/// Each tag has an id (hash), a constant expression for string literals. A tag
+/// is checked against the mask of the enabled ids first, and the string set is
+/// searched only if its bit is set, i.e., no lookup if no tag is enabled.
 class DebugLog {
 public:
+  /// Type for tag ids.
+  typedef uint64_t TagIdType;
+
+  /// Return the id of the tag (FNV-1a hash).
+  static constexpr TagIdType TagId(const char* tag) {
+    TagIdType id = 14695981039346656037ULL;
+    for (; *tag != '\0'; tag++) {
+      id = (id ^ static_cast<unsigned char>(*tag)) * 1099511628211ULL;
+    }
+    return id;
+  }
+
+  /// Return the bit of the tag id in the enabled mask.
+  static constexpr uint64_t TagBit(const TagIdType& id) {
+    return static_cast<uint64_t>(1) << (id & 63);
+  }
+
   /// Add a debug tag.
   static void Enable(const std::string& tag);
 
@@ -88,10 +111,36 @@ public:
   /// Find if the tag is enabled.
   static bool Find(const std::string& tag);
 
+  /// Find if the tag, with the id computed at compile time, is enabled.
+  template <TagIdType Id> static inline bool Find(const char* tag) {
+    return FindId(Id, tag);
+  }
+
+  /// Find if the tag (a string literal, id folded at compile time) is enabled.
+  template <size_t N> static inline bool Enabled(const char (&tag)[N]) {
+    return FindId(TagId(tag), tag);
+  }
+  /// Find if the tag (any string, id computed at run time) is enabled.
+  static inline bool Enabled(const std::string& tag) {
+    return FindId(TagId(tag.c_str()), tag.c_str());
+  }
+
 private:
   /// The set of debug tags.
   static std::set<std::string> debug_tags_;
 
+  /// The bits of the enabled tag ids.
+  static std::atomic<uint64_t> enabled_mask_;
+
+  /// Check the mask before searching the set.
+  static inline bool FindId(const TagIdType& id, const char* tag) {
+    auto mask = enabled_mask_.load(std::memory_order_relaxed);
+    return (mask & TagBit(id)) != 0 && Find(std::string(tag));
+  }
+
+  /// Update the mask based on the set of tags.
+  static void UpdateMask();
+
   /// The one and only initializer for the log system.
   static LogInitter init_;
 
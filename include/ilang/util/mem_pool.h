@@ -0,0 +1,84 @@
+/// \file
+/// Header for the size-class memory pool and its STL allocator wrapper.
+
+#ifndef ILANG_UTIL_MEM_POOL_H__
+#define ILANG_UTIL_MEM_POOL_H__
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/// \namespace ilang
+namespace ilang {
+
+/// \brief A slab allocator for small, frequently created objects (e.g. AST
+/// nodes). Requests are rounded up to a size class; each class carves
+/// fixed-size blocks out of large slabs. Every thread allocates from its own
+/// slabs without locking, and blocks freed by other threads are handed back
+/// through a lock-free list. A slab is returned to the system once all its
+/// blocks are free (and, if it is not the one in use, right away), and all
+/// slabs of a thread are released when the thread exits and its blocks die.
+/// Requests larger than the biggest class go to the global operator new.
+class MemPool {
+public:
+  /// Allocate a block of (at least) the given size.
+  static void* Allocate(const size_t& size);
+  /// Return a block previously allocated with the same size.
+  static void Deallocate(void* ptr, const size_t& size);
+
+  /// Return the number of blocks currently handed out by the pool (a snapshot
+  /// if other threads are allocating).
+  static size_t LiveBlockNum();
+  /// Return the total number of bytes currently reserved in slabs.
+  static size_t ReservedBytes();
+
+  /// Granularity of the size classes.
+  static constexpr size_t kAlign = 16;
+  /// Largest request served from the pool.
+  static constexpr size_t kMaxBlockSize = 512;
+  /// Size of each slab.
+  static constexpr size_t kSlabSize = 64 * 1024;
+
+}; // class MemPool
+
+/// \brief STL-compatible allocator on top of MemPool, e.g. for use with
+/// std::allocate_shared.
+template <class T> class PoolAllocator {
+public:
+  /// Value type.
+  typedef T value_type;
+
+  /// Default constructor.
+  PoolAllocator() noexcept {}
+  /// Rebind constructor.
+  template <class U> PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+  /// Allocate memory for n objects of type T.
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(MemPool::Allocate(n * sizeof(T)));
+  }
+  /// Deallocate memory for n objects of type T.
+  void deallocate(T* p, std::size_t n) noexcept {
+    MemPool::Deallocate(p, n * sizeof(T));
+  }
+
+  /// All instances are interchangeable.
+  template <class U> bool operator==(const PoolAllocator<U>&) const noexcept {
+    return true;
+  }
+  /// All instances are interchangeable.
+  template <class U> bool operator!=(const PoolAllocator<U>&) const noexcept {
+    return false;
+  }
+
+}; // class PoolAllocator
+
+/// Create a shared object with memory from the pool.
+template <class T, class... Args> std::shared_ptr<T> PoolNew(Args&&... args) {
+  return std::allocate_shared<T>(PoolAllocator<T>(),
+                                 std::forward<Args>(args)...);
+}
+
+} // namespace ilang
+
+#endif // ILANG_UTIL_MEM_POOL_H__
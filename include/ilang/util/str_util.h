@@ -5,6 +5,7 @@
 #define ILANG_UTIL_STR_UTIL_H__
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <vector>
@@ -83,6 +84,11 @@ bool StrEndsWith(const std::string& str, const std::string& suffix);
 /// Finds out if str starts with prefix
 bool StrStartsWith(const std::string& str, const std::string& prefix);
 
+/// FNV-1a hash of the string, stable across platforms and runs (unlike
+/// std::hash), chained by passing the previous hash as the seed.
+uint64_t HashContent(const std::string& str,
+                     uint64_t seed = 0xcbf29ce484222325ULL);
+
 
 } // namespace ilang
 
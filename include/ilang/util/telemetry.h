@@ -0,0 +1,120 @@
+/// \file
+/// The header file for the performance telemetry (timers, counters, gauges).
+
+#ifndef ILANG_UTIL_TELEMETRY_H__
+#define ILANG_UTIL_TELEMETRY_H__
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ilang {
+
+// Both in Debug and Release mode (no-op unless enabled at runtime)
+/******************************************************************************/
+/// Time the enclosing scope under the name (a string literal).
+#define ILA_TRACE_SCOPE(name)                                                  \
+  ::ilang::ScopedTimer ILA_TELEMETRY_CAT(ila_trace_scope_, __LINE__)(name)
+/// Add n to the counter of the name (a string literal).
+#define ILA_COUNT(name, n)                                                     \
+  do {                                                                         \
+    if (::ilang::Telemetry::enabled()) {                                       \
+      static auto& ila_counter_ = ::ilang::Telemetry::GetCounter(name);        \
+      ila_counter_.Add(n);                                                     \
+    }                                                                          \
+  } while (0)
+/// Set the gauge of the name (a string literal) to the value v.
+#define ILA_GAUGE(name, v)                                                     \
+  do {                                                                         \
+    if (::ilang::Telemetry::enabled()) {                                       \
+      ::ilang::Telemetry::SetGauge(name, v);                                   \
+    }                                                                          \
+  } while (0)
+
+#define ILA_TELEMETRY_CAT_(a, b) a##b
+#define ILA_TELEMETRY_CAT(a, b) ILA_TELEMETRY_CAT_(a, b)
+
+/// \brief The collector of the performance telemetry, disabled by default.
+/// - Scopes timed by ILA_TRACE_SCOPE are recorded as complete events.
+/// - Counters accumulate via ILA_COUNT, and gauges are sampled via ILA_GAUGE.
+/// - When disabled, each probe costs one relaxed atomic load.
+/// The records can be exported as a Chrome trace-event JSON (chrome://tracing
+/// or Perfetto) or as a summary table.
+class Telemetry {
+public:
+  /// Type for time stamps and durations (in microseconds).
+  typedef int64_t TimeType;
+
+  /// A named counter, with a stable address for the program lifetime.
+  class Counter {
+  public:
+    /// Add the delta to the counter.
+    inline void Add(const int64_t& delta) {
+      value_.fetch_add(delta, std::memory_order_relaxed);
+    }
+    /// Return the value of the counter.
+    inline int64_t value() const {
+      return value_.load(std::memory_order_relaxed);
+    }
+    /// Reset the counter to zero.
+    inline void Reset() { value_.store(0, std::memory_order_relaxed); }
+
+  private:
+    std::atomic<int64_t> value_{0};
+  }; // class Counter
+
+  /// Check if the telemetry is enabled.
+  static inline bool enabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+  /// Enable the telemetry (the time origin is set at the first enabling).
+  static void Enable();
+  /// Disable the telemetry (the records are kept).
+  static void Disable();
+  /// Clear all the records, counters, and gauges.
+  static void Reset();
+
+  /// Return the counter of the name (created if not exist).
+  static Counter& GetCounter(const std::string& name);
+  /// Set the gauge of the name and record the sample.
+  static void SetGauge(const std::string& name, const int64_t& value);
+  /// Record a timed scope (called by ScopedTimer).
+  static void RecordScope(const char* name, const TimeType& begin,
+                          const TimeType& end);
+  /// Return the current time stamp.
+  static TimeType Now();
+
+  /// \brief Write the records to the file in Chrome trace-event JSON format.
+  /// \return Return true if complete successfully.
+  static bool ExportChromeTrace(const std::string& file_name);
+  /// Write the summary table (time per scope, counters, and gauges).
+  static void PrintSummary(std::ostream& out);
+
+private:
+  /// Set if enabled.
+  static std::atomic<bool> enabled_;
+
+}; // class Telemetry
+
+/// \brief The RAII timer recording the scope to Telemetry if enabled at entry.
+class ScopedTimer {
+public:
+  /// Constructor (the name should outlive the telemetry, e.g., literal).
+  ScopedTimer(const char* name)
+      : name_(name), begin_(Telemetry::enabled() ? Telemetry::Now() : -1) {}
+  /// Destructor, recording the scope.
+  ~ScopedTimer() {
+    if (begin_ >= 0) {
+      Telemetry::RecordScope(name_, begin_, Telemetry::Now());
+    }
+  }
+
+private:
+  const char* name_;
+  Telemetry::TimeType begin_;
+}; // class ScopedTimer
+
+} // namespace ilang
+
+#endif // ILANG_UTIL_TELEMETRY_H__
@@ -122,6 +122,17 @@ inline z3::expr Z3RRotate(z3::context& ctx, z3::expr& e, unsigned& w) {
 #endif
 }
 
+/// \brief Conjunct (AND) the expressions as one n-ary and (simplified), which
+/// keeps the term shallow compared to a left-deep chain of binary ands.
+template <class ExprVec>
+inline z3::expr Z3AndAll(z3::context& ctx, const ExprVec& vec) {
+  auto args = z3::expr_vector(ctx);
+  for (size_t i = 0; i != vec.size(); i++) {
+    args.push_back(vec[i]);
+  }
+  return z3::mk_and(args).simplify();
+}
+
 /// \brief Return the output string of the given z3::expr.
 inline std::string Z3Expr2String(z3::context& ctx, const z3::expr& e) {
 #ifndef Z3_LEGACY_API
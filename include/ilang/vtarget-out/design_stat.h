@@ -32,6 +32,8 @@ struct DesignStatistics {
   double TimeOfInvSynEnhance;
   /// the series of time spent on each cegar iteration
   std::vector<double> TimeOfInvSynSeries;
+  /// the backend that finished the synthesis in each cegar iteration
+  std::vector<std::string> InvSynBackendSeries;
   /// Total time
   double TotalTime;
 
@@ -11,11 +11,14 @@
 #include <ilang/vtarget-out/design_stat.h>
 #include <ilang/vtarget-out/vtarget_gen.h>
 
+#include <future>
 #include <memory>
 #include <string>
 
 namespace ilang {
 
+class VerilogAnalyzer;
+
 /// \brief the implementation of the synthesizer class
 class InvariantSynthesizerCegar {
 
@@ -83,6 +86,10 @@ public:
   void CexGeneralizeRemoveStates(const std::vector<std::string>&);
   /// to generate synthesis target
   void GenerateSynthesisTarget();
+  /// race these synthesis backends in each round instead of the one given at
+  /// construction (empty to disable), the first inductive result is taken
+  void SetSynthesisPortfolio(
+      const std::vector<synthesis_backend_selector>& backends);
   /// to extract reachability test result
   void ExtractSynthesisResult(bool autodet = true, bool reachable = true,
                               const std::string& res_file = "");
@@ -97,8 +104,13 @@ public:
                             const std::string& pid_fname = "",
                             bool run_test = false,
                             unsigned timeout = 0);
+  /// run the selected verification targets (e.g., of each instruction)
+  /// concurrently and stop at the first counterexample : returns eq true/false
+  bool RunVerifAutoParallel(const std::vector<std::string>& script_selections,
+                            bool run_test = false, unsigned timeout = 0);
   /// run Synthesis : returns reachable/not
-  bool virtual RunSynAuto(bool run_test = false);
+  /// (timeout in seconds if not 0, taken as reachable)
+  bool virtual RunSynAuto(bool run_test = false, unsigned timeout = 0);
 
   /// Forcing to accept all the candidate invariants
   void AcceptAllCandidateInvariant();
@@ -184,6 +196,49 @@ protected:
   std::string synthesis_result_fn;
   /// the invariant type
   enum cur_inv_tp { NONE, GRAIN_CHC, CHC, CEGAR_ABC } current_inv_type;
+  /// the output path of the synthesis target to extract from
+  std::string synthesis_output_path;
+
+  /// a synthesis target of one backend
+  struct synthesis_target_t {
+    /// the synthesis backend
+    synthesis_backend_selector backend;
+    /// where the target is generated
+    std::string output_path;
+    /// the script to run
+    std::string script;
+    /// the type of invariant it produces
+    cur_inv_tp inv_type;
+    /// the SMT-LIB2 information of the design (not for ABC)
+    std::shared_ptr<smt::YosysSmtParser> design_smt_info;
+  };
+  /// the synthesis targets of this round (more than one in portfolio mode)
+  std::vector<synthesis_target_t> synthesis_targets;
+  /// the backends to race (empty if not in portfolio mode)
+  std::vector<synthesis_backend_selector> portfolio_backends;
+
+  // -------------------- HELPERs ------------------ //
+  /// generate the synthesis target of a backend to the given path
+  synthesis_target_t
+  GenerateSynthesisTargetOf(synthesis_backend_selector backend,
+                            const std::string& output_path);
+  /// make the target the one to extract the synthesis result from
+  void AdoptSynthesisTarget(const synthesis_target_t& target);
+  /// read the result of a synthesis run, false if it cannot be read;
+  /// definitive is false if the backend could not tell (e.g., unknown)
+  bool ReadSynthesisResult(const synthesis_target_t& target, bool& reachable,
+                           bool& definitive);
+  /// read the result of a verification run, true if it has a counterexample
+  bool ReadVerificationResult(const std::string& result_fn,
+                              const std::string& work_dir);
+
+  /// the Verilog design analysis done while the verification tools run
+  std::future<std::shared_ptr<VerilogAnalyzer>> vlg_analysis;
+  /// start analyzing the Verilog design in the background
+  void StartVerilogAnalysis();
+  /// wait for the analysis (nullptr if not started). It must be released
+  /// before generating targets, as only one analyzer can exist at a time.
+  std::shared_ptr<VerilogAnalyzer> FinishVerilogAnalysis();
 
   // --------------------------------------------------
   // for book-keeping purpose
@@ -226,6 +281,8 @@ protected:
   double inv_enhance_time;
   /// the series of synthesis time
   std::vector<double> inv_syn_time_series;
+  /// the series of backends that synthesized the invariant
+  std::vector<std::string> inv_syn_backend_series;
 
 public:
   /// total cands there are
@@ -83,6 +83,9 @@ public:
       CONFIRMED,
       ALL
     } ValidateSynthesizedInvariant;
+    /// Whether to share the compiled refinement-map expressions among the
+    /// targets, instead of parsing them again for every use
+    bool CacheRefinementExprs; // true
 
     // ----------- Options for CoSA settings -------------- //
     /// Do we set separate problems for different var map (CoSA only)
@@ -225,7 +228,7 @@ public:
           InstructionNoReset(true), OnlyCheckInstUpdatedVars(true),
           IteUnknownAutoIgnore(false),
           VerificationSettingAvoidIssueStage(false),
-          ValidateSynthesizedInvariant(ALL),
+          ValidateSynthesizedInvariant(ALL), CacheRefinementExprs(true),
 
           // ----------- Options for CoSA settings -------------- //
           PerVariableProblemCosa(false), MemAbsReadAbstraction(false),
@@ -32,6 +32,26 @@
 
 namespace ilang {
 
+/// \brief The refinement-map expressions compiled once and shared by all the
+/// targets of a generator: tokenized, with the references resolved
+struct RfExprCache {
+  /// A token of a compiled expression
+  struct token_t {
+    /// the type of the token
+    VarExtractor::token_type type;
+    /// the text to put in the property
+    std::string text;
+    /// the Verilog signal it refers to, with range (VLG_S, if recorded)
+    std::string vlg_name;
+    /// the range part of the Verilog signal reference
+    std::string vlg_range;
+  };
+  /// Type of a compiled expression
+  typedef std::vector<token_t> expr_t;
+  /// (expression, force Verilog names) -> compiled expression
+  std::map<std::pair<std::string, bool>, expr_t> exprs;
+}; // struct RfExprCache
+
 /// \brief Generating a target (just the invairant or for an instruction)
 class VlgSglTgtGen {
 public:
@@ -90,6 +110,12 @@ public:
   /// Destructor: do nothing , most importantly it is virtual
   virtual ~VlgSglTgtGen() {}
 
+  /// Share the compiled refinement-map expressions with other targets
+  /// (unless disabled by CacheRefinementExprs)
+  void SetRfExprCache(RfExprCache* cache) {
+    _rf_expr_cache = _vtg_config.CacheRefinementExprs ? cache : nullptr;
+  }
+
 protected:
   // --------------------- MEMBERS ---------------------------- //
   // the following are used to store info presented
@@ -119,6 +145,8 @@ protected:
   VerilogInfo* vlg_info_ptr;
   /// variable extractor to handle property expressions
   VarExtractor _vext;
+  /// the compiled expressions (not shared if nullptr)
+  RfExprCache* _rf_expr_cache = nullptr;
   /// refinement relation variable mapping
   nlohmann::json& rf_vmap;
   /// refinement relation instruction conditions
@@ -180,6 +208,10 @@ protected:
   ExprPtr TryFindIlaVarName(const std::string& sname);
   /// Modify a token and record its use
   std::string ModifyCondExprAndRecordVlgName(const VarExtractor::token& t);
+  /// Resolve the reference of a token (no recording)
+  RfExprCache::token_t ResolveToken(const VarExtractor::token& t);
+  /// Record the use of a resolved token and return its text
+  std::string UseResolvedToken(const RfExprCache::token_t& t);
   /// Check if ila name and vlg name are type compatible (not including special
   /// directives)
   static unsigned TypeMatched(const ExprPtr& ila_var,
@@ -454,6 +486,8 @@ protected:
   nlohmann::json rf_cond;
   /// The supplementary information
   VlgTgtSupplementaryInfo supplementary_info;
+  /// the refinement-map expressions compiled by the targets
+  RfExprCache rf_expr_cache;
 
 public:
   // --------------------- METHODS ---------------------------- //
@@ -5,12 +5,14 @@
 
 #include <ilang/ila-mngr/u_unroller.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
 namespace pass {
 
 bool InferChildProgCFG(const InstrLvlAbsPtr& m) {
+  ILA_TRACE_SCOPE("pass.infer_child_prog_cfg");
   ILA_NOT_NULL(m);
   ILA_INFO << "Start pass: infer child program control-flow";
 
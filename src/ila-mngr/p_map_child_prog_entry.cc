@@ -5,12 +5,14 @@
 
 #include <ilang/ila-mngr/u_unroller.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
 namespace pass {
 
 bool MapChildProgEntryPoint(const InstrLvlAbsPtr& m) {
+  ILA_TRACE_SCOPE("pass.map_child_prog_entry");
   ILA_NOT_NULL(m);
   ILA_INFO << "Start pass: mapping child program entry";
 
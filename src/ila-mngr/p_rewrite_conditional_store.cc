@@ -6,6 +6,7 @@
 #include <ilang/ila-mngr/u_rewriter.h>
 #include <ilang/ila/ast_hub.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -107,6 +108,7 @@ private:
 }; // class FuncObjRewrCondStore
 
 bool RewriteConditionalStore(const InstrLvlAbsPtr& m) {
+  ILA_TRACE_SCOPE("pass.rewrite_conditional_store");
   ILA_NOT_NULL(m);
   ILA_INFO << "Start pass: rewrite conditional store";
 
@@ -4,6 +4,7 @@
 #include <ilang/ila-mngr/pass.h>
 
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -11,6 +12,7 @@ namespace pass {
 
 bool RewriteGeneric(const InstrLvlAbsPtr& m,
                     std::function<ExprPtr(const ExprPtr)> Rewr) {
+  ILA_TRACE_SCOPE("pass.rewrite_generic");
   ILA_NOT_NULL(m);
 
   // rewrite valid
@@ -6,6 +6,7 @@
 #include <ilang/ila-mngr/u_rewriter.h>
 #include <ilang/ila/ast_hub.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -74,6 +75,7 @@ private:
 }; // class FuncObjRewrStoreLoad
 
 bool RewriteStoreLoad(const InstrLvlAbsPtr& m) {
+  ILA_TRACE_SCOPE("pass.rewrite_store_load");
   ILA_NOT_NULL(m);
   ILA_INFO << "Start pass: rewrite store-load pattern";
 
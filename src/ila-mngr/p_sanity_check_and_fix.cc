@@ -8,6 +8,7 @@
 #include <ilang/ila-mngr/u_abs_knob.h>
 #include <ilang/target-smt/z3_expr_adapter.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -56,6 +57,7 @@ bool CheckDeterminism(const InstrLvlAbsCnstPtr& m) {
 }
 
 bool SanityCheckAndFix(const InstrLvlAbsPtr& m) {
+  ILA_TRACE_SCOPE("pass.sanity_check_and_fix");
   ILA_NOT_NULL(m);
   ILA_INFO << "Start pass: sanity check and fix";
 
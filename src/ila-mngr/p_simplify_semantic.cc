@@ -5,6 +5,7 @@
 
 #include <ilang/target-smt/z3_expr_adapter.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -12,8 +13,10 @@ namespace pass {
 
 class FuncObjEqSubtree {
 public:
-  FuncObjEqSubtree(const ExprPtr& target, const ExprPtr& assump)
-      : target_(target), assump_(assump) {}
+  FuncObjEqSubtree(const ExprPtr& target, const ExprPtr& assump,
+                   const SolverPortfolioPtr& portfolio, const int& timeout)
+      : target_(target), assump_(assump), portfolio_(portfolio),
+        timeout_(timeout > 0 ? timeout : 0) {}
 
   ExprPtr get(const ExprPtr& e) const {
     auto pos = rule_.find(e);
@@ -35,6 +38,8 @@ private:
   ExprMap rule_;
   ExprPtr target_;
   ExprPtr assump_;
+  SolverPortfolioPtr portfolio_;
+  unsigned timeout_;
   ExprPtr candidate_ = nullptr;
 
   ExprPtr Rewrite(const ExprPtr& e) {
@@ -50,7 +55,9 @@ private:
       auto can = gen.GetExpr(x);
 
       s.add(ass && (can != tar));
-      return (s.check() == z3::unsat);
+      // the portfolio contexts do not see the global timeout
+      auto res = (portfolio_) ? portfolio_->Check(s, timeout_) : s.check();
+      return (res == z3::unsat);
     };
 
     // skip target itself
@@ -70,7 +77,9 @@ private:
 
 }; // class FuncObjSimpInstrUpdateRedundant
 
-bool SimplifySemantic(const InstrLvlAbsCnstPtr& m, const int& timeout) {
+bool SimplifySemantic(const InstrLvlAbsCnstPtr& m, const int& timeout,
+                      const SolverPortfolioPtr& portfolio) {
+  ILA_TRACE_SCOPE("pass.simplify_semantic");
   ILA_NOT_NULL(m);
   ILA_INFO << "Start pass: semantic simplification";
 
@@ -85,7 +94,8 @@ bool SimplifySemantic(const InstrLvlAbsCnstPtr& m, const int& timeout) {
     auto decode = i->decode();
     ILA_NOT_NULL(decode);
 
-    auto func = FuncObjEqSubtree(e, asthub::And(valid, decode));
+    auto func =
+        FuncObjEqSubtree(e, asthub::And(valid, decode), portfolio, timeout);
     e->DepthFirstVisitPrePost(func);
 
     auto new_update = func.get(e);
@@ -3,21 +3,31 @@
 
 #include <ilang/ila-mngr/pass.h>
 
+#include <ilang/ila-mngr/u_rewriter.h>
 #include <ilang/ila/hash_ast.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
 namespace pass {
 
 bool SimplifySyntactic(const InstrLvlAbsPtr& m) {
+  ILA_TRACE_SCOPE("pass.simplify_syntactic");
   ILA_NOT_NULL(m);
   ILA_INFO << "Start pass: syntactic simplification";
 
+  // apply the standard rules first, then merge structurally equal sub-trees
+  // (both memoized across the whole ILA)
+  auto rules = FuncObjRuleRewr(RewriteRuleSet::Default());
   auto mngr = ExprMngr::New();
-  auto Rewr = [&mngr](const ExprPtr& expr) { return mngr->GetRep(expr); };
+  auto Rewr = [&rules, &mngr](const ExprPtr& expr) {
+    return mngr->GetRep(rules.Apply(expr));
+  };
   try {
-    return RewriteGeneric(m, Rewr);
+    auto status = RewriteGeneric(m, Rewr);
+    ILA_DLOG("PassSimpSyntactic") << "Rules applied: " << rules.hit_num();
+    return status;
   } catch (...) {
     return false;
   }
@@ -3,7 +3,17 @@
 
 #include <ilang/ila-mngr/u_abs_knob.h>
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
 #include <ilang/ila-mngr/u_rewriter.h>
+#include <ilang/ila/ast/expr_op.h>
 #include <ilang/util/log.h>
 
 namespace ilang {
@@ -209,6 +219,12 @@ ExprPtr Rewrite(const ExprPtr& e, const ExprMap& rule) {
   return rewr;
 }
 
+ExprPtr Rewrite(const ExprPtr& e, const RewriteRuleSet& rules) {
+  ILA_ASSERT(e) << "Rewriting NULL pointer";
+  auto func = FuncObjRuleRewr(rules);
+  return func.Apply(e);
+}
+
 void RewriteInstr(const InstrCnstPtr src, const InstrPtr& dst,
                   const ExprMap& expr_map) {
   // decode
@@ -392,6 +408,164 @@ void DuplInstrSeq(const InstrLvlAbsCnstPtr& src, const InstrLvlAbsPtr& dst) {
   // TODO
 }
 
+/******************************************************************************/
+/// Depth and tree size of a node.
+struct NodeInfo {
+  size_t depth;
+  size_t tree;
+};
+
+typedef std::unordered_map<const Expr*, NodeInfo> NodeInfoMap;
+
+static NodeInfo VisitNode(const ExprPtr& root, NodeInfoMap& visited) {
+  if (auto pos = visited.find(root.get()); pos != visited.end()) {
+    return pos->second;
+  }
+  // explicit work stack of (node, next argument), since the DAG can be deeper
+  // than the call stack allows
+  std::vector<std::pair<const Expr*, size_t>> work = {{root.get(), 0}};
+  while (!work.empty()) {
+    auto& [e, next] = work.back();
+    if (next != e->arg_num()) {
+      auto arg = e->arg(next++).get();
+      if (visited.find(arg) == visited.end()) {
+        work.push_back({arg, 0}); // invalidates e and next
+      }
+      continue;
+    }
+    auto info = NodeInfo({1, 1});
+    for (size_t i = 0; i != e->arg_num(); i++) {
+      auto& arg = visited.at(e->arg(i).get());
+      info.depth = std::max(info.depth, arg.depth + 1);
+      // saturate, since sharing may blow up the tree exponentially
+      info.tree = (arg.tree > std::numeric_limits<size_t>::max() - info.tree)
+                      ? std::numeric_limits<size_t>::max()
+                      : info.tree + arg.tree;
+    }
+    visited.emplace(e, info);
+    work.pop_back();
+  }
+  return visited.at(root.get());
+}
+
+static std::vector<ExprPtr> GetRoots(const InstrCnstPtr& instr) {
+  std::vector<ExprPtr> roots;
+  if (instr->decode()) {
+    roots.push_back(instr->decode());
+  }
+  for (const auto& s : instr->updated_states()) {
+    roots.push_back(instr->update(s));
+  }
+  return roots;
+}
+
+ExprGraphStats GetExprGraphStats(const InstrLvlAbsCnstPtr& m) {
+  ILA_NOT_NULL(m);
+  auto stats = ExprGraphStats();
+
+  // cone of each instruction, in parallel
+  auto instrs = GetInstrTree(m);
+  std::vector<NodeInfoMap> cones(instrs.size());
+  auto workers_num = std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u), instrs.size());
+  auto Worker = [&instrs, &cones, &workers_num](size_t id) {
+    for (auto i = id; i < instrs.size(); i += workers_num) {
+      for (const auto& r : GetRoots(instrs[i])) {
+        VisitNode(r, cones[i]);
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < workers_num; i++) {
+    workers.emplace_back(Worker, i);
+  }
+  if (workers_num != 0) {
+    Worker(0);
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+
+  // merge the cones, then visit the remaining roots
+  auto visited = NodeInfoMap();
+  std::vector<ExprPtr> roots;
+  for (size_t i = 0; i != instrs.size(); i++) {
+    stats.instr_cone_size.push_back(
+        {instrs[i]->name().str(), cones[i].size()});
+    // move the nodes over, and release what is left (shared with others)
+    visited.merge(cones[i]);
+    NodeInfoMap().swap(cones[i]);
+    auto instr_roots = GetRoots(instrs[i]);
+    roots.insert(roots.end(), instr_roots.begin(), instr_roots.end());
+  }
+  for (const auto& r : {m->valid(), m->fetch()}) {
+    if (r) {
+      roots.push_back(r);
+    }
+  }
+  for (size_t i = 0; i != m->init_num(); i++) {
+    roots.push_back(m->init(i));
+  }
+
+  for (const auto& r : roots) {
+    auto info = VisitNode(r, visited);
+    stats.max_depth = std::max(stats.max_depth, info.depth);
+    stats.tree_node_num =
+        (info.tree > std::numeric_limits<size_t>::max() - stats.tree_node_num)
+            ? std::numeric_limits<size_t>::max()
+            : stats.tree_node_num + info.tree;
+  }
+
+  // node kinds and fan-outs
+  std::unordered_map<const Expr*, size_t> fanout;
+  for (const auto& it : visited) {
+    auto e = it.first;
+    fanout.emplace(e, 0);
+    for (size_t i = 0; i != e->arg_num(); i++) {
+      fanout[e->arg(i).get()]++;
+    }
+    if (e->is_op()) {
+      auto op = static_cast<const ExprOp*>(e);
+      stats.op_hist[op->op_name()]++;
+      stats.load_num += (op->uid() == AstUidExprOp::kLoad) ? 1 : 0;
+      stats.store_num += (op->uid() == AstUidExprOp::kStore) ? 1 : 0;
+    } else {
+      stats.op_hist[e->is_var() ? "VAR" : "CONST"]++;
+    }
+  }
+  for (const auto& it : fanout) {
+    stats.fanout_hist[it.second]++;
+  }
+  stats.unique_node_num = visited.size();
+
+  return stats;
+}
+
+std::string ExprGraphStats::ToJson(const int& indent) const {
+  auto ratio = (unique_node_num == 0)
+                   ? 0.0
+                   : static_cast<double>(tree_node_num) / unique_node_num;
+  auto j = nlohmann::json::object();
+  j["unique_node_num"] = unique_node_num;
+  j["tree_node_num"] = tree_node_num;
+  j["sharing_ratio"] = ratio;
+  j["max_depth"] = max_depth;
+  auto fanout = nlohmann::json::object();
+  for (const auto& it : fanout_hist) {
+    fanout[std::to_string(it.first)] = it.second;
+  }
+  j["fanout_hist"] = fanout;
+  j["op_hist"] = op_hist;
+  j["load_num"] = load_num;
+  j["store_num"] = store_num;
+  auto cones = nlohmann::json::array();
+  for (const auto& it : instr_cone_size) {
+    cones.push_back({{"instr", it.first}, {"cone_size", it.second}});
+  }
+  j["instr_cone_size"] = cones;
+  return j.dump(indent);
+}
+
 } // namespace absknob
 
 } // namespace ilang
@@ -96,21 +96,21 @@ ExprPtr FuncObjRewrExpr::RewriteOp(const ExprPtr& e) const {
     auto a1 = get(e->arg(1));
     return Div(a0, a1);
   }
-#if 0
   case AstUidExprOp::kSignedRemainder: {
-    // TODO
+    auto a0 = get(e->arg(0));
+    auto a1 = get(e->arg(1));
+    return SRem(a0, a1);
   }
-#endif
   case AstUidExprOp::kUnsignedRemainder: {
     auto a0 = get(e->arg(0));
     auto a1 = get(e->arg(1));
     return URem(a0, a1);
   }
-#if 0
   case AstUidExprOp::kSignedModular: {
-    // TODO
+    auto a0 = get(e->arg(0));
+    auto a1 = get(e->arg(1));
+    return SMod(a0, a1);
   }
-#endif
   case AstUidExprOp::kMultiply: {
     auto a0 = get(e->arg(0));
     auto a1 = get(e->arg(1));
@@ -0,0 +1,339 @@
+/// \file
+/// Rule-indexed rewriting of Expr, and the standard rule set.
+
+#include <ilang/ila-mngr/u_rewriter.h>
+
+#include <ilang/ila/ast_hub.h>
+#include <ilang/util/log.h>
+
+namespace ilang {
+
+//
+// static helpers
+//
+
+// Rewrites stacked on top of each other before giving up (guard against
+// non-terminating user rules).
+static const int kMaxRewriteDepth = 64;
+
+static int GetWidth(const ExprPtr& e) {
+  if (e->is_bool()) {
+    return 0;
+  } else if (e->is_bv()) {
+    return e->sort()->bit_width();
+  }
+  return -1;
+}
+
+static BvValType GetConstVal(const ExprPtr& e) {
+  auto c = std::static_pointer_cast<ExprConst>(e);
+  return e->is_bool() ? c->val_bool()->val() : c->val_bv()->val();
+}
+
+static bool IsConstVal(const ExprPtr& e, const BvValType& val) {
+  return e->is_const() && !e->is_mem() && GetConstVal(e) == val;
+}
+
+static BvValType GetMask(const int& width) {
+  return (width >= 64) ? ~BvValType(0) : ((BvValType(1) << width) - 1);
+}
+
+// Evaluate an operation with all constant arguments (NULL if not supported).
+static ExprPtr FoldConst(const ExprPtr& e) {
+  ExprPtrVec args;
+  for (size_t i = 0; i != e->arg_num(); i++) {
+    args.push_back(e->arg(i));
+  }
+  std::vector<int> params;
+  for (size_t i = 0; i != e->param_num(); i++) {
+    params.push_back(e->param(i));
+  }
+  return asthub::FoldConst(asthub::GetUidExprOp(e), args, params);
+}
+
+static ExprPtr RewrExtractConcat(const ExprPtr& e) {
+  auto concat = e->arg(0);
+  auto hi = e->param(0);
+  auto lo = e->param(1);
+  auto lo_width = GetWidth(concat->arg(1));
+  if (hi < lo_width) {
+    return asthub::Extract(concat->arg(1), hi, lo);
+  } else if (lo >= lo_width) {
+    return asthub::Extract(concat->arg(0), hi - lo_width, lo - lo_width);
+  }
+  return nullptr;
+}
+
+static ExprPtr RewrExtractFull(const ExprPtr& e) {
+  auto bv = e->arg(0);
+  auto full = (e->param(1) == 0) && (e->param(0) == GetWidth(bv) - 1);
+  return full ? bv : nullptr;
+}
+
+static ExprPtr RewrIteConstCond(const ExprPtr& e) {
+  return (GetConstVal(e->arg(0)) != 0) ? e->arg(1) : e->arg(2);
+}
+
+static ExprPtr RewrIteSameBranch(const ExprPtr& e) {
+  return (e->arg(1) == e->arg(2)) ? e->arg(1) : nullptr;
+}
+
+static ExprPtr RewrLoadFromStore(const ExprPtr& e) {
+  auto store = e->arg(0);
+  auto addr_st = store->arg(1);
+  auto addr_ld = e->arg(1);
+  if (addr_st == addr_ld) {
+    return store->arg(2);
+  }
+  if (addr_st->is_const() && addr_ld->is_const()) {
+    return (GetConstVal(addr_st) == GetConstVal(addr_ld))
+               ? store->arg(2)
+               : asthub::Load(store->arg(0), addr_ld);
+  }
+  return nullptr;
+}
+
+// x & x --> x, x | x --> x
+static ExprPtr RewrIdempotent(const ExprPtr& e) {
+  return (e->arg(0) == e->arg(1)) ? e->arg(0) : nullptr;
+}
+
+// x & 1..1 --> x, x & 0 --> 0 (and dually for or)
+static ExprPtr RewrAndOrConst(const ExprPtr& e) {
+  if (GetWidth(e) > 64) {
+    return nullptr;
+  }
+  auto is_and = (asthub::GetUidExprOp(e) == AstUidExprOp::kAnd);
+  auto ones = e->is_bool() ? 1 : GetMask(GetWidth(e));
+  auto identity = is_and ? ones : 0;
+  auto absorbing = is_and ? 0 : ones;
+  for (auto i = 0; i < 2; i++) {
+    auto c = e->arg(i);
+    if (IsConstVal(c, identity)) {
+      return e->arg(1 - i);
+    } else if (IsConstVal(c, absorbing)) {
+      return c;
+    }
+  }
+  return nullptr;
+}
+
+// x & (x | y) --> x, x | (x & y) --> x
+static ExprPtr RewrAbsorption(const ExprPtr& e) {
+  auto inner = (asthub::GetUidExprOp(e) == AstUidExprOp::kAnd)
+                   ? AstUidExprOp::kOr
+                   : AstUidExprOp::kAnd;
+  for (auto i = 0; i < 2; i++) {
+    auto x = e->arg(i);
+    auto y = e->arg(1 - i);
+    if (y->is_op() && asthub::GetUidExprOp(y) == inner &&
+        (y->arg(0) == x || y->arg(1) == x)) {
+      return x;
+    }
+  }
+  return nullptr;
+}
+
+//
+// RewritePattern
+//
+
+RewritePattern RewritePattern::Any() { return RewritePattern(); }
+
+RewritePattern RewritePattern::Const() {
+  RewritePattern p;
+  p.kind_ = CONST;
+  return p;
+}
+
+RewritePattern RewritePattern::Const(const BvValType& val) {
+  auto p = Const();
+  p.has_val_ = true;
+  p.val_ = val;
+  return p;
+}
+
+RewritePattern RewritePattern::Op(const AstUidExprOp& op,
+                                  const std::vector<RewritePattern>& args) {
+  RewritePattern p;
+  p.kind_ = OP;
+  p.op_ = op;
+  p.args_ = args;
+  return p;
+}
+
+RewritePattern RewritePattern::Width(const int& width) const {
+  auto p = *this;
+  p.width_ = width;
+  return p;
+}
+
+bool RewritePattern::Match(const ExprPtr& e) const {
+  if (width_ >= 0 && GetWidth(e) != width_) {
+    return false;
+  }
+
+  switch (kind_) {
+  case CONST: {
+    return e->is_const() && (!has_val_ || IsConstVal(e, val_));
+  }
+  case OP: {
+    if (!e->is_op() || asthub::GetUidExprOp(e) != op_ ||
+        e->arg_num() < args_.size()) {
+      return false;
+    }
+    for (size_t i = 0; i != args_.size(); i++) {
+      if (!args_[i].Match(e->arg(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  default: {
+    return true;
+  }
+  };
+}
+
+//
+// RewriteRuleSet
+//
+
+const RewriteRuleSet& RewriteRuleSet::Default() {
+  static const RewriteRuleSet std_rules = []() {
+    using P = RewritePattern;
+    RewriteRuleSet rules;
+
+    // constant folding
+    for (auto op : {kNegate, kNot, kComplement, kZeroExtend, kSignedExtend,
+                    kExtract, kRotateLeft, kRotateRight}) {
+      rules.Add("const_fold", P::Op(op, {P::Const()}), FoldConst);
+    }
+    for (auto op :
+         {kAnd, kOr, kXor, kShiftLeft, kArithShiftRight, kLogicShiftRight,
+          kAdd, kSubtract, kMultiply, kUnsignedRemainder, kSignedRemainder,
+          kSignedModular, kEqual, kLessThan, kGreaterThan, kUnsignedLessThan,
+          kUnsignedGreaterThan, kConcatenate, kImply}) {
+      rules.Add("const_fold", P::Op(op, {P::Const(), P::Const()}), FoldConst);
+    }
+
+    // extract
+    rules.Add("extract_concat", P::Op(kExtract, {P::Op(kConcatenate)}),
+              RewrExtractConcat);
+    rules.Add("extract_full", P::Op(kExtract), RewrExtractFull);
+
+    // if-then-else
+    rules.Add("ite_const_cond", P::Op(kIfThenElse, {P::Const()}),
+              RewrIteConstCond);
+    rules.Add("ite_same_branch", P::Op(kIfThenElse), RewrIteSameBranch);
+
+    // memory
+    rules.Add("load_store", P::Op(kLoad, {P::Op(kStore)}), RewrLoadFromStore);
+
+    // and/or
+    for (auto op : {kAnd, kOr}) {
+      rules.Add("and_or_const", P::Op(op), RewrAndOrConst);
+      rules.Add("and_or_idempotent", P::Op(op), RewrIdempotent);
+      rules.Add("and_or_absorption", P::Op(op), RewrAbsorption);
+    }
+
+    return rules;
+  }();
+
+  return std_rules;
+}
+
+void RewriteRuleSet::Add(const RewriteRule& rule) {
+  auto op = rule.lhs.op();
+  ILA_CHECK(op != AstUidExprOp::kInvalid)
+      << "Root of rule " << rule.name << " must be an operation";
+  ILA_NOT_NULL(rule.rhs);
+
+  if (index_.size() <= static_cast<size_t>(op)) {
+    index_.resize(op + 1);
+  }
+  index_[op].push_back(rule);
+  size_++;
+}
+
+void RewriteRuleSet::Add(const std::string& name, const RewritePattern& lhs,
+                         const RewriteRule::Action& rhs) {
+  Add(RewriteRule({name, lhs, rhs}));
+}
+
+ExprPtr RewriteRuleSet::Apply(const ExprPtr& e, std::string* name) const {
+  if (!e->is_op()) {
+    return nullptr;
+  }
+  auto op = static_cast<size_t>(asthub::GetUidExprOp(e));
+  if (op >= index_.size()) {
+    return nullptr;
+  }
+  for (const auto& rule : index_[op]) {
+    if (!rule.lhs.Match(e)) {
+      continue;
+    }
+    if (auto res = rule.rhs(e); res && res != e) {
+      if (name) {
+        *name = rule.name;
+      }
+      return res;
+    }
+  }
+  return nullptr;
+}
+
+//
+// FuncObjRuleRewr
+//
+
+ExprPtr FuncObjRuleRewr::Apply(const ExprPtr& e) {
+  ILA_NOT_NULL(e);
+  e->DepthFirstVisitPrePost(*this);
+  return get(e);
+}
+
+void FuncObjRuleRewr::post(const ExprPtr& e) {
+  auto res = Rebuild(e);
+
+  // rewrite the root until no rule applies; sub-trees of the replacement are
+  // normalized recursively (those already visited are looked up)
+  for (auto depth = 0; depth < kMaxRewriteDepth; depth++) {
+    std::string name;
+    auto next = rules_.Apply(res, &name);
+    if (!next) {
+      break;
+    }
+    hit_num_++;
+    hits_[name]++;
+    ILA_DLOG("FuncObjRuleRewr") << name << ": " << res << " -> " << next;
+
+    if (pre(next)) {
+      res = get(next);
+      break;
+    }
+    for (size_t i = 0; i != next->arg_num(); i++) {
+      next->arg(i)->DepthFirstVisitPrePost(*this);
+    }
+    res = Rebuild(next);
+  }
+
+  rule_.emplace(e, res);
+}
+
+size_t FuncObjRuleRewr::hit_num(const std::string& name) const {
+  auto pos = hits_.find(name);
+  return (pos == hits_.end()) ? 0 : pos->second;
+}
+
+ExprPtr FuncObjRuleRewr::Rebuild(const ExprPtr& e) const {
+  // only create a new node if any argument has been rewritten
+  for (size_t i = 0; i != e->arg_num(); i++) {
+    if (get(e->arg(i)) != e->arg(i)) {
+      return Rewrite(e);
+    }
+  }
+  return e;
+}
+
+} // namespace ilang
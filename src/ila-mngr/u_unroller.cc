@@ -3,11 +3,16 @@
 
 #include <ilang/ila-mngr/u_unroller.h>
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <vector>
 
 #include <ilang/ila-mngr/u_abs_knob.h>
+#include <ilang/target-smt/z3_lazy_mem.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
+#include <ilang/util/z3_helper.h>
 
 namespace ilang {
 
@@ -47,6 +52,13 @@ void Unroller::ClearPred() {
   ClearStepPred();
 }
 
+void Unroller::AddLazyMem(const ExprPtr& mem) {
+  ILA_ASSERT(mem->is_var() && mem->is_mem()) << mem << " is not a memory";
+  lazy_mem_.push_back(mem);
+}
+
+void Unroller::ClearLazyMem() { lazy_mem_.clear(); }
+
 ZExpr Unroller::CurrState(const ExprPtr& v, const int& t) {
   ILA_ASSERT(v->is_var()) << "Use GetZ3Expr for non-var Expr";
   return gen().GetExpr(v, SuffCurr(t));
@@ -77,6 +89,8 @@ z3::func_decl Unroller::GetZ3FuncDecl(const FuncPtr& f) const {
 }
 
 ZExpr Unroller::UnrollSubs(const size_t& len, const int& pos) {
+  ILA_TRACE_SCOPE("unroll.subs");
+  ILA_GAUGE("unroll.length", len);
   // bootstrap basic information
   BootStrap(pos);
 
@@ -124,10 +138,12 @@ ZExpr Unroller::UnrollSubs(const size_t& len, const int& pos) {
 
   // accumulate all constraints and return
   auto cstr = ConjPred(cstr_);
-  return cstr;
+  return EncodeMem(cstr);
 }
 
 ZExpr Unroller::UnrollAssn(const size_t& len, const int& pos, bool cache) {
+  ILA_TRACE_SCOPE("unroll.assn");
+  ILA_GAUGE("unroll.length", len);
   // bootstrap basic information
   BootStrap(pos, cache);
 
@@ -165,10 +181,12 @@ ZExpr Unroller::UnrollAssn(const size_t& len, const int& pos, bool cache) {
 
   // accumulate all constraints and return
   auto cstr = ConjPred(cstr_);
-  return cstr;
+  return EncodeMem(cstr);
 }
 
 ZExpr Unroller::UnrollNone(const size_t& len, const int& pos) {
+  ILA_TRACE_SCOPE("unroll.none");
+  ILA_GAUGE("unroll.length", len);
   // bootstrap basic information
   BootStrap(pos);
 
@@ -200,7 +218,39 @@ ZExpr Unroller::UnrollNone(const size_t& len, const int& pos) {
 
   // accumulate all constraints and return
   auto cstr = ConjPred(cstr_);
-  return cstr;
+  return EncodeMem(cstr);
+}
+
+void Unroller::UnrollStepBegin(const int& pos) { BootStrap(pos); }
+
+ZExpr Unroller::StepState(const size_t& k, const int& pos) {
+  auto k_suffix = SuffCurr(pos + k);
+  auto cstr = ZExprVec(ctx());
+  IExprToZExpr(g_pred_, k_suffix, cstr);
+  IExprToZExpr(s_pred_[k], k_suffix, cstr);
+  return ConjPred(cstr);
+}
+
+ZExpr Unroller::StepTrans(const size_t& k, const int& pos) {
+  auto k_suffix = SuffCurr(pos + k);
+  auto cstr = ZExprVec(ctx());
+
+  // get transition relation (k_next_) and step-specific predicate (k_pred_)
+  Transition(k);
+  if (k == 0) {
+    IExprToZExpr(i_pred_, k_suffix, cstr);
+  }
+  IExprToZExpr(k_pred_, k_suffix, cstr);
+
+  // equal between next state value and the state var of the next step
+  Clear(k_next_z3_);
+  IExprToZExpr(k_next_, k_suffix, k_next_z3_);
+  ILA_ASSERT(k_next_z3_.size() == vars_.size()) << "Var num mismatch.";
+  for (unsigned i = 0; i != k_next_z3_.size(); i++) {
+    auto next_var = gen().GetExpr(vars_[i], SuffCurr(pos + k + 1));
+    cstr.push_back(k_next_z3_[i] == next_var);
+  }
+  return ConjPred(cstr);
 }
 
 ExprPtr Unroller::StateUpdCmpl(const InstrPtr& instr, const ExprPtr& var) {
@@ -230,6 +280,8 @@ ExprPtr Unroller::NewFreeVar(const ExprPtr& var, const std::string& name) {
 
 void Unroller::BootStrap(const int& pos, bool cache) {
   if (!cache) {
+    // drop the variables cached by earlier unrollings
+    gen().ClearCache();
     vars_.clear();
     k_pred_.clear();
     k_next_.clear();
@@ -303,12 +355,34 @@ void Unroller::CopyZExprVec(const ZExprVec& src, ZExprVec& dst) {
 }
 
 ZExpr Unroller::ConjPred(const ZExprVec& vec) const {
-  auto conj = ctx().bool_val(true);
-  for (size_t i = 0; i != vec.size(); i++) {
-    conj = (conj && vec[i]);
+  return Z3AndAll(ctx(), vec);
+}
+
+ZExpr Unroller::EncodeMem(const ZExpr& cstr) const {
+  ILA_TRACE_SCOPE("unroll.lazy_mem");
+  if (lazy_mem_.empty()) {
+    return cstr;
+  }
+
+  // the z3 variables of a memory (in all steps) share the name prefix
+  std::vector<std::string> prefixes;
+  for (const auto& mem : lazy_mem_) {
+    auto host = mem->host();
+    auto root = (host) ? host->GetRootName() : "";
+    prefixes.push_back(mem->name().format_str(root, "") + "_sEp_");
   }
-  conj = conj.simplify();
-  return conj;
+  auto filter = [&prefixes](const z3::expr& e) {
+    auto name = e.decl().name().str();
+    for (const auto& p : prefixes) {
+      if (name.compare(0, p.size(), p) == 0) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto encoder = Z3LazyMemEncoder(ctx(), filter);
+  return encoder.Encode(cstr);
 }
 
 /******************************************************************************/
@@ -337,6 +411,78 @@ ZExpr PathUnroll::PathNone(const InstrVec& seq, const int& pos) {
   return UnrollNone(seq.size(), pos);
 }
 
+std::vector<z3::check_result>
+PathUnroll::PathAssnBatch(const std::vector<InstrVec>& seqs,
+                          z3::solver& solver, const ExprPtrVec& props,
+                          const int& pos) {
+  ILA_ASSERT(props.empty() || props.size() == seqs.size())
+      << "Assumptions mismatch with the sequences.";
+
+  // build the prefix trie (node 0 is the root)
+  struct TrieNode {
+    std::vector<std::pair<InstrPtr, size_t>> edges;
+    std::vector<size_t> ends;
+  };
+  auto trie = std::vector<TrieNode>(1);
+  for (size_t i = 0; i != seqs.size(); i++) {
+    size_t node = 0;
+    for (auto& instr : seqs[i]) {
+      auto& edges = trie[node].edges;
+      auto it = std::find_if(edges.begin(), edges.end(),
+                             [&instr](const std::pair<InstrPtr, size_t>& e) {
+                               return e.first == instr;
+                             });
+      if (it != edges.end()) {
+        node = it->second;
+      } else {
+        edges.push_back({instr, trie.size()});
+        node = trie.size();
+        trie.emplace_back();
+      }
+    }
+    trie[node].ends.push_back(i);
+  }
+
+  // state vars are the union of all sequences
+  seq_.clear();
+  for (auto& seq : seqs) {
+    seq_.insert(seq_.end(), seq.begin(), seq.end());
+  }
+  UnrollStepBegin(pos);
+
+  // depth-first walk, seq_ holds the path from the root
+  auto results = std::vector<z3::check_result>(seqs.size(), z3::unknown);
+  std::function<void(const size_t&)> Walk = [&](const size_t& node) {
+    auto depth = seq_.size();
+    solver.add(StepState(depth, pos));
+
+    // check sequences ending at this node
+    for (auto& i : trie[node].ends) {
+      auto assumptions = ZExprVec(solver.ctx());
+      if (!props.empty()) {
+        assumptions.push_back(GetZ3Expr(props[i], pos + depth));
+      }
+      results[i] = solver.check(assumptions);
+    }
+
+    // extend each edge under its own scope
+    for (auto& [instr, child] : trie[node].edges) {
+      seq_.push_back(instr);
+      solver.push();
+      solver.add(StepTrans(depth, pos));
+      Walk(child);
+      solver.pop();
+      seq_.pop_back();
+    }
+  };
+
+  solver.push();
+  seq_.clear();
+  Walk(0);
+  solver.pop();
+  return results;
+}
+
 void PathUnroll::DefineDepVar() {
   // collect the set of vars
   auto dep_var = ExprSet();
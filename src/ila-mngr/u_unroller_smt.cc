@@ -3,9 +3,12 @@
 
 #include <ilang/ila-mngr/u_unroller_smt.h>
 
+#include <type_traits>
+
 #include <ilang/ila-mngr/u_abs_knob.h>
 #include <ilang/target-smt/smt_switch_itf.h>
 #include <ilang/target-smt/z3_expr_adapter.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -16,20 +19,26 @@ namespace ilang {
 template <class Generator>
 typename UnrollerSmt<Generator>::SmtExpr
 UnrollerSmt<Generator>::Unroll_(const size_t& len, const size_t& begin) {
+  ILA_TRACE_SCOPE("unroll.smt");
   // reset to clean starting state
   deciding_vars_.clear();
   update_holder_.clear();
   assert_holder_.clear();
+  frame_holder_.clear();
+  // drop the variables cached by earlier unrollings (z3 only, smt-switch
+  // terms must not be re-created)
+  if constexpr (std::is_same<Generator, Z3ExprAdapter>::value) {
+    smt_gen_.get().ClearCache();
+  }
 
   // setup deciding variable (and the order)
   SetDecidingVars();
   ILA_ASSERT(!deciding_vars_.empty());
 
-  // placeholder for generated SMT terms
-  SmtExprVec smt_holder;
-
   // unroll each step
   for (size_t i = 0; i < len; i++) {
+    // placeholder for generated SMT terms of this step
+    SmtExprVec smt_holder;
     auto suffix = SuffixCurrent(begin + i);
     auto suffix_next = SuffixCurrent(begin + i + 1);
 
@@ -51,15 +60,20 @@ UnrollerSmt<Generator>::Unroll_(const size_t& len, const size_t& begin) {
     InterpIlaExprAndAppend(update_holder_, suffix, smt_next_val);
     InterpIlaExprAndAppend(deciding_vars_, suffix_next, smt_next_var);
     ElementWiseEqualAndAppend(smt_next_val, smt_next_var, smt_holder);
+
+    frame_holder_.push_back(ConjunctAll(smt_holder));
   }
 
   { // take care of the end state
+    SmtExprVec smt_holder;
     auto suffix = SuffixCurrent(len);
     InterpIlaExprAndAppend(global_pred_, suffix, smt_holder);
     InterpIlaExprAndAppend(step_pred_[len], suffix, smt_holder);
+    frame_holder_.push_back(ConjunctAll(smt_holder));
   }
 
-  return ConjunctAll(smt_holder);
+  // n-ary conjunction of the steps (shallow, unlike a chain of binary and)
+  return ConjunctAll(frame_holder_);
 }
 
 template <class Generator>
@@ -4,6 +4,7 @@
 #include <ilang/ila-mngr/v_eq_check_legacy_bmc.h>
 
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 #include <ilang/util/z3_helper.h>
 
 namespace ilang {
@@ -18,6 +19,7 @@ void LegacyBmc::AddInvariant(ExprPtr inv) { invs_.push_back(inv); }
 
 z3::check_result LegacyBmc::Check(InstrLvlAbsPtr m0, const int& k0,
                                   InstrLvlAbsPtr m1, const int& k1) {
+  ILA_TRACE_SCOPE("check.legacy_bmc");
   ILA_NOT_NULL(m0);
   ILA_NOT_NULL(m1);
 
@@ -82,10 +84,10 @@ z3::check_result LegacyBmc::Check(InstrLvlAbsPtr m0, const int& k0,
     solver.add(inv_e);
   }
 
-  auto result = solver.check();
+  auto result = (portfolio_) ? portfolio_->Check(solver) : solver.check();
 
   if (result == z3::sat) {
-    auto m = solver.get_model();
+    auto m = (portfolio_) ? portfolio_->GetModel(ctx_) : solver.get_model();
     ILA_DLOG("Bmc.Legacy") << m;
   }
 
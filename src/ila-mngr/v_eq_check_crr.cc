@@ -8,6 +8,7 @@
 #include <ilang/ila-mngr/u_abs_knob.h>
 #include <ilang/ila-mngr/u_unroller.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 #include <ilang/util/z3_helper.h>
 
 namespace ilang {
@@ -27,6 +28,15 @@ CommDiag::CommDiag(z3::context& ctx, const CrrPtr crr) : ctx_(ctx), crr_(crr) {
 
 CommDiag::~CommDiag() {}
 
+z3::check_result CommDiag::Check(z3::solver& s) const {
+  ILA_TRACE_SCOPE("check.crr_query");
+  return (portfolio_) ? portfolio_->Check(s) : s.check();
+}
+
+z3::model CommDiag::GetModel(z3::solver& s) const {
+  return (portfolio_) ? portfolio_->GetModel(ctx_) : s.get_model();
+}
+
 bool CommDiag::EqCheck(const int& max) {
   // refinement relation sanity check
   auto sc_res = SanityCheck();
@@ -51,14 +61,14 @@ bool CommDiag::EqCheck(const int& max) {
 
   auto s = z3::solver(ctx_);
   s.add(cstr_tran_a);
-  if (s.check() == z3::unsat) {
+  if (Check(s) == z3::unsat) {
     ILA_ERROR << "Dead transition relation.";
     ILA_DLOG("Verbose-CrrEqCheck") << s;
     return false;
   }
   s.reset();
   s.add(cstr_tran_b);
-  if (s.check() == z3::unsat) {
+  if (Check(s) == z3::unsat) {
     ILA_ERROR << "Dead transition relation.";
     ILA_DLOG("Verbose-CrrEqCheck") << s;
     return false;
@@ -74,9 +84,9 @@ bool CommDiag::EqCheck(const int& max) {
   // check
   s.add(cstr_tran_a && cstr_tran_b && cstr_assm);
   s.add(!cstr_prop);
-  auto res = s.check();
+  auto res = Check(s);
   if (res == z3::sat) {
-    ILA_DLOG("Verbose-CrrEqCheck") << s.get_model();
+    ILA_DLOG("Verbose-CrrEqCheck") << GetModel(s);
   }
 
   return (res == z3::unsat);
@@ -145,7 +155,7 @@ bool CommDiag::IncCheck(const int& min, const int& max, const int& step) {
     // check prop
     s.add(assm);
     s.add(!prop);
-    auto res = s.check();
+    auto res = Check(s);
     ILA_INFO << "Result: " << res;
     if (res == z3::sat) {
       return false;
@@ -403,10 +413,10 @@ bool CommDiag::IncEqCheck(const int& min, const int& max, const int& step) {
     s.add(!prop);
     ILA_INFO << "Start checking " << num_old_a << " " << num_new_a << " "
              << num_old_b << " " << num_new_b;
-    auto res = s.check();
+    auto res = Check(s);
     ILA_INFO << "Result: " << res;
     if (res == z3::sat) {
-      auto m = s.get_model();
+      auto m = GetModel(s);
 
       ILA_WARN << "Model A";
       for (auto it = stts_a.begin(); it != stts_a.end(); it++) {
@@ -505,8 +515,8 @@ bool CommDiag::SanityCheckRefinement(const RefPtr ref) {
   auto exc = g.GetExpr(And(f, a));
   s.reset();
   s.add(exc);
-  if (s.check() == z3::sat) {
-    ILA_DLOG("Verbose-CrrEqCheck") << s.get_model();
+  if (Check(s) == z3::sat) {
+    ILA_DLOG("Verbose-CrrEqCheck") << GetModel(s);
     ILA_ERROR << "Non-exclusive flushing function and apply function.";
     return false;
   }
@@ -516,7 +526,7 @@ bool CommDiag::SanityCheckRefinement(const RefPtr ref) {
     auto cmpl_unique = g.GetExpr(Imply(f, c));
     s.reset();
     s.add(!cmpl_unique);
-    if (s.check() == z3::unsat) {
+    if (Check(s) == z3::unsat) {
       ILA_ERROR << "Flushing function implies completion.";
       return false;
     }
@@ -534,9 +544,9 @@ bool CommDiag::SanityCheckRefinement(const RefPtr ref) {
   }
   s.add(z3::forall(appl_z3, an && !init));
   // s.add(an && !(fo && an && eq));
-  if (s.check() == z3::sat) {
+  if (Check(s) == z3::sat) {
     ILA_ERROR << "Flushing and apply function intervene state equivalence.";
-    ILA_DLOG("Verbose-CrrEqCheck") << s.get_model();
+    ILA_DLOG("Verbose-CrrEqCheck") << GetModel(s);
     return false;
   }
 
@@ -614,7 +624,7 @@ bool CommDiag::CheckStepOrig(const RefPtr ref, const int& k) {
   auto s = z3::solver(ctx_);
   // sanity check on transition
   s.add(init && tran);
-  if (s.check() == z3::unsat) {
+  if (Check(s) == z3::unsat) {
     ILA_ERROR << "Dead transition: " << ref->coi() << " #step: " << k;
     ILA_DLOG("Verbose-CrrEqCheck") << s;
     ILA_CHECK(false);
@@ -624,13 +634,13 @@ bool CommDiag::CheckStepOrig(const RefPtr ref, const int& k) {
   auto at_least_once = AtLeastOnce(u, ref->cmpl(), 0, k);
   s.reset();
   s.add(init && tran && !at_least_once);
-  if (s.check() == z3::sat) {
+  if (Check(s) == z3::sat) {
     return false;
   }
   // at most once
   auto at_most_once = AtMostOnce(u, ref->cmpl(), 0, k);
   s.add(init && tran && !at_most_once);
-  if (s.check() == z3::sat) {
+  if (Check(s) == z3::sat) {
     return false;
   }
   // valid #unroll step
@@ -657,13 +667,13 @@ bool CommDiag::CheckStepAppl(const RefPtr ref, const int& k) {
   auto at_least_once = AtLeastOnce(u, ref->cmpl(), 1, k + 1);
   s.reset();
   s.add(init && tran && !at_least_once);
-  if (s.check() == z3::sat) {
+  if (Check(s) == z3::sat) {
     return false;
   }
   // at most once
   auto at_most_once = AtMostOnce(u, ref->cmpl(), 1, k + 1);
   s.add(init && tran && !at_most_once);
-  if (s.check() == z3::sat) {
+  if (Check(s) == z3::sat) {
     return false;
   }
   // valid #unroll step
@@ -773,7 +783,7 @@ z3::expr CommDiag::GetZ3IncUnrl(MonoUnroll& un, const RefPtr ref,
 bool CommDiag::CheckCmpl(z3::solver& s, z3::expr& cmpl_expr) const {
   s.push();
   s.add(!cmpl_expr);
-  auto must_cmpl = (s.check() == z3::unsat);
+  auto must_cmpl = (Check(s) == z3::unsat);
   s.pop();
 
   if (must_cmpl) {
@@ -4,20 +4,33 @@
 #include <ilang/ila/ast/expr.h>
 
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
-Expr::Expr() {}
+Expr::Expr() { ILA_COUNT("ast.expr", 1); }
 
-Expr::Expr(const std::string& name) : Ast(name) {}
+Expr::Expr(const std::string& name) : Ast(name) { ILA_COUNT("ast.expr", 1); }
 
 Expr::~Expr() {}
 
 void Expr::set_sort(const SortPtr sort) { sort_ = sort; }
 
-void Expr::set_args(const ExprPtrVec& args) { args_ = args; }
+void Expr::set_args(const ExprPtrVec& args) {
+  args_.assign(args.begin(), args.end());
+}
+
+void Expr::set_args(std::initializer_list<ExprPtr> args) {
+  args_.assign(args.begin(), args.end());
+}
 
-void Expr::set_params(const std::vector<int> params) { params_ = params; }
+void Expr::set_params(const std::vector<int> params) {
+  params_.assign(params.begin(), params.end());
+}
+
+void Expr::set_params(std::initializer_list<int> params) {
+  params_.assign(params.begin(), params.end());
+}
 
 void Expr::replace_arg(const int& idx, const ExprPtr& arg) {
   args_.at(idx) = arg;
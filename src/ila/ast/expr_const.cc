@@ -4,6 +4,7 @@
 #include <ilang/ila/ast/expr_const.h>
 
 #include <ilang/util/log.h>
+#include <ilang/util/mem_pool.h>
 #include <ilang/util/z3_helper.h>
 
 /// \namespace ilang
@@ -11,7 +12,7 @@ namespace ilang {
 
 ExprConst::ExprConst(const BoolVal& bool_val) {
   set_sort(Sort::MakeBoolSort());
-  val_ = std::make_shared<BoolVal>(bool_val);
+  val_ = PoolNew<BoolVal>(bool_val);
 }
 
 ExprConst::ExprConst(const BvVal& bv_val, const int& bit_width) {
@@ -28,13 +29,13 @@ ExprConst::ExprConst(const BvVal& bv_val, const int& bit_width) {
       << "Define a " << bit_width << "-bit constant " << bv_val;
 
   set_sort(Sort::MakeBvSort(bit_width));
-  val_ = std::make_shared<BvVal>(bv_val);
+  val_ = PoolNew<BvVal>(bv_val);
 }
 
 ExprConst::ExprConst(const MemVal& mem_val, const int& addr_width,
                      const int& data_width) {
   set_sort(Sort::MakeMemSort(addr_width, data_width));
-  val_ = std::make_shared<MemVal>(mem_val);
+  val_ = PoolNew<MemVal>(mem_val);
 }
 
 ExprConst::~ExprConst() {}
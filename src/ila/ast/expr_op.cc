@@ -3,7 +3,7 @@
 
 #include <ilang/ila/ast/expr_op.h>
 
-#include <set>
+#include <algorithm>
 #include <unordered_map>
 
 #include <ilang/ila/ast/func.h>
@@ -50,54 +50,58 @@ static const std::unordered_map<AstUidExprOp, std::string> kOpName{
 
 // ------------------------- Class ExprOp ----------------------------------- //
 
-ExprOp::ExprOp(const ExprPtr& arg) {
+ExprOp::ExprOp(const AstUidExprOp& uid, const ExprPtr& arg) : uid_(uid) {
   // arg
   set_args({arg});
   // host
-  set_host(GetHost({arg}));
+  set_host(GetHost());
 }
 
-ExprOp::ExprOp(const ExprPtr& arg0, const ExprPtr& arg1) {
+ExprOp::ExprOp(const AstUidExprOp& uid, const ExprPtr& arg0,
+               const ExprPtr& arg1)
+    : uid_(uid) {
   // args
   set_args({arg0, arg1});
   // set host
-  set_host(GetHost({arg0, arg1}));
+  set_host(GetHost());
 }
 
-ExprOp::ExprOp(const ExprPtr& arg0, const ExprPtr& arg1, const ExprPtr& arg2) {
+ExprOp::ExprOp(const AstUidExprOp& uid, const ExprPtr& arg0,
+               const ExprPtr& arg1, const ExprPtr& arg2)
+    : uid_(uid) {
   // args
   set_args({arg0, arg1, arg2});
   // set host
-  set_host(GetHost({arg0, arg1, arg2}));
+  set_host(GetHost());
 }
 
-ExprOp::ExprOp(const ExprPtr& arg0, const int& param1) {
+ExprOp::ExprOp(const AstUidExprOp& uid, const ExprPtr& arg0, const int& param1)
+    : uid_(uid) {
   // args
   set_args({arg0});
   // params
   set_params({param1});
   // set host
-  set_host(GetHost({arg0}));
+  set_host(GetHost());
 }
 
-ExprOp::ExprOp(const ExprPtr& arg0, const int& param1, const int& param2) {
+ExprOp::ExprOp(const AstUidExprOp& uid, const ExprPtr& arg0,
+               const int& param1, const int& param2)
+    : uid_(uid) {
   // args
   set_args({arg0});
   // params
   set_params({param1, param2});
   // set hsot
-  set_host(GetHost({arg0}));
+  set_host(GetHost());
 }
 
-ExprOp::ExprOp(const ExprPtrVec& args) {
+ExprOp::ExprOp(const AstUidExprOp& uid, const ExprPtrVec& args)
+    : uid_(uid) {
   // args
   set_args(args);
   // host
-  auto args_set = ExprSet();
-  for (const auto& arg_i : args) {
-    args_set.insert(arg_i);
-  }
-  set_host(GetHost(args_set));
+  set_host(GetHost());
 }
 
 ExprOp::~ExprOp() {}
@@ -128,15 +132,21 @@ SortPtr ExprOp::GetSortBinaryComparison(const ExprPtr& e0, const ExprPtr& e1) {
   return Sort::MakeBoolSort();
 }
 
-ExprOp::InstrLvlAbsPtr ExprOp::GetHost(const ExprSet& args) const {
-  // get all hosts
-  std::set<InstrLvlAbsPtr> hosts;
-  for (const auto& arg_i : args) {
-    auto host_i = arg_i->host();
-    if (host_i) {
-      hosts.insert(host_i);
+ExprOp::InstrLvlAbsPtr ExprOp::GetHost() const {
+  // get all hosts (ordered and unique, as in std::set)
+  SmallVec<InstrLvlAbsPtr, 3> hosts;
+  for (size_t i = 0; i != arg_num(); i++) {
+    auto host_i = arg(i)->host();
+    if (host_i &&
+        std::find(hosts.begin(), hosts.end(), host_i) == hosts.end()) {
+      hosts.push_back(host_i);
     }
   }
+  if (hosts.size() == 1) {
+    return hosts[0];
+  }
+  std::sort(hosts.begin(), hosts.end());
+
   // find host with no child in the hosts ("one of" the leaf hosts)
   InstrLvlAbsPtr leaf = nullptr;
   for (const auto& host_i : hosts) {
@@ -146,7 +156,8 @@ ExprOp::InstrLvlAbsPtr ExprOp::GetHost(const ExprSet& args) const {
       auto is_leaf = true;
       for (decltype(host_i->child_num()) j = 0; j != host_i->child_num(); j++) {
         auto child_ij = host_i->child(j);
-        is_leaf &= (hosts.find(child_ij) == hosts.end());
+        is_leaf &=
+            (std::find(hosts.begin(), hosts.end(), child_ij) == hosts.end());
       }
       if (is_leaf) {
         return host_i;
@@ -157,7 +168,7 @@ ExprOp::InstrLvlAbsPtr ExprOp::GetHost(const ExprSet& args) const {
 }
 
 // ------------------------- Class ExprOpNeg -------------------------------- //
-ExprOpNeg::ExprOpNeg(const ExprPtr& arg) : ExprOp(arg) {
+ExprOpNeg::ExprOpNeg(const ExprPtr& arg) : ExprOp(AstUidExprOp::kNegate, arg) {
   ILA_ASSERT(arg->is_bv()) << "Negate can only be applied to bitvector.";
   set_sort(arg->sort());
 }
@@ -169,7 +180,7 @@ z3::expr ExprOpNeg::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 }
 
 // ------------------------- Class ExprOpNot -------------------------------- //
-ExprOpNot::ExprOpNot(const ExprPtr& arg) : ExprOp(arg) {
+ExprOpNot::ExprOpNot(const ExprPtr& arg) : ExprOp(AstUidExprOp::kNot, arg) {
   ILA_ASSERT(arg->is_bool()) << "Not can only be applied to bool.";
   set_sort(arg->sort());
 }
@@ -181,7 +192,8 @@ z3::expr ExprOpNot::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 }
 
 // ------------------------- Class ExprOpCompl ------------------------------ //
-ExprOpCompl::ExprOpCompl(const ExprPtr& arg) : ExprOp(arg) {
+ExprOpCompl::ExprOpCompl(const ExprPtr& arg)
+    : ExprOp(AstUidExprOp::kComplement, arg) {
   ILA_ASSERT(arg->is_bv()) << "Complement can only be applied to bitvector.";
   set_sort(arg->sort());
 }
@@ -194,7 +206,7 @@ z3::expr ExprOpCompl::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpAnd -------------------------------- //
 ExprOpAnd::ExprOpAnd(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kAnd, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -211,7 +223,7 @@ z3::expr ExprOpAnd::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpOr --------------------------------- //
 ExprOpOr::ExprOpOr(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kOr, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -228,7 +240,7 @@ z3::expr ExprOpOr::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpXor -------------------------------- //
 ExprOpXor::ExprOpXor(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kXor, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -247,7 +259,8 @@ z3::expr ExprOpXor::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 }
 
 // ------------------------- Class ExprOpShl -------------------------------- //
-ExprOpShl::ExprOpShl(const ExprPtr& bv, const ExprPtr& n) : ExprOp(bv, n) {
+ExprOpShl::ExprOpShl(const ExprPtr& bv, const ExprPtr& n)
+    : ExprOp(AstUidExprOp::kShiftLeft, bv, n) {
   ILA_ASSERT(bv->is_bv()) << "Left shift can only be applied to bit-vectors.";
   set_sort(GetSortBinaryOperation(bv, n));
 }
@@ -259,7 +272,8 @@ z3::expr ExprOpShl::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 }
 
 // ------------------------- Class ExprOpAshr ------------------------------- //
-ExprOpAshr::ExprOpAshr(const ExprPtr& bv, const ExprPtr& n) : ExprOp(bv, n) {
+ExprOpAshr::ExprOpAshr(const ExprPtr& bv, const ExprPtr& n)
+    : ExprOp(AstUidExprOp::kArithShiftRight, bv, n) {
   ILA_ASSERT(bv->is_bv()) << "Right shift can only be applied to bit-vectors.";
   set_sort(GetSortBinaryOperation(bv, n));
 }
@@ -271,7 +285,8 @@ z3::expr ExprOpAshr::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 }
 
 // ------------------------- Class ExprOpLshr ------------------------------- //
-ExprOpLshr::ExprOpLshr(const ExprPtr& bv, const ExprPtr& n) : ExprOp(bv, n) {
+ExprOpLshr::ExprOpLshr(const ExprPtr& bv, const ExprPtr& n)
+    : ExprOp(AstUidExprOp::kLogicShiftRight, bv, n) {
   ILA_ASSERT(bv->is_bv()) << "Right shift can only be applied to bit-vectors.";
   set_sort(GetSortBinaryOperation(bv, n));
 }
@@ -284,7 +299,7 @@ z3::expr ExprOpLshr::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpAdd -------------------------------- //
 ExprOpAdd::ExprOpAdd(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kAdd, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -297,7 +312,7 @@ z3::expr ExprOpAdd::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpSub -------------------------------- //
 ExprOpSub::ExprOpSub(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kSubtract, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -310,7 +325,7 @@ z3::expr ExprOpSub::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpDiv ------------------------------- //
 ExprOpDiv::ExprOpDiv(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kDivide, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -323,7 +338,7 @@ z3::expr ExprOpDiv::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpSRem ------------------------------- //
 ExprOpSRem::ExprOpSRem(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kSignedRemainder, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -336,7 +351,7 @@ z3::expr ExprOpSRem::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpURem ------------------------------- //
 ExprOpURem::ExprOpURem(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kUnsignedRemainder, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -349,7 +364,7 @@ z3::expr ExprOpURem::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpSMod ------------------------------- //
 ExprOpSMod::ExprOpSMod(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kSignedModular, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -362,7 +377,7 @@ z3::expr ExprOpSMod::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpMul ------------------------------- //
 ExprOpMul::ExprOpMul(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kMultiply, arg0, arg1) {
   set_sort(GetSortBinaryOperation(arg0, arg1));
 }
 
@@ -375,7 +390,7 @@ z3::expr ExprOpMul::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpEq --------------------------------- //
 ExprOpEq::ExprOpEq(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kEqual, arg0, arg1) {
   set_sort(GetSortBinaryComparison(arg0, arg1));
 }
 
@@ -387,7 +402,7 @@ z3::expr ExprOpEq::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpLt --------------------------------- //
 ExprOpLt::ExprOpLt(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kLessThan, arg0, arg1) {
   set_sort(GetSortBinaryComparison(arg0, arg1));
 }
 
@@ -399,7 +414,7 @@ z3::expr ExprOpLt::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpGt --------------------------------- //
 ExprOpGt::ExprOpGt(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kGreaterThan, arg0, arg1) {
   set_sort(GetSortBinaryComparison(arg0, arg1));
 }
 
@@ -411,7 +426,7 @@ z3::expr ExprOpGt::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpUlt -------------------------------- //
 ExprOpUlt::ExprOpUlt(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kUnsignedLessThan, arg0, arg1) {
   set_sort(GetSortBinaryComparison(arg0, arg1));
 }
 
@@ -423,7 +438,7 @@ z3::expr ExprOpUlt::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpUgt -------------------------------- //
 ExprOpUgt::ExprOpUgt(const ExprPtr& arg0, const ExprPtr& arg1)
-    : ExprOp(arg0, arg1) {
+    : ExprOp(AstUidExprOp::kUnsignedGreaterThan, arg0, arg1) {
   set_sort(GetSortBinaryComparison(arg0, arg1));
 }
 
@@ -435,7 +450,7 @@ z3::expr ExprOpUgt::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpLoad ------------------------------- //
 ExprOpLoad::ExprOpLoad(const ExprPtr& mem, const ExprPtr& addr)
-    : ExprOp(mem, addr) {
+    : ExprOp(AstUidExprOp::kLoad, mem, addr) {
   ILA_ASSERT(mem->sort()->addr_width() == addr->sort()->bit_width());
   // sort should be the data sort of the mem
   auto data_sort = Sort::MakeBvSort(mem->sort()->data_width());
@@ -451,7 +466,7 @@ z3::expr ExprOpLoad::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 // ------------------------- Class ExprOpLoad ------------------------------- //
 ExprOpStore::ExprOpStore(const ExprPtr& mem, const ExprPtr& addr,
                          const ExprPtr& data)
-    : ExprOp(mem, addr, data) {
+    : ExprOp(AstUidExprOp::kStore, mem, addr, data) {
   ILA_ASSERT(mem->sort()->addr_width() == addr->sort()->bit_width());
   ILA_ASSERT(mem->sort()->data_width() == data->sort()->bit_width());
   set_sort(mem->sort());
@@ -468,7 +483,7 @@ z3::expr ExprOpStore::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpConcat ----------------------------- //
 ExprOpConcat::ExprOpConcat(const ExprPtr& hi, const ExprPtr& lo)
-    : ExprOp(hi, lo) {
+    : ExprOp(AstUidExprOp::kConcatenate, hi, lo) {
   ILA_ASSERT(hi->is_bv()) << "Concat non-bv var " << hi;
   ILA_ASSERT(lo->is_bv()) << "Concat non-bv var " << lo;
   set_sort(Sort::MakeBvSort(hi->sort()->bit_width() + lo->sort()->bit_width()));
@@ -484,7 +499,7 @@ z3::expr ExprOpConcat::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpExtract ---------------------------- //
 ExprOpExtract::ExprOpExtract(const ExprPtr& bv, const int& hi, const int& lo)
-    : ExprOp(bv, hi, lo) {
+    : ExprOp(AstUidExprOp::kExtract, bv, hi, lo) {
   ILA_ASSERT(bv->is_bv()) << "Extract can only be applied to bitvector.";
   ILA_ASSERT(hi >= lo) << "Invalid boundary for extraction.";
   set_sort(Sort::MakeBvSort(hi - lo + 1));
@@ -502,7 +517,7 @@ z3::expr ExprOpExtract::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpZExt ------------------------------- //
 ExprOpZExt::ExprOpZExt(const ExprPtr& bv, const int& bit_width)
-    : ExprOp(bv, bit_width) {
+    : ExprOp(AstUidExprOp::kZeroExtend, bv, bit_width) {
   ILA_ASSERT(bv->is_bv()) << "Zero-extend can only be applied to bit-vector.";
   ILA_ASSERT(bit_width >= bv->sort()->bit_width());
   set_sort(Sort::MakeBvSort(bit_width));
@@ -520,7 +535,7 @@ z3::expr ExprOpZExt::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpSExt ------------------------------- //
 ExprOpSExt::ExprOpSExt(const ExprPtr& bv, const int& bit_width)
-    : ExprOp(bv, bit_width) {
+    : ExprOp(AstUidExprOp::kSignedExtend, bv, bit_width) {
   ILA_ASSERT(bv->is_bv()) << "Sign-extend can only be applied to bit-vector.";
   ILA_ASSERT(bit_width >= bv->sort()->bit_width());
   set_sort(Sort::MakeBvSort(bit_width));
@@ -538,7 +553,7 @@ z3::expr ExprOpSExt::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpLRotate ---------------------------- //
 ExprOpLRotate::ExprOpLRotate(const ExprPtr& bv, const int& immediate)
-    : ExprOp(bv, immediate) {
+    : ExprOp(AstUidExprOp::kRotateLeft, bv, immediate) {
   ILA_ASSERT(bv->is_bv()) << "Left-rotate can only be applied to bit-vector.";
   ILA_ASSERT(immediate >= 0) << "Invalid number of times to rotate.";
   set_sort(bv->sort());
@@ -555,7 +570,7 @@ z3::expr ExprOpLRotate::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpRRotate ---------------------------- //
 ExprOpRRotate::ExprOpRRotate(const ExprPtr& bv, const int& immediate)
-    : ExprOp(bv, immediate) {
+    : ExprOp(AstUidExprOp::kRotateRight, bv, immediate) {
   ILA_ASSERT(bv->is_bv()) << "Right-rotate can only be applied to bit-vector.";
   ILA_ASSERT(immediate >= 0) << "Invalid number of times to rotate.";
   set_sort(bv->sort());
@@ -572,7 +587,7 @@ z3::expr ExprOpRRotate::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpAppFunc ---------------------------- //
 ExprOpAppFunc::ExprOpAppFunc(const FuncPtr& _f, const ExprPtrVec& args)
-    : ExprOp(args), f(_f) {
+    : ExprOp(AstUidExprOp::kApplyFunc, args), f(_f) {
   ILA_ASSERT(_f->CheckSort(args));
   set_sort(_f->out());
 }
@@ -590,7 +605,7 @@ z3::expr ExprOpAppFunc::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 
 // ------------------------- Class ExprOpImply ------------------------------ //
 ExprOpImply::ExprOpImply(const ExprPtr& ante, const ExprPtr& cons)
-    : ExprOp(ante, cons) {
+    : ExprOp(AstUidExprOp::kImply, ante, cons) {
   ILA_ASSERT(ante->is_bool()) << "Antecedent must be Boolean.";
   ILA_ASSERT(cons->is_bool()) << "Consequent must be Boolean.";
   set_sort(Sort::MakeBoolSort());
@@ -607,7 +622,7 @@ z3::expr ExprOpImply::GetZ3Expr(z3::context& ctx, const Z3ExprVec& expr_vec,
 // ------------------------- Class ExprOpIte -------------------------------- //
 ExprOpIte::ExprOpIte(const ExprPtr& cnd, const ExprPtr& true_expr,
                      const ExprPtr& false_expr)
-    : ExprOp(cnd, true_expr, false_expr) {
+    : ExprOp(AstUidExprOp::kIfThenElse, cnd, true_expr, false_expr) {
   ILA_ASSERT(cnd->is_bool()) << "Condition must be Boolean.";
   ILA_ASSERT(true_expr->sort() == false_expr->sort()) << "sort mismatch";
   set_sort(true_expr->sort());
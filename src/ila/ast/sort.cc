@@ -3,6 +3,10 @@
 
 #include <ilang/ila/ast/sort.h>
 
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 #include <ilang/util/log.h>
 
 namespace ilang {
@@ -26,14 +30,47 @@ int Sort::data_width() const {
   return 0;
 }
 
-SortPtr Sort::MakeBoolSort() { return std::make_shared<SortBool>(); }
+// The interning table of canonical sorts. Entries are never released, and the
+// table itself is intentionally leaked so that sorts held by objects with
+// static storage duration stay valid during program exit.
+namespace {
+
+struct SortTable {
+  std::mutex mtx;
+  std::unordered_map<int, SortPtr> bv;
+  std::map<std::pair<int, int>, SortPtr> mem;
+};
+
+SortTable& GetSortTable() {
+  static auto table = new SortTable();
+  return *table;
+}
+
+} // namespace
+
+SortPtr Sort::MakeBoolSort() {
+  static const SortPtr kBoolSort = std::make_shared<SortBool>();
+  return kBoolSort;
+}
 
 SortPtr Sort::MakeBvSort(const int& bit_width) {
-  return std::make_shared<SortBv>(bit_width);
+  auto& table = GetSortTable();
+  std::lock_guard<std::mutex> lock(table.mtx);
+  auto& res = table.bv[bit_width];
+  if (!res) {
+    res = std::make_shared<SortBv>(bit_width);
+  }
+  return res;
 }
 
 SortPtr Sort::MakeMemSort(const int& addr_width, const int& data_width) {
-  return std::make_shared<SortMem>(addr_width, data_width);
+  auto& table = GetSortTable();
+  std::lock_guard<std::mutex> lock(table.mtx);
+  auto& res = table.mem[{addr_width, data_width}];
+  if (!res) {
+    res = std::make_shared<SortMem>(addr_width, data_width);
+  }
+  return res;
 }
 
 SortBool::SortBool() {}
@@ -46,7 +83,9 @@ z3::expr SortBool::GetZ3Expr(z3::context& ctx, const std::string& name) const {
   return ctx.bool_const(name.c_str());
 }
 
-bool SortBool::Equal(const SortPtr rhs) const { return rhs->is_bool(); }
+bool SortBool::Equal(const SortPtr rhs) const {
+  return (rhs.get() == this) || rhs->is_bool();
+}
 
 std::ostream& SortBool::Print(std::ostream& out) const {
   return out << "Boolean";
@@ -65,6 +104,9 @@ z3::expr SortBv::GetZ3Expr(z3::context& ctx, const std::string& name) const {
 }
 
 bool SortBv::Equal(const SortPtr rhs) const {
+  if (rhs.get() == this) {
+    return true;
+  }
   return rhs->is_bv() && (rhs->bit_width() == bit_width_);
 }
 
@@ -89,6 +131,9 @@ z3::expr SortMem::GetZ3Expr(z3::context& ctx, const std::string& name) const {
 }
 
 bool SortMem::Equal(const SortPtr rhs) const {
+  if (rhs.get() == this) {
+    return true;
+  }
   return rhs->is_mem() && (rhs->addr_width() == addr_width_) &&
          (rhs->data_width() == data_width_);
 }
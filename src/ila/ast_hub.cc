@@ -3,63 +3,392 @@
 
 #include <ilang/ila/ast_hub.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+
 #include <ilang/ila/hash_ast.h>
 #include <ilang/util/log.h>
+#include <ilang/util/mem_pool.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
 namespace asthub {
 
+//
+// constant folding
+//
+
+namespace {
+
+/// Number of operation types.
+static const size_t kOpNum =
+    static_cast<size_t>(AstUidExprOp::kSignedModular) + 1;
+
+std::atomic<bool> g_const_folding{true};
+std::array<std::atomic<size_t>, kOpNum> g_const_fold_num{};
+
+// bit-width of bool/bv (0 for bool), -1 for mem or > 64 bits
+int GetFoldWidth(const ExprPtr& e) {
+  if (e->is_bool()) {
+    return 0;
+  } else if (e->is_bv() && e->sort()->bit_width() <= 64) {
+    return e->sort()->bit_width();
+  }
+  return -1;
+}
+
+BvValType GetMask(const int& width) {
+  return (width >= 64) ? ~BvValType(0) : ((BvValType(1) << width) - 1);
+}
+
+int64_t ToSigned(const BvValType& val, const int& width) {
+  if (width >= 64) {
+    return static_cast<int64_t>(val);
+  }
+  auto sign = BvValType(1) << (width - 1);
+  return static_cast<int64_t>((val ^ sign) - sign);
+}
+
+BvValType RotateLeft(const BvValType& val, const int& width, const int& n) {
+  auto amount = n % width;
+  if (amount == 0) {
+    return val;
+  }
+  return ((val << amount) | (val >> (width - amount))) & GetMask(width);
+}
+
+// fold the operation if enabled and all arguments are constant
+ExprPtr TryFold(const AstUidExprOp& op, std::initializer_list<ExprPtr> args,
+                std::initializer_list<int> params = {}) {
+  if (!g_const_folding.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  auto is_const = [](const ExprPtr& a) { return a->is_const(); };
+  if (!std::all_of(args.begin(), args.end(), is_const)) {
+    return nullptr;
+  }
+  auto res = FoldConst(op, args, params);
+  if (res) {
+    g_const_fold_num[static_cast<size_t>(op)]++;
+    ILA_COUNT("ast.const_fold", 1);
+  }
+  return res;
+}
+
+} // namespace
+
+void SetConstFolding(const bool& enable) { g_const_folding = enable; }
+
+bool ConstFoldingEnabled() { return g_const_folding; }
+
+size_t GetConstFoldNum(const AstUidExprOp& op) {
+  return g_const_fold_num[static_cast<size_t>(op)];
+}
+
+size_t GetConstFoldNum() {
+  size_t num = 0;
+  for (const auto& n : g_const_fold_num) {
+    num += n;
+  }
+  return num;
+}
+
+void ResetConstFoldNum() {
+  for (auto& n : g_const_fold_num) {
+    n = 0;
+  }
+}
+
+ExprPtr FoldConst(const AstUidExprOp& op, const ExprPtrVec& args,
+                  const std::vector<int>& params) {
+  if (args.empty()) {
+    return nullptr;
+  }
+  for (const auto& a : args) {
+    if (!a->is_const()) {
+      return nullptr;
+    }
+  }
+
+  // if-then-else picks one of the (existing) branches
+  if (op == AstUidExprOp::kIfThenElse) {
+    auto cnd = std::static_pointer_cast<ExprConst>(args.at(0));
+    if (!cnd->is_bool() || args.at(1)->sort() != args.at(2)->sort() ||
+        GetFoldWidth(args.at(1)) < 0) {
+      return nullptr;
+    }
+    return cnd->val_bool()->val() ? args.at(1) : args.at(2);
+  }
+
+  // load from a constant memory
+  if (op == AstUidExprOp::kLoad) {
+    auto mem = std::static_pointer_cast<ExprConst>(args.at(0));
+    auto addr = args.at(1);
+    if (!mem->is_mem() || GetFoldWidth(addr) <= 0 ||
+        mem->sort()->addr_width() != addr->sort()->bit_width() ||
+        mem->sort()->data_width() > 64) {
+      return nullptr;
+    }
+    auto addr_val = std::static_pointer_cast<ExprConst>(addr)->val_bv()->val();
+    auto data_val = mem->val_mem()->get_data(addr_val);
+    return BvConst(data_val, mem->sort()->data_width());
+  }
+
+  // bool/bv arguments and values
+  std::vector<BvValType> val;
+  std::vector<int> width;
+  for (const auto& a : args) {
+    auto w = GetFoldWidth(a);
+    if (w < 0) {
+      return nullptr;
+    }
+    auto c = std::static_pointer_cast<ExprConst>(a);
+    val.push_back(a->is_bool() ? c->val_bool()->val()
+                               : (c->val_bv()->val() & GetMask(w)));
+    width.push_back(w);
+  }
+
+  auto a = val.at(0);
+  auto b = (val.size() > 1) ? val.at(1) : 0;
+  auto aw = width.at(0);
+  auto bw = (width.size() > 1) ? width.at(1) : -1;
+  auto is_bv = aw > 0;
+  auto same_sort =
+      (args.size() == 2) && (args.at(0)->sort() == args.at(1)->sort());
+  auto res_width = aw; // 0 for bool result
+  BvValType res = 0;
+
+  switch (op) {
+  case AstUidExprOp::kNegate:
+  case AstUidExprOp::kComplement: {
+    if (!is_bv) {
+      return nullptr;
+    }
+    res = (op == AstUidExprOp::kNegate) ? (~a + 1) : ~a;
+    break;
+  }
+  case AstUidExprOp::kNot: {
+    if (is_bv) {
+      return nullptr;
+    }
+    res = !a;
+    break;
+  }
+  case AstUidExprOp::kAnd:
+  case AstUidExprOp::kOr:
+  case AstUidExprOp::kXor: {
+    if (!same_sort) {
+      return nullptr;
+    }
+    res = (op == AstUidExprOp::kAnd) ? (a & b)
+                                     : (op == AstUidExprOp::kOr) ? (a | b)
+                                                                 : (a ^ b);
+    break;
+  }
+  case AstUidExprOp::kImply: {
+    if (is_bv || bw != 0) {
+      return nullptr;
+    }
+    res = !a || b;
+    break;
+  }
+  case AstUidExprOp::kEqual: {
+    if (!same_sort) {
+      return nullptr;
+    }
+    res = (a == b);
+    res_width = 0;
+    break;
+  }
+  case AstUidExprOp::kLessThan:
+  case AstUidExprOp::kGreaterThan:
+  case AstUidExprOp::kUnsignedLessThan:
+  case AstUidExprOp::kUnsignedGreaterThan: {
+    if (!same_sort || !is_bv) {
+      return nullptr;
+    }
+    auto sa = ToSigned(a, aw);
+    auto sb = ToSigned(b, bw);
+    res = (op == AstUidExprOp::kLessThan)           ? (sa < sb)
+          : (op == AstUidExprOp::kGreaterThan)      ? (sa > sb)
+          : (op == AstUidExprOp::kUnsignedLessThan) ? (a < b)
+                                                    : (a > b);
+    res_width = 0;
+    break;
+  }
+  case AstUidExprOp::kShiftLeft:
+  case AstUidExprOp::kLogicShiftRight:
+  case AstUidExprOp::kArithShiftRight: {
+    if (!same_sort || !is_bv) {
+      return nullptr;
+    }
+    auto amount = std::min(b, static_cast<BvValType>(aw));
+    if (op == AstUidExprOp::kArithShiftRight) {
+      amount = std::min(amount, static_cast<BvValType>(aw - 1));
+      res = static_cast<BvValType>(ToSigned(a, aw) >> amount);
+    } else if (amount == static_cast<BvValType>(aw)) {
+      res = 0;
+    } else {
+      res = (op == AstUidExprOp::kShiftLeft) ? (a << amount) : (a >> amount);
+    }
+    break;
+  }
+  case AstUidExprOp::kAdd:
+  case AstUidExprOp::kSubtract:
+  case AstUidExprOp::kMultiply: {
+    if (!same_sort || !is_bv) {
+      return nullptr;
+    }
+    res = (op == AstUidExprOp::kAdd)        ? (a + b)
+          : (op == AstUidExprOp::kSubtract) ? (a - b)
+                                            : (a * b);
+    break;
+  }
+  case AstUidExprOp::kUnsignedRemainder: {
+    if (!same_sort || !is_bv || b == 0) {
+      return nullptr;
+    }
+    res = a % b;
+    break;
+  }
+  case AstUidExprOp::kSignedRemainder:
+  case AstUidExprOp::kSignedModular: {
+    if (!same_sort || !is_bv || b == 0) {
+      return nullptr;
+    }
+    auto sa = ToSigned(a, aw);
+    auto sb = ToSigned(b, bw);
+    // sign follows the dividend (avoid overflow of INT64_MIN % -1)
+    auto rem = (sb == -1) ? 0 : (sa % sb);
+    // sign follows the divisor
+    auto diff_sign = (rem < 0) != (sb < 0);
+    if (op == AstUidExprOp::kSignedModular && rem != 0 && diff_sign) {
+      rem += sb;
+    }
+    res = static_cast<BvValType>(rem);
+    break;
+  }
+  case AstUidExprOp::kConcatenate: {
+    if (!is_bv || bw <= 0 || aw + bw > 64) {
+      return nullptr;
+    }
+    res = (a << bw) | b;
+    res_width = aw + bw;
+    break;
+  }
+  case AstUidExprOp::kExtract: {
+    if (!is_bv || params.size() != 2 || params.at(0) >= aw ||
+        params.at(1) < 0 || params.at(0) < params.at(1)) {
+      return nullptr;
+    }
+    res = a >> params.at(1);
+    res_width = params.at(0) - params.at(1) + 1;
+    break;
+  }
+  case AstUidExprOp::kZeroExtend:
+  case AstUidExprOp::kSignedExtend: {
+    if (!is_bv || params.size() != 1 || params.at(0) < aw ||
+        params.at(0) > 64) {
+      return nullptr;
+    }
+    res = (op == AstUidExprOp::kZeroExtend)
+              ? a
+              : static_cast<BvValType>(ToSigned(a, aw));
+    res_width = params.at(0);
+    break;
+  }
+  case AstUidExprOp::kRotateLeft:
+  case AstUidExprOp::kRotateRight: {
+    if (!is_bv || params.size() != 1 || params.at(0) < 0) {
+      return nullptr;
+    }
+    auto n = params.at(0) % aw;
+    res = RotateLeft(a, aw, (op == AstUidExprOp::kRotateLeft) ? n : aw - n);
+    break;
+  }
+  default: {
+    // division (signedness differs among the targets), memory updates, and
+    // function applications are left as is
+    return nullptr;
+  }
+  };
+
+  return (res_width == 0) ? BoolConst(res != 0)
+                          : BvConst(res & GetMask(res_width), res_width);
+}
+
+//
+// construction
+//
+
 ExprPtr NewBoolVar(const std::string& name) {
-  return std::make_shared<ExprVar>(name);
+  return PoolNew<ExprVar>(name);
 }
 
 ExprPtr NewBvVar(const std::string& name, const int& bit_width) {
-  return std::make_shared<ExprVar>(name, bit_width);
+  return PoolNew<ExprVar>(name, bit_width);
 }
 
 ExprPtr NewMemVar(const std::string& name, const int& addr_width,
                   const int& data_width) {
-  return std::make_shared<ExprVar>(name, addr_width, data_width);
+  return PoolNew<ExprVar>(name, addr_width, data_width);
 }
 
 ExprPtr BoolConst(const bool& val) {
-  return std::make_shared<ExprConst>(BoolVal(val));
+  return PoolNew<ExprConst>(BoolVal(val));
 }
 
 ExprPtr BoolConst(const BoolVal& val) {
-  return std::make_shared<ExprConst>(val);
+  return PoolNew<ExprConst>(val);
 }
 
 ExprPtr BvConst(const BvValType& val, const int& bit_width) {
-  return std::make_shared<ExprConst>(BvVal(val), bit_width);
+  return PoolNew<ExprConst>(BvVal(val), bit_width);
 }
 
 ExprPtr BvConst(const BvVal& val, const int& bit_width) {
-  return std::make_shared<ExprConst>(val, bit_width);
+  return PoolNew<ExprConst>(val, bit_width);
 }
 
 ExprPtr MemConst(const BvValType& def_val, const int& addr_width,
                  const int& data_width) {
-  return std::make_shared<ExprConst>(MemVal(def_val), addr_width, data_width);
+  return PoolNew<ExprConst>(MemVal(def_val), addr_width, data_width);
 }
 
 ExprPtr MemConst(const MemVal& val, const int& addr_width,
                  const int& data_width) {
-  return std::make_shared<ExprConst>(val, addr_width, data_width);
+  return PoolNew<ExprConst>(val, addr_width, data_width);
 }
 
-ExprPtr Negate(const ExprPtr& arg) { return std::make_shared<ExprOpNeg>(arg); }
+ExprPtr Negate(const ExprPtr& arg) {
+  if (auto res = TryFold(AstUidExprOp::kNegate, {arg})) {
+    return res;
+  }
+  return PoolNew<ExprOpNeg>(arg);
+}
 
-ExprPtr Not(const ExprPtr& arg) { return std::make_shared<ExprOpNot>(arg); }
+ExprPtr Not(const ExprPtr& arg) {
+  if (auto res = TryFold(AstUidExprOp::kNot, {arg})) {
+    return res;
+  }
+  return PoolNew<ExprOpNot>(arg);
+}
 
 ExprPtr Complement(const ExprPtr& arg) {
-  return std::make_shared<ExprOpCompl>(arg);
+  if (auto res = TryFold(AstUidExprOp::kComplement, {arg})) {
+    return res;
+  }
+  return PoolNew<ExprOpCompl>(arg);
 }
 
 ExprPtr And(const ExprPtr& l, const ExprPtr& r) {
   if (l->sort() == r->sort()) {
-    return std::make_shared<ExprOpAnd>(l, r);
+    if (auto res = TryFold(AstUidExprOp::kAnd, {l, r})) {
+      return res;
+    }
+    return PoolNew<ExprOpAnd>(l, r);
   }
   // support unequal-sort-AND for: Bool AND bv(1)
   if (l->is_bv(1) && r->is_bool()) {
@@ -73,7 +402,10 @@ ExprPtr And(const ExprPtr& l, const ExprPtr& r) {
 
 ExprPtr Or(const ExprPtr& l, const ExprPtr& r) {
   if (l->sort() == r->sort()) {
-    return std::make_shared<ExprOpOr>(l, r);
+    if (auto res = TryFold(AstUidExprOp::kOr, {l, r})) {
+      return res;
+    }
+    return PoolNew<ExprOpOr>(l, r);
   }
   // support unequal-sort-OR for: Bool OR bv(1)
   if (l->is_bv(1) && r->is_bool()) {
@@ -87,7 +419,10 @@ ExprPtr Or(const ExprPtr& l, const ExprPtr& r) {
 
 ExprPtr Xor(const ExprPtr& l, const ExprPtr& r) {
   if (l->sort() == r->sort()) {
-    return std::make_shared<ExprOpXor>(l, r);
+    if (auto res = TryFold(AstUidExprOp::kXor, {l, r})) {
+      return res;
+    }
+    return PoolNew<ExprOpXor>(l, r);
   }
   // support unequal-sort-XOR for: Bool XOR bv(1)
   if (l->is_bv(1) && r->is_bool()) {
@@ -100,43 +435,73 @@ ExprPtr Xor(const ExprPtr& l, const ExprPtr& r) {
 }
 
 ExprPtr Shl(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpShl>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kShiftLeft, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpShl>(l, r);
 }
 
 ExprPtr Ashr(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpAshr>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kArithShiftRight, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpAshr>(l, r);
 }
 
 ExprPtr Lshr(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpLshr>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kLogicShiftRight, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpLshr>(l, r);
 }
 
 ExprPtr Add(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpAdd>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kAdd, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpAdd>(l, r);
 }
 
 ExprPtr Sub(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpSub>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kSubtract, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpSub>(l, r);
 }
 
 ExprPtr Div(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpDiv>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kDivide, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpDiv>(l, r);
 }
 
 ExprPtr SRem(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpSRem>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kSignedRemainder, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpSRem>(l, r);
 }
 
 ExprPtr URem(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpURem>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kUnsignedRemainder, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpURem>(l, r);
 }
 
 ExprPtr SMod(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpSMod>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kSignedModular, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpSMod>(l, r);
 }
 
 ExprPtr Mul(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpMul>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kMultiply, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpMul>(l, r);
 }
 
 ExprPtr And(const ExprPtr& l, const bool& r) {
@@ -185,51 +550,57 @@ ExprPtr Mul(const ExprPtr& l, const BvValType& r) {
 }
 
 ExprPtr Eq(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpEq>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kEqual, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpEq>(l, r);
 }
 
 ExprPtr Ne(const ExprPtr& l, const ExprPtr& r) {
-  auto eq = std::make_shared<ExprOpEq>(l, r);
-  return std::make_shared<ExprOpNot>(eq);
+  return Not(Eq(l, r));
 }
 
 ExprPtr Lt(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpLt>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kLessThan, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpLt>(l, r);
 }
 
 ExprPtr Gt(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpGt>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kGreaterThan, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpGt>(l, r);
 }
 
 ExprPtr Le(const ExprPtr& l, const ExprPtr& r) {
-  auto eq = std::make_shared<ExprOpEq>(l, r);
-  auto lt = std::make_shared<ExprOpLt>(l, r);
-  return std::make_shared<ExprOpOr>(eq, lt);
+  return Or(Eq(l, r), Lt(l, r));
 }
 
 ExprPtr Ge(const ExprPtr& l, const ExprPtr& r) {
-  auto eq = std::make_shared<ExprOpEq>(l, r);
-  auto gt = std::make_shared<ExprOpGt>(l, r);
-  return std::make_shared<ExprOpOr>(eq, gt);
+  return Or(Eq(l, r), Gt(l, r));
 }
 ExprPtr Ult(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpUlt>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kUnsignedLessThan, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpUlt>(l, r);
 }
 
 ExprPtr Ugt(const ExprPtr& l, const ExprPtr& r) {
-  return std::make_shared<ExprOpUgt>(l, r);
+  if (auto res = TryFold(AstUidExprOp::kUnsignedGreaterThan, {l, r})) {
+    return res;
+  }
+  return PoolNew<ExprOpUgt>(l, r);
 }
 
 ExprPtr Ule(const ExprPtr& l, const ExprPtr& r) {
-  auto eq = std::make_shared<ExprOpEq>(l, r);
-  auto ult = std::make_shared<ExprOpUlt>(l, r);
-  return std::make_shared<ExprOpOr>(eq, ult);
+  return Or(Eq(l, r), Ult(l, r));
 }
 
 ExprPtr Uge(const ExprPtr& l, const ExprPtr& r) {
-  auto eq = std::make_shared<ExprOpEq>(l, r);
-  auto ugt = std::make_shared<ExprOpUgt>(l, r);
-  return std::make_shared<ExprOpOr>(eq, ugt);
+  return Or(Eq(l, r), Ugt(l, r));
 }
 
 #if 0
@@ -292,11 +663,14 @@ ExprPtr Uge(const ExprPtr& l, const BvValType& r) {
 }
 
 ExprPtr Load(const ExprPtr& mem, const ExprPtr& addr) {
-  return std::make_shared<ExprOpLoad>(mem, addr);
+  if (auto res = TryFold(AstUidExprOp::kLoad, {mem, addr})) {
+    return res;
+  }
+  return PoolNew<ExprOpLoad>(mem, addr);
 }
 
 ExprPtr Store(const ExprPtr& mem, const ExprPtr& addr, const ExprPtr& data) {
-  return std::make_shared<ExprOpStore>(mem, addr, data);
+  return PoolNew<ExprOpStore>(mem, addr, data);
 }
 
 ExprPtr Load(const ExprPtr& mem, const BvValType& addr) {
@@ -339,52 +713,77 @@ ExprPtr Concat(const ExprPtr& hi, const ExprPtr& lo) {
   auto const_one = BvConst(0x1, 1);
   auto bv_hi = hi->is_bool() ? Ite(hi, const_one, const_zero) : hi;
   auto bv_lo = lo->is_bool() ? Ite(lo, const_one, const_zero) : lo;
-  return std::make_shared<ExprOpConcat>(bv_hi, bv_lo);
+  if (auto res = TryFold(AstUidExprOp::kConcatenate, {bv_hi, bv_lo})) {
+    return res;
+  }
+  return PoolNew<ExprOpConcat>(bv_hi, bv_lo);
 }
 
 ExprPtr Extract(const ExprPtr& bv, const int& hi, const int& lo) {
-  return std::make_shared<ExprOpExtract>(bv, hi, lo);
+  if (auto res = TryFold(AstUidExprOp::kExtract, {bv}, {hi, lo})) {
+    return res;
+  }
+  return PoolNew<ExprOpExtract>(bv, hi, lo);
 }
 
 ExprPtr ZExt(const ExprPtr& bv, const int& out_width) {
-  return std::make_shared<ExprOpZExt>(bv, out_width);
+  if (auto res = TryFold(AstUidExprOp::kZeroExtend, {bv}, {out_width})) {
+    return res;
+  }
+  return PoolNew<ExprOpZExt>(bv, out_width);
 }
 
 ExprPtr SExt(const ExprPtr& bv, const int& out_width) {
-  return std::make_shared<ExprOpSExt>(bv, out_width);
+  if (auto res = TryFold(AstUidExprOp::kSignedExtend, {bv}, {out_width})) {
+    return res;
+  }
+  return PoolNew<ExprOpSExt>(bv, out_width);
 }
 
 ExprPtr LRotate(const ExprPtr& bv, const int& immediate) {
-  return std::make_shared<ExprOpLRotate>(bv, immediate);
+  if (auto res = TryFold(AstUidExprOp::kRotateLeft, {bv}, {immediate})) {
+    return res;
+  }
+  return PoolNew<ExprOpLRotate>(bv, immediate);
 }
 
 ExprPtr RRotate(const ExprPtr& bv, const int& immediate) {
-  return std::make_shared<ExprOpRRotate>(bv, immediate);
+  if (auto res = TryFold(AstUidExprOp::kRotateRight, {bv}, {immediate})) {
+    return res;
+  }
+  return PoolNew<ExprOpRRotate>(bv, immediate);
 }
 
 ExprPtr AppFunc(const FuncPtr& func) {
-  return std::shared_ptr<ExprOpAppFunc>(new ExprOpAppFunc(func, {}));
+  return PoolNew<ExprOpAppFunc>(func, ExprPtrVec());
 }
 
 ExprPtr AppFunc(const FuncPtr& func, const ExprPtr& arg0) {
-  return std::shared_ptr<ExprOpAppFunc>(new ExprOpAppFunc(func, {arg0}));
+  return PoolNew<ExprOpAppFunc>(func, ExprPtrVec({arg0}));
 }
 
 ExprPtr AppFunc(const FuncPtr& func, const ExprPtr& arg0, const ExprPtr& arg1) {
-  return std::shared_ptr<ExprOpAppFunc>(new ExprOpAppFunc(func, {arg0, arg1}));
+  return PoolNew<ExprOpAppFunc>(func, ExprPtrVec({arg0, arg1}));
 }
 
 ExprPtr AppFunc(const FuncPtr& func, const ExprPtrVec& args) {
-  return std::shared_ptr<ExprOpAppFunc>(new ExprOpAppFunc(func, args));
+  return PoolNew<ExprOpAppFunc>(func, args);
 }
 
 ExprPtr Imply(const ExprPtr& p, const ExprPtr& q) {
-  return std::make_shared<ExprOpImply>(p, q);
+  if (auto res = TryFold(AstUidExprOp::kImply, {p, q})) {
+    return res;
+  }
+  return PoolNew<ExprOpImply>(p, q);
 }
 
 ExprPtr Ite(const ExprPtr& cnd, const ExprPtr& true_expr,
             const ExprPtr& false_expr) {
-  return std::make_shared<ExprOpIte>(cnd, true_expr, false_expr);
+  if (auto res = TryFold(AstUidExprOp::kIfThenElse,
+                         {cnd, true_expr, false_expr})) {
+    return res;
+  }
+  return PoolNew<ExprOpIte>(cnd, true_expr, false_expr);
 }
 
 bool TopEq(const ExprPtr& a, const ExprPtr& b) {
@@ -16,7 +16,10 @@ ExprMngr::~ExprMngr() {}
 
 ExprMngrPtr ExprMngr::New() { return std::make_shared<ExprMngr>(); }
 
-void ExprMngr::clear() { map_.clear(); }
+void ExprMngr::clear() {
+  map_.clear();
+  sort_hash_.clear();
+}
 
 ExprPtr ExprMngr::GetRep(const ExprPtr& node) {
   node->DepthFirstVisit(*this);
@@ -58,12 +61,18 @@ std::string ExprMngr::Hash(const ExprPtr& expr) {
   static const char* kTemplateOp = "op::{sort}::{op}::{arg_list}::{param_list}";
   static const char* kTemplateSort = "{type}_{bit}_{addr}_{data}";
 
-  auto GetSortHash = [](const SortPtr& sort) {
-    return fmt::format(
+  // sorts are interned, so only a handful of distinct ones need formatting
+  auto GetSortHash = [this](const SortPtr& sort) -> const std::string& {
+    auto pos = sort_hash_.find(sort);
+    if (pos != sort_hash_.end()) {
+      return pos->second;
+    }
+    auto res = fmt::format(
         kTemplateSort, fmt::arg("type", sort->uid()),
         fmt::arg("bit", sort->is_bv() ? sort->bit_width() : 0),
         fmt::arg("addr", sort->is_mem() ? sort->addr_width() : 0),
         fmt::arg("data", sort->is_mem() ? sort->data_width() : 0));
+    return sort_hash_.emplace(sort, res).first->second;
   };
 
   if (expr->is_var()) {
@@ -92,7 +101,8 @@ std::string ExprMngr::Hash(const ExprPtr& expr) {
     for (size_t i = 0; i < expr->arg_num(); i++) {
       arg_list.push_back(expr->arg(i)->name().id());
     }
-    if (auto app_func = std::dynamic_pointer_cast<ExprOpAppFunc>(expr)) {
+    if (asthub::GetUidExprOp(expr) == AstUidExprOp::kApplyFunc) {
+      auto app_func = std::static_pointer_cast<ExprOpAppFunc>(expr);
       arg_list.push_back(app_func->func()->name().id());
     }
 
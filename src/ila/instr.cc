@@ -48,6 +48,7 @@ void Instr::set_update(const ExprPtr& state, const ExprPtr& update) {
 }
 
 void Instr::set_program(const InstrLvlAbsPtr& program) {
+  ILA_CHECK(!host_ || !host_->is_frozen()) << "Modifying frozen " << name();
   ILA_ASSERT(!prog_) << "Child-program has been defined for " << name();
   ILA_ASSERT(program) << "NULL program.";
   prog_ = program;
@@ -78,11 +79,14 @@ Instr::StateNameSet Instr::updated_states() const {
 void Instr::ForceSetDecode(const ExprPtr& decode) {
   ILA_NOT_NULL(decode); // setting NULL pointer to decode function
   ILA_CHECK(decode->is_bool()) << "Decode must have Boolean sort.";
+  ILA_CHECK(!host_ || !host_->is_frozen()) << "Modifying frozen " << name();
 
   decode_ = Unify(decode);
 }
 
 void Instr::ForceAddUpdate(const std::string& name, const ExprPtr& update) {
+  ILA_CHECK(!host_ || !host_->is_frozen())
+      << "Modifying frozen " << this->name();
   ExprPtr sim_update = Unify(update);
   updates_[name] = sim_update;
 }
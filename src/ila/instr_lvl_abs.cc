@@ -28,23 +28,24 @@ InstrLvlAbsPtr InstrLvlAbs::New(const std::string& name,
 }
 
 const ExprPtr InstrLvlAbs::input(const std::string& name) const {
-  auto inp = find_input(Symbol(name));
-  return inp;
+  // search by the plain name to avoid creating (and interning) a new symbol
+  auto pos = inputs_.find(name);
+  return (pos == inputs_.end()) ? nullptr : pos->second;
 }
 
 const ExprPtr InstrLvlAbs::state(const std::string& name) const {
-  auto stt = find_state(Symbol(name));
-  return stt;
+  auto pos = states_.find(name);
+  return (pos == states_.end()) ? nullptr : pos->second;
 }
 
 const InstrPtr InstrLvlAbs::instr(const std::string& name) const {
-  auto instr = find_instr(Symbol(name));
-  return instr;
+  auto pos = instrs_.find(name);
+  return (pos == instrs_.end()) ? nullptr : pos->second;
 }
 
 const InstrLvlAbsPtr InstrLvlAbs::child(const std::string& name) const {
-  auto child = find_child(Symbol(name));
-  return child;
+  auto pos = childs_.find(name);
+  return (pos == childs_.end()) ? nullptr : pos->second;
 }
 
 const ExprPtr InstrLvlAbs::find_input(const Symbol& name) const {
@@ -68,6 +69,7 @@ const InstrLvlAbsPtr InstrLvlAbs::find_child(const Symbol& name) const {
 }
 
 void InstrLvlAbs::AddInput(const ExprPtr& input_var) {
+  CheckMutable();
   // sanity check
   ILA_NOT_NULL(input_var);
   ILA_ASSERT(input_var->is_var()) << "Register non-var to Inputs.";
@@ -83,6 +85,7 @@ void InstrLvlAbs::AddInput(const ExprPtr& input_var) {
 }
 
 void InstrLvlAbs::AddState(const ExprPtr& state_var) {
+  CheckMutable();
   // sanity check
   ILA_NOT_NULL(state_var);
   ILA_ASSERT(state_var->is_var()) << "Register non-var to States.";
@@ -98,6 +101,7 @@ void InstrLvlAbs::AddState(const ExprPtr& state_var) {
 }
 
 void InstrLvlAbs::AddInit(const ExprPtr& cntr_expr) {
+  CheckMutable();
   // sanity check
   ILA_NOT_NULL(cntr_expr);
   ILA_ASSERT(cntr_expr->is_bool()) << "Initial condition must be Boolean.";
@@ -118,6 +122,7 @@ void InstrLvlAbs::SetValid(const ExprPtr& valid_expr) {
 }
 
 void InstrLvlAbs::AddInstr(const InstrPtr& instr) {
+  CheckMutable();
   ILA_NOT_NULL(instr);
   // register the instruction and idx
   auto name = instr->name();
@@ -125,6 +130,7 @@ void InstrLvlAbs::AddInstr(const InstrPtr& instr) {
 }
 
 void InstrLvlAbs::AddChild(const InstrLvlAbsPtr& child) {
+  CheckMutable();
   ILA_NOT_NULL(child);
   /// register the child-ILA and idx
   auto name = child->name();
@@ -242,6 +248,7 @@ const InstrLvlAbsPtr InstrLvlAbs::NewChild(const std::string& name) {
 }
 
 void InstrLvlAbs::ForceSetFetch(const ExprPtr& fetch_expr) {
+  CheckMutable();
   // sanity check
   ILA_NOT_NULL(fetch_expr);
   ILA_ASSERT(fetch_expr->is_bv()) << "Fetch function must be bit-vector.";
@@ -252,6 +259,7 @@ void InstrLvlAbs::ForceSetFetch(const ExprPtr& fetch_expr) {
 }
 
 void InstrLvlAbs::ForceSetValid(const ExprPtr& valid_expr) {
+  CheckMutable();
   // sanity check
   ILA_NOT_NULL(valid_expr);
   ILA_ASSERT(valid_expr->is_bool()) << "Valid function must be Boolean.";
@@ -263,6 +271,7 @@ void InstrLvlAbs::ForceSetValid(const ExprPtr& valid_expr) {
 
 void InstrLvlAbs::AddSeqTran(const InstrPtr& src, const InstrPtr& dst,
                              const ExprPtr& cnd) {
+  CheckMutable();
   // XXX src, dst should already registered.
   auto cnd_simplified = Unify(cnd);
   if (!instr_seq_) {
@@ -272,13 +281,26 @@ void InstrLvlAbs::AddSeqTran(const InstrPtr& src, const InstrPtr& dst,
 }
 
 std::string InstrLvlAbs::GetRootName() const {
-  if (parent()) {
+  if (frozen_) {
+    return root_name_;
+  } else if (parent()) {
     return parent()->GetRootName() + "." + name().str();
   } else {
     return name().str();
   }
 }
 
+void InstrLvlAbs::Freeze() {
+  if (frozen_) {
+    return;
+  }
+  for (size_t i = 0; i != child_num(); i++) {
+    child(i)->Freeze();
+  }
+  root_name_ = GetRootName();
+  frozen_ = true;
+}
+
 std::ostream& InstrLvlAbs::Print(std::ostream& out) const {
   out << "ILA." << name();
   return out;
@@ -300,6 +322,10 @@ ExprPtr InstrLvlAbs::Unify(const ExprPtr& e) {
   return kUnifyAst ? expr_mngr_->GetRep(e) : e;
 }
 
+void InstrLvlAbs::CheckMutable() const {
+  ILA_CHECK(!frozen_) << "Modifying frozen ILA " << name();
+}
+
 void InstrLvlAbs::InitObject() {
   // local
   inputs_.clear();
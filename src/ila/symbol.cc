@@ -3,34 +3,46 @@
 
 #include <ilang/ila/symbol.h>
 
+#include <mutex>
+#include <unordered_set>
+
 #include <ilang/util/log.h>
 #include <ilang/util/str_util.h>
 
 /// \namespace ilang
 namespace ilang {
 
-size_t Symbol::counter_ = 0;
+std::atomic<size_t> Symbol::counter_ = 0;
 
-Symbol::Symbol() {
-  id_ = ++counter_;
-  name_ = "$" + std::to_string(id_);
-}
+Symbol::Symbol() { id_ = ++counter_; }
 
-Symbol::Symbol(const char* str) : name_(str) { id_ = ++counter_; }
+Symbol::Symbol(const char* str) : name_(Intern(str)) { id_ = ++counter_; }
 
-Symbol::Symbol(const std::string& str) : name_(str) { id_ = ++counter_; }
+Symbol::Symbol(const std::string& str) : name_(Intern(str)) {
+  id_ = ++counter_;
+}
 
-Symbol::Symbol(const Symbol& rhs) : name_(rhs.name_), id_(rhs.id_) {}
+Symbol::Symbol(const Symbol& rhs)
+    : name_(rhs.name_.load(std::memory_order_acquire)), id_(rhs.id_) {}
 
 Symbol::~Symbol() {}
 
-const std::string& Symbol::str() const { return name_; }
+const std::string& Symbol::str() const {
+  // anonymous names are only rendered when needed
+  auto name = name_.load(std::memory_order_acquire);
+  if (!name) {
+    // concurrent readers render the same pooled string, so any winner is fine
+    name = Intern("$" + std::to_string(id_));
+    name_.store(name, std::memory_order_release);
+  }
+  return *name;
+}
 
-const char* Symbol::c_str() const { return name_.c_str(); }
+const char* Symbol::c_str() const { return str().c_str(); }
 
 const std::string Symbol::format_str(const std::string& prefix,
                                      const std::string& suffix) const {
-  std::string res = name_;
+  std::string res = str();
   if (!prefix.empty()) {
     res = prefix + "_sEp_" + res;
   }
@@ -40,29 +52,47 @@ const std::string Symbol::format_str(const std::string& prefix,
   return res;
 }
 
-int Symbol::to_int() const { return StrToInt(name_); }
+int Symbol::to_int() const { return StrToInt(str()); }
 
 const size_t& Symbol::id() const { return id_; }
 
-void Symbol::set_name(const std::string& name) { name_ = name; }
+void Symbol::set_name(const std::string& name) { name_ = Intern(name); }
 
-std::ostream& Symbol::Print(std::ostream& out) const { return out << name_; }
+std::ostream& Symbol::Print(std::ostream& out) const { return out << str(); }
 
 std::ostream& operator<<(std::ostream& out, const Symbol& s) {
   return s.Print(out);
 }
 
 Symbol& Symbol::operator=(const Symbol& rhs) {
-  name_ = rhs.name_;
+  name_ = &rhs.str();
   return *this;
 }
 
 bool operator==(const Symbol& lhs, const Symbol& rhs) {
-  return (lhs.name_ == rhs.name_);
+  // interned strings are equal iff they are the same object
+  return (&lhs.str() == &rhs.str());
 }
 
 bool operator<(const Symbol& lhs, const Symbol& rhs) {
-  return (lhs.name_ < rhs.name_);
+  return (lhs.str() < rhs.str());
+}
+
+bool operator<(const Symbol& lhs, const std::string& rhs) {
+  return (lhs.str() < rhs);
+}
+
+bool operator<(const std::string& lhs, const Symbol& rhs) {
+  return (lhs < rhs.str());
+}
+
+const std::string* Symbol::Intern(const std::string& str) {
+  // the pool is intentionally leaked so that names stay valid during exit
+  static auto pool = new std::unordered_set<std::string>();
+  static auto mtx = new std::mutex();
+
+  std::lock_guard<std::mutex> lock(*mtx);
+  return &(*pool->insert(str).first);
 }
 
 } // namespace ilang
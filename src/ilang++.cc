@@ -8,11 +8,14 @@
 #include <ilang/ila-mngr/u_abs_knob.h>
 #include <ilang/ila-mngr/u_unroller.h>
 #include <ilang/ila/instr_lvl_abs.h>
+#include <ilang/target-aig/aiger_writer.h>
+#include <ilang/target-btor/btor2_writer.h>
 #include <ilang/target-itsy/interface.h>
 #include <ilang/target-json/interface.h>
 #include <ilang/target-sc/ilator.h>
 #include <ilang/target-smt/smt_switch_itf.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 #include <ilang/verilog-out/verilog_gen.h>
 
 #ifdef SMTSWITCH_INTERFACE
@@ -28,6 +31,8 @@ namespace ilang {
 bool UnsignedComparison = false;
 void SetUnsignedComparison(bool sign) { UnsignedComparison = sign; }
 
+void SetConstFolding(bool enable) { asthub::SetConstFolding(enable); }
+
 /******************************************************************************/
 // SortRef
 /******************************************************************************/
@@ -765,6 +770,30 @@ void ExportSysCSim(const Ila& ila, const std::string& dir_path, bool opt) {
   ilator.Generate(dir_path, opt);
 }
 
+void ExportStandaloneSim(const Ila& ila, const std::string& dir_path,
+                         bool opt, int lanes) {
+  auto ilator = Ilator(ila.get(), true, lanes);
+  ilator.Generate(dir_path, opt);
+}
+
+bool ExportBtor2(const Ila& ila, const std::string& file_name) {
+  auto writer = Btor2Writer(ila.get());
+  return writer.WriteToFile(file_name);
+}
+
+bool ExportAiger(const Ila& ila, const std::string& file_name,
+                 const std::vector<ExprRef>& props) {
+  auto writer = AigerWriter(ila.get());
+  for (auto& p : props) {
+    writer.AddProperty(p.get());
+  }
+  return writer.WriteToFile(file_name);
+}
+
+std::string GetExprGraphStats(const Ila& ila, const int& indent) {
+  return absknob::GetExprGraphStats(ila.get()).ToJson(indent);
+}
+
 IlaZ3Unroller::IlaZ3Unroller(z3::context& ctx, const std::string& suff)
     : ctx_(ctx), extra_suff_(suff) {
   univ_ = std::make_shared<MonoUnroll>(ctx);
@@ -819,6 +848,21 @@ z3::expr IlaZ3Unroller::UnrollPathFree(const std::vector<InstrRef>& path,
   return u->PathNone(seq, init);
 }
 
+std::vector<z3::check_result> IlaZ3Unroller::CheckPathConnBatch(
+    const std::vector<std::vector<InstrRef>>& paths, z3::solver& solver,
+    const int& init) {
+  auto u = std::make_shared<PathUnroll>(ctx_, extra_suff_);
+  InitializeUnroller(u);
+  std::vector<InstrVec> seqs;
+  for (auto& path : paths) {
+    seqs.emplace_back();
+    for (auto& instr : path) {
+      seqs.back().push_back(instr.get());
+    }
+  }
+  return u->PathAssnBatch(seqs, solver, {}, init);
+}
+
 z3::expr IlaZ3Unroller::CurrState(const ExprRef& v, const int& t) {
   return univ_->CurrState(v.get(), t);
 }
@@ -859,6 +903,22 @@ void EnableDebug(const std::string& tag) { DebugLog::Enable(tag); }
 
 void DisableDebug(const std::string& tag) { DebugLog::Disable(tag); }
 
+void EnableTelemetry(bool enable) {
+  if (enable) {
+    Telemetry::Enable();
+  } else {
+    Telemetry::Disable();
+  }
+}
+
+void ResetTelemetry() { Telemetry::Reset(); }
+
+bool ExportTelemetryTrace(const std::string& file_name) {
+  return Telemetry::ExportChromeTrace(file_name);
+}
+
+void PrintTelemetrySummary(std::ostream& out) { Telemetry::PrintSummary(out); }
+
 #ifdef SMTSWITCH_INTERFACE
 smt::Term ResetAndGetSmtTerm(smt::SmtSolver& solver, const ExprRef& expr,
                              const std::string& suffix) {
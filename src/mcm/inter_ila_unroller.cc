@@ -8,6 +8,7 @@
 
 #include <ilang/mcm/set_op.h>
 #include <ilang/util/log.h>
+#include <ilang/util/z3_helper.h>
 
 namespace ilang {
 
@@ -214,6 +215,18 @@ bool InterIlaUnroller::CurrConstrSat() {
 bool InterIlaUnroller::CheckSat() {
   z3::solver solver(ctx());
 
+  if (portfolio_) {
+    for (const auto& c : cstr_) {
+      solver.add(c);
+    }
+    if (portfolio_->Check(solver) == z3::sat) {
+      model_ptr_.reset(new z3::model(portfolio_->GetModel(ctx())));
+      return true;
+    }
+    model_ptr_.reset(); // delete old value
+    return false;
+  }
+
   // auto cnst = ConjPred( cstr_ );
   unsigned idx = 0;
   for (const auto& c : cstr_) {
@@ -261,12 +274,7 @@ void InterIlaUnroller::Pop() {
 }
 
 InterIlaUnroller::ZExpr InterIlaUnroller::ConjPred(const ZExprVec& vec) const {
-  auto conj = ctx().bool_val(true);
-  for (size_t i = 0; i != vec.size(); i++) {
-    conj = (conj && vec[i]);
-  }
-  conj = conj.simplify();
-  return conj;
+  return Z3AndAll(ctx(), vec);
 }
 
 /******************************************************************************/
@@ -0,0 +1,759 @@
+/// \file
+/// Source for bit-blasting ILA to AIGER.
+
+#include <ilang/target-aig/aiger_writer.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include <ilang/ila/ast_hub.h>
+#include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
+
+/// \namespace ilang
+namespace ilang {
+
+static const AigerWriter::Lit kAigFalse = 0;
+static const AigerWriter::Lit kAigTrue = 1;
+
+AigerWriter::AigerWriter(const InstrLvlAbsCnstPtr& m,
+                         const int& max_addr_width)
+    : m_(m), max_addr_width_(max_addr_width) {}
+
+AigerWriter::~AigerWriter() {}
+
+void AigerWriter::AddProperty(const ExprPtr& prop, const std::string& name) {
+  ILA_ASSERT(prop->is_bool()) << "Property " << prop << " is not Boolean";
+  auto prop_name =
+      name.empty() ? fmt::format("__property_{}__", props_.size()) : name;
+  props_.push_back({prop, prop_name});
+}
+
+bool AigerWriter::WriteToFile(const std::string& file_name) {
+  std::ofstream fw(file_name, std::ios::binary);
+  if (!fw.is_open()) {
+    ILA_ERROR << "Fail opening file " << file_name;
+    return false;
+  }
+  return Write(fw);
+}
+
+bool AigerWriter::Write(std::ostream& out) {
+  ILA_TRACE_SCOPE("aig.write");
+  ILA_NOT_NULL(m_);
+  ILA_WARN_IF(m_->child_num() != 0)
+      << "Child-ILAs of " << m_ << " are not translated to AIGER";
+  Reset();
+
+  // inputs and states
+  for (size_t i = 0; i < m_->input_num(); i++) {
+    NewVar(m_->input(i), false);
+  }
+  for (size_t i = 0; i < m_->state_num(); i++) {
+    NewVar(m_->state(i), true);
+  }
+
+  // initial conditions only hold when the initial flag is not set
+  std::vector<Lit> constraints;
+  if (m_->init_num() != 0) {
+    auto init_flag = NewLatch("__init__");
+    latch_reset_.back() = kAigFalse;
+    SetNext(init_flag, kAigTrue);
+    for (size_t i = 0; i < m_->init_num(); i++) {
+      constraints.push_back(Or(init_flag, BitsOf(m_->init(i)).at(0)));
+    }
+  }
+
+  // valid and decode functions
+  auto valid = m_->valid();
+  if (!valid) {
+    valid = asthub::BoolConst(true);
+    ILA_WARN << "Use default (true) valid for " << m_;
+  }
+  auto valid_lit = BitsOf(valid).at(0);
+  std::vector<Lit> grants;
+  for (size_t i = 0; i < m_->instr_num(); i++) {
+    auto decode = m_->instr(i)->decode();
+    if (!decode) {
+      decode = asthub::BoolConst(true);
+      ILA_WARN << "Use default (true) decode for " << m_->instr(i);
+    }
+    grants.push_back(And(valid_lit, BitsOf(decode).at(0)));
+  }
+
+  // next state functions, the first decoded instruction takes effect
+  for (size_t i = 0; i < m_->state_num(); i++) {
+    auto state = m_->state(i);
+    if (state->is_mem()) {
+      auto next = WordsOf(state);
+      for (auto j = m_->instr_num(); j-- > 0;) {
+        if (auto update = m_->instr(j)->update(state); update) {
+          auto& update_words = WordsOf(update);
+          for (size_t a = 0; a < next.size(); a++) {
+            next[a] = Mux(grants.at(j), update_words.at(a), next[a]);
+          }
+        }
+      }
+      auto& curr = WordsOf(state);
+      for (size_t a = 0; a < next.size(); a++) {
+        for (size_t b = 0; b < next[a].size(); b++) {
+          SetNext(curr[a][b], next[a][b]);
+        }
+      }
+    } else {
+      auto next = BitsOf(state);
+      for (auto j = m_->instr_num(); j-- > 0;) {
+        if (auto update = m_->instr(j)->update(state); update) {
+          next = Mux(grants.at(j), BitsOf(update), next);
+        }
+      }
+      auto& curr = BitsOf(state);
+      for (size_t b = 0; b < next.size(); b++) {
+        SetNext(curr[b], next[b]);
+      }
+    }
+  }
+
+  // properties (as bad states)
+  std::vector<Lit> outputs;
+  std::vector<std::string> output_names;
+  for (auto& [prop, name] : props_) {
+    outputs.push_back(BitsOf(prop).at(0) ^ 1);
+    output_names.push_back(name);
+  }
+
+  if (failed_) {
+    ILA_ERROR << "Fail bit-blasting " << m_;
+    return false;
+  }
+  return WriteAiger(out, outputs, output_names, constraints);
+}
+
+bool AigerWriter::pre(const ExprPtr& expr) {
+  return (expr->is_mem()) ? (words_.find(expr) != words_.end())
+                          : (bits_.find(expr) != bits_.end());
+}
+
+void AigerWriter::post(const ExprPtr& expr) {
+  if (expr->is_var()) {
+    // variables out of the ILA, e.g., states of the parent
+    ILA_WARN << expr << " is not defined in " << m_ << ", use as input";
+    NewVar(expr, false);
+  } else if (expr->is_const()) {
+    auto expr_const = std::static_pointer_cast<ExprConst>(expr);
+    if (expr->is_bool()) {
+      bits_[expr] = {expr_const->val_bool()->val() ? kAigTrue : kAigFalse};
+    } else if (expr->is_bv()) {
+      bits_[expr] =
+          Const(expr->sort()->bit_width(), expr_const->val_bv()->val());
+    } else {
+      auto addr_width = expr->sort()->addr_width();
+      auto data_width = expr->sort()->data_width();
+      if (addr_width > max_addr_width_) {
+        ILA_ERROR << "Memory " << expr << " is too large to bit-blast";
+        failed_ = true;
+        addr_width = 0;
+      }
+      auto mem_val = expr_const->val_mem();
+      auto& val_map = mem_val->val_map();
+      auto& words = words_[expr];
+      for (uint64_t a = 0; a < (uint64_t(1) << addr_width); a++) {
+        auto pos = val_map.find(a);
+        auto data = (pos == val_map.end()) ? mem_val->def_val() : pos->second;
+        words.push_back(Const(data_width, data));
+      }
+    }
+  } else {
+    ILA_ASSERT(expr->is_op());
+    BlastOp(expr);
+  }
+}
+
+void AigerWriter::Reset() {
+  failed_ = false;
+  kinds_ = {VarKind::kConst};
+  ands_.clear();
+  strash_.clear();
+  inputs_.clear();
+  latches_.clear();
+  latch_next_.clear();
+  latch_reset_.clear();
+  bits_.clear();
+  words_.clear();
+}
+
+AigerWriter::Lit AigerWriter::NewInput(const std::string& name) {
+  unsigned var = kinds_.size();
+  kinds_.push_back(VarKind::kInput);
+  inputs_.push_back({var, name});
+  return 2 * var;
+}
+
+AigerWriter::Lit AigerWriter::NewLatch(const std::string& name) {
+  unsigned var = kinds_.size();
+  kinds_.push_back(VarKind::kLatch);
+  latches_.push_back({var, name});
+  latch_next_.push_back(2 * var);
+  latch_reset_.push_back(2 * var);
+  return 2 * var;
+}
+
+void AigerWriter::NewVar(const ExprPtr& var, const bool& is_latch) {
+  auto NewBit = [this, &is_latch](const std::string& name) {
+    return is_latch ? NewLatch(name) : NewInput(name);
+  };
+  auto name = var->name().str();
+
+  if (var->is_mem()) {
+    auto addr_width = var->sort()->addr_width();
+    auto data_width = var->sort()->data_width();
+    if (addr_width > max_addr_width_) {
+      ILA_ERROR << "Memory " << var << " is too large to bit-blast";
+      failed_ = true;
+      addr_width = 0;
+    }
+    auto& words = words_[var];
+    for (uint64_t a = 0; a < (uint64_t(1) << addr_width); a++) {
+      Bits word;
+      for (int b = 0; b < data_width; b++) {
+        word.push_back(NewBit(fmt::format("{}[{}][{}]", name, a, b)));
+      }
+      words.push_back(word);
+    }
+  } else {
+    auto width = var->is_bool() ? 1 : var->sort()->bit_width();
+    auto& bits = bits_[var];
+    for (int b = 0; b < width; b++) {
+      bits.push_back(NewBit(var->is_bool() ? name
+                                           : fmt::format("{}[{}]", name, b)));
+    }
+  }
+}
+
+void AigerWriter::SetNext(const Lit& latch, const Lit& next) {
+  auto pos = std::lower_bound(
+      latches_.begin(), latches_.end(), latch >> 1,
+      [](const std::pair<unsigned, std::string>& l, const unsigned& var) {
+        return l.first < var;
+      });
+  ILA_ASSERT(pos != latches_.end() && pos->first == (latch >> 1));
+  latch_next_.at(pos - latches_.begin()) = next;
+}
+
+const AigerWriter::Bits& AigerWriter::BitsOf(const ExprPtr& expr) {
+  ILA_ASSERT(!expr->is_mem()) << expr;
+  expr->DepthFirstVisitPrePost(*this);
+  return bits_.at(expr);
+}
+
+const AigerWriter::Words& AigerWriter::WordsOf(const ExprPtr& expr) {
+  ILA_ASSERT(expr->is_mem()) << expr;
+  expr->DepthFirstVisitPrePost(*this);
+  return words_.at(expr);
+}
+
+AigerWriter::Lit AigerWriter::And(const Lit& a, const Lit& b) {
+  // constant propagation and trivial cases
+  if (a == kAigFalse || b == kAigFalse || a == (b ^ 1)) {
+    return kAigFalse;
+  }
+  if (a == kAigTrue || a == b) {
+    return b;
+  }
+  if (b == kAigTrue) {
+    return a;
+  }
+
+  // structural hashing
+  auto lo = std::min(a, b);
+  auto hi = std::max(a, b);
+  auto key = (static_cast<uint64_t>(hi) << 32) | lo;
+  if (auto pos = strash_.find(key); pos != strash_.end()) {
+    return pos->second;
+  }
+  unsigned var = kinds_.size();
+  kinds_.push_back(VarKind::kAnd);
+  ands_.push_back({hi, lo});
+  strash_.emplace(key, 2 * var);
+  return 2 * var;
+}
+
+AigerWriter::Lit AigerWriter::Or(const Lit& a, const Lit& b) {
+  return And(a ^ 1, b ^ 1) ^ 1;
+}
+
+AigerWriter::Lit AigerWriter::Xor(const Lit& a, const Lit& b) {
+  return Or(And(a, b ^ 1), And(a ^ 1, b));
+}
+
+AigerWriter::Lit AigerWriter::Mux(const Lit& c, const Lit& t, const Lit& e) {
+  if (t == e) {
+    return t;
+  }
+  return Or(And(c, t), And(c ^ 1, e));
+}
+
+AigerWriter::Bits AigerWriter::Const(const int& width,
+                                     const uint64_t& val) const {
+  Bits res(width, kAigFalse);
+  for (int i = 0; i < width && i < 64; i++) {
+    res[i] = ((val >> i) & 1) ? kAigTrue : kAigFalse;
+  }
+  return res;
+}
+
+AigerWriter::Bits AigerWriter::Not(const Bits& a) const {
+  Bits res;
+  for (auto& l : a) {
+    res.push_back(l ^ 1);
+  }
+  return res;
+}
+
+AigerWriter::Bits AigerWriter::Bitwise(const Bits& a, const Bits& b,
+                                       const AstUidExprOp& op) {
+  Bits res;
+  for (size_t i = 0; i < a.size(); i++) {
+    switch (op) {
+    case AstUidExprOp::kAnd: {
+      res.push_back(And(a[i], b[i]));
+      break;
+    }
+    case AstUidExprOp::kOr: {
+      res.push_back(Or(a[i], b[i]));
+      break;
+    }
+    default: {
+      ILA_ASSERT(op == AstUidExprOp::kXor);
+      res.push_back(Xor(a[i], b[i]));
+      break;
+    }
+    }; // switch op
+  }
+  return res;
+}
+
+AigerWriter::Bits AigerWriter::Mux(const Lit& c, const Bits& t,
+                                   const Bits& e) {
+  Bits res;
+  for (size_t i = 0; i < t.size(); i++) {
+    res.push_back(Mux(c, t[i], e[i]));
+  }
+  return res;
+}
+
+AigerWriter::Bits AigerWriter::Add(const Bits& a, const Bits& b,
+                                   const Lit& carry_in, Lit* carry_out) {
+  // ripple-carry adder
+  Bits res;
+  auto carry = carry_in;
+  for (size_t i = 0; i < a.size(); i++) {
+    auto half = Xor(a[i], b[i]);
+    res.push_back(Xor(half, carry));
+    carry = Or(And(a[i], b[i]), And(carry, half));
+  }
+  if (carry_out) {
+    *carry_out = carry;
+  }
+  return res;
+}
+
+AigerWriter::Bits AigerWriter::Neg(const Bits& a) {
+  return Add(Not(a), Const(a.size(), 0), kAigTrue);
+}
+
+AigerWriter::Bits AigerWriter::Mul(const Bits& a, const Bits& b) {
+  // shift-and-add, truncated to the width of the operands
+  auto width = a.size();
+  auto res = Const(width, 0);
+  for (size_t i = 0; i < width; i++) {
+    auto row = Const(width, 0);
+    for (size_t j = 0; i + j < width; j++) {
+      row[i + j] = And(a[j], b[i]);
+    }
+    res = Add(res, row, kAigFalse);
+  }
+  return res;
+}
+
+void AigerWriter::UDivRem(const Bits& a, const Bits& b, Bits& quot,
+                          Bits& rem) {
+  // restoring division, dividing by zero gives all ones and the dividend
+  auto width = a.size();
+  auto divisor = b;
+  divisor.push_back(kAigFalse);
+  auto neg_divisor = Not(divisor);
+
+  quot = Const(width, 0);
+  auto r = Const(width + 1, 0);
+  for (auto i = width; i-- > 0;) {
+    r.pop_back();
+    r.insert(r.begin(), a[i]);
+    Lit no_borrow;
+    auto diff = Add(r, neg_divisor, kAigTrue, &no_borrow);
+    quot[i] = no_borrow;
+    r = Mux(no_borrow, diff, r);
+  }
+  rem = Bits(r.begin(), r.begin() + width);
+}
+
+AigerWriter::Bits AigerWriter::Abs(const Bits& a) {
+  return Mux(a.back(), Neg(a), a);
+}
+
+AigerWriter::Bits AigerWriter::Shift(const Bits& a, const Bits& b,
+                                     const AstUidExprOp& op) {
+  // barrel shifter, shifting out all bits if the amount exceeds the width
+  auto width = a.size();
+  auto is_left = (op == AstUidExprOp::kShiftLeft);
+  auto fill = (op == AstUidExprOp::kArithShiftRight) ? a.back() : kAigFalse;
+
+  auto res = a;
+  auto overflow = kAigFalse;
+  for (size_t k = 0; k < b.size(); k++) {
+    if (k >= 32 || (size_t(1) << k) >= width) {
+      overflow = Or(overflow, b[k]);
+      continue;
+    }
+    auto amount = size_t(1) << k;
+    Bits shifted(width, fill);
+    for (size_t i = 0; i < width; i++) {
+      if (is_left) {
+        shifted[i] = (i >= amount) ? res[i - amount] : kAigFalse;
+      } else if (i + amount < width) {
+        shifted[i] = res[i + amount];
+      }
+    }
+    res = Mux(b[k], shifted, res);
+  }
+  return Mux(overflow, Bits(width, is_left ? kAigFalse : fill), res);
+}
+
+AigerWriter::Lit AigerWriter::Eq(const Bits& a, const Bits& b) {
+  auto res = kAigTrue;
+  for (size_t i = 0; i < a.size(); i++) {
+    res = And(res, Xor(a[i], b[i]) ^ 1);
+  }
+  return res;
+}
+
+AigerWriter::Lit AigerWriter::Ult(const Bits& a, const Bits& b) {
+  // a < b iff a - b borrows
+  Lit no_borrow;
+  Add(a, Not(b), kAigTrue, &no_borrow);
+  return no_borrow ^ 1;
+}
+
+AigerWriter::Lit AigerWriter::Slt(const Bits& a, const Bits& b) {
+  // flip the sign bits and compare unsigned
+  auto a_flip = a;
+  auto b_flip = b;
+  a_flip.back() ^= 1;
+  b_flip.back() ^= 1;
+  return Ult(a_flip, b_flip);
+}
+
+AigerWriter::Lit AigerWriter::ReduceOr(const Bits& a) {
+  auto res = kAigFalse;
+  for (auto& l : a) {
+    res = Or(res, l);
+  }
+  return res;
+}
+
+AigerWriter::Bits AigerWriter::Load(const Words& mem, const Bits& addr) {
+  // mux tree over the address bits
+  auto level = mem;
+  for (size_t k = 0; level.size() > 1; k++) {
+    Words next;
+    for (size_t i = 0; i < level.size(); i += 2) {
+      next.push_back((i + 1 < level.size())
+                         ? Mux(addr.at(k), level[i + 1], level[i])
+                         : level[i]);
+    }
+    level.swap(next);
+  }
+  return level.at(0);
+}
+
+AigerWriter::Words AigerWriter::Store(const Words& mem, const Bits& addr,
+                                      const Bits& data) {
+  Words res;
+  for (size_t i = 0; i < mem.size(); i++) {
+    auto hit = Eq(addr, Const(addr.size(), i));
+    res.push_back(Mux(hit, data, mem[i]));
+  }
+  return res;
+}
+
+void AigerWriter::BlastOp(const ExprPtr& expr) {
+  auto Arg = [this, &expr](const size_t& i) -> const Bits& {
+    return bits_.at(expr->arg(i));
+  };
+  auto ArgWords = [this, &expr](const size_t& i) -> const Words& {
+    return words_.at(expr->arg(i));
+  };
+  auto Single = [](const Lit& l) { return Bits(1, l); };
+
+  Bits res;
+  switch (auto expr_op_uid = asthub::GetUidExprOp(expr); expr_op_uid) {
+  case AstUidExprOp::kNegate: {
+    res = Neg(Arg(0));
+    break;
+  }
+  case AstUidExprOp::kNot:
+  case AstUidExprOp::kComplement: {
+    res = Not(Arg(0));
+    break;
+  }
+  case AstUidExprOp::kAnd:
+  case AstUidExprOp::kOr:
+  case AstUidExprOp::kXor: {
+    res = Bitwise(Arg(0), Arg(1), expr_op_uid);
+    break;
+  }
+  case AstUidExprOp::kShiftLeft:
+  case AstUidExprOp::kArithShiftRight:
+  case AstUidExprOp::kLogicShiftRight: {
+    res = Shift(Arg(0), Arg(1), expr_op_uid);
+    break;
+  }
+  case AstUidExprOp::kAdd: {
+    res = Add(Arg(0), Arg(1), kAigFalse);
+    break;
+  }
+  case AstUidExprOp::kSubtract: {
+    res = Add(Arg(0), Not(Arg(1)), kAigTrue);
+    break;
+  }
+  case AstUidExprOp::kMultiply: {
+    res = Mul(Arg(0), Arg(1));
+    break;
+  }
+  case AstUidExprOp::kDivide: {
+    // signed bv div, same as the z3 and smt-switch translation
+    Bits quot, rem;
+    UDivRem(Abs(Arg(0)), Abs(Arg(1)), quot, rem);
+    res = Mux(Xor(Arg(0).back(), Arg(1).back()), Neg(quot), quot);
+    break;
+  }
+  case AstUidExprOp::kSignedRemainder: {
+    Bits quot, rem;
+    UDivRem(Abs(Arg(0)), Abs(Arg(1)), quot, rem);
+    res = Mux(Arg(0).back(), Neg(rem), rem);
+    break;
+  }
+  case AstUidExprOp::kUnsignedRemainder: {
+    Bits quot;
+    UDivRem(Arg(0), Arg(1), quot, res);
+    break;
+  }
+  case AstUidExprOp::kSignedModular: {
+    // the remainder takes the sign of the divisor
+    Bits quot, rem;
+    UDivRem(Abs(Arg(0)), Abs(Arg(1)), quot, rem);
+    auto signed_rem = Mux(Arg(0).back(), Neg(rem), rem);
+    auto adjusted = Mux(Xor(Arg(0).back(), Arg(1).back()),
+                        Add(signed_rem, Arg(1), kAigFalse), signed_rem);
+    res = Mux(ReduceOr(rem), adjusted, rem);
+    break;
+  }
+  case AstUidExprOp::kEqual: {
+    if (expr->arg(0)->is_mem()) {
+      auto eq = kAigTrue;
+      for (size_t a = 0; a < ArgWords(0).size(); a++) {
+        eq = And(eq, Eq(ArgWords(0)[a], ArgWords(1)[a]));
+      }
+      res = Single(eq);
+    } else {
+      res = Single(Eq(Arg(0), Arg(1)));
+    }
+    break;
+  }
+  case AstUidExprOp::kLessThan: {
+    res = Single(Slt(Arg(0), Arg(1)));
+    break;
+  }
+  case AstUidExprOp::kGreaterThan: {
+    res = Single(Slt(Arg(1), Arg(0)));
+    break;
+  }
+  case AstUidExprOp::kUnsignedLessThan: {
+    res = Single(Ult(Arg(0), Arg(1)));
+    break;
+  }
+  case AstUidExprOp::kUnsignedGreaterThan: {
+    res = Single(Ult(Arg(1), Arg(0)));
+    break;
+  }
+  case AstUidExprOp::kLoad: {
+    res = Load(ArgWords(0), Arg(1));
+    break;
+  }
+  case AstUidExprOp::kStore: {
+    words_[expr] = Store(ArgWords(0), Arg(1), Arg(2));
+    return;
+  }
+  case AstUidExprOp::kConcatenate: {
+    // the first argument is the most significant part
+    res = Arg(1);
+    res.insert(res.end(), Arg(0).begin(), Arg(0).end());
+    break;
+  }
+  case AstUidExprOp::kExtract: {
+    auto& arg = Arg(0);
+    res.assign(arg.begin() + expr->param(1), arg.begin() + expr->param(0) + 1);
+    break;
+  }
+  case AstUidExprOp::kZeroExtend:
+  case AstUidExprOp::kSignedExtend: {
+    res = Arg(0);
+    auto fill = (expr_op_uid == AstUidExprOp::kSignedExtend) ? res.back()
+                                                             : kAigFalse;
+    res.resize(expr->param(0), fill);
+    break;
+  }
+  case AstUidExprOp::kRotateLeft:
+  case AstUidExprOp::kRotateRight: {
+    auto& arg = Arg(0);
+    auto width = arg.size();
+    auto amount = static_cast<size_t>(expr->param(0)) % width;
+    if (expr_op_uid == AstUidExprOp::kRotateLeft) {
+      amount = width - amount;
+    }
+    for (size_t i = 0; i < width; i++) {
+      res.push_back(arg[(i + amount) % width]);
+    }
+    break;
+  }
+  case AstUidExprOp::kImply: {
+    res = Single(Or(Arg(0).at(0) ^ 1, Arg(1).at(0)));
+    break;
+  }
+  case AstUidExprOp::kIfThenElse: {
+    auto cond = Arg(0).at(0);
+    if (expr->is_mem()) {
+      Words words;
+      for (size_t a = 0; a < ArgWords(1).size(); a++) {
+        words.push_back(Mux(cond, ArgWords(1)[a], ArgWords(2)[a]));
+      }
+      words_[expr] = words;
+      return;
+    }
+    res = Mux(cond, Arg(1), Arg(2));
+    break;
+  }
+  case AstUidExprOp::kApplyFunc: {
+    // no uninterpreted functions in AIG, use fresh inputs per application
+    ILA_WARN << "Over-approximate " << expr << " with fresh inputs";
+    auto func = std::static_pointer_cast<ExprOpAppFunc>(expr)->func();
+    auto name = fmt::format("{}_app{}", func->name().str(), expr->name().id());
+    auto width = expr->is_bool() ? 1 : expr->sort()->bit_width();
+    for (int b = 0; b < width; b++) {
+      res.push_back(NewInput(fmt::format("{}[{}]", name, b)));
+    }
+    break;
+  }
+  default: {
+    ILA_ERROR << "Op " << expr_op_uid << " not supported in AIGER";
+    failed_ = true;
+    res = Const(expr->is_bool() ? 1 : expr->sort()->bit_width(), 0);
+    break;
+  }
+  }; // switch expr_op_uid
+
+  ILA_ASSERT(expr->is_mem() || res.size() == static_cast<size_t>(
+                                   expr->is_bool() ? 1
+                                                   : expr->sort()->bit_width()))
+      << expr;
+  bits_[expr] = res;
+}
+
+// encode an unsigned integer in the 7-bit variable length format
+static void WriteDelta(std::ostream& out, unsigned x) {
+  while (x & ~0x7fu) {
+    out.put(static_cast<char>((x & 0x7f) | 0x80));
+    x >>= 7;
+  }
+  out.put(static_cast<char>(x));
+}
+
+bool AigerWriter::WriteAiger(std::ostream& out, const std::vector<Lit>& outputs,
+                             const std::vector<std::string>& output_names,
+                             const std::vector<Lit>& constraints) const {
+  // AIGER requires inputs, latches, and AND gates to be numbered in order
+  std::vector<unsigned> var_map(kinds_.size(), 0);
+  unsigned idx = 0;
+  for (auto& [var, name] : inputs_) {
+    var_map[var] = ++idx;
+  }
+  for (auto& [var, name] : latches_) {
+    var_map[var] = ++idx;
+  }
+  for (size_t var = 0; var < kinds_.size(); var++) {
+    if (kinds_[var] == VarKind::kAnd) {
+      var_map[var] = ++idx;
+    }
+  }
+  auto Map = [&var_map](const Lit& l) { return 2 * var_map[l >> 1] | (l & 1); };
+
+  // header
+  out << fmt::format("aig {} {} {} {} {}", idx, inputs_.size(),
+                     latches_.size(), outputs.size(), ands_.size());
+  if (!constraints.empty()) {
+    out << fmt::format(" 0 {}", constraints.size());
+  }
+  out << "\n";
+
+  // latches (next and reset), outputs, and constraints
+  for (size_t i = 0; i < latches_.size(); i++) {
+    auto reset = latch_reset_[i];
+    out << Map(latch_next_[i]);
+    if (reset != kAigFalse) {
+      out << " " << Map(reset);
+    }
+    out << "\n";
+  }
+  for (auto& l : outputs) {
+    out << Map(l) << "\n";
+  }
+  for (auto& l : constraints) {
+    out << Map(l) << "\n";
+  }
+
+  // AND gates (binary)
+  size_t and_idx = 0;
+  for (size_t var = 0; var < kinds_.size(); var++) {
+    if (kinds_[var] != VarKind::kAnd) {
+      continue;
+    }
+    auto lhs = 2 * var_map[var];
+    auto rhs0 = Map(ands_[and_idx].first);
+    auto rhs1 = Map(ands_[and_idx].second);
+    if (rhs0 < rhs1) {
+      std::swap(rhs0, rhs1);
+    }
+    ILA_ASSERT(lhs > rhs0);
+    WriteDelta(out, lhs - rhs0);
+    WriteDelta(out, rhs0 - rhs1);
+    and_idx++;
+  }
+
+  // symbol table
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    out << "i" << i << " " << inputs_[i].second << "\n";
+  }
+  for (size_t i = 0; i < latches_.size(); i++) {
+    out << "l" << i << " " << latches_[i].second << "\n";
+  }
+  for (size_t i = 0; i < output_names.size(); i++) {
+    out << "o" << i << " " << output_names[i] << "\n";
+  }
+  out << "c\n" << m_->name().str() << "\n";
+
+  return static_cast<bool>(out);
+}
+
+} // namespace ilang
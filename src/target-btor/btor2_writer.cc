@@ -0,0 +1,379 @@
+/// \file
+/// Source for the ILA to BTOR2 writer.
+
+#include <ilang/target-btor/btor2_writer.h>
+
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include <ilang/ila/ast_hub.h>
+#include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
+
+/// \namespace ilang
+namespace ilang {
+
+Btor2Writer::Btor2Writer(const InstrLvlAbsCnstPtr& m) : m_(m) {}
+
+Btor2Writer::~Btor2Writer() {}
+
+bool Btor2Writer::WriteToFile(const std::string& file_name) {
+  std::ofstream fw(file_name);
+  if (!fw.is_open()) {
+    ILA_ERROR << "Fail opening file " << file_name;
+    return false;
+  }
+  return Write(fw);
+}
+
+bool Btor2Writer::Write(std::ostream& out) {
+  ILA_TRACE_SCOPE("btor.write");
+  ILA_NOT_NULL(m_);
+  ILA_WARN_IF(m_->child_num() != 0)
+      << "Child-ILAs of " << m_ << " are not translated to BTOR2";
+
+  out_ = &out;
+  last_id_ = 0;
+  expr_map_.clear();
+  line_map_.clear();
+  bv_sorts_.clear();
+  mem_sorts_.clear();
+  approximated_ = false;
+
+  out << "; BTOR2 of ILA " << m_->name().str() << "\n";
+
+  // inputs and states
+  for (size_t i = 0; i < m_->input_num(); i++) {
+    auto var = m_->input(i);
+    auto sid = SortOf(var->sort());
+    expr_map_[var] = Emit(fmt::format("input {} {}", sid, var->name().str()));
+  }
+  for (size_t i = 0; i < m_->state_num(); i++) {
+    auto var = m_->state(i);
+    auto sid = SortOf(var->sort());
+    expr_map_[var] = Emit(fmt::format("state {} {}", sid, var->name().str()));
+  }
+
+  // initial conditions only hold when the initial flag is set
+  auto bool_sort = BvSort(1);
+  if (m_->init_num() != 0) {
+    auto init_flag = Emit(fmt::format("state {} __init__", bool_sort));
+    Emit(fmt::format("init {} {} {}", bool_sort, init_flag, BvConst(1, 1)));
+    Emit(fmt::format("next {} {} {}", bool_sort, init_flag, BvConst(1, 0)));
+    for (size_t i = 0; i < m_->init_num(); i++) {
+      auto cond = NodeOf(m_->init(i));
+      auto guarded = Emit(
+          fmt::format("implies {} {} {}", bool_sort, init_flag, cond));
+      Emit(fmt::format("constraint {}", guarded));
+    }
+  }
+
+  // valid and decode functions
+  auto valid = m_->valid();
+  if (!valid) {
+    valid = asthub::BoolConst(true);
+    ILA_WARN << "Use default (true) valid for " << m_;
+  }
+  auto valid_node = NodeOf(valid);
+  Emit(fmt::format("output {} __valid__", valid_node));
+
+  std::vector<NodeId> grants;
+  for (size_t i = 0; i < m_->instr_num(); i++) {
+    auto instr = m_->instr(i);
+    auto decode = instr->decode();
+    if (!decode) {
+      decode = asthub::BoolConst(true);
+      ILA_WARN << "Use default (true) decode for " << instr;
+    }
+    auto decode_node = NodeOf(decode);
+    Emit(fmt::format("output {} __decode_of_{}__", decode_node,
+                     instr->name().str()));
+    grants.push_back(Emit(
+        fmt::format("and {} {} {}", bool_sort, valid_node, decode_node)));
+  }
+
+  // next state functions
+  for (size_t i = 0; i < m_->state_num(); i++) {
+    EmitNext(m_->state(i), grants);
+  }
+
+  out_ = nullptr;
+  ILA_WARN_IF(approximated_)
+      << "BTOR2 of " << m_ << " over-approximates uninterpreted functions";
+  return static_cast<bool>(out);
+}
+
+bool Btor2Writer::pre(const ExprPtr& expr) {
+  return (expr_map_.find(expr) != expr_map_.end());
+}
+
+void Btor2Writer::post(const ExprPtr& expr) {
+  std::vector<NodeId> args;
+  for (size_t i = 0; i < expr->arg_num(); i++) {
+    auto pos = expr_map_.find(expr->arg(i));
+    ILA_ASSERT(pos != expr_map_.end()) << expr->arg(i);
+    args.push_back(pos->second);
+  }
+
+  NodeId res;
+  if (expr->is_var()) {
+    // variables out of the ILA, e.g., states of the parent
+    ILA_WARN << expr << " is not defined in " << m_ << ", use as input";
+    res = Emit(
+        fmt::format("input {} {}", SortOf(expr->sort()), expr->name().str()));
+  } else if (expr->is_const()) {
+    res = EmitConst(expr);
+  } else {
+    ILA_ASSERT(expr->is_op());
+    res = EmitOp(expr, args);
+  }
+  expr_map_.insert({expr, res});
+}
+
+Btor2Writer::NodeId Btor2Writer::Emit(const std::string& line) {
+  ILA_NOT_NULL(out_);
+  *out_ << ++last_id_ << " " << line << "\n";
+  return last_id_;
+}
+
+Btor2Writer::NodeId Btor2Writer::EmitShared(const std::string& line) {
+  auto pos = line_map_.find(line);
+  if (pos != line_map_.end()) {
+    return pos->second;
+  }
+  auto id = Emit(line);
+  line_map_.emplace(line, id);
+  return id;
+}
+
+Btor2Writer::NodeId Btor2Writer::BvSort(const int& width) {
+  auto pos = bv_sorts_.find(width);
+  if (pos != bv_sorts_.end()) {
+    return pos->second;
+  }
+  auto sid = Emit(fmt::format("sort bitvec {}", width));
+  bv_sorts_.emplace(width, sid);
+  return sid;
+}
+
+Btor2Writer::NodeId Btor2Writer::SortOf(const SortPtr& sort) {
+  switch (auto sort_uid = sort->uid(); sort_uid) {
+  case AstUidSort::kBool: {
+    return BvSort(1);
+  }
+  case AstUidSort::kBv: {
+    return BvSort(sort->bit_width());
+  }
+  default: {
+    ILA_ASSERT(sort_uid == AstUidSort::kMem);
+    auto key = std::make_pair(sort->addr_width(), sort->data_width());
+    auto pos = mem_sorts_.find(key);
+    if (pos != mem_sorts_.end()) {
+      return pos->second;
+    }
+    auto addr_sort = BvSort(sort->addr_width());
+    auto data_sort = BvSort(sort->data_width());
+    auto sid = Emit(fmt::format("sort array {} {}", addr_sort, data_sort));
+    mem_sorts_.emplace(key, sid);
+    return sid;
+  }
+  }; // switch sort_uid
+}
+
+Btor2Writer::NodeId Btor2Writer::NodeOf(const ExprPtr& expr) {
+  expr->DepthFirstVisitPrePost(*this);
+  auto pos = expr_map_.find(expr);
+  ILA_ASSERT(pos != expr_map_.end()) << expr;
+  return pos->second;
+}
+
+Btor2Writer::NodeId Btor2Writer::BvConst(const int& width,
+                                         const uint64_t& val) {
+  std::string bits(width, '0');
+  for (int i = 0; i < width && i < 64; i++) {
+    bits[width - 1 - i] = ((val >> i) & 1) ? '1' : '0';
+  }
+  return EmitShared(fmt::format("const {} {}", BvSort(width), bits));
+}
+
+Btor2Writer::NodeId Btor2Writer::EmitConst(const ExprPtr& expr) {
+  auto expr_const = std::static_pointer_cast<ExprConst>(expr);
+
+  switch (auto sort_uid = asthub::GetUidSort(expr); sort_uid) {
+  case AstUidSort::kBool: {
+    return BvConst(1, expr_const->val_bool()->val() ? 1 : 0);
+  }
+  case AstUidSort::kBv: {
+    return BvConst(expr->sort()->bit_width(), expr_const->val_bv()->val());
+  }
+  default: {
+    ILA_ASSERT(sort_uid == AstUidSort::kMem);
+    // a state holding the default value, then write in the non-default ones
+    auto addr_width = expr->sort()->addr_width();
+    auto data_width = expr->sort()->data_width();
+    auto mem_sort = SortOf(expr->sort());
+    auto memory_value = expr_const->val_mem();
+    auto def_val = BvConst(data_width, memory_value->def_val());
+    auto mem = Emit(fmt::format("state {}", mem_sort));
+    Emit(fmt::format("init {} {} {}", mem_sort, mem, def_val));
+    Emit(fmt::format("next {} {} {}", mem_sort, mem, mem));
+
+    for (const auto& p : memory_value->val_map()) {
+      auto addr = BvConst(addr_width, p.first);
+      auto data = BvConst(data_width, p.second);
+      mem = Emit(fmt::format("write {} {} {} {}", mem_sort, mem, addr, data));
+    }
+    return mem;
+  }
+  }; // switch sort_uid
+}
+
+Btor2Writer::NodeId Btor2Writer::EmitOp(const ExprPtr& expr,
+                                        const std::vector<NodeId>& args) {
+  auto sid = SortOf(expr->sort());
+
+  auto Unary = [this, &sid, &args](const std::string& op) {
+    return EmitShared(fmt::format("{} {} {}", op, sid, args.at(0)));
+  };
+  auto Binary = [this, &sid, &args](const std::string& op) {
+    return EmitShared(
+        fmt::format("{} {} {} {}", op, sid, args.at(0), args.at(1)));
+  };
+  auto Ternary = [this, &sid, &args](const std::string& op) {
+    return EmitShared(fmt::format("{} {} {} {} {}", op, sid, args.at(0),
+                                  args.at(1), args.at(2)));
+  };
+
+  // construct based on the operator
+  switch (auto expr_op_uid = asthub::GetUidExprOp(expr); expr_op_uid) {
+  case AstUidExprOp::kNegate: {
+    return Unary("neg");
+  }
+  case AstUidExprOp::kNot:
+  case AstUidExprOp::kComplement: {
+    return Unary("not");
+  }
+  case AstUidExprOp::kAnd: {
+    return Binary("and");
+  }
+  case AstUidExprOp::kOr: {
+    return Binary("or");
+  }
+  case AstUidExprOp::kXor: {
+    return Binary("xor");
+  }
+  case AstUidExprOp::kShiftLeft: {
+    return Binary("sll");
+  }
+  case AstUidExprOp::kArithShiftRight: {
+    return Binary("sra");
+  }
+  case AstUidExprOp::kLogicShiftRight: {
+    return Binary("srl");
+  }
+  case AstUidExprOp::kAdd: {
+    return Binary("add");
+  }
+  case AstUidExprOp::kSubtract: {
+    return Binary("sub");
+  }
+  case AstUidExprOp::kDivide: {
+    // signed bv div, same as the z3 and smt-switch translation
+    return Binary("sdiv");
+  }
+  case AstUidExprOp::kSignedRemainder: {
+    return Binary("srem");
+  }
+  case AstUidExprOp::kUnsignedRemainder: {
+    return Binary("urem");
+  }
+  case AstUidExprOp::kSignedModular: {
+    return Binary("smod");
+  }
+  case AstUidExprOp::kMultiply: {
+    return Binary("mul");
+  }
+  case AstUidExprOp::kEqual: {
+    return Binary("eq");
+  }
+  case AstUidExprOp::kLessThan: {
+    return Binary("slt");
+  }
+  case AstUidExprOp::kGreaterThan: {
+    return Binary("sgt");
+  }
+  case AstUidExprOp::kUnsignedLessThan: {
+    return Binary("ult");
+  }
+  case AstUidExprOp::kUnsignedGreaterThan: {
+    return Binary("ugt");
+  }
+  case AstUidExprOp::kLoad: {
+    return Binary("read");
+  }
+  case AstUidExprOp::kStore: {
+    return Ternary("write");
+  }
+  case AstUidExprOp::kConcatenate: {
+    return Binary("concat");
+  }
+  case AstUidExprOp::kExtract: {
+    return EmitShared(fmt::format("slice {} {} {} {}", sid, args.at(0),
+                                  expr->param(0), expr->param(1)));
+  }
+  case AstUidExprOp::kZeroExtend:
+  case AstUidExprOp::kSignedExtend: {
+    // the param in BTOR2 is the diff
+    auto diff = expr->param(0) - expr->arg(0)->sort()->bit_width();
+    auto op = (expr_op_uid == AstUidExprOp::kZeroExtend) ? "uext" : "sext";
+    return EmitShared(fmt::format("{} {} {} {}", op, sid, args.at(0), diff));
+  }
+  case AstUidExprOp::kRotateLeft:
+  case AstUidExprOp::kRotateRight: {
+    auto op = (expr_op_uid == AstUidExprOp::kRotateLeft) ? "rol" : "ror";
+    auto width = expr->sort()->bit_width();
+    auto amount = BvConst(width, expr->param(0) % width);
+    return EmitShared(fmt::format("{} {} {} {}", op, sid, args.at(0), amount));
+  }
+  case AstUidExprOp::kImply: {
+    return Binary("implies");
+  }
+  case AstUidExprOp::kIfThenElse: {
+    return Ternary("ite");
+  }
+  case AstUidExprOp::kApplyFunc: {
+    // BTOR2 has no uninterpreted functions, use a fresh input per application
+    approximated_ = true;
+    auto func = std::static_pointer_cast<ExprOpAppFunc>(expr)->func();
+    return Emit(fmt::format("input {} {}_app{}", sid, func->name().str(),
+                            expr->name().id()));
+  }
+  default: {
+    ILA_CHECK(false) << "Op " << expr_op_uid << " not supported in BTOR2";
+    return Unary("not");
+  }
+  }; // switch expr_op_uid
+}
+
+void Btor2Writer::EmitNext(const ExprPtr& state,
+                           const std::vector<NodeId>& grants) {
+  auto sid = SortOf(state->sort());
+  auto state_node = NodeOf(state);
+
+  // the first decoded instruction (in the order of declaration) takes effect
+  auto next = state_node;
+  for (auto i = m_->instr_num(); i-- > 0;) {
+    auto update = m_->instr(i)->update(state);
+    if (!update) {
+      continue;
+    }
+    auto update_node = NodeOf(update);
+    next = EmitShared(
+        fmt::format("ite {} {} {} {}", sid, grants.at(i), update_node, next));
+  }
+
+  Emit(fmt::format("next {} {} {}", sid, state_node, next));
+}
+
+} // namespace ilang
@@ -35,78 +35,79 @@ AST_UID_EXPR GetUidExpr(const ExprPtr& expr) {
 }
 
 AST_UID_EXPR_OP GetUidExprOp(const ExprPtr& expr) {
-  auto expr_op = std::dynamic_pointer_cast<ExprOp>(expr);
-  if (!expr_op) {
+  if (!expr->is_op()) {
     return AST_UID_EXPR_OP::INVALID;
   }
 
-  if (std::dynamic_pointer_cast<ExprOpNeg>(expr_op)) {
+  switch (static_cast<const ExprOp*>(expr.get())->uid()) {
+  case AstUidExprOp::kNegate:
     return AST_UID_EXPR_OP::NEG;
-  } else if (std::dynamic_pointer_cast<ExprOpNot>(expr_op)) {
+  case AstUidExprOp::kNot:
     return AST_UID_EXPR_OP::NOT;
-  } else if (std::dynamic_pointer_cast<ExprOpCompl>(expr_op)) {
+  case AstUidExprOp::kComplement:
     return AST_UID_EXPR_OP::COMPL;
-  } else if (std::dynamic_pointer_cast<ExprOpAnd>(expr_op)) {
+  case AstUidExprOp::kAnd:
     return AST_UID_EXPR_OP::AND;
-  } else if (std::dynamic_pointer_cast<ExprOpOr>(expr_op)) {
+  case AstUidExprOp::kOr:
     return AST_UID_EXPR_OP::OR;
-  } else if (std::dynamic_pointer_cast<ExprOpXor>(expr_op)) {
+  case AstUidExprOp::kXor:
     return AST_UID_EXPR_OP::XOR;
-  } else if (std::dynamic_pointer_cast<ExprOpShl>(expr_op)) {
+  case AstUidExprOp::kShiftLeft:
     return AST_UID_EXPR_OP::SHL;
-  } else if (std::dynamic_pointer_cast<ExprOpAshr>(expr_op)) {
+  case AstUidExprOp::kArithShiftRight:
     return AST_UID_EXPR_OP::ASHR;
-  } else if (std::dynamic_pointer_cast<ExprOpLshr>(expr_op)) {
+  case AstUidExprOp::kLogicShiftRight:
     return AST_UID_EXPR_OP::LSHR;
-  } else if (std::dynamic_pointer_cast<ExprOpAdd>(expr_op)) {
+  case AstUidExprOp::kAdd:
     return AST_UID_EXPR_OP::ADD;
-  } else if (std::dynamic_pointer_cast<ExprOpSub>(expr_op)) {
+  case AstUidExprOp::kSubtract:
     return AST_UID_EXPR_OP::SUB;
-  } else if (std::dynamic_pointer_cast<ExprOpDiv>(expr_op)) {
+  case AstUidExprOp::kDivide:
     return AST_UID_EXPR_OP::DIV;
-  } else if (std::dynamic_pointer_cast<ExprOpSRem>(expr_op)) {
+  case AstUidExprOp::kSignedRemainder:
     return AST_UID_EXPR_OP::SREM;
-  } else if (std::dynamic_pointer_cast<ExprOpURem>(expr_op)) {
+  case AstUidExprOp::kUnsignedRemainder:
     return AST_UID_EXPR_OP::UREM;
-  } else if (std::dynamic_pointer_cast<ExprOpSMod>(expr_op)) {
+  case AstUidExprOp::kSignedModular:
     return AST_UID_EXPR_OP::SMOD;
-  } else if (std::dynamic_pointer_cast<ExprOpMul>(expr_op)) {
+  case AstUidExprOp::kMultiply:
     return AST_UID_EXPR_OP::MUL;
-  } else if (std::dynamic_pointer_cast<ExprOpEq>(expr_op)) {
+  case AstUidExprOp::kEqual:
     return AST_UID_EXPR_OP::EQ;
-  } else if (std::dynamic_pointer_cast<ExprOpLt>(expr_op)) {
+  case AstUidExprOp::kLessThan:
     return AST_UID_EXPR_OP::LT;
-  } else if (std::dynamic_pointer_cast<ExprOpGt>(expr_op)) {
+  case AstUidExprOp::kGreaterThan:
     return AST_UID_EXPR_OP::GT;
-  } else if (std::dynamic_pointer_cast<ExprOpUlt>(expr_op)) {
+  case AstUidExprOp::kUnsignedLessThan:
     return AST_UID_EXPR_OP::ULT;
-  } else if (std::dynamic_pointer_cast<ExprOpUgt>(expr_op)) {
+  case AstUidExprOp::kUnsignedGreaterThan:
     return AST_UID_EXPR_OP::UGT;
-  } else if (std::dynamic_pointer_cast<ExprOpLoad>(expr_op)) {
+  case AstUidExprOp::kLoad:
     return AST_UID_EXPR_OP::LOAD;
-  } else if (std::dynamic_pointer_cast<ExprOpStore>(expr_op)) {
+  case AstUidExprOp::kStore:
     return AST_UID_EXPR_OP::STORE;
-  } else if (std::dynamic_pointer_cast<ExprOpConcat>(expr_op)) {
+  case AstUidExprOp::kConcatenate:
     return AST_UID_EXPR_OP::CONCAT;
-  } else if (std::dynamic_pointer_cast<ExprOpExtract>(expr_op)) {
+  case AstUidExprOp::kExtract:
     return AST_UID_EXPR_OP::EXTRACT;
-  } else if (std::dynamic_pointer_cast<ExprOpZExt>(expr_op)) {
+  case AstUidExprOp::kZeroExtend:
     return AST_UID_EXPR_OP::ZEXT;
-  } else if (std::dynamic_pointer_cast<ExprOpSExt>(expr_op)) {
+  case AstUidExprOp::kSignedExtend:
     return AST_UID_EXPR_OP::SEXT;
-  } else if (std::dynamic_pointer_cast<ExprOpLRotate>(expr_op)) {
+  case AstUidExprOp::kRotateLeft:
     return AST_UID_EXPR_OP::LROTATE;
-  } else if (std::dynamic_pointer_cast<ExprOpRRotate>(expr_op)) {
+  case AstUidExprOp::kRotateRight:
     return AST_UID_EXPR_OP::RROTATE;
-  } else if (std::dynamic_pointer_cast<ExprOpAppFunc>(expr_op)) {
+  case AstUidExprOp::kApplyFunc:
     return AST_UID_EXPR_OP::APP_FUNC;
-  } else if (std::dynamic_pointer_cast<ExprOpImply>(expr_op)) {
+  case AstUidExprOp::kImply:
     return AST_UID_EXPR_OP::IMPLY;
-  } else {
-    auto expr_op_ite = std::dynamic_pointer_cast<ExprOpIte>(expr_op);
-    ILA_NOT_NULL(expr_op_ite);
+  case AstUidExprOp::kIfThenElse:
     return AST_UID_EXPR_OP::ITE;
-  }
+  default:
+    ILA_ASSERT(false) << "Unknown operator " << expr;
+    return AST_UID_EXPR_OP::INVALID;
+  };
 }
 
 }; // namespace ilang
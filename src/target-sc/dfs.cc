@@ -494,7 +494,7 @@ void IlaSim::dfs_func_op(std::stringstream& dfs_simulator, std::string& indent,
                          const ExprPtr& expr) {
   dfs_func_op_check(expr);
   auto id = expr->name().id();
-  auto appfunc_expr = std::dynamic_pointer_cast<ExprOpAppFunc>(expr);
+  auto appfunc_expr = std::static_pointer_cast<ExprOpAppFunc>(expr);
   auto func = appfunc_expr->func();
   auto func_name = func->name().str();
   if (func_set_.find(func_name) == func_set_.end()) {
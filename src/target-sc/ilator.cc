@@ -3,9 +3,16 @@
 
 #include <ilang/target-sc/ilator.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <fstream>
+#include <sstream>
+#include <thread>
+#include <tuple>
 
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
 #include <z3++.h>
 
 #include <ilang/config.h>
@@ -15,6 +22,8 @@
 #include <ilang/target-smt/z3_expr_adapter.h>
 #include <ilang/util/fs.h>
 #include <ilang/util/log.h>
+#include <ilang/util/str_util.h>
+#include <ilang/util/telemetry.h>
 
 /// \namespace ilang
 namespace ilang {
@@ -27,18 +36,7 @@ static const std::string kDirApp = "app";
 static const std::string kDirSrc = "src";
 static const std::string kDirInclude = "include";
 static const std::string kDirExtern = "extern";
-
-static std::unordered_map<size_t, size_t> kPivotalId;
-
-size_t GetPivotalId(const size_t& id) {
-  if (auto pos = kPivotalId.find(id); pos == kPivotalId.end()) {
-    auto new_id = kPivotalId.size();
-    kPivotalId.insert({id, new_id});
-    return new_id;
-  } else {
-    return pos->second;
-  }
-}
+static const std::string kManifest = "ilator_manifest.json";
 
 void WriteFile(const std::string& file_path, const fmt::memory_buffer& buff) {
   std::ofstream fw(file_path);
@@ -47,6 +45,17 @@ void WriteFile(const std::string& file_path, const fmt::memory_buffer& buff) {
   fw.close();
 }
 
+// names in the ILA, e.g., "I.0", may not be valid C++ identifiers
+std::string ToCxxIdentifier(const std::string& name) {
+  auto res = name;
+  for (auto& c : res) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+      c = '_';
+    }
+  }
+  return res;
+}
+
 bool HasLoadFromStore(const ExprPtr& expr) {
   auto monitor = false;
   auto LoadFromStore = [&monitor](const ExprPtr& e) {
@@ -64,26 +73,30 @@ bool HasLoadFromStore(const ExprPtr& expr) {
 // Ilator implementation
 //
 
-Ilator::Ilator(const InstrLvlAbsPtr& m) : m_(m) {}
+Ilator::Ilator(const InstrLvlAbsPtr& m, bool standalone, int lanes)
+    : m_(m), standalone_(standalone), lanes_(lanes) {
+  ILA_CHECK(lanes_ >= 1 && (standalone_ || lanes_ == 1))
+      << "Multiple lanes only supported in standalone mode";
+}
 
 Ilator::~Ilator() { Reset(); }
 
 void Ilator::Generate(const std::string& dst, bool opt) {
+  ILA_TRACE_SCOPE("ilator.generate");
   // sanity checks and initialize
   if (!SanityCheck() || !Bootstrap(dst, opt)) {
     return;
   }
 
   auto status = true;
-  ILA_INFO << "Start generating SystemC simulator of " << m_;
+  ILA_INFO << "Start generating " << (standalone_ ? "standalone" : "SystemC")
+           << " simulator of " << m_;
 
   // non-instruction basics
   status &= GenerateIlaBasics(os_portable_append_dir(dst, kDirSrc));
 
   // instruction semantics (decode and updates)
-  for (auto& instr : absknob::GetInstrTree(m_)) {
-    status &= GenerateInstrContent(instr, os_portable_append_dir(dst, kDirSrc));
-  }
+  status &= GenerateInstrContents(os_portable_append_dir(dst, kDirSrc));
 
   // memory updates
   status &= GenerateMemoryUpdate(os_portable_append_dir(dst, kDirSrc));
@@ -97,15 +110,24 @@ void Ilator::Generate(const std::string& dst, bool opt) {
   // execution kernel
   status &= GenerateExecuteKernel(os_portable_append_dir(dst, kDirSrc));
 
+  // profiling counters (enabled when building the simulator)
+  status &= GenerateProfile(dst);
+
+  // checkpoint save/restore
+  status &= GenerateCheckpoint(os_portable_append_dir(dst, kDirSrc));
+
   // shared header (input, state, func., etc.)
   status &= GenerateGlobalHeader(os_portable_append_dir(dst, kDirInclude));
 
   // cmake support, e.g., recipe and templates
   status &= GenerateBuildSupport(dst);
 
+  // record generated files for incremental re-generation
+  status &= status && WriteManifest();
+
   // clean up if something went wrong
   if (status) {
-    ILA_INFO << "Sucessfully generate SystemC simulator at " << dst;
+    ILA_INFO << "Sucessfully generate simulator at " << dst;
   } else {
     ILA_ERROR << "Fail generating simulator at " << dst;
 #ifdef NDEBUG
@@ -137,6 +159,14 @@ void Ilator::Reset() {
   source_files_.clear();
   const_mems_.clear();
   global_vars_.clear();
+  digests_.clear();
+  digest_keys_.clear();
+  cxx_ids_.clear();
+  cxx_ids_taken_.clear();
+  prof_instrs_.clear();
+  prof_mems_.clear();
+  prev_manifest_.clear();
+  manifest_.clear();
 }
 
 bool Ilator::SanityCheck() const {
@@ -154,6 +184,19 @@ bool Ilator::Bootstrap(const std::string& root, bool opt) {
     status &= pass::RewriteConditionalStore(m_);
   }
 
+  // index instructions and memories for the profiling counters
+  for (auto& instr : absknob::GetInstrTree(m_)) {
+    prof_instrs_.emplace(instr, prof_instrs_.size());
+  }
+  for (auto& var : absknob::GetSttTree(m_)) {
+    if (var->is_mem()) {
+      prof_mems_.emplace(var, prof_mems_.size());
+    }
+  }
+
+  // assign identifiers before rendering (in parallel)
+  RegisterCxxIds();
+
   // create/structure project directory
   status &= os_portable_mkdir(root);
   status &= os_portable_mkdir(os_portable_append_dir(root, kDirApp));
@@ -165,6 +208,8 @@ bool Ilator::Bootstrap(const std::string& root, bool opt) {
   }
 
   ILA_ERROR_IF(!status) << "Fail bootstraping";
+  root_ = root;
+  LoadManifest();
   return status;
 }
 
@@ -184,6 +229,7 @@ bool Ilator::GenerateIlaBasics(const std::string& dir) {
     }
     auto valid_func = RegisterFunction(GetValidFuncName(m), valid_expr);
     BeginFuncDef(valid_func, buff);
+    WriteFullLaneMask(buff);
     ExprVarMap lut;
     ILA_CHECK(RenderExpr(valid_expr, buff, lut));
     fmt::format_to(buff, "auto& {universal_name} = {local_name};\n",
@@ -200,6 +246,33 @@ bool Ilator::GenerateIlaBasics(const std::string& dir) {
   return true;
 }
 
+bool Ilator::GenerateInstrContents(const std::string& dir) {
+  auto instrs = absknob::GetInstrTree(m_);
+  std::vector<char> results(instrs.size(), true);
+  std::atomic<size_t> next = 0;
+
+  // each worker takes the next instruction until all are rendered
+  auto Worker = [this, &dir, &instrs, &results, &next]() {
+    for (auto i = next++; i < instrs.size(); i = next++) {
+      results[i] = GenerateInstrContent(instrs[i], dir);
+    }
+  };
+
+  auto num_jobs = std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u), instrs.size());
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < num_jobs; i++) {
+    workers.emplace_back(Worker);
+  }
+  Worker();
+  for (auto& w : workers) {
+    w.join();
+  }
+
+  return std::all_of(results.begin(), results.end(),
+                     [](const char& r) { return r; });
+}
+
 bool Ilator::GenerateInstrContent(const InstrPtr& instr,
                                   const std::string& dir) {
   StrBuff buff;
@@ -212,6 +285,7 @@ bool Ilator::GenerateInstrContent(const InstrPtr& instr,
   auto decode_expr = instr->decode();
   auto decode_func = RegisterFunction(GetDecodeFuncName(instr), decode_expr);
   BeginFuncDef(decode_func, buff);
+  WriteFullLaneMask(buff);
   lut.clear();
   if (!RenderExpr(decode_expr, buff, lut)) {
     return false;
@@ -243,6 +317,10 @@ bool Ilator::GenerateInstrContent(const InstrPtr& instr,
       }
       fmt::format_to(buff, "auto {local_var}_nxt_holder = {local_var};\n",
                      fmt::arg("local_var", LookUp(update_expr, lut)));
+    } else if (!update_expr->is_op()) { // memory var/const (no store)
+      if (!RenderExpr(update_expr, buff, lut)) {
+        return false;
+      }
     } else { // memory (one copy for performance, require special handling)
       if (HasLoadFromStore(update_expr)) {
         return false;
@@ -253,10 +331,11 @@ bool Ilator::GenerateInstrContent(const InstrPtr& instr,
       auto mem_update_func = RegisterMemoryUpdate(update_expr);
       fmt::format_to(buff,
                      "{mem_type} {placeholder};\n"
-                     "{mem_update_func}({placeholder});\n",
+                     "{mem_update_func}({placeholder}{lane_mask});\n",
                      fmt::arg("mem_type", GetCxxType(update_expr)),
                      fmt::arg("mem_update_func", mem_update_func->name),
-                     fmt::arg("placeholder", placeholder));
+                     fmt::arg("placeholder", placeholder),
+                     fmt::arg("lane_mask", GetLaneMaskArg()));
       // dummy traverse collect related memory operation
       StrBuff dummy_buff;
       ExprVarMap dummy_lut;
@@ -265,14 +344,33 @@ bool Ilator::GenerateInstrContent(const InstrPtr& instr,
       }
     }
   }
-  // update state
+  // update state (only the lanes where the instruction is activated)
   for (auto& s : updated_states) {
     auto curr = instr->host()->state(s);
     auto next = instr->update(s);
-    if (!curr->is_mem()) {
+    if (lanes_ > 1) {
+      if (next == curr) {
+        continue;
+      }
+      static const char* kLaneUpdateTemplate =
+          "{current} = select(lane_mask, {next_value}{suffix}, {current});\n";
+      static const char* kLaneMergeTemplate =
+          "merge(lane_mask, {current}, {next_value});\n";
+      auto merge = curr->is_mem() && next->is_op();
+      fmt::format_to(buff, merge ? kLaneMergeTemplate : kLaneUpdateTemplate,
+                     fmt::arg("current", GetCxxName(curr)),
+                     fmt::arg("next_value", LookUp(next, lut)),
+                     fmt::arg("suffix", curr->is_mem() ? "" : "_nxt_holder"));
+    } else if (!curr->is_mem()) {
       fmt::format_to(buff, "{current} = {next_value}_nxt_holder;\n",
                      fmt::arg("current", GetCxxName(curr)),
                      fmt::arg("next_value", LookUp(next, lut)));
+    } else if (!next->is_op()) {
+      if (next != curr) {
+        fmt::format_to(buff, "{current} = {next_value};\n",
+                       fmt::arg("current", GetCxxName(curr)),
+                       fmt::arg("next_value", LookUp(next, lut)));
+      }
     } else {
       fmt::format_to(buff,
                      "for (auto& it : {next_value}) {{\n"
@@ -285,7 +383,7 @@ bool Ilator::GenerateInstrContent(const InstrPtr& instr,
   EndFuncDef(update_func, buff);
 
   // record and write to file
-  CommitSource(fmt::format("idu_{}.cc", instr->name().str()), dir, buff);
+  CommitSource(GetInstrFileName(instr) + ".cc", dir, buff);
   return true;
 }
 
@@ -352,11 +450,28 @@ bool Ilator::GenerateMemoryUpdate(const std::string& dir) {
       auto lut_local_true = lut;
       auto& lut_local_false = lut; // reuse
 
-      fmt::format_to(buff, "if ({}) {{\n", LookUp(mem->arg(0), lut));
-      RenderMemUpdate(mem->arg(1), buff, lut_local_true);
-      fmt::format_to(buff, "}} else {{\n");
-      RenderMemUpdate(mem->arg(2), buff, lut_local_false);
-      fmt::format_to(buff, "}}\n");
+      if (lanes_ > 1) { // both branches, each under its own lane mask
+        static const char* kLaneBranchTemplate =
+            "{{\n"
+            "const auto lane_mask_{branch} = lane_mask & {condition};\n"
+            "{{\n"
+            "const auto& lane_mask = lane_mask_{branch};\n";
+        auto cond = LookUp(mem->arg(0), lut);
+        fmt::format_to(buff, kLaneBranchTemplate, fmt::arg("branch", "t"),
+                       fmt::arg("condition", cond));
+        RenderMemUpdate(mem->arg(1), buff, lut_local_true);
+        fmt::format_to(buff, "}}\n}}\n");
+        fmt::format_to(buff, kLaneBranchTemplate, fmt::arg("branch", "f"),
+                       fmt::arg("condition", "!" + cond));
+        RenderMemUpdate(mem->arg(2), buff, lut_local_false);
+        fmt::format_to(buff, "}}\n}}\n");
+      } else {
+        fmt::format_to(buff, "if ({}) {{\n", LookUp(mem->arg(0), lut));
+        RenderMemUpdate(mem->arg(1), buff, lut_local_true);
+        fmt::format_to(buff, "}} else {{\n");
+        RenderMemUpdate(mem->arg(2), buff, lut_local_false);
+        fmt::format_to(buff, "}}\n");
+      }
     }
 
     EndFuncDef(mem_update_func, buff);
@@ -375,7 +490,7 @@ bool Ilator::GenerateConstantMemory(const std::string& dir) {
   StrBuff buff;
   fmt::format_to(buff, "#include <{}.h>\n", GetProjectName());
 
-  for (auto& mem : const_mems_) {
+  for (auto& [name, mem] : const_mems_) {
     auto const_mem = std::dynamic_pointer_cast<ExprConst>(mem);
     const auto& val_map = const_mem->val_mem()->val_map();
     std::vector<std::string> addr_data_pairs;
@@ -389,9 +504,8 @@ bool Ilator::GenerateConstantMemory(const std::string& dir) {
         "{var_type} {project}::{var_name} = {{\n"
         "{addr_data_pairs}\n"
         "}};\n",
-        fmt::arg("var_type", GetCxxType(mem)),
-        fmt::arg("project", GetProjectName()),
-        fmt::arg("var_name", GetCxxName(mem)),
+        fmt::arg("var_type", GetCxxElemType(mem->sort())),
+        fmt::arg("project", GetProjectName()), fmt::arg("var_name", name),
         fmt::arg("addr_data_pairs", fmt::join(addr_data_pairs, ",\n")));
   }
 
@@ -424,7 +538,14 @@ bool Ilator::GenerateInitialSetup(const std::string& dir) {
   auto model = solver.get_model();
   auto refer_vars = absknob::GetVar(init);
   for (const auto& var : refer_vars) {
-    auto var_value = model.eval(gen.GetExpr(var));
+    auto var_value = model.eval(gen.GetExpr(var), true);
+    if (var->is_bool()) {
+      init_values.emplace(var, var_value.is_true() ? 1 : 0);
+      continue;
+    } else if (var->is_mem()) {
+      ILA_WARN << "Skip initial condition of memory " << var;
+      continue;
+    }
     try {
 #ifndef Z3_LEGACY_API
       auto value_holder = var_value.get_numeral_uint64();
@@ -473,37 +594,49 @@ bool Ilator::GenerateExecuteKernel(const std::string& dir) {
       "}}\n",
       fmt::arg("project", GetProjectName()));
 
-  fmt::format_to(buff, "static bool g_initialized = false;\n");
-
   auto kernel_func = RegisterFunction("compute");
   BeginFuncDef(kernel_func, buff);
 
   // setup initial condition
-  fmt::format_to(buff, "if (!g_initialized) {{\n"
+  fmt::format_to(buff, "if (!initialized) {{\n"
                        "  setup_initial_condition();\n"
-                       "  g_initialized = true;\n"
+                       "  initialized = true;\n"
                        "}}\n");
 
-  // read in input value
-  for (size_t i = 0; i < m_->input_num(); i++) {
+  // read in input value (set by step() in standalone)
+  for (size_t i = 0; i < m_->input_num() && !standalone_; i++) {
     fmt::format_to(buff, "{input_name} = {input_name}_in.read();\n",
                    fmt::arg("input_name", GetCxxName(m_->input(i))));
   }
 
-  // instruction execution
+  // instruction execution (lanes: update if activated in any lane)
+  static const char* kExecInstrTemplate =
+      "if ({valid_func_name}() && {decode_func_name}()) {{\n";
+  static const char* kExecInstrLaneTemplate =
+      "lane_mask = {valid_func_name}() & {decode_func_name}();\n"
+      "if (any(lane_mask)) {{\n"
+      "  lane_active += count(lane_mask);\n"
+      "  lane_slots += ILATOR_LANES;\n";
   auto ExecInstr = [this, &buff](const InstrPtr& instr, bool child) {
+    fmt::format_to(
+        buff, (lanes_ > 1) ? kExecInstrLaneTemplate : kExecInstrTemplate,
+        fmt::arg("valid_func_name", GetValidFuncName(instr->host())),
+        fmt::arg("decode_func_name", GetDecodeFuncName(instr)));
     fmt::format_to(
         buff,
-        "if ({valid_func_name}() && {decode_func_name}()) {{\n"
+        "  ILATOR_PROF_TIME(auto prof_start = ilator_prof_now();)\n"
         "  {update_func_name}();\n"
+        "  ILATOR_PROF(profile.instr_count[{instr_id}] += {activated};)\n"
+        "  ILATOR_PROF_TIME(profile.instr_time[{instr_id}] += "
+        "ilator_prof_now() - prof_start;)\n"
         "  {child_counter}"
         "#ifdef ILATOR_VERBOSE\n"
         "  LogInstrSequence(\"{instr_name}\");\n"
         "#endif\n"
         "}}\n",
-        fmt::arg("valid_func_name", GetValidFuncName(instr->host())),
-        fmt::arg("decode_func_name", GetDecodeFuncName(instr)),
         fmt::arg("update_func_name", GetUpdateFuncName(instr)),
+        fmt::arg("instr_id", prof_instrs_.at(instr)),
+        fmt::arg("activated", (lanes_ > 1) ? "count(lane_mask)" : "1"),
         fmt::arg("child_counter", (child ? "schedule_counter++;\n" : "")),
         fmt::arg("instr_name", instr->name().str()));
   };
@@ -517,7 +650,8 @@ bool Ilator::GenerateExecuteKernel(const std::string& dir) {
   }
 
   // child instr
-  fmt::format_to(buff, "while (1) {{\n"
+  fmt::format_to(buff, "ILATOR_PROF(uint64_t prof_iter = 0;)\n"
+                       "while (1) {{\n"
                        "  int schedule_counter = 0;\n");
   std::set<InstrPtr> tops(top_instrs.begin(), top_instrs.end());
   for (auto& instr : all_instrs) {
@@ -528,16 +662,34 @@ bool Ilator::GenerateExecuteKernel(const std::string& dir) {
   fmt::format_to(buff, "  if (schedule_counter == 0) {{\n"
                        "    break;\n"
                        "  }}\n"
-                       "}}\n");
+                       "  ILATOR_PROF(prof_iter++;)\n"
+                       "}}\n"
+                       "ILATOR_PROF(profile.Schedule(prof_iter);)\n");
 
   // done
   EndFuncDef(kernel_func, buff);
 
+  // standalone entry: latch inputs and compute
+  if (standalone_) {
+    fmt::format_to(buff, "void {project}::step(const Inputs& in) {{\n",
+                   fmt::arg("project", GetProjectName()));
+    for (size_t i = 0; i < m_->input_num(); i++) {
+      fmt::format_to(buff, "{input_name} = in.{input_name};\n",
+                     fmt::arg("input_name", GetCxxName(m_->input(i))));
+    }
+    fmt::format_to(buff, "compute();\n"
+                         "}}\n");
+  }
+
   CommitSource("compute.cc", dir, buff);
   return true;
 }
 
 bool Ilator::GenerateGlobalHeader(const std::string& dir) {
+  if (standalone_) {
+    return GenerateStandaloneHeader(dir);
+  }
+
   StrBuff buff;
 
   fmt::format_to(buff,
@@ -548,6 +700,7 @@ bool Ilator::GenerateGlobalHeader(const std::string& dir) {
 #else
                  "#include <unordered_map>\n"
 #endif
+                 "#include <ilator_profile.h>\n"
                  "SC_MODULE({project}) {{\n"
                  "  std::ofstream instr_log;\n"
                  "  void LogInstrSequence(const std::string& instr_name);\n",
@@ -562,35 +715,8 @@ bool Ilator::GenerateGlobalHeader(const std::string& dir) {
                    fmt::arg("var_name", GetCxxName(var)));
   }
 
-  // state and global vars (e.g., CONCAT)
-  for (auto& var : absknob::GetSttTree(m_)) {
-    fmt::format_to(buff, "  {var_type} {var_name};\n",
-                   fmt::arg("var_type", GetCxxType(var)),
-                   fmt::arg("var_name", GetCxxName(var)));
-  }
-  for (auto& var : global_vars_) {
-    fmt::format_to(buff, "  {var_type} {var_name};\n",
-                   fmt::arg("var_type", GetCxxType(var)),
-                   fmt::arg("var_name", GetCxxName(var)));
-  }
-
-  // memory constant
-  for (auto& mem : const_mems_) {
-    fmt::format_to(buff, "  static {var_type} {var_name};\n",
-                   fmt::arg("var_type", GetCxxType(mem)),
-                   fmt::arg("var_name", GetCxxName(mem)));
-  }
-
-  // function declaration
-  for (auto& func : functions_) {
-    WriteFuncDecl(func.second, buff);
-  }
-  for (auto& func : externs_) {
-    WriteFuncDecl(func.second, buff);
-  }
-  for (auto& func : memory_updates_) {
-    WriteFuncDecl(func.second, buff);
-  }
+  // state, global vars, and functions
+  WriteMemberDecl(buff);
 
   // invoke
   fmt::format_to(buff,
@@ -611,11 +737,15 @@ bool Ilator::GenerateGlobalHeader(const std::string& dir) {
 
   // write to file
   auto file_path = os_portable_append_dir(dir, GetProjectName() + ".h");
-  WriteFile(file_path, buff);
+  CommitFile(file_path, buff);
   return true;
 }
 
 bool Ilator::GenerateBuildSupport(const std::string& dir) {
+  if (standalone_) {
+    return GenerateStandaloneBuildSupport(dir);
+  }
+
   // CMakeLists.txt
   static const char* kCmakeRecipeTemplate =
       "# CMakeLists.txt for {project}\n"
@@ -624,6 +754,8 @@ bool Ilator::GenerateBuildSupport(const std::string& dir) {
       "\n"
       "option(ILATOR_VERBOSE \"Enable instruction sequence logging\" OFF)\n"
       "option(JSON_SUPPORT \"Build JSON parser support\" OFF)\n"
+      "option(ILATOR_PROFILE \"Collect instruction-level counters\" OFF)\n"
+      "option(ILATOR_PROFILE_TIME \"Also time each instruction\" OFF)\n"
       "\n"
       "find_package(SystemCLanguage CONFIG REQUIRED)\n"
       "set(CMAKE_CXX_STANDARD ${{SystemC_CXX_STANDARD}})\n"
@@ -640,6 +772,12 @@ bool Ilator::GenerateBuildSupport(const std::string& dir) {
       "if(${{ILATOR_VERBOSE}})\n"
       "  target_compile_definitions({project} PRIVATE ILATOR_VERBOSE)\n"
       "endif()\n"
+      "if(${{ILATOR_PROFILE}})\n"
+      "  target_compile_definitions({project} PRIVATE ILATOR_PROFILE)\n"
+      "endif()\n"
+      "if(${{ILATOR_PROFILE_TIME}})\n"
+      "  target_compile_definitions({project} PRIVATE ILATOR_PROFILE_TIME)\n"
+      "endif()\n"
       "if(${{JSON_SUPPORT}})\n"
       "  include(FetchContent)\n"
       "  FetchContent_Declare(\n"
@@ -665,7 +803,7 @@ bool Ilator::GenerateBuildSupport(const std::string& dir) {
                  fmt::arg("source_files", fmt::join(src_files, "\n")),
                  fmt::arg("dir_include", kDirInclude));
 
-  WriteFile(os_portable_append_dir(dir, "CMakeLists.txt"), buff);
+  CommitFile(os_portable_append_dir(dir, "CMakeLists.txt"), buff);
 
   // dummy main function if not exist
   static const char* kSimEntryTemplate =
@@ -687,6 +825,59 @@ bool Ilator::GenerateBuildSupport(const std::string& dir) {
   return true;
 }
 
+void Ilator::WriteMemberDecl(StrBuff& buff) const {
+  // lanes where the current instruction is activated, and the utilization
+  // (activated over evaluated lanes) for choosing the scalar fallback
+  if (lanes_ > 1) {
+    fmt::format_to(buff,
+                   "  {} lane_mask;\n"
+                   "  uint64_t lane_active = 0;\n"
+                   "  uint64_t lane_slots = 0;\n",
+                   GetCxxType(Sort::MakeBoolSort()));
+  }
+
+  // state (set up from the initial condition or a checkpoint)
+  fmt::format_to(buff,
+                 "  bool initialized = false;\n"
+                 "  bool save_state(const std::string& path, "
+                 "uint64_t step = 0) const;\n"
+                 "  bool load_state(const std::string& path, "
+                 "uint64_t* step = nullptr);\n");
+
+  // state and global vars (e.g., CONCAT)
+  for (auto& var : absknob::GetSttTree(m_)) {
+    fmt::format_to(buff, "  {var_type} {var_name};\n",
+                   fmt::arg("var_type", GetCxxType(var)),
+                   fmt::arg("var_name", GetCxxName(var)));
+  }
+  for (auto& [name, var] : global_vars_) {
+    fmt::format_to(buff, "  {var_type} {var_name};\n",
+                   fmt::arg("var_type", GetCxxType(var)),
+                   fmt::arg("var_name", name));
+  }
+
+  // memory constant
+  for (auto& [name, mem] : const_mems_) {
+    fmt::format_to(buff, "  static {var_type} {var_name};\n",
+                   fmt::arg("var_type", GetCxxElemType(mem->sort())),
+                   fmt::arg("var_name", name));
+  }
+
+  // function declaration
+  for (auto& func : functions_) {
+    WriteFuncDecl(func.second, buff);
+  }
+  for (auto& func : externs_) {
+    WriteFuncDecl(func.second, buff);
+  }
+  for (auto& func : memory_updates_) {
+    WriteFuncDecl(func.second, buff);
+  }
+
+  // profiling counters
+  WriteProfileDecl(buff);
+}
+
 bool Ilator::RenderExpr(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
 
   class ExprDfsVisiter {
@@ -714,6 +905,7 @@ bool Ilator::RenderExpr(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
 Ilator::CxxFunc* Ilator::RegisterFunction(const std::string& func_name,
                                           ExprPtr return_expr) {
   auto func = new CxxFunc(func_name, return_expr);
+  std::lock_guard<std::mutex> lock(mtx_);
   auto [it, status] = functions_.insert({func->name, func});
   ILA_ASSERT(status);
   return func;
@@ -721,6 +913,7 @@ Ilator::CxxFunc* Ilator::RegisterFunction(const std::string& func_name,
 
 Ilator::CxxFunc* Ilator::RegisterExternalFunc(const FuncPtr& func) {
   auto func_cxx = new CxxFunc(func->name().str(), func->out());
+  std::lock_guard<std::mutex> lock(mtx_);
   auto [it, status] = externs_.insert({func_cxx->name, func_cxx});
   // uninterpreted function can have multiple occurrence
   if (status) {
@@ -735,6 +928,7 @@ Ilator::CxxFunc* Ilator::RegisterExternalFunc(const FuncPtr& func) {
 
 Ilator::CxxFunc* Ilator::RegisterMemoryUpdate(const ExprPtr& mem) {
   auto func_cxx = new CxxFunc(GetMemoryFuncName(mem), NULL, mem);
+  std::lock_guard<std::mutex> lock(mtx_);
   auto [it, status] = memory_updates_.insert({func_cxx->name, func_cxx});
   // memory updates can have multiple occurrence
   if (!status) {
@@ -747,9 +941,7 @@ void Ilator::BeginFuncDef(Ilator::CxxFunc* func, StrBuff& buff) const {
   ILA_ASSERT(func->args.empty()); // no definition for uninterpreted funcs
 
   auto type = (func->ret) ? GetCxxType(func->ret) : GetCxxType(func->ret_type);
-  auto args = (func->target)
-                  ? fmt::format("{}& tmp_memory", GetCxxType(func->target))
-                  : "";
+  auto args = (func->target) ? GetMemoryFuncArgs(func->target) : "";
 
   fmt::format_to(buff, "{return_type} {project}::{func_name}({argument}) {{\n",
                  fmt::arg("return_type", type),
@@ -764,11 +956,16 @@ void Ilator::EndFuncDef(Ilator::CxxFunc* func, StrBuff& buff) const {
   fmt::format_to(buff, "}}\n");
 }
 
+void Ilator::WriteFullLaneMask(StrBuff& buff) const {
+  if (lanes_ > 1) {
+    fmt::format_to(buff, "ILATOR_PROF(const {} lane_mask(true);)\n",
+                   GetCxxType(Sort::MakeBoolSort()));
+  }
+}
+
 void Ilator::WriteFuncDecl(Ilator::CxxFunc* func, StrBuff& buff) const {
   auto type = (func->ret) ? GetCxxType(func->ret) : GetCxxType(func->ret_type);
-  auto args = (func->target)
-                  ? fmt::format("{}& tmp_memory", GetCxxType(func->target))
-                  : "";
+  auto args = (func->target) ? GetMemoryFuncArgs(func->target) : "";
   if (!func->args.empty()) { // uninterpreted func only
     ILA_NOT_NULL(func->ret_type);
     std::vector<std::string> arg_list;
@@ -786,24 +983,97 @@ void Ilator::WriteFuncDecl(Ilator::CxxFunc* func, StrBuff& buff) const {
 void Ilator::CommitSource(const std::string& file_name, const std::string& dir,
                           const StrBuff& buff) {
   auto file_path = os_portable_append_dir(dir, file_name);
-  auto [it, ret] = source_files_.insert(file_name);
-  ILA_ASSERT(ret) << "Duplicated source file name " << file_name;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto [it, ret] = source_files_.insert(file_name);
+    ILA_ASSERT(ret) << "Duplicated source file name " << file_name;
+  }
+
+  CommitFile(file_path, buff);
+}
+
+void Ilator::CommitFile(const std::string& file_path, const StrBuff& buff) {
+  auto content = to_string(buff);
+  auto hash = fmt::format("{:016x}", HashContent(content));
+
+  // key by the path relative to the project root
+  auto key = file_path;
+  if (key.compare(0, root_.size(), root_) == 0) {
+    key = key.substr(root_.size());
+    key.erase(0, key.find_first_not_of("/\\"));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    manifest_[key] = hash;
+    auto pos = prev_manifest_.find(key);
+    if (pos != prev_manifest_.end() && pos->second == hash &&
+        os_portable_exist(file_path)) {
+      return; // unchanged, keep the timestamp to avoid re-compiling
+    }
+  }
 
   WriteFile(file_path, buff);
 }
 
-std::string Ilator::GetCxxType(const SortPtr& sort) {
+void Ilator::LoadManifest() {
+  std::ifstream fr(os_portable_append_dir(root_, kManifest));
+  if (!fr.is_open()) {
+    return;
+  }
+  try {
+    auto manifest = nlohmann::json::parse(fr);
+    prev_manifest_ = manifest.at("files").get<decltype(prev_manifest_)>();
+  } catch (std::exception& err) {
+    ILA_WARN << "Ignore invalid manifest: " << err.what();
+    prev_manifest_.clear();
+  }
+}
+
+bool Ilator::WriteManifest() {
+  // remove files generated previously but not anymore, e.g., renamed instr.
+  for (auto& [key, hash] : prev_manifest_) {
+    if (manifest_.find(key) == manifest_.end()) {
+      auto file_path = os_portable_append_dir(root_, key);
+      ILA_INFO << "Remove stale file " << file_path;
+      os_portable_remove_file(file_path);
+    }
+  }
+
+  nlohmann::json manifest;
+  manifest["project"] = GetProjectName();
+  manifest["files"] = manifest_;
+
+  std::ofstream fw(os_portable_append_dir(root_, kManifest));
+  if (!fw.is_open()) {
+    ILA_ERROR << "Fail writing manifest at " << root_;
+    return false;
+  }
+  fw << manifest.dump(2) << "\n";
+  return true;
+}
+
+std::string Ilator::GetCxxType(const SortPtr& sort) const {
+  if (lanes_ > 1 && sort) {
+    return fmt::format("Lanes<{}, ILATOR_LANES>", GetCxxElemType(sort));
+  }
+  return GetCxxElemType(sort);
+}
+
+std::string Ilator::GetCxxElemType(const SortPtr& sort) const {
+  auto bv_type = standalone_ ? "BitVec" : "sc_biguint";
   if (!sort) {
     return "void";
   } else if (sort->is_bool()) {
     return "bool";
   } else if (sort->is_bv()) {
-    return fmt::format("sc_biguint<{}>", sort->bit_width());
+    return fmt::format("{}<{}>", bv_type, sort->bit_width());
   } else {
     ILA_ASSERT(sort->is_mem());
 #ifdef ILATOR_PRECISE_MEM
     return fmt::format(
-        "std::map<sc_biguint<{addr_width}>, sc_biguint<{data_width}>>",
+        "std::map<{bv_type}<{addr_width}>, {bv_type}<{data_width}>>",
+        fmt::arg("bv_type", bv_type),
         fmt::arg("addr_width", sort->addr_width()),
         fmt::arg("data_width", sort->data_width()));
 #else
@@ -812,37 +1082,155 @@ std::string Ilator::GetCxxType(const SortPtr& sort) {
   }
 }
 
-std::string Ilator::GetCxxName(const ExprPtr& expr) {
+std::string Ilator::GetMemoryFuncArgs(const ExprPtr& mem) const {
+  if (lanes_ > 1) {
+    return fmt::format("{}& tmp_memory, const {}& lane_mask", GetCxxType(mem),
+                       GetCxxType(Sort::MakeBoolSort()));
+  }
+  return fmt::format("{}& tmp_memory", GetCxxType(mem));
+}
+
+std::string Ilator::GetCxxName(const ExprPtr& expr) const {
   if (expr->is_var()) {
-    return fmt::format("{}_{}", expr->host()->name().str(), expr->name().str());
+    return GetCxxId("var", expr->host()->name().str(), expr->name().str());
   } else {
-    return fmt::format("univ_var_{}", GetPivotalId(expr->name().id()));
+    return fmt::format("univ_var_{:x}", GetDigest(expr));
   }
 }
 
-std::string Ilator::GetValidFuncName(const InstrLvlAbsCnstPtr& m) {
-  return fmt::format("valid_{host}", fmt::arg("host", m->name().str()));
+std::string Ilator::GetValidFuncName(const InstrLvlAbsCnstPtr& m) const {
+  return GetCxxId("valid", "", m->name().str());
 }
 
-std::string Ilator::GetDecodeFuncName(const InstrPtr& instr) {
-  return fmt::format("decode_{host}_{instr}",
-                     fmt::arg("host", instr->host()->name().str()),
-                     fmt::arg("instr", instr->name().str()));
+std::string Ilator::GetDecodeFuncName(const InstrPtr& instr) const {
+  return GetCxxId("decode", instr->host()->name().str(), instr->name().str());
 }
 
-std::string Ilator::GetUpdateFuncName(const InstrPtr& instr) {
-  return fmt::format("update_{host}_{instr}",
-                     fmt::arg("host", instr->host()->name().str()),
-                     fmt::arg("instr", instr->name().str()));
+std::string Ilator::GetUpdateFuncName(const InstrPtr& instr) const {
+  return GetCxxId("update", instr->host()->name().str(), instr->name().str());
 }
 
-std::string Ilator::GetMemoryFuncName(const ExprPtr& expr) {
+std::string Ilator::GetInstrFileName(const InstrPtr& instr) const {
+  return GetCxxId("idu", instr->host()->name().str(), instr->name().str());
+}
+
+std::string Ilator::GetCxxId(const std::string& kind, const std::string& host,
+                             const std::string& name) const {
+  // the host is length-prefixed, so that the key is unique
+  auto key = fmt::format("{}:{}:{}{}", kind, host.size(), host, name);
+
+  std::lock_guard<std::mutex> lock(cxx_id_mtx_);
+  if (auto pos = cxx_ids_.find(key); pos != cxx_ids_.end()) {
+    return pos->second;
+  }
+
+  auto base = ToCxxIdentifier(host.empty() ? kind + "_" + name
+                              : kind == "var"
+                                  ? host + "_" + name
+                                  : kind + "_" + host + "_" + name);
+  auto res = base;
+  for (auto i = 1; !cxx_ids_taken_.insert(res).second; i++) {
+    res = fmt::format("{}_{}", base, i);
+  }
+  ILA_WARN_IF(res != base) << "Rename " << name << " of " << host << " to "
+                           << res << " (C++ identifier collision)";
+  cxx_ids_.emplace(key, res);
+  return res;
+}
+
+void Ilator::RegisterCxxIds() {
+  auto PerIla = [this](const InstrLvlAbsCnstPtr& m) {
+    GetValidFuncName(m);
+    for (size_t i = 0; i != m->input_num(); i++) {
+      GetCxxName(m->input(i));
+    }
+    for (size_t i = 0; i != m->state_num(); i++) {
+      GetCxxName(m->state(i));
+    }
+    for (size_t i = 0; i != m->instr_num(); i++) {
+      auto instr = m->instr(i);
+      GetDecodeFuncName(instr);
+      GetUpdateFuncName(instr);
+      GetInstrFileName(instr);
+    }
+  };
+  m_->DepthFirstVisit(PerIla);
+}
+
+std::string Ilator::GetMemoryFuncName(const ExprPtr& expr) const {
   ILA_ASSERT(expr->is_mem());
   if (asthub::GetUidExprOp(expr) == AstUidExprOp::kIfThenElse) {
-    return fmt::format("ite_{}", GetPivotalId(expr->name().id()));
+    return fmt::format("ite_{:x}", GetDigest(expr));
   } else {
-    return fmt::format("store_{}", GetPivotalId(expr->name().id()));
+    return fmt::format("store_{:x}", GetDigest(expr));
+  }
+}
+
+uint64_t Ilator::GetDigest(const ExprPtr& expr) const {
+  // names derived from the structure (instead of the node id or visiting
+  // order) stay the same when unrelated parts of the model change
+  class DigestVisiter {
+  public:
+    DigestVisiter(const Ilator* hi) : host(hi) {}
+    bool pre(const ExprPtr& e) {
+      return host->digests_.find(e) != host->digests_.end();
+    }
+    void post(const ExprPtr& e) {
+      auto sort = e->sort();
+      auto key = fmt::format("{}_{}_{}_{}", sort->uid(),
+                             sort->is_bv() ? sort->bit_width() : 0,
+                             sort->is_mem() ? sort->addr_width() : 0,
+                             sort->is_mem() ? sort->data_width() : 0);
+
+      if (e->is_var()) {
+        key += fmt::format("|{}", host->GetCxxName(e));
+      } else if (e->is_const()) {
+        auto expr_const = std::static_pointer_cast<ExprConst>(e);
+        if (e->is_bool()) {
+          key += fmt::format("|{}", expr_const->val_bool()->str());
+        } else if (e->is_bv()) {
+          key += fmt::format("|{}", expr_const->val_bv()->str());
+        } else {
+          for (auto& [addr, data] : expr_const->val_mem()->val_map()) {
+            key += fmt::format("|{}:{}", addr, data);
+          }
+        }
+      } else {
+        key += fmt::format("|{}", static_cast<int>(asthub::GetUidExprOp(e)));
+        for (size_t i = 0; i < e->arg_num(); i++) {
+          key += fmt::format("|{:x}", host->digests_.at(e->arg(i)));
+        }
+        for (size_t i = 0; i < e->param_num(); i++) {
+          key += fmt::format("|{}", e->param(i));
+        }
+        if (asthub::GetUidExprOp(e) == AstUidExprOp::kApplyFunc) {
+          auto app = std::static_pointer_cast<ExprOpAppFunc>(e);
+          key += fmt::format("|{}", app->func()->name().str());
+        }
+      }
+
+      // structurally equal expressions share the digest (and the name), while
+      // a collision of different ones is resolved by re-hashing
+      auto res = HashContent(key);
+      auto [pos, fresh] = host->digest_keys_.emplace(res, key);
+      while (!fresh && pos->second != key) {
+        ILA_DLOG("Ilator") << "Digest collision " << key << " " << pos->second;
+        res = HashContent(key, res);
+        std::tie(pos, fresh) = host->digest_keys_.emplace(res, key);
+      }
+      host->digests_.emplace(e, res);
+    }
+
+    const Ilator* host;
+  };
+
+  std::lock_guard<std::mutex> lock(digest_mtx_);
+  if (auto pos = digests_.find(expr); pos != digests_.end()) {
+    return pos->second;
   }
+  auto visiter = DigestVisiter(this);
+  expr->DepthFirstVisitPrePost(visiter);
+  return digests_.at(expr);
 }
 
 } // namespace ilang
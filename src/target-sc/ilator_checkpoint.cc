@@ -0,0 +1,212 @@
+/// \file
+/// Implementation of the checkpoint save/restore functions of Ilator.
+
+#include <ilang/target-sc/ilator.h>
+
+#include <fmt/format.h>
+
+#include <ilang/ila-mngr/u_abs_knob.h>
+#include <ilang/util/log.h>
+#include <ilang/util/str_util.h>
+
+/// \namespace ilang
+namespace ilang {
+
+// Layout of a checkpoint (native byte order):
+// - magic "ILATORCK", u32 version, u32 lanes, u64 model fingerprint, u64 step
+// - each state in the order of GetSttTree (lanes of a state are consecutive)
+//   - Boolean: one byte
+//   - bit-vector: ceil(width / 64) words, least significant first
+//   - memory: u64 number of written entries, then the (address, data) pairs
+static const char* kCheckpointHelperTemplate = R"(
+namespace {{
+
+template <class T> void put(std::ostream& os, const T& v) {{
+  os.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}}
+
+template <class T> void get(std::istream& is, T& v) {{
+  is.read(reinterpret_cast<char*>(&v), sizeof(T));
+}}
+
+inline void save(std::ostream& os, const bool& v) {{ put<uint8_t>(os, v); }}
+
+inline void load(std::istream& is, bool& v) {{
+  uint8_t b = 0;
+  get(is, b);
+  v = b;
+}}
+
+{bv_helpers}
+template <class K, class V> void save(std::ostream& os, const {map}<K, V>& m) {{
+  put<uint64_t>(os, m.size());
+  for (auto& it : m) {{
+    save(os, it.first);
+    save(os, it.second);
+  }}
+}}
+
+template <class K, class V> void load(std::istream& is, {map}<K, V>& m) {{
+  uint64_t n = 0;
+  get(is, n);
+  m.clear();
+  for (; n > 0 && is; n--) {{
+    K k;
+    V d;
+    load(is, k);
+    load(is, d);
+    m.emplace(k, d);
+  }}
+}}
+{lanes_helpers}
+}} // namespace
+)";
+
+static const char* kBitVecHelperTemplate = R"(
+template <int W> void save(std::ostream& os, const BitVec<W>& v) {
+  uint64_t words[BitVec<W>::N];
+  v.to_words(words);
+  os.write(reinterpret_cast<const char*>(words), sizeof(words));
+}
+
+template <int W> void load(std::istream& is, BitVec<W>& v) {
+  uint64_t words[BitVec<W>::N] = {};
+  is.read(reinterpret_cast<char*>(words), sizeof(words));
+  v = BitVec<W>::from_words(words);
+}
+)";
+
+static const char* kScBigUintHelperTemplate = R"(
+template <int W> void save(std::ostream& os, const sc_biguint<W>& v) {
+  for (int lo = 0; lo < W; lo += 64) {
+    auto hi = (lo + 63 < W) ? lo + 63 : W - 1;
+    put<uint64_t>(os, v.range(hi, lo).to_uint64());
+  }
+}
+
+template <int W> void load(std::istream& is, sc_biguint<W>& v) {
+  for (int lo = 0; lo < W; lo += 64) {
+    auto hi = (lo + 63 < W) ? lo + 63 : W - 1;
+    uint64_t word = 0;
+    get(is, word);
+    v.range(hi, lo) = word;
+  }
+}
+)";
+
+static const char* kLanesHelperTemplate = R"(
+template <class T, int N> void save(std::ostream& os, const Lanes<T, N>& v) {
+  for (int l = 0; l < N; l++) {
+    save(os, v.d[l]);
+  }
+}
+
+template <class T, int N> void load(std::istream& is, Lanes<T, N>& v) {
+  for (int l = 0; l < N; l++) {
+    load(is, v.d[l]);
+  }
+}
+)";
+
+bool Ilator::GenerateCheckpoint(const std::string& dir) {
+  StrBuff buff;
+
+  fmt::format_to(buff,
+                 "#include <cstdint>\n"
+                 "#include <cstring>\n"
+                 "#include <fstream>\n"
+                 "#include <utility>\n"
+                 "#include <{project}.h>\n",
+                 fmt::arg("project", GetProjectName()));
+
+  // serialization of each type
+  auto bv_helpers =
+      standalone_ ? kBitVecHelperTemplate : kScBigUintHelperTemplate;
+  fmt::format_to(buff, kCheckpointHelperTemplate,
+#ifdef ILATOR_PRECISE_MEM
+                 fmt::arg("map", "std::map"),
+#else
+                 fmt::arg("map", "std::unordered_map"),
+#endif
+                 fmt::arg("bv_helpers", bv_helpers),
+                 fmt::arg("lanes_helpers",
+                          (lanes_ > 1) ? kLanesHelperTemplate : ""));
+
+  // reject checkpoints of a different model (state names and types)
+  auto states = absknob::GetSttTree(m_);
+  auto fingerprint = HashContent(std::to_string(lanes_));
+  for (auto& var : states) {
+    fingerprint = HashContent(
+        fmt::format("{}:{};", GetCxxName(var), GetCxxType(var)), fingerprint);
+  }
+
+  static const char* kSaveBeginTemplate =
+      "bool {project}::save_state(const std::string& path, uint64_t step) "
+      "const {{\n"
+      "  std::ofstream os(path, std::ios::binary);\n"
+      "  if (!os.is_open()) {{\n"
+      "    return false;\n"
+      "  }}\n"
+      "  os.write(\"ILATORCK\", 8);\n"
+      "  put<uint32_t>(os, 1);\n"
+      "  put<uint32_t>(os, {lanes});\n"
+      "  put<uint64_t>(os, {fingerprint}ULL);\n"
+      "  put<uint64_t>(os, step);\n";
+  fmt::format_to(buff, kSaveBeginTemplate,
+                 fmt::arg("project", GetProjectName()),
+                 fmt::arg("lanes", GetLaneNum()),
+                 fmt::arg("fingerprint", fingerprint));
+  for (auto& var : states) {
+    fmt::format_to(buff, "  save(os, {});\n", GetCxxName(var));
+  }
+  fmt::format_to(buff, "  return static_cast<bool>(os);\n"
+                       "}}\n");
+
+  static const char* kLoadBeginTemplate =
+      "bool {project}::load_state(const std::string& path, uint64_t* step) "
+      "{{\n"
+      "  std::ifstream is(path, std::ios::binary);\n"
+      "  char magic[8] = {{}};\n"
+      "  uint32_t version = 0;\n"
+      "  uint32_t lanes = 0;\n"
+      "  uint64_t fingerprint = 0;\n"
+      "  uint64_t saved_step = 0;\n"
+      "  is.read(magic, 8);\n"
+      "  get(is, version);\n"
+      "  get(is, lanes);\n"
+      "  get(is, fingerprint);\n"
+      "  get(is, saved_step);\n"
+      "  if (!is || std::memcmp(magic, \"ILATORCK\", 8) != 0 || version != 1 "
+      "||\n"
+      "      lanes != {lanes} || fingerprint != {fingerprint}ULL) {{\n"
+      "    return false;\n"
+      "  }}\n";
+  fmt::format_to(buff, kLoadBeginTemplate,
+                 fmt::arg("project", GetProjectName()),
+                 fmt::arg("lanes", GetLaneNum()),
+                 fmt::arg("fingerprint", fingerprint));
+  // states are only overwritten after the whole file is read and validated
+  for (auto& var : states) {
+    fmt::format_to(buff, "  decltype({0}) ck_{0};\n  load(is, ck_{0});\n",
+                   GetCxxName(var));
+  }
+  fmt::format_to(buff,
+                 "  if (!is || is.peek() != std::ifstream::traits_type::eof()) "
+                 "{{\n"
+                 "    return false;\n"
+                 "  }}\n");
+  for (auto& var : states) {
+    fmt::format_to(buff, "  {0} = std::move(ck_{0});\n", GetCxxName(var));
+  }
+  fmt::format_to(buff, "  if (step) {{\n"
+                       "    *step = saved_step;\n"
+                       "  }}\n"
+                       "  initialized = true;\n"
+                       "  return true;\n"
+                       "}}\n");
+
+  CommitSource("checkpoint.cc", dir, buff);
+  return true;
+}
+
+} // namespace ilang
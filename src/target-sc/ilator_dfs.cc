@@ -41,7 +41,8 @@ void Ilator::DfsConst(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
     fmt::format_to(buff, kConstMemTemplate, //
                    fmt::arg("local_var", local_var),
                    fmt::arg("const_mem", GetCxxName(expr)));
-    const_mems_.insert(expr);
+    std::lock_guard<std::mutex> lock(mtx_);
+    const_mems_.emplace(GetCxxName(expr), expr);
     return;
   }
 
@@ -106,14 +107,21 @@ void Ilator::DfsOpMemory(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
 #else
         "tmp_memory[{address}.to_int()] = {data}.to_int();\n";
 #endif
-    fmt::format_to(buff, kMemStoreTemplate,
+    static const char* kMemStoreLaneTemplate =
+        "store(tmp_memory, {address}, {data}, lane_mask);\n";
+    fmt::format_to(buff,
+                   (lanes_ > 1) ? kMemStoreLaneTemplate : kMemStoreTemplate,
                    fmt::arg("address", LookUp(expr->arg(1), lut)),
                    fmt::arg("data", LookUp(expr->arg(2), lut)));
+    WriteMemoryAccessCount(expr, "mem_write",
+                           (lanes_ > 1) ? "count(lane_mask)" : "1", buff);
   } else { // ite
-    static const char* kMemIteTemplate = "{ite_update_func}(tmp_memory);\n";
+    static const char* kMemIteTemplate =
+        "{ite_update_func}(tmp_memory{lane_mask});\n";
     auto mem_update_func = RegisterMemoryUpdate(expr);
     fmt::format_to(buff, kMemIteTemplate,
-                   fmt::arg("ite_update_func", mem_update_func->name));
+                   fmt::arg("ite_update_func", mem_update_func->name),
+                   fmt::arg("lane_mask", GetLaneMaskArg()));
   }
 }
 
@@ -125,7 +133,7 @@ void Ilator::DfsOpAppFunc(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
   ILA_ASSERT(status);
 
   // apply uninterpreted function
-  auto app_func = std::dynamic_pointer_cast<ExprOpAppFunc>(expr);
+  auto app_func = std::static_pointer_cast<ExprOpAppFunc>(expr);
   auto func = app_func->func();
   auto func_cxx = RegisterExternalFunc(func);
 
@@ -151,7 +159,14 @@ void Ilator::DfsOpSpecial(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
   case AstUidExprOp::kLoad: {
     static const char* kLoadTemplate =
         "auto {local_var} = {memory_source}[{address}{mem_suffix}];\n";
-    fmt::format_to(buff, kLoadTemplate, //
+    static const char* kLoadStandaloneTemplate =
+        "auto {local_var} = load_elem({memory_source}, {address});\n";
+    static const char* kLoadLaneTemplate =
+        "auto {local_var} = load({memory_source}, {address});\n";
+    auto load_template = (lanes_ > 1)   ? kLoadLaneTemplate
+                         : standalone_ ? kLoadStandaloneTemplate
+                                       : kLoadTemplate;
+    fmt::format_to(buff, load_template,
                    fmt::arg("local_var", local_var),
                    fmt::arg("memory_source", LookUp(expr->arg(0), lut)),
                    fmt::arg("address", LookUp(expr->arg(1), lut)),
@@ -161,6 +176,8 @@ void Ilator::DfsOpSpecial(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
                    fmt::arg("mem_suffix", ".to_int()")
 #endif
     );
+    WriteMemoryAccessCount(expr->arg(0), "mem_read",
+                           (lanes_ > 1) ? "count(lane_mask)" : "1", buff);
     break;
   }
   case AstUidExprOp::kConcatenate: {
@@ -168,7 +185,10 @@ void Ilator::DfsOpSpecial(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
     auto global_var = GetCxxName(expr);
     auto [itg, stg] = lut.insert_or_assign(expr, global_var);
     ILA_ASSERT(!stg);
-    global_vars_.insert(expr);
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      global_vars_.emplace(global_var, expr);
+    }
 
     static const char* kConcatTemplate =
         "{global_var} = ({type_0}({arg_0}), {type_1}({arg_1}));\n";
@@ -185,7 +205,11 @@ void Ilator::DfsOpSpecial(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
   case AstUidExprOp::kExtract: {
     static const char* kExtractTemplate =
         "auto {extract} = {origin}.range({loc_high}, {loc_low});\n";
-    fmt::format_to(buff, kExtractTemplate, //
+    static const char* kExtractStandaloneTemplate =
+        "auto {extract} = {origin}.extract<{width}>({loc_low});\n";
+    fmt::format_to(buff,
+                   standalone_ ? kExtractStandaloneTemplate : kExtractTemplate,
+                   fmt::arg("width", expr->sort()->bit_width()),
                    fmt::arg("extract", local_var),
                    fmt::arg("origin", LookUp(expr->arg(0), lut)),
                    fmt::arg("loc_high", expr->param(0)),
@@ -195,6 +219,20 @@ void Ilator::DfsOpSpecial(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
   case AstUidExprOp::kZeroExtend:
     [[fallthrough]];
   case AstUidExprOp::kSignedExtend: {
+    if (standalone_) {
+      static const char* kZeroExtendTemplate =
+          "{var_type} {extend} = {origin};\n";
+      static const char* kSignedExtendTemplate =
+          "auto {extend} = {origin}.sext<{width}>();\n";
+      fmt::format_to(buff,
+                     uid == AstUidExprOp::kSignedExtend ? kSignedExtendTemplate
+                                                        : kZeroExtendTemplate,
+                     fmt::arg("var_type", GetCxxType(expr)),
+                     fmt::arg("width", expr->sort()->bit_width()),
+                     fmt::arg("extend", local_var),
+                     fmt::arg("origin", LookUp(expr->arg(0), lut)));
+      break;
+    }
     static const char* kExtendTemplate =
         "auto {extend} = ({origin}[{sign}] == 1) ? (~{origin}) : {origin};\n"
         "{extend} = ({origin}[{sign}] == 1) ? (~{extend}) : {extend};\n";
@@ -217,7 +255,10 @@ void Ilator::DfsOpSpecial(const ExprPtr& expr, StrBuff& buff, ExprVarMap& lut) {
   case AstUidExprOp::kIfThenElse: {
     static const char* kIteTemplate =
         "auto {local_var} = ({condition}) ? {true_branch} : {false_branch};\n";
-    fmt::format_to(buff, kIteTemplate, //
+    static const char* kIteLaneTemplate =
+        "auto {local_var} = select({condition}, {true_branch}, "
+        "{false_branch});\n";
+    fmt::format_to(buff, (lanes_ > 1) ? kIteLaneTemplate : kIteTemplate,
                    fmt::arg("local_var", local_var),
                    fmt::arg("condition", LookUp(expr->arg(0), lut)),
                    fmt::arg("true_branch", LookUp(expr->arg(1), lut)),
@@ -270,7 +311,23 @@ void Ilator::DfsOpRegular(const ExprPtr& expr, StrBuff& buff,
   static const char* kBinaryOpTemplate =
       "{var_type} {local_var} = ({arg_0} {binary_op} {arg_1});\n";
 
-  if (expr->arg_num() == 1) {
+  // signed operations are helper functions in the standalone bit-vector
+  static const std::unordered_map<AstUidExprOp, std::string> kSignedFuncs = {
+      {AstUidExprOp::kLessThan, "slt"},
+      {AstUidExprOp::kGreaterThan, "sgt"},
+      {AstUidExprOp::kArithShiftRight, "ashr"}};
+  static const char* kSignedOpTemplate =
+      "{var_type} {local_var} = {func}({arg_0}, {arg_1});\n";
+
+  if (auto sf = kSignedFuncs.find(uid);
+      standalone_ && sf != kSignedFuncs.end()) {
+    fmt::format_to(buff, kSignedOpTemplate, //
+                   fmt::arg("var_type", GetCxxType(expr)),
+                   fmt::arg("local_var", local_var),
+                   fmt::arg("func", sf->second),
+                   fmt::arg("arg_0", LookUp(expr->arg(0), lut)),
+                   fmt::arg("arg_1", LookUp(expr->arg(1), lut)));
+  } else if (expr->arg_num() == 1) {
     fmt::format_to(buff, kUnaryOpTemplate, //
                    fmt::arg("var_type", GetCxxType(expr)),
                    fmt::arg("local_var", local_var),
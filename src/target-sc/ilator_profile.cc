@@ -0,0 +1,180 @@
+/// \file
+/// Implementation of the instruction-level profiling counters of Ilator.
+
+#include <ilang/target-sc/ilator.h>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <ilang/ila/ast_hub.h>
+#include <ilang/util/fs.h>
+#include <ilang/util/log.h>
+
+/// \namespace ilang
+namespace ilang {
+
+static const std::string kDirSrc = "src";
+static const std::string kDirInclude = "include";
+static const std::string kProfileHeader = "ilator_profile.h";
+
+// Counters are compiled in only with ILATOR_PROFILE, so that the simulator
+// pays nothing by default. Statements wrapped in ILATOR_PROF(...) may contain
+// commas, hence the variadic macros.
+static const char* kProfileTemplate = R"(
+#ifndef ILATOR_PROFILE_H__
+#define ILATOR_PROFILE_H__
+
+#ifdef ILATOR_PROFILE
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+
+#define ILATOR_PROF(...) __VA_ARGS__
+#ifdef ILATOR_PROFILE_TIME
+#define ILATOR_PROF_TIME(...) __VA_ARGS__
+#else
+#define ILATOR_PROF_TIME(...)
+#endif
+
+inline uint64_t ilator_prof_now() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+#else
+#define ILATOR_PROF(...)
+#define ILATOR_PROF_TIME(...)
+#endif // ILATOR_PROFILE
+
+#endif // ILATOR_PROFILE_H__
+)";
+
+// the memory state (or constant) a memory expression is derived from
+static ExprPtr GetMemoryRoot(const ExprPtr& mem) {
+  auto root = mem;
+  while (root->is_op()) {
+    auto is_ite = asthub::GetUidExprOp(root) == AstUidExprOp::kIfThenElse;
+    root = is_ite ? root->arg(1) : root->arg(0);
+  }
+  return root;
+}
+
+bool Ilator::GenerateProfile(const std::string& dir) {
+  StrBuff buff;
+
+  // support header (macros and timer)
+  fmt::format_to(buff, "{}", kProfileTemplate);
+  CommitFile(os_portable_join_dir({dir, kDirInclude, kProfileHeader}), buff);
+  buff.clear();
+
+  // names in the order of the counter index
+  std::vector<std::string> instr_names(prof_instrs_.size());
+  for (auto& [instr, id] : prof_instrs_) {
+    instr_names.at(id) = fmt::format("\"{}.{}\"", instr->host()->name().str(),
+                                     instr->name().str());
+  }
+  std::vector<std::string> mem_names(prof_mems_.size());
+  for (auto& [mem, id] : prof_mems_) {
+    mem_names.at(id) = fmt::format("\"{}.{}\"", mem->host()->name().str(),
+                                   mem->name().str());
+  }
+
+  // dump as JSON when the simulator is destructed
+  static const char* kProfileDumpTemplate =
+      "#include <{project}.h>\n"
+      "#ifdef ILATOR_PROFILE\n"
+      "static const char* kInstrNames[] = {{{instr_names}}};\n"
+      "static const char* kMemNames[] = {{{mem_names}}};\n"
+      "void {project}::DumpProfile(std::ostream& os) const {{\n"
+      "  os << \"{{\\n\";\n"
+      "  os << \"  \\\"model\\\": \\\"{project}\\\",\\n\";\n"
+      "  os << \"  \\\"lanes\\\": \" << {lanes} << \",\\n\";\n"
+      "  os << \"  \\\"compute\\\": \" << profile.compute << \",\\n\";\n"
+      "  os << \"  \\\"schedule_iterations\\\": \" << profile.sched_iter;\n"
+      "  os << \",\\n  \\\"schedule_iterations_max\\\": \";\n"
+      "  os << profile.sched_iter_max << \",\\n\";\n"
+      "  os << \"  \\\"instructions\\\": [\";\n"
+      "  for (int i = 0; i < {instr_num}; i++) {{\n"
+      "    os << (i ? \",\\n\" : \"\\n\") << \"    {{\\\"name\\\": \\\"\";\n"
+      "    os << kInstrNames[i] << \"\\\", \\\"count\\\": \";\n"
+      "    os << profile.instr_count[i];\n"
+      "    ILATOR_PROF_TIME(os << \", \\\"time_ns\\\": \";)\n"
+      "    ILATOR_PROF_TIME(os << profile.instr_time[i];)\n"
+      "    os << \"}}\";\n"
+      "  }}\n"
+      "  os << \"\\n  ],\\n  \\\"memories\\\": [\";\n"
+      "  for (int i = 0; i < {mem_num}; i++) {{\n"
+      "    os << (i ? \",\\n\" : \"\\n\") << \"    {{\\\"name\\\": \\\"\";\n"
+      "    os << kMemNames[i] << \"\\\", \\\"read\\\": \";\n"
+      "    os << profile.mem_read[i] << \", \\\"write\\\": \";\n"
+      "    os << profile.mem_write[i] << \"}}\";\n"
+      "  }}\n"
+      "  os << \"\\n  ]\\n}}\\n\";\n"
+      "}}\n"
+      "{project}::~{project}() {{\n"
+      "  auto path = std::getenv(\"ILATOR_PROFILE_OUT\");\n"
+      "  std::ofstream fw(path ? path : \"{project}_profile.json\");\n"
+      "  DumpProfile(fw);\n"
+      "}}\n"
+      "#endif // ILATOR_PROFILE\n";
+
+  // avoid zero-length arrays
+  instr_names.resize(std::max<size_t>(instr_names.size(), 1), "\"\"");
+  mem_names.resize(std::max<size_t>(mem_names.size(), 1), "\"\"");
+
+  fmt::format_to(buff, kProfileDumpTemplate,
+                 fmt::arg("project", GetProjectName()),
+                 fmt::arg("lanes", GetLaneNum()),
+                 fmt::arg("instr_num", prof_instrs_.size()),
+                 fmt::arg("mem_num", prof_mems_.size()),
+                 fmt::arg("instr_names", fmt::join(instr_names, ", ")),
+                 fmt::arg("mem_names", fmt::join(mem_names, ", ")));
+
+  CommitSource("profile.cc", os_portable_append_dir(dir, kDirSrc), buff);
+  return true;
+}
+
+void Ilator::WriteProfileDecl(StrBuff& buff) const {
+  static const char* kProfileDeclTemplate =
+      "#ifdef ILATOR_PROFILE\n"
+      "  struct Profile {{\n"
+      "    uint64_t compute = 0;\n"
+      "    uint64_t sched_iter = 0;\n"
+      "    uint64_t sched_iter_max = 0;\n"
+      "    uint64_t instr_count[{instr_num}] = {{}};\n"
+      "    uint64_t instr_time[{instr_num}] = {{}};\n"
+      "    uint64_t mem_read[{mem_num}] = {{}};\n"
+      "    uint64_t mem_write[{mem_num}] = {{}};\n"
+      "    void Schedule(uint64_t iter) {{\n"
+      "      compute++;\n"
+      "      sched_iter += iter;\n"
+      "      sched_iter_max = (iter > sched_iter_max) ? iter : sched_iter_max;\n"
+      "    }}\n"
+      "  }} profile;\n"
+      "  void DumpProfile(std::ostream& os) const;\n"
+      "  ~{project}();\n"
+      "#endif\n";
+
+  fmt::format_to(buff, kProfileDeclTemplate,
+                 fmt::arg("project", GetProjectName()),
+                 fmt::arg("instr_num", std::max<size_t>(prof_instrs_.size(), 1)),
+                 fmt::arg("mem_num", std::max<size_t>(prof_mems_.size(), 1)));
+}
+
+void Ilator::WriteMemoryAccessCount(const ExprPtr& mem,
+                                    const std::string& counter,
+                                    const std::string& amount,
+                                    StrBuff& buff) const {
+  // constant memories are not profiled
+  auto pos = prof_mems_.find(GetMemoryRoot(mem));
+  if (pos == prof_mems_.end()) {
+    return;
+  }
+  fmt::format_to(buff, "ILATOR_PROF(profile.{counter}[{id}] += {amount};)\n",
+                 fmt::arg("counter", counter), fmt::arg("id", pos->second),
+                 fmt::arg("amount", amount));
+}
+
+} // namespace ilang
@@ -0,0 +1,921 @@
+/// \file
+/// Implementation of the SystemC-free standalone target of Ilator.
+
+#include <ilang/target-sc/ilator.h>
+
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include <ilang/ila-mngr/u_abs_knob.h>
+#include <ilang/util/fs.h>
+#include <ilang/util/log.h>
+
+/// \namespace ilang
+namespace ilang {
+
+static const std::string kDirApp = "app";
+static const std::string kDirSrc = "src";
+static const std::string kDirInclude = "include";
+
+static const std::string kBitVecHeader = "ilator_bitvec.h";
+static const std::string kLanesHeader = "ilator_lanes.h";
+
+void WriteFile(const std::string& file_path, const fmt::memory_buffer& buff);
+
+// Header-only bit-vector replacing sc_biguint in standalone mode. Values are
+// stored in 64-bit words (a single word for widths up to 64) with the unused
+// top bits kept zero; out-of-range shift and division follow SMT-LIB.
+static const char* kBitVecTemplate = R"(#ifndef ILATOR_BITVEC_H__
+#define ILATOR_BITVEC_H__
+
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <ostream>
+
+template <int W> class BitVec {
+  static_assert(W > 0, "BitVec requires positive bit-width");
+  template <int V> friend class BitVec;
+
+public:
+  static constexpr int N = (W + 63) / 64;
+  static constexpr uint64_t kTopMask =
+      (W % 64 == 0) ? ~0ULL : ((1ULL << (W % 64)) - 1);
+
+  BitVec() : w_{} {}
+  BitVec(uint64_t v) : w_{} {
+    w_[0] = v;
+    trim();
+  }
+  template <int V> BitVec(const BitVec<V>& b) : w_{} {
+    for (int i = 0; i < N && i < BitVec<V>::N; i++) {
+      w_[i] = b.w_[i];
+    }
+    trim();
+  }
+  static BitVec from_words(const uint64_t* words) {
+    BitVec r;
+    for (int i = 0; i < N; i++) {
+      r.w_[i] = words[i];
+    }
+    r.trim();
+    return r;
+  }
+  static BitVec ones() { return ~BitVec(); }
+  void to_words(uint64_t* words) const {
+    for (int i = 0; i < N; i++) {
+      words[i] = w_[i];
+    }
+  }
+
+  uint64_t to_uint64() const { return w_[0]; }
+  int to_int() const { return static_cast<int>(w_[0]); }
+  bool is_neg() const { return (*this)[W - 1]; }
+  bool operator[](int i) const { return (w_[i / 64] >> (i % 64)) & 1; }
+
+  // bits [l + R - 1, l]
+  template <int R> BitVec<R> extract(int l) const { return shr(l); }
+  // sign-extend to V bits
+  template <int V> BitVec<V> sext() const {
+    return is_neg() ? (BitVec<V>(*this) | BitVec<V>::ones().shl(W))
+                    : BitVec<V>(*this);
+  }
+
+  BitVec operator~() const {
+    BitVec r;
+    for (int i = 0; i < N; i++) {
+      r.w_[i] = ~w_[i];
+    }
+    r.trim();
+    return r;
+  }
+  BitVec operator-() const { return ~*this + BitVec(1); }
+  BitVec operator&(const BitVec& b) const {
+    BitVec r;
+    for (int i = 0; i < N; i++) {
+      r.w_[i] = w_[i] & b.w_[i];
+    }
+    return r;
+  }
+  BitVec operator|(const BitVec& b) const {
+    BitVec r;
+    for (int i = 0; i < N; i++) {
+      r.w_[i] = w_[i] | b.w_[i];
+    }
+    return r;
+  }
+  BitVec operator^(const BitVec& b) const {
+    BitVec r;
+    for (int i = 0; i < N; i++) {
+      r.w_[i] = w_[i] ^ b.w_[i];
+    }
+    return r;
+  }
+  BitVec operator+(const BitVec& b) const {
+    if constexpr (N == 1) {
+      return BitVec(w_[0] + b.w_[0]);
+    }
+    BitVec r;
+    uint64_t carry = 0;
+    for (int i = 0; i < N; i++) {
+      auto s = w_[i] + carry;
+      carry = (s < carry);
+      r.w_[i] = s + b.w_[i];
+      carry |= (r.w_[i] < s);
+    }
+    r.trim();
+    return r;
+  }
+  BitVec operator-(const BitVec& b) const {
+    if constexpr (N == 1) {
+      return BitVec(w_[0] - b.w_[0]);
+    }
+    return *this + (-b);
+  }
+  BitVec operator*(const BitVec& b) const {
+    if constexpr (N == 1) {
+      return BitVec(w_[0] * b.w_[0]);
+    }
+    BitVec r;
+    for (int i = 0; i < N; i++) {
+      unsigned __int128 carry = 0;
+      for (int j = 0; i + j < N; j++) {
+        carry += static_cast<unsigned __int128>(w_[i]) * b.w_[j] + r.w_[i + j];
+        r.w_[i + j] = static_cast<uint64_t>(carry);
+        carry >>= 64;
+      }
+    }
+    r.trim();
+    return r;
+  }
+  BitVec operator/(const BitVec& b) const {
+    BitVec q, r;
+    divmod(*this, b, q, r);
+    return q;
+  }
+  BitVec operator%(const BitVec& b) const {
+    BitVec q, r;
+    divmod(*this, b, q, r);
+    return r;
+  }
+
+  bool operator==(const BitVec& b) const {
+    for (int i = 0; i < N; i++) {
+      if (w_[i] != b.w_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  bool operator!=(const BitVec& b) const { return !(*this == b); }
+  bool operator<(const BitVec& b) const {
+    for (int i = N - 1; i >= 0; i--) {
+      if (w_[i] != b.w_[i]) {
+        return w_[i] < b.w_[i];
+      }
+    }
+    return false;
+  }
+  bool operator>(const BitVec& b) const { return b < *this; }
+
+  BitVec shl(uint64_t s) const {
+    if constexpr (N == 1) {
+      return BitVec((s >= W) ? 0 : (w_[0] << s));
+    }
+    if (s >= W) {
+      return BitVec();
+    }
+    BitVec r;
+    int ws = s / 64, bs = s % 64;
+    for (int i = N - 1; i >= ws; i--) {
+      r.w_[i] = w_[i - ws] << bs;
+      if (bs && i - ws - 1 >= 0) {
+        r.w_[i] |= w_[i - ws - 1] >> (64 - bs);
+      }
+    }
+    r.trim();
+    return r;
+  }
+  BitVec shr(uint64_t s) const {
+    if constexpr (N == 1) {
+      return BitVec((s >= W) ? 0 : (w_[0] >> s));
+    }
+    if (s >= W) {
+      return BitVec();
+    }
+    BitVec r;
+    int ws = s / 64, bs = s % 64;
+    for (int i = 0; i + ws < N; i++) {
+      r.w_[i] = w_[i + ws] >> bs;
+      if (bs && i + ws + 1 < N) {
+        r.w_[i] |= w_[i + ws + 1] << (64 - bs);
+      }
+    }
+    return r;
+  }
+  // shift amount saturated at cap
+  uint64_t amount(uint64_t cap) const {
+    for (int i = 1; i < N; i++) {
+      if (w_[i]) {
+        return cap;
+      }
+    }
+    return (w_[0] < cap) ? w_[0] : cap;
+  }
+  template <int B> BitVec operator<<(const BitVec<B>& b) const {
+    return shl(b.amount(W));
+  }
+  template <int B> BitVec operator>>(const BitVec<B>& b) const {
+    return shr(b.amount(W));
+  }
+
+private:
+  uint64_t w_[N];
+
+  void trim() { w_[N - 1] &= kTopMask; }
+
+  static void divmod(const BitVec& a, const BitVec& b, BitVec& q, BitVec& r) {
+    if constexpr (N == 1) {
+      auto d = b.w_[0] ? b.w_[0] : 1;
+      q.w_[0] = b.w_[0] ? (a.w_[0] / d) : kTopMask;
+      r.w_[0] = b.w_[0] ? (a.w_[0] % d) : a.w_[0];
+    } else if (b == BitVec()) {
+      q = ones();
+      r = a;
+    } else {
+      q = r = BitVec();
+      for (int i = W - 1; i >= 0; i--) {
+        auto carry = r.is_neg();
+        r = r.shl(1);
+        r.w_[0] |= a[i];
+        if (carry || !(r < b)) {
+          r = r - b;
+          q.w_[i / 64] |= 1ULL << (i % 64);
+        }
+      }
+    }
+  }
+};
+
+template <int W> bool slt(const BitVec<W>& a, const BitVec<W>& b) {
+  return (a.is_neg() != b.is_neg()) ? a.is_neg() : (a < b);
+}
+
+template <int W> bool sgt(const BitVec<W>& a, const BitVec<W>& b) {
+  return slt(b, a);
+}
+
+template <int A, int B> BitVec<A> ashr(const BitVec<A>& a, const BitVec<B>& b) {
+  auto s = b.amount(A);
+  if constexpr (A <= 64) {
+    // sign-extend to 64 bits, where shifting by A - 1 fills all the bits
+    auto v = static_cast<int64_t>(a.to_uint64() << (64 - A)) >> (64 - A);
+    return BitVec<A>(static_cast<uint64_t>(v >> ((s < A) ? s : A - 1)));
+  }
+  return a.is_neg() ? (a.shr(s) | ~BitVec<A>::ones().shr(s)) : a.shr(s);
+}
+
+template <int A, int B>
+BitVec<A + B> operator,(const BitVec<A>& a, const BitVec<B>& b) {
+  return BitVec<A + B>(a).shl(B) | BitVec<A + B>(b);
+}
+
+template <int W>
+std::ostream& operator<<(std::ostream& os, const BitVec<W>& b) {
+  if constexpr (W <= 64) {
+    return os << b.to_uint64();
+  } else {
+    auto flags = os.flags();
+    auto fill = os.fill('0');
+    os << std::hex << BitVec<W - 64>(b.shr(64)) << std::setw(16)
+       << b.to_uint64();
+    os.flags(flags);
+    os.fill(fill);
+    return os;
+  }
+}
+
+// memory read without inserting the default value
+template <class K, class V>
+V load_elem(const std::map<K, V>& mem, const K& addr) {
+  auto pos = mem.find(addr);
+  return (pos == mem.end()) ? V() : pos->second;
+}
+
+#endif // ILATOR_BITVEC_H__
+)";
+
+// Structure-of-arrays over independent lanes for multi-lane simulation.
+// Operators are element-wise loops over the lanes (vectorized by the compiler
+// for single-word bit-vectors); control flow becomes per-lane masks.
+static const char* kLanesTemplate = R"(#ifndef ILATOR_LANES_H__
+#define ILATOR_LANES_H__
+
+#include <map>
+#include <type_traits>
+
+#include <ilator_bitvec.h>
+
+template <class T, int N> class Lanes {
+public:
+  T d[N];
+
+  Lanes() : d{} {}
+  template <class U,
+            class = std::enable_if_t<std::is_convertible<U, T>::value>>
+  Lanes(const U& v) {
+    for (int l = 0; l < N; l++) {
+      d[l] = v;
+    }
+  }
+  template <class U> Lanes(const Lanes<U, N>& b) {
+    for (int l = 0; l < N; l++) {
+      d[l] = b.d[l];
+    }
+  }
+
+  T& operator[](int l) { return d[l]; }
+  const T& operator[](int l) const { return d[l]; }
+
+  template <int R> Lanes<BitVec<R>, N> extract(int low) const {
+    Lanes<BitVec<R>, N> r;
+    for (int l = 0; l < N; l++) {
+      r.d[l] = d[l].template extract<R>(low);
+    }
+    return r;
+  }
+  template <int V> Lanes<BitVec<V>, N> sext() const {
+    Lanes<BitVec<V>, N> r;
+    for (int l = 0; l < N; l++) {
+      r.d[l] = d[l].template sext<V>();
+    }
+    return r;
+  }
+};
+
+#define ILATOR_LANES_UNARY(OP)                                                 \
+  template <class T, int N> Lanes<T, N> operator OP(const Lanes<T, N>& a) {    \
+    Lanes<T, N> r;                                                             \
+    for (int l = 0; l < N; l++) {                                              \
+      r.d[l] = OP a.d[l];                                                      \
+    }                                                                          \
+    return r;                                                                  \
+  }
+
+#define ILATOR_LANES_BINARY(OP, RET)                                           \
+  template <class T, class U, int N>                                           \
+  Lanes<RET, N> operator OP(const Lanes<T, N>& a, const Lanes<U, N>& b) {      \
+    Lanes<RET, N> r;                                                           \
+    for (int l = 0; l < N; l++) {                                              \
+      r.d[l] = a.d[l] OP b.d[l];                                               \
+    }                                                                          \
+    return r;                                                                  \
+  }
+
+ILATOR_LANES_UNARY(!)
+ILATOR_LANES_UNARY(~)
+ILATOR_LANES_UNARY(-)
+ILATOR_LANES_BINARY(&, T)
+ILATOR_LANES_BINARY(|, T)
+ILATOR_LANES_BINARY(^, T)
+ILATOR_LANES_BINARY(+, T)
+ILATOR_LANES_BINARY(-, T)
+ILATOR_LANES_BINARY(*, T)
+ILATOR_LANES_BINARY(/, T)
+ILATOR_LANES_BINARY(%, T)
+ILATOR_LANES_BINARY(<<, T)
+ILATOR_LANES_BINARY(>>, T)
+ILATOR_LANES_BINARY(==, bool)
+ILATOR_LANES_BINARY(<, bool)
+ILATOR_LANES_BINARY(>, bool)
+
+#define ILATOR_LANES_FUNC(FUNC, RET)                                           \
+  template <class T, class U, int N>                                           \
+  Lanes<RET, N> FUNC(const Lanes<T, N>& a, const Lanes<U, N>& b) {             \
+    Lanes<RET, N> r;                                                           \
+    for (int l = 0; l < N; l++) {                                              \
+      r.d[l] = FUNC(a.d[l], b.d[l]);                                           \
+    }                                                                          \
+    return r;                                                                  \
+  }
+
+ILATOR_LANES_FUNC(slt, bool)
+ILATOR_LANES_FUNC(sgt, bool)
+ILATOR_LANES_FUNC(ashr, T)
+
+template <int A, int B, int N>
+Lanes<BitVec<A + B>, N> operator,(const Lanes<BitVec<A>, N>& a,
+                                  const Lanes<BitVec<B>, N>& b) {
+  Lanes<BitVec<A + B>, N> r;
+  for (int l = 0; l < N; l++) {
+    r.d[l] = (a.d[l], b.d[l]);
+  }
+  return r;
+}
+
+template <int N> bool any(const Lanes<bool, N>& c) {
+  auto res = false;
+  for (int l = 0; l < N; l++) {
+    res |= c.d[l];
+  }
+  return res;
+}
+
+template <int N> int count(const Lanes<bool, N>& c) {
+  auto res = 0;
+  for (int l = 0; l < N; l++) {
+    res += c.d[l];
+  }
+  return res;
+}
+
+template <class T, int N>
+Lanes<T, N> select(const Lanes<bool, N>& c, const Lanes<T, N>& a,
+                   const Lanes<T, N>& b) {
+  Lanes<T, N> r;
+  for (int l = 0; l < N; l++) {
+    r.d[l] = c.d[l] ? a.d[l] : b.d[l];
+  }
+  return r;
+}
+
+// memory (per-lane map, or shared constant map)
+template <class K, class V, int N>
+Lanes<V, N> load(const Lanes<std::map<K, V>, N>& mem, const Lanes<K, N>& addr) {
+  Lanes<V, N> r;
+  for (int l = 0; l < N; l++) {
+    r.d[l] = load_elem(mem.d[l], addr.d[l]);
+  }
+  return r;
+}
+
+template <class K, class V, int N>
+Lanes<V, N> load(const std::map<K, V>& mem, const Lanes<K, N>& addr) {
+  Lanes<V, N> r;
+  for (int l = 0; l < N; l++) {
+    r.d[l] = load_elem(mem, addr.d[l]);
+  }
+  return r;
+}
+
+template <class K, class V, int N>
+void store(Lanes<std::map<K, V>, N>& mem, const Lanes<K, N>& addr,
+           const Lanes<V, N>& data, const Lanes<bool, N>& mask) {
+  for (int l = 0; l < N; l++) {
+    if (mask.d[l]) {
+      mem.d[l][addr.d[l]] = data.d[l];
+    }
+  }
+}
+
+template <class K, class V, int N>
+void merge(const Lanes<bool, N>& mask, Lanes<std::map<K, V>, N>& curr,
+           const Lanes<std::map<K, V>, N>& next) {
+  for (int l = 0; l < N; l++) {
+    if (mask.d[l]) {
+      for (auto& it : next.d[l]) {
+        curr.d[l][it.first] = it.second;
+      }
+    }
+  }
+}
+
+#endif // ILATOR_LANES_H__
+)";
+
+bool Ilator::GenerateStandaloneHeader(const std::string& dir) {
+  StrBuff buff;
+
+  // native bit-vector support
+  fmt::format_to(buff, "{}", kBitVecTemplate);
+  CommitFile(os_portable_append_dir(dir, kBitVecHeader), buff);
+  buff.clear();
+
+  // structure-of-arrays support
+  if (lanes_ > 1) {
+    fmt::format_to(buff, "{}", kLanesTemplate);
+    CommitFile(os_portable_append_dir(dir, kLanesHeader), buff);
+    buff.clear();
+  }
+
+  auto& support_header = (lanes_ > 1) ? kLanesHeader : kBitVecHeader;
+  fmt::format_to(buff,
+                 "#include <cstdint>\n"
+                 "#include <fstream>\n"
+#ifdef ILATOR_PRECISE_MEM
+                 "#include <map>\n"
+#else
+                 "#include <unordered_map>\n"
+#endif
+                 "#include <{bitvec}>\n"
+                 "#include <ilator_profile.h>\n",
+                 fmt::arg("bitvec", support_header));
+
+  // the scalar fallback builds the same sources with one lane
+  static const char* kLaneNumTemplate =
+      "#ifdef ILATOR_SCALAR_FALLBACK\n"
+      "#define ILATOR_LANES 1\n"
+      "#define {project} {project}_scalar\n"
+      "#else\n"
+      "#define ILATOR_LANES {lanes}\n"
+      "#endif\n";
+  if (lanes_ > 1) {
+    fmt::format_to(buff, kLaneNumTemplate,
+                   fmt::arg("project", GetProjectName()),
+                   fmt::arg("lanes", lanes_));
+  }
+
+  fmt::format_to(buff,
+                 "class {project} {{\n"
+                 "public:\n"
+                 "  std::ofstream instr_log;\n"
+                 "  void LogInstrSequence(const std::string& instr_name);\n",
+                 fmt::arg("project", GetProjectName()));
+
+  // input (top-level, in declaration order)
+  fmt::format_to(buff, "  struct Inputs {{\n");
+  for (size_t i = 0; i < m_->input_num(); i++) {
+    fmt::format_to(buff, "    {var_type} {var_name};\n",
+                   fmt::arg("var_type", GetCxxType(m_->input(i))),
+                   fmt::arg("var_name", GetCxxName(m_->input(i))));
+  }
+  fmt::format_to(buff, "  }};\n"
+                       "  void step(const Inputs& in);\n");
+
+  for (auto& var : absknob::GetInp(m_)) {
+    fmt::format_to(buff, "  {var_type} {var_name};\n",
+                   fmt::arg("var_type", GetCxxType(var)),
+                   fmt::arg("var_name", GetCxxName(var)));
+  }
+
+  // state, global vars, and functions
+  WriteMemberDecl(buff);
+
+  // done
+  fmt::format_to(buff, "}};\n");
+
+  // write to file
+  auto file_path = os_portable_append_dir(dir, GetProjectName() + ".h");
+  CommitFile(file_path, buff);
+  return true;
+}
+
+bool Ilator::GenerateStandaloneBuildSupport(const std::string& dir) {
+  // CMakeLists.txt
+  static const char* kCmakeRecipeTemplate =
+      "# CMakeLists.txt for {project}\n"
+      "cmake_minimum_required(VERSION 3.14.0)\n"
+      "project({project} LANGUAGES CXX)\n"
+      "\n"
+      "option(ILATOR_VERBOSE \"Enable instruction sequence logging\" OFF)\n"
+      "{native_option}"
+      "option(ILATOR_PROFILE \"Collect instruction-level counters\" OFF)\n"
+      "option(ILATOR_PROFILE_TIME \"Also time each instruction\" OFF)\n"
+      "\n"
+      "set(CMAKE_CXX_STANDARD 17)\n"
+      "if(NOT CMAKE_BUILD_TYPE)\n"
+      "  set(CMAKE_BUILD_TYPE Release)\n"
+      "endif()\n"
+      "\n"
+      "aux_source_directory(extern extern_src)\n"
+      "add_executable({project}\n"
+      "  ${{CMAKE_CURRENT_SOURCE_DIR}}/{dir_app}/main.cc\n"
+      "  ${{extern_src}}\n"
+      "{source_files}\n"
+      ")\n"
+      "\n"
+      "target_include_directories({project} PRIVATE {dir_include})\n"
+      "if(${{ILATOR_VERBOSE}})\n"
+      "  target_compile_definitions({project} PRIVATE ILATOR_VERBOSE)\n"
+      "endif()\n"
+      "{native_recipe}"
+      "if(${{ILATOR_PROFILE}})\n"
+      "  target_compile_definitions({project} PRIVATE ILATOR_PROFILE)\n"
+      "endif()\n"
+      "if(${{ILATOR_PROFILE_TIME}})\n"
+      "  target_compile_definitions({project} PRIVATE ILATOR_PROFILE_TIME)\n"
+      "endif()\n"
+      "{fallback_recipe}";
+
+  std::vector<std::string> src_files;
+  for (auto& f : source_files_) {
+    src_files.push_back(
+        fmt::format("  ${{CMAKE_CURRENT_SOURCE_DIR}}/{dir}/{file}",
+                    fmt::arg("dir", kDirSrc), fmt::arg("file", f)));
+  }
+
+  // host-specific tuning of the lane loops, off by default since the binary
+  // then only runs on the host CPU
+  static const char* kNativeOption =
+      "option(ILATOR_NATIVE \"Tune the lane loops for the host CPU\" OFF)\n";
+  static const char* kNativeRecipeTemplate =
+      "if(${{ILATOR_NATIVE}})\n"
+      "  include(CheckCXXCompilerFlag)\n"
+      "  check_cxx_compiler_flag(-march=native ILATOR_HAS_MARCH_NATIVE)\n"
+      "  if(ILATOR_HAS_MARCH_NATIVE)\n"
+      "    target_compile_options({project} PRIVATE -march=native)\n"
+      "  endif()\n"
+      "endif()\n";
+  auto native_recipe = fmt::format(kNativeRecipeTemplate,
+                                   fmt::arg("project", GetProjectName()));
+
+  // scalar fallback of the lanes driver, i.e., the model sources built again
+  // with one lane (not available if uninterpreted functions are user-defined)
+  auto fallback = (lanes_ > 1) && externs_.empty();
+  static const char* kFallbackRecipeTemplate =
+      "\n"
+      "add_library({project}_scalar OBJECT\n"
+      "  ${{CMAKE_CURRENT_SOURCE_DIR}}/{dir_app}/scalar.cc\n"
+      "{source_files}\n"
+      ")\n"
+      "target_include_directories({project}_scalar PRIVATE {dir_include})\n"
+      "target_compile_definitions({project}_scalar PRIVATE "
+      "ILATOR_SCALAR_FALLBACK)\n"
+      "target_sources({project} PRIVATE $<TARGET_OBJECTS:{project}_scalar>)\n";
+  auto fallback_recipe = fmt::format(
+      kFallbackRecipeTemplate, fmt::arg("project", GetProjectName()),
+      fmt::arg("dir_app", kDirApp),
+      fmt::arg("source_files", fmt::join(src_files, "\n")),
+      fmt::arg("dir_include", kDirInclude));
+
+  StrBuff buff;
+  fmt::format_to(buff, kCmakeRecipeTemplate,
+                 fmt::arg("project", GetProjectName()),
+                 fmt::arg("native_option", (lanes_ > 1) ? kNativeOption : ""),
+                 fmt::arg("native_recipe", (lanes_ > 1) ? native_recipe : ""),
+                 fmt::arg("fallback_recipe", fallback ? fallback_recipe : ""),
+                 fmt::arg("dir_app", kDirApp),
+                 fmt::arg("source_files", fmt::join(src_files, "\n")),
+                 fmt::arg("dir_include", kDirInclude));
+
+  CommitFile(os_portable_append_dir(dir, "CMakeLists.txt"), buff);
+
+  // trace-driven batch driver if not exist
+  // - each step reads ceil(width / 64) words (native byte order, least
+  //   significant word first) per input per lane, in the order of the Inputs
+  //   struct (lanes of an input are consecutive)
+  // - with --load, resume from a checkpoint and skip the steps it covers
+  // - with lanes, an instruction activated in any lane is evaluated over all
+  //   lanes, so a divergent trace runs faster on the scalar fallback (one lane
+  //   at a time); --engine auto (default) picks it if the lane utilization
+  //   sampled over the first steps is low, unless checkpoints are involved
+  static const char* kSimEntryTemplate =
+      "#include <chrono>\n"
+      "#include <cstdlib>\n"
+      "#include <iostream>\n"
+      "#include <memory>\n"
+      "#include <string>\n"
+      "#include <vector>\n"
+      "#include <{project}.h>\n"
+      "{fallback_decl}\n"
+      "int main(int argc, char* argv[]) {{\n"
+      "  std::string load_path, save_path;\n"
+      "{engine_decl}"
+      "  std::vector<char*> args;\n"
+      "  for (int i = 1; i < argc; i++) {{\n"
+      "    std::string arg = argv[i];\n"
+      "    if ((arg == \"--load\" || arg == \"--save\") && i + 1 < argc) {{\n"
+      "      (arg == \"--load\" ? load_path : save_path) = argv[++i];\n"
+      "{engine_option}"
+      "    }} else {{\n"
+      "      args.push_back(argv[i]);\n"
+      "    }}\n"
+      "  }}\n"
+      "  if (args.empty() || ({input_num} == 0 && args.size() < 2)) {{\n"
+      "    std::cerr << \"Usage: \" << argv[0] << \" <trace> [max_steps]\";\n"
+      "    std::cerr << \" [--load checkpoint] [--save checkpoint]\";\n"
+      "    std::cerr << \"{usage}\\n\";\n"
+      "    return 1;\n"
+      "  }}\n"
+      "  std::ifstream trace(args[0], std::ios::binary);\n"
+      "  if (!trace.is_open()) {{\n"
+      "    std::cerr << \"Fail opening \" << args[0] << \"\\n\";\n"
+      "    return 1;\n"
+      "  }}\n"
+      "  auto max_steps =\n"
+      "      (args.size() > 1) ? std::strtoull(args[1], NULL, 10) : ~0ULL;\n"
+      "\n"
+      "  auto sim = std::make_unique<{project}>();\n"
+      "  {project}::Inputs in;\n"
+      "  std::vector<uint64_t> words({input_num});\n"
+      "  auto bytes = sizeof(uint64_t) * words.size();\n"
+      "  auto read_step = [&trace, &words, &bytes, &in]() {{\n"
+      "    if (!trace.read(reinterpret_cast<char*>(words.data()), bytes)) {{\n"
+      "      return false;\n"
+      "    }}\n"
+      "{assign_inputs}"
+      "    return true;\n"
+      "  }};\n"
+      "{engine_select}"
+      "\n"
+      "  // fast-forward: resume from the checkpoint, skipping its prefix\n"
+      "  uint64_t first = 0;\n"
+      "  if (!load_path.empty()) {{\n"
+      "    if (!sim->load_state(load_path, &first)) {{\n"
+      "      std::cerr << \"Fail loading \" << load_path << \"\\n\";\n"
+      "      return 1;\n"
+      "    }}\n"
+      "    trace.seekg(first * bytes);\n"
+      "  }}\n"
+      "\n"
+      "  unsigned long long steps = 0;\n"
+      "  auto start = std::chrono::steady_clock::now();\n"
+      "  while (steps < max_steps && read_step()) {{\n"
+      "    sim->step(in);\n"
+      "    steps++;\n"
+      "  }}\n"
+      "  std::chrono::duration<double> elapsed =\n"
+      "      std::chrono::steady_clock::now() - start;\n"
+      "\n"
+      "  std::cout << steps << \" steps x {lanes} lane(s) in \";\n"
+      "  std::cout << elapsed.count() << \" s\";\n"
+      "  if (elapsed.count() > 0) {{\n"
+      "    auto rate = steps * {lanes} / elapsed.count();\n"
+      "    std::cout << \" (\" << rate << \" steps/s)\";\n"
+      "  }}\n"
+      "  std::cout << \"\\n\";\n"
+      "\n"
+      "  if (!save_path.empty() && !sim->save_state(save_path, first + steps)) "
+      "{{\n"
+      "    std::cerr << \"Fail saving \" << save_path << \"\\n\";\n"
+      "    return 1;\n"
+      "  }}\n"
+      "  return 0;\n"
+      "}}\n";
+
+  // - the utilization threshold and the sample size can be set at build time
+  static const char* kFallbackDeclTemplate =
+      "\n"
+      "// scalar fallback, see scalar.cc\n"
+      "#ifndef ILATOR_MIN_LANE_UTIL\n"
+      "#define ILATOR_MIN_LANE_UTIL 0.5\n"
+      "#endif\n"
+      "#ifndef ILATOR_LANE_SAMPLE\n"
+      "#define ILATOR_LANE_SAMPLE 1024\n"
+      "#endif\n"
+      "bool run_scalar(std::istream& trace, unsigned long long max_steps,\n"
+      "                const std::string& save_path, unsigned long long& "
+      "steps);\n";
+  static const char* kEngineDecl = "  std::string engine = \"auto\";\n";
+  static const char* kEngineOption =
+      "    } else if (arg == \"--engine\" && i + 1 < argc) {\n"
+      "      engine = argv[++i];\n";
+  static const char* kEngineSelectTemplate =
+      "\n"
+      "  // sample the lane utilization (checkpoints are in the lanes layout)\n"
+      "  if (engine == \"auto\") {{\n"
+      "    engine = \"lanes\";\n"
+      "    if (load_path.empty() && save_path.empty()) {{\n"
+      "      auto probe = std::make_unique<{project}>();\n"
+      "      for (unsigned long long i = 0;\n"
+      "           i < ILATOR_LANE_SAMPLE && i < max_steps && read_step(); "
+      "i++) {{\n"
+      "        probe->step(in);\n"
+      "      }}\n"
+      "      auto slots = probe->lane_slots;\n"
+      "      if (probe->lane_active < ILATOR_MIN_LANE_UTIL * slots) {{\n"
+      "        engine = \"scalar\";\n"
+      "      }}\n"
+      "      trace.clear();\n"
+      "      trace.seekg(0);\n"
+      "    }}\n"
+      "  }}\n"
+      "\n"
+      "  // scalar fallback: one lane at a time, saved to <path>.<lane>\n"
+      "  if (engine == \"scalar\") {{\n"
+      "    if (!load_path.empty()) {{\n"
+      "      std::cerr << \"Checkpoints are loaded by the lanes engine\\n\";\n"
+      "      return 1;\n"
+      "    }}\n"
+      "    unsigned long long steps = 0;\n"
+      "    auto start = std::chrono::steady_clock::now();\n"
+      "    if (!run_scalar(trace, max_steps, save_path, steps)) {{\n"
+      "      std::cerr << \"Fail saving \" << save_path << \".<lane>\\n\";\n"
+      "      return 1;\n"
+      "    }}\n"
+      "    std::chrono::duration<double> elapsed =\n"
+      "        std::chrono::steady_clock::now() - start;\n"
+      "    std::cout << steps << \" steps x {lanes} lane(s) in \";\n"
+      "    std::cout << elapsed.count() << \" s\";\n"
+      "    if (elapsed.count() > 0) {{\n"
+      "      auto rate = steps * {lanes} / elapsed.count();\n"
+      "      std::cout << \" (\" << rate << \" steps/s)\";\n"
+      "    }}\n"
+      "    std::cout << \" [scalar fallback]\\n\";\n"
+      "    return 0;\n"
+      "  }} else if (engine != \"lanes\") {{\n"
+      "    std::cerr << \"Unknown engine \" << engine << \"\\n\";\n"
+      "    return 1;\n"
+      "  }}\n";
+
+  // the scalar fallback steps each lane of the trace on its own one-lane model,
+  // i.e., this file and the model sources built with ILATOR_SCALAR_FALLBACK
+  static const char* kScalarEntryTemplate =
+      "#include <fstream>\n"
+      "#include <memory>\n"
+      "#include <string>\n"
+      "#include <vector>\n"
+      "#include <{project}.h>\n\n"
+      "bool run_scalar(std::istream& trace, unsigned long long max_steps,\n"
+      "                const std::string& save_path, unsigned long long& "
+      "steps) {{\n"
+      "  std::vector<std::unique_ptr<{project}>> sims;\n"
+      "  for (int l = 0; l < {lanes}; l++) {{\n"
+      "    sims.push_back(std::make_unique<{project}>());\n"
+      "  }}\n"
+      "  {project}::Inputs in;\n"
+      "  std::vector<uint64_t> words({input_num});\n"
+      "  auto bytes = sizeof(uint64_t) * words.size();\n"
+      "  steps = 0;\n"
+      "  while (steps < max_steps &&\n"
+      "         trace.read(reinterpret_cast<char*>(words.data()), bytes)) {{\n"
+      "    for (int l = 0; l < {lanes}; l++) {{\n"
+      "{assign_inputs}"
+      "      sims[l]->step(in);\n"
+      "    }}\n"
+      "    steps++;\n"
+      "  }}\n"
+      "  for (int l = 0; l < {lanes} && !save_path.empty(); l++) {{\n"
+      "    auto path = save_path + \".\" + std::to_string(l);\n"
+      "    if (!sims[l]->save_state(path, steps)) {{\n"
+      "      return false;\n"
+      "    }}\n"
+      "  }}\n"
+      "  return true;\n"
+      "}}\n";
+
+  auto app_dir = os_portable_append_dir(dir, kDirApp);
+  auto entry_path = os_portable_append_dir(app_dir, "main.cc");
+  auto scalar_path = os_portable_append_dir(app_dir, "scalar.cc");
+
+  static const char* kReadBoolTemplate =
+      "    in.{var_name}{lane} = words[{idx}];\n";
+  static const char* kReadBvTemplate =
+      "    in.{var_name}{lane} = {var_type}::from_words(&words[{idx}]);\n";
+  static const char* kReadLaneTemplate =
+      "    for (int l = 0; l < {lanes}; l++) {{\n"
+      "  {read_one}"
+      "    }}\n";
+
+  std::string assign_inputs = "";
+  std::string assign_scalar = "";
+  size_t word_num = 0;
+  for (size_t i = 0; i < m_->input_num(); i++) {
+    auto var = m_->input(i);
+    auto var_words =
+        var->is_bool() ? 1 : ((var->sort()->bit_width() + 63) / 64);
+    auto ReadOne = [&](const std::string& lane, const std::string& idx) {
+      return fmt::format(var->is_bool() ? kReadBoolTemplate : kReadBvTemplate,
+                         fmt::arg("var_name", GetCxxName(var)),
+                         fmt::arg("lane", lane),
+                         fmt::arg("var_type", GetCxxElemType(var->sort())),
+                         fmt::arg("idx", idx));
+    };
+    if (lanes_ > 1) {
+      auto idx = fmt::format("{} + l * {}", word_num, var_words);
+      assign_inputs +=
+          fmt::format(kReadLaneTemplate, fmt::arg("lanes", lanes_),
+                      fmt::arg("read_one", ReadOne("[l]", idx)));
+      assign_scalar += "  " + ReadOne("[0]", idx);
+    } else {
+      assign_inputs += ReadOne("", std::to_string(word_num));
+    }
+    word_num += var_words * lanes_;
+  }
+
+  if (!os_portable_exist(entry_path)) {
+    auto engine_select =
+        fmt::format(kEngineSelectTemplate,
+                    fmt::arg("project", GetProjectName()),
+                    fmt::arg("lanes", lanes_));
+    buff.clear();
+    fmt::format_to(buff, kSimEntryTemplate,
+                   fmt::arg("project", GetProjectName()),
+                   fmt::arg("fallback_decl", fallback ? kFallbackDeclTemplate
+                                                      : ""),
+                   fmt::arg("engine_decl", fallback ? kEngineDecl : ""),
+                   fmt::arg("engine_option", fallback ? kEngineOption : ""),
+                   fmt::arg("usage", fallback ? " [--engine auto|lanes|scalar]"
+                                              : ""),
+                   fmt::arg("input_num", word_num),
+                   fmt::arg("engine_select", fallback ? engine_select : ""),
+                   fmt::arg("lanes", lanes_),
+                   fmt::arg("assign_inputs", assign_inputs));
+    WriteFile(entry_path, buff);
+  }
+
+  if (fallback && !os_portable_exist(scalar_path)) {
+    buff.clear();
+    fmt::format_to(buff, kScalarEntryTemplate,
+                   fmt::arg("project", GetProjectName()),
+                   fmt::arg("input_num", word_num),
+                   fmt::arg("lanes", lanes_),
+                   fmt::arg("assign_inputs", assign_scalar));
+    WriteFile(scalar_path, buff);
+  }
+
+  return true;
+}
+
+} // namespace ilang
@@ -10,6 +10,7 @@
 #include <ilang/ila/ast_hub.h>
 #include <ilang/ila/instr_lvl_abs.h>
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 #define PARAM_BIT_WIDTH 8
 
@@ -31,6 +32,7 @@ void SmtSwitchItf::Reset() {
 
 smt::Term SmtSwitchItf::GetSmtTerm(const ExprPtr& expr,
                                    const std::string& suffix) {
+  ILA_TRACE_SCOPE("smt.switch_term");
   suffix_ = suffix;
   expr->DepthFirstVisitPrePost(*this);
 
@@ -0,0 +1,151 @@
+/// \file
+/// Source for checking z3 queries with several configurations in parallel.
+
+#include <ilang/target-smt/solver_portfolio.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
+
+namespace ilang {
+
+SolverPortfolio::SolverPortfolio(const std::vector<Config>& configs,
+                                 const unsigned& timeout)
+    : configs_(configs), timeout_(timeout) {
+  ILA_WARN_IF(configs_.empty()) << "Empty solver portfolio";
+}
+
+SolverPortfolio::~SolverPortfolio() {
+  // the model must be released before its context
+  model_.reset();
+  model_ctx_.reset();
+}
+
+std::vector<SolverPortfolio::Config> SolverPortfolio::DefaultConfigs() {
+  return {{"default", {}, 0},
+          {"default-seed", {}, 42},
+          {"qfbv", {"qfbv"}, 0},
+          {"bit-blast", {"simplify", "solve-eqs", "bit-blast", "sat"}, 0}};
+}
+
+z3::check_result SolverPortfolio::Check(const z3::expr_vector& assertions,
+                                        const unsigned& timeout) {
+  ILA_TRACE_SCOPE("smt.portfolio_check");
+  model_.reset();
+  model_ctx_.reset();
+  winner_.clear();
+  if (configs_.empty()) {
+    return z3::unknown;
+  }
+
+  // translate the query to each context before any solving starts, since the
+  // source context is not thread-safe
+  auto num = configs_.size();
+  std::vector<std::unique_ptr<z3::context>> ctxs;
+  std::vector<z3::expr_vector> queries;
+  for (size_t i = 0; i != num; i++) {
+    ctxs.push_back(std::make_unique<z3::context>());
+    auto& ctx = *ctxs.back();
+    queries.emplace_back(ctx);
+    for (unsigned j = 0; j != assertions.size(); j++) {
+      auto a = assertions[j];
+      queries.back().push_back(z3::expr(ctx, Z3_translate(a.ctx(), a, ctx)));
+    }
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::vector<char> finished(num, false);
+  size_t finished_num = 0;
+  auto winner = num;
+  auto result = z3::unknown;
+  std::unique_ptr<z3::model> model;
+
+  // the tighter of the portfolio's and the query's time limit
+  auto limit = (timeout != 0 && (timeout_ == 0 || timeout < timeout_))
+                   ? timeout
+                   : timeout_;
+
+  auto Worker = [&](size_t i) {
+    auto& ctx = *ctxs[i];
+    auto& config = configs_[i];
+    auto res = z3::unknown;
+    std::unique_ptr<z3::model> res_model;
+    try {
+      auto solver = z3::solver(ctx);
+      if (!config.tactics.empty()) {
+        auto t = z3::tactic(ctx, config.tactics.front().c_str());
+        for (size_t k = 1; k < config.tactics.size(); k++) {
+          t = t & z3::tactic(ctx, config.tactics[k].c_str());
+        }
+        solver = t.mk_solver();
+      }
+      auto params = z3::params(ctx);
+      params.set("random_seed", config.seed);
+      if (limit != 0) {
+        params.set("timeout", limit);
+      }
+      solver.set(params);
+      solver.add(queries[i]);
+      res = solver.check();
+      if (res == z3::sat) {
+        res_model = std::make_unique<z3::model>(solver.get_model());
+      }
+    } catch (z3::exception& e) {
+      // e.g., canceled, or tactic not applicable
+      ILA_DLOG("SolverPortfolio") << config.name << ": " << e.msg();
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    finished[i] = true;
+    finished_num++;
+    if (res != z3::unknown && winner == num) {
+      winner = i;
+      result = res;
+      model = std::move(res_model);
+    }
+    cv.notify_all();
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i != num; i++) {
+    workers.emplace_back(Worker, i);
+  }
+
+  // wait for the first definitive answer, and cancel the others until they
+  // all stop (a run may start after being interrupted)
+  std::unique_lock<std::mutex> lock(mtx);
+  cv.wait(lock, [&] { return winner != num || finished_num == num; });
+  while (finished_num != num) {
+    for (size_t i = 0; i != num; i++) {
+      if (!finished[i]) {
+        ctxs[i]->interrupt();
+      }
+    }
+    cv.wait_for(lock, std::chrono::milliseconds(10));
+  }
+  lock.unlock();
+  for (auto& w : workers) {
+    w.join();
+  }
+
+  if (winner != num) {
+    winner_ = configs_[winner].name;
+    model_ = std::move(model);
+    model_ctx_ = std::move(ctxs[winner]);
+  }
+  ILA_DLOG("SolverPortfolio") << "Answered by " << winner_;
+  return result;
+}
+
+z3::model SolverPortfolio::GetModel(z3::context& ctx) const {
+  ILA_CHECK(model_) << "No model from the last query";
+  return z3::model(*model_, ctx, z3::model::translate());
+}
+
+} // namespace ilang
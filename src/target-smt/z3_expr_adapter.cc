@@ -4,6 +4,7 @@
 #include <ilang/target-smt/z3_expr_adapter.h>
 
 #include <ilang/util/log.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -13,8 +14,10 @@ Z3ExprAdapter::~Z3ExprAdapter() {}
 
 z3::expr Z3ExprAdapter::GetExpr(const ExprPtr& expr,
                                 const std::string& suffix) {
+  ILA_TRACE_SCOPE("smt.z3_expr");
   expr_map_.clear();
   suffix_ = suffix;
+  frame_ = frame_id_.emplace(suffix, frame_id_.size()).first->second;
 
   expr->DepthFirstVisit(*this);
 
@@ -24,6 +27,11 @@ z3::expr Z3ExprAdapter::GetExpr(const ExprPtr& expr,
   return pos->second;
 }
 
+void Z3ExprAdapter::ClearCache() {
+  var_map_.clear();
+  frame_id_.clear();
+}
+
 void Z3ExprAdapter::operator()(const ExprPtr& expr) {
   auto pos = expr_map_.find(expr);
   // expression has been generated.
@@ -40,6 +48,21 @@ void Z3ExprAdapter::operator()(const ExprPtr& expr) {
 }
 
 void Z3ExprAdapter::PopulateExprMap(const ExprPtr& expr) {
+  // variables are shared across calls with the same suffix (frame)
+  if (expr->is_var()) {
+    auto key = VarFrameKey(expr->name().id(), frame_);
+    auto name = &expr->name().str();
+    auto pos = var_map_.find(key);
+    if (pos == var_map_.end()) {
+      auto res = expr->GetZ3Expr(ctx_, {}, suffix_);
+      pos = var_map_.emplace(key, VarEntry(name, res)).first;
+    } else if (pos->second.first != name) { // renamed (Symbol::set_name)
+      pos->second = VarEntry(name, expr->GetZ3Expr(ctx_, {}, suffix_));
+    }
+    expr_map_.insert({expr, pos->second.second});
+    return;
+  }
+
   size_t num = expr->arg_num();
 
   // reserve the container for argument expressions.
@@ -55,8 +78,14 @@ void Z3ExprAdapter::PopulateExprMap(const ExprPtr& expr) {
     expr_vec.push_back(pos->second);
   }
 
-  // get the expression based on different type of the ast node.
-  z3::expr res = expr->GetZ3Expr(ctx_, expr_vec, suffix_);
+  // get the expression based on different type of the ast node, where the
+  // operations are dispatched statically by their IDs
+  auto GetZ3Expr = [this, &expr_vec](const auto& node) {
+    return node.GetZ3Expr(ctx_, expr_vec, suffix_);
+  };
+  auto res = expr->is_op()
+                 ? DispatchExprOp(static_cast<const ExprOp&>(*expr), GetZ3Expr)
+                 : GetZ3Expr(*expr);
 
   // simplify expression
   res = res.simplify();
@@ -0,0 +1,284 @@
+/// \file
+/// Source for eliminating array reasoning of memories in z3 formulas.
+
+#include <ilang/target-smt/z3_lazy_mem.h>
+
+#include <string>
+#include <vector>
+
+#include <ilang/util/log.h>
+
+namespace ilang {
+
+Z3LazyMemEncoder::Z3LazyMemEncoder(z3::context& ctx, const MemFilter& filter)
+    : ctx_(ctx), filter_(filter) {}
+
+Z3LazyMemEncoder::~Z3LazyMemEncoder() {}
+
+z3::expr Z3LazyMemEncoder::Encode(const z3::expr& formula) {
+  ILA_ASSERT(formula.is_bool()) << "Encoding non-Boolean formula";
+  Reset();
+
+  // split the top-level conjunction
+  auto conjuncts = z3::expr_vector(ctx_);
+  std::vector<z3::expr> stack = {formula};
+  while (!stack.empty()) {
+    auto e = stack.back();
+    stack.pop_back();
+    if (e.is_app() && e.decl().decl_kind() == Z3_OP_AND) {
+      for (auto i = e.num_args(); i != 0; i--) {
+        stack.push_back(e.arg(i - 1));
+      }
+    } else {
+      conjuncts.push_back(e);
+    }
+  }
+
+  auto rest = z3::expr_vector(ctx_);
+  CollectDefs(conjuncts, rest);
+
+  auto rewritten = z3::expr_vector(ctx_);
+  for (unsigned i = 0; i != rest.size(); i++) {
+    rewritten.push_back(Rewrite(rest[i]));
+  }
+  auto res = Ackermannize(z3::mk_and(rewritten));
+
+  ILA_DLOG("Z3LazyMem") << "Substitute " << def_num_ << " memories, "
+                        << read_num_ << " initial reads";
+  Reset();
+  return res;
+}
+
+void Z3LazyMemEncoder::Reset() {
+  defs_.clear();
+  rewrite_map_.clear();
+  read_map_.clear();
+  lazy_map_.clear();
+}
+
+bool Z3LazyMemEncoder::IsLazyVar(const z3::expr& e) const {
+  return e.is_const() && e.is_array() &&
+         e.decl().decl_kind() == Z3_OP_UNINTERPRETED && filter_(e);
+}
+
+bool Z3LazyMemEncoder::IsLazy(const z3::expr& arr) {
+  auto pos = lazy_map_.find(arr.id());
+  if (pos != lazy_map_.end()) {
+    return pos->second;
+  }
+  auto res = IsLazyVar(arr);
+  if (!res && arr.is_app()) {
+    switch (arr.decl().decl_kind()) {
+    case Z3_OP_STORE:
+      res = IsLazy(arr.arg(0));
+      break;
+    case Z3_OP_ITE:
+      res = IsLazy(arr.arg(1)) || IsLazy(arr.arg(2));
+      break;
+    default:
+      break;
+    }
+  }
+  lazy_map_.emplace(arr.id(), res);
+  return res;
+}
+
+void Z3LazyMemEncoder::CollectDefs(const z3::expr_vector& conjuncts,
+                                   z3::expr_vector& rest) {
+  // candidates, i.e., the first equality on each lazy variable
+  std::map<unsigned, unsigned> cand;
+  for (unsigned i = 0; i != conjuncts.size(); i++) {
+    auto c = conjuncts[i];
+    if (c.is_app() && c.decl().decl_kind() == Z3_OP_EQ && c.num_args() == 2) {
+      auto lhs = c.arg(0);
+      auto rhs = c.arg(1);
+      if (IsLazyVar(rhs) && cand.find(rhs.id()) == cand.end() &&
+          rhs.id() != lhs.id()) {
+        defs_.emplace(rhs.id(), lhs);
+        cand.emplace(rhs.id(), i);
+        continue;
+      }
+      if (IsLazyVar(lhs) && cand.find(lhs.id()) == cand.end() &&
+          rhs.id() != lhs.id()) {
+        defs_.emplace(lhs.id(), rhs);
+        cand.emplace(lhs.id(), i);
+        continue;
+      }
+    }
+    rest.push_back(c);
+  }
+
+  // dependency among the candidates
+  std::map<unsigned, std::vector<unsigned>> deps;
+  for (auto& it : cand) {
+    std::unordered_set<unsigned> visited;
+    std::vector<z3::expr> stack = {defs_.at(it.first)};
+    while (!stack.empty()) {
+      auto e = stack.back();
+      stack.pop_back();
+      if (!visited.insert(e.id()).second || !e.is_app()) {
+        continue;
+      }
+      if (cand.find(e.id()) != cand.end()) {
+        deps[it.first].push_back(e.id());
+      }
+      for (unsigned i = 0; i != e.num_args(); i++) {
+        stack.push_back(e.arg(i));
+      }
+    }
+  }
+
+  // break cycles by dropping the source of each back edge
+  std::unordered_set<unsigned> dropped;
+  std::unordered_map<unsigned, int> color; // 1: visiting, 2: done
+  std::function<void(unsigned)> Visit = [&](unsigned v) {
+    color[v] = 1;
+    for (auto u : deps[v]) {
+      if (color[u] == 1) {
+        dropped.insert(v);
+      } else if (color[u] == 0) {
+        Visit(u);
+      }
+    }
+    color[v] = 2;
+  };
+  for (auto& it : cand) {
+    if (color[it.first] == 0) {
+      Visit(it.first);
+    }
+  }
+  for (auto& it : cand) {
+    if (dropped.find(it.first) != dropped.end()) {
+      defs_.erase(it.first);
+      rest.push_back(conjuncts[it.second]);
+    }
+  }
+  def_num_ += defs_.size();
+}
+
+z3::expr Z3LazyMemEncoder::Rewrite(const z3::expr& e) {
+  auto pos = rewrite_map_.find(e.id());
+  if (pos != rewrite_map_.end()) {
+    return pos->second;
+  }
+
+  auto res = e;
+  auto def = defs_.find(e.id());
+  if (def != defs_.end()) {
+    res = Rewrite(def->second);
+    // reads on the definition are resolved, even if not rooted at a variable
+    lazy_map_[res.id()] = true;
+  } else if (e.is_app() && e.num_args() != 0) {
+    auto args = z3::expr_vector(ctx_);
+    for (unsigned i = 0; i != e.num_args(); i++) {
+      args.push_back(Rewrite(e.arg(i)));
+    }
+    if (e.decl().decl_kind() == Z3_OP_SELECT && IsLazy(args[0])) {
+      res = Read(args[0], args[1]);
+    } else {
+      res = e.decl()(args);
+    }
+  }
+  rewrite_map_.emplace(e.id(), res);
+  return res;
+}
+
+z3::expr Z3LazyMemEncoder::Read(const z3::expr& arr, const z3::expr& addr) {
+  auto key = std::make_pair(arr.id(), addr.id());
+  auto pos = read_map_.find(key);
+  if (pos != read_map_.end()) {
+    return pos->second;
+  }
+
+  auto res = z3::select(arr, addr);
+  switch (arr.is_app() ? arr.decl().decl_kind() : Z3_OP_UNINTERPRETED) {
+  case Z3_OP_STORE: {
+    auto w_addr = arr.arg(1);
+    auto w_data = arr.arg(2);
+    if (w_addr.id() == addr.id()) {
+      res = w_data;
+    } else if (w_addr.is_numeral() && addr.is_numeral()) {
+      // numerals are hash-consed, i.e., different ids for different values
+      res = Read(arr.arg(0), addr);
+    } else {
+      res = z3::ite(w_addr == addr, w_data, Read(arr.arg(0), addr));
+    }
+    break;
+  }
+  case Z3_OP_ITE: {
+    res = z3::ite(arr.arg(0), Read(arr.arg(1), addr), Read(arr.arg(2), addr));
+    break;
+  }
+  case Z3_OP_CONST_ARRAY: {
+    res = arr.arg(0);
+    break;
+  }
+  default:
+    break;
+  };
+
+  read_map_.emplace(key, res);
+  return res;
+}
+
+z3::expr Z3LazyMemEncoder::Ackermannize(const z3::expr& formula) {
+  // collect the reads on lazy variables, and the variables used otherwise
+  std::map<unsigned, std::vector<z3::expr>> reads;
+  std::unordered_set<unsigned> kept;
+  std::unordered_set<unsigned> visited;
+  std::vector<z3::expr> stack = {formula};
+  while (!stack.empty()) {
+    auto e = stack.back();
+    stack.pop_back();
+    if (!visited.insert(e.id()).second || !e.is_app()) {
+      continue;
+    }
+    auto is_select = e.decl().decl_kind() == Z3_OP_SELECT;
+    for (unsigned i = 0; i != e.num_args(); i++) {
+      auto arg = e.arg(i);
+      if (IsLazyVar(arg)) {
+        if (is_select && i == 0) {
+          reads[arg.id()].push_back(e);
+        } else {
+          kept.insert(arg.id());
+        }
+      }
+      stack.push_back(arg);
+    }
+  }
+
+  auto src = z3::expr_vector(ctx_);
+  auto dst = z3::expr_vector(ctx_);
+  auto cstr = z3::expr_vector(ctx_);
+  for (auto& [var, var_reads] : reads) {
+    if (kept.find(var) != kept.end()) {
+      continue;
+    }
+    auto prefix = var_reads.front().arg(0).decl().name().str() + "_rd";
+    auto base = dst.size();
+    for (size_t i = 0; i != var_reads.size(); i++) {
+      auto sort = var_reads[i].get_sort();
+      auto data = z3::expr(ctx_, Z3_mk_fresh_const(ctx_, prefix.c_str(), sort));
+      src.push_back(var_reads[i]);
+      dst.push_back(data);
+      // same address implies same data
+      auto addr_i = var_reads[i].arg(1);
+      for (size_t j = 0; j != i; j++) {
+        auto addr_j = var_reads[j].arg(1);
+        if (!addr_i.is_numeral() || !addr_j.is_numeral()) {
+          auto same_data = data == dst[base + j];
+          cstr.push_back(z3::implies(addr_i == addr_j, same_data));
+        }
+      }
+    }
+    read_num_ += var_reads.size();
+  }
+
+  if (src.empty()) {
+    return formula;
+  }
+  cstr.push_back(formula);
+  return z3::mk_and(cstr).substitute(src, dst);
+}
+
+} // namespace ilang
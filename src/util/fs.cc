@@ -7,7 +7,9 @@
 
 #include <ilang/util/fs.h>
 
+#include <algorithm>
 #include <cctype>
+#include <cerrno>
 #include <cstdlib>
 #include <fstream>
 #include <iomanip>
@@ -38,6 +40,7 @@
 #include <fmt/format.h>
 #include <ilang/util/log.h>
 #include <ilang/util/str_util.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -256,6 +259,7 @@ os_portable_execute_shell(const std::vector<std::string>& cmdargs,
                           const std::string& redirect_output_file,
                           redirect_t rdt, unsigned timeout,
                           const std::string& pid_file_name) {
+  ILA_TRACE_SCOPE("tool.execute_shell");
   int pipefd[2];
   execute_result _ret;
   struct timeval Time1, Time2; // count the time
@@ -534,6 +538,232 @@ os_portable_execute_shell(const std::vector<std::string>& cmdargs,
 #endif
 }
 
+size_t os_portable_execute_shell_race(
+    const std::vector<execute_job>& jobs,
+    const std::function<bool(size_t, const execute_result&)>& accept,
+    std::vector<execute_result>& results, unsigned timeout) {
+  results.clear();
+  results.resize(jobs.size());
+  for (auto& res : results) {
+    res.timeout = false;
+    res.cancelled = false;
+    res.failure = execute_result::NONE;
+    res.ret = 0;
+    res.subexit_normal = false;
+    res.seconds = 0;
+  }
+
+#if defined(_WIN32) || defined(_WIN64)
+  ILA_ERROR_IF(timeout != 0) << "Timeout feature is not supported on WINDOWS.";
+  // no process groups to kill, run them one after another
+  auto cwd = os_portable_getcwd();
+  for (size_t idx = 0; idx < jobs.size(); ++idx) {
+    if (!os_portable_chdir(jobs[idx].work_dir)) {
+      results[idx].failure = execute_result::PREIO;
+      continue;
+    }
+    results[idx] = os_portable_execute_shell(
+        jobs[idx].cmdargs, jobs[idx].redirect_output_file, redirect_t::BOTH);
+    os_portable_chdir(cwd);
+    if (accept(idx, results[idx])) {
+      return idx;
+    }
+  }
+  return jobs.size();
+#else
+  // seconds between SIGTERM and SIGKILL when stopping the jobs
+  static const double kKillGracePeriod = 1.0;
+
+  struct timeval Time1, Time2; // count the time
+  gettimeofday(&Time1, NULL);
+
+  // pid of each job, 0 if it has been reaped (or failed to start)
+  std::vector<pid_t> pids(jobs.size(), 0);
+  std::vector<int> pipes(jobs.size(), -1);
+
+  for (size_t idx = 0; idx < jobs.size(); ++idx) {
+    auto& job = jobs[idx];
+    ILA_ASSERT(!job.cmdargs.empty()) << "API misuse!";
+
+    int pipefd[2];
+#if defined(__linux__)
+    auto pipe_res = pipe2(pipefd, O_CLOEXEC);
+#else
+    auto pipe_res = pipe(pipefd);
+    if (pipe_res == 0) {
+      fcntl(pipefd[0], F_SETFD, FD_CLOEXEC);
+      fcntl(pipefd[1], F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    if (pipe_res != 0) {
+      ILA_ERROR << "Fail creating pipe for: " << Join(job.cmdargs, ",");
+      results[idx].failure = execute_result::PREIO;
+      continue;
+    }
+
+    pid_t pid = fork();
+    if (pid == -1) {
+      close(pipefd[0]);
+      close(pipefd[1]);
+      results[idx].failure = execute_result::FORK;
+      continue;
+    }
+
+    if (pid == 0) {
+      // the child: own process group, so that the whole job can be killed
+      setpgid(0, 0);
+      close(pipefd[0]);
+      unsigned char report_to_parent = execute_result::PREIO;
+
+      if (chdir(job.work_dir.c_str()) != 0) {
+        write(pipefd[1], (void*)&report_to_parent, sizeof(report_to_parent));
+        _exit(1);
+      }
+      if (!job.redirect_output_file.empty()) {
+        int fd = open(job.redirect_output_file.c_str(),
+                      O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        if (fd < 0) {
+          write(pipefd[1], (void*)&report_to_parent, sizeof(report_to_parent));
+          _exit(1);
+        }
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+      }
+
+      std::vector<char*> argv;
+      for (auto& arg : job.cmdargs) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+      }
+      argv.push_back(NULL);
+      execvp(argv[0], argv.data());
+
+      // only if not successful
+      report_to_parent = execute_result::EXEC;
+      write(pipefd[1], (void*)&report_to_parent, sizeof(report_to_parent));
+      _exit(1);
+    }
+
+    // the parent: also set the group here to avoid racing with the child
+    setpgid(pid, pid);
+    close(pipefd[1]);
+    pids[idx] = pid;
+    pipes[idx] = pipefd[0];
+    ILA_INFO << "Execute subprocess: [" << Join(job.cmdargs, ",") << "] in "
+             << job.work_dir;
+  }
+
+  auto elapsed = [&Time1, &Time2]() {
+    gettimeofday(&Time2, NULL);
+    return ((Time2.tv_usec + Time2.tv_sec * 1000000.0) -
+            (Time1.tv_usec + Time1.tv_sec * 1000000.0)) /
+           1000000.0;
+  };
+
+  // the write end is closed on exec (or exit), so this never blocks
+  auto collect = [&](size_t idx, int infop) {
+    auto& res = results[idx];
+    res.seconds = elapsed();
+    res.subexit_normal = WIFEXITED(infop);
+    res.ret = WEXITSTATUS(infop);
+    unsigned char child_report;
+    if (read(pipes[idx], (void*)&child_report, sizeof(child_report)) == 1) {
+      res.failure = static_cast<execute_result::_failure>(child_report);
+    }
+    close(pipes[idx]);
+    pids[idx] = 0;
+  };
+
+  // the child can no longer be waited for (e.g., reaped elsewhere)
+  auto abandon = [&](size_t idx) {
+    results[idx].seconds = elapsed();
+    results[idx].failure = execute_result::WAIT;
+    close(pipes[idx]);
+    pids[idx] = 0;
+  };
+
+  // reap the job if it has exited, false if it is still running
+  auto reap = [&](size_t idx) {
+    int infop = 0;
+    auto wait_pid_res = waitpid(pids[idx], &infop, WNOHANG);
+    if (wait_pid_res == 0 || (wait_pid_res == -1 && errno == EINTR)) {
+      return false; // still running, or interrupted (retry in the next round)
+    }
+    if (wait_pid_res == -1) {
+      abandon(idx);
+    } else {
+      collect(idx, infop);
+    }
+    return true;
+  };
+
+  // only wait for our own children, so poll instead of waitpid(-1, ...)
+  size_t winner = jobs.size();
+  auto running = [&pids]() {
+    return std::any_of(pids.begin(), pids.end(), [](pid_t p) { return p; });
+  };
+  while (winner == jobs.size() && running()) {
+    bool reaped = false;
+    for (size_t idx = 0; idx < jobs.size() && winner == jobs.size(); ++idx) {
+      if (pids[idx] == 0 || !reap(idx)) {
+        continue;
+      }
+      reaped = true;
+      if (results[idx].failure != execute_result::WAIT &&
+          accept(idx, results[idx])) {
+        winner = idx;
+      }
+    }
+    if (timeout != 0 && elapsed() > timeout) {
+      break;
+    }
+    if (!reaped) {
+      usleep(10000);
+    }
+  }
+
+  // stop the others (cancelled by the winner, or timeout): SIGTERM first, and
+  // SIGKILL those still running after the grace period
+  auto cancelled = winner != jobs.size();
+  for (size_t idx = 0; idx < jobs.size(); ++idx) {
+    if (pids[idx] != 0) {
+      kill(-pids[idx], SIGTERM);
+      results[idx].cancelled = cancelled;
+      results[idx].timeout = !cancelled;
+    }
+  }
+  auto grace_end = elapsed() + kKillGracePeriod;
+  while (running() && elapsed() < grace_end) {
+    for (size_t idx = 0; idx < jobs.size(); ++idx) {
+      if (pids[idx] != 0) {
+        reap(idx);
+      }
+    }
+    if (running()) {
+      usleep(10000);
+    }
+  }
+  for (size_t idx = 0; idx < jobs.size(); ++idx) {
+    if (pids[idx] == 0) {
+      continue;
+    }
+    kill(-pids[idx], SIGKILL);
+    int infop = 0;
+    pid_t wait_pid_res;
+    do {
+      wait_pid_res = waitpid(pids[idx], &infop, 0);
+    } while (wait_pid_res == -1 && errno == EINTR);
+    if (wait_pid_res == -1) {
+      abandon(idx);
+    } else {
+      collect(idx, infop);
+    }
+  }
+
+  return winner;
+#endif
+}
+
 /// read the last meaningful line from a file
 std::string os_portable_read_last_line(const std::string& filename) {
   std::ifstream fin(filename);
@@ -596,6 +826,11 @@ std::string os_portable_getcwd() {
   return fs::current_path().string();
 } // os_portable_getcwd
 
+/// Get the absolute path (resolved against the current directory)
+std::string os_portable_absolute_path(const std::string& path) {
+  return fs::absolute(path).string();
+} // os_portable_absolute_path
+
 #if (defined(__unix__) || defined(unix) || defined(__APPLE__) ||               \
      defined(__MACH__) || defined(__FreeBSD__)) &&                             \
     !defined(__linux__)
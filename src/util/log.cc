@@ -25,16 +25,35 @@ LogInitter::LogInitter() {
 
 std::set<std::string> DebugLog::debug_tags_;
 
+std::atomic<uint64_t> DebugLog::enabled_mask_{0};
+
 LogInitter DebugLog::init_;
 
-void DebugLog::Enable(const std::string& tag) { debug_tags_.insert(tag); }
+void DebugLog::Enable(const std::string& tag) {
+  debug_tags_.insert(tag);
+  UpdateMask();
+}
 
-void DebugLog::Disable(const std::string& tag) { debug_tags_.erase(tag); }
+void DebugLog::Disable(const std::string& tag) {
+  debug_tags_.erase(tag);
+  UpdateMask();
+}
 
-void DebugLog::Clear() { debug_tags_.clear(); }
+void DebugLog::Clear() {
+  debug_tags_.clear();
+  UpdateMask();
+}
 
 bool DebugLog::Find(const std::string& tag) {
   return (debug_tags_.find(tag) != debug_tags_.end());
 }
 
+void DebugLog::UpdateMask() {
+  uint64_t mask = 0;
+  for (const auto& tag : debug_tags_) {
+    mask |= TagBit(TagId(tag.c_str()));
+  }
+  enabled_mask_.store(mask, std::memory_order_relaxed);
+}
+
 } // namespace ilang
@@ -0,0 +1,393 @@
+/// \file
+/// Source for the size-class memory pool.
+
+#include <ilang/util/mem_pool.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_set>
+
+/// \namespace ilang
+namespace ilang {
+
+namespace {
+
+/// Number of size classes.
+constexpr size_t kClassNum = MemPool::kMaxBlockSize / MemPool::kAlign;
+
+/// Intrusive free-list node placed in unused blocks.
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+class ThreadCache;
+
+/// \brief Header of a slab. Slabs are aligned to their size, so the slab of a
+/// block is found by masking the block address. Only the owning thread
+/// allocates from a slab (and writes the plain fields); other threads return
+/// blocks through the atomic remote list.
+struct Slab {
+  /// The cache owning the slab (alive as long as the slab is).
+  ThreadCache* owner;
+  /// Size class index.
+  size_t idx;
+  /// Blocks freed by the owner thread.
+  FreeBlock* free_list = nullptr;
+  /// Offset of the first block never handed out.
+  size_t bump;
+  /// Previous slab in the owner's partial or full list.
+  Slab* prev = nullptr;
+  /// Next slab in the owner's partial or full list.
+  Slab* next = nullptr;
+  /// Whether the slab is in the full list.
+  bool full = false;
+  /// Blocks handed out and not known by the owner to be freed (only written
+  /// by the owner, atomic for the statistics).
+  std::atomic<int64_t> used{0};
+  /// Blocks freed by other threads.
+  std::atomic<FreeBlock*> remote{nullptr};
+  /// Number of blocks freed by other threads not yet accounted in used. Once
+  /// the owner has exited, it is minus the number of live blocks, and the
+  /// thread bringing it to zero releases the slab.
+  std::atomic<int64_t> remote_num{0};
+};
+
+/// Offset of the first block in a slab.
+constexpr size_t kSlabHead =
+    (sizeof(Slab) + MemPool::kAlign - 1) / MemPool::kAlign * MemPool::kAlign;
+
+/// Bookkeeping of all slabs, for statistics. Intentionally never destroyed,
+/// so that objects with static storage duration (e.g. global ExprPtr) can
+/// still be released safely during program exit.
+struct SlabRegistry {
+  std::mutex mtx;
+  std::unordered_set<Slab*> slabs;
+};
+
+SlabRegistry& GetRegistry() {
+  static auto registry = new SlabRegistry();
+  return *registry;
+}
+
+inline size_t ClassIdx(const size_t& size) {
+  return (size + MemPool::kAlign - 1) / MemPool::kAlign - 1;
+}
+
+inline size_t BlockSize(const size_t& idx) {
+  return (idx + 1) * MemPool::kAlign;
+}
+
+inline Slab* SlabOf(void* ptr) {
+  auto addr = reinterpret_cast<uintptr_t>(ptr);
+  return reinterpret_cast<Slab*>(addr & ~(MemPool::kSlabSize - 1));
+}
+
+/// \brief The slabs of one thread, kept per size class in a list of slabs
+/// with free blocks (the head is the one in use) and a list of full ones.
+class ThreadCache {
+public:
+  /// Allocate a block of the size class (owner thread only).
+  void* Allocate(const size_t& idx) {
+    auto& cls = classes_[idx];
+    for (;;) {
+      auto slab = cls.partial;
+      if (!slab) {
+        if (!CollectRemote(idx)) {
+          Link(cls.partial, NewSlab(idx));
+        }
+        continue;
+      }
+      if (auto blk = Pop(slab)) {
+        AddUsed(slab, 1);
+        return blk;
+      }
+      Unlink(cls.partial, slab);
+      Link(cls.full, slab);
+      slab->full = true;
+    }
+  }
+
+  /// Return a block to one of the own slabs (owner thread only).
+  void FreeLocal(Slab* slab, FreeBlock* blk) {
+    blk->next = slab->free_list;
+    slab->free_list = blk;
+    auto& cls = classes_[slab->idx];
+    if (slab->full) {
+      Unlink(cls.full, slab);
+      LinkBehind(cls.partial, slab);
+      slab->full = false;
+    }
+    // release the slab if it is empty and not the one in use
+    if (AddUsed(slab, -1) == 0 && slab != cls.partial) {
+      Unlink(cls.partial, slab);
+      Release(slab);
+    }
+  }
+
+  /// Return a block allocated by another thread (any thread).
+  static void FreeRemote(Slab* slab, FreeBlock* blk) {
+    auto head = slab->remote.load(std::memory_order_relaxed);
+    do {
+      blk->next = head;
+    } while (!slab->remote.compare_exchange_weak(
+        head, blk, std::memory_order_release, std::memory_order_relaxed));
+    if (!head) {
+      slab->owner->remote_hint_[slab->idx].store(true,
+                                                 std::memory_order_release);
+    }
+    // the last block of a slab whose owner has exited
+    if (slab->remote_num.fetch_add(1, std::memory_order_acq_rel) == -1) {
+      Release(slab);
+    }
+  }
+
+  /// Give up all slabs when the owner thread exits; each one is released as
+  /// soon as its last block is freed.
+  void Abandon() {
+    for (auto& cls : classes_) {
+      for (auto list : {cls.partial, cls.full}) {
+        while (list) {
+          auto slab = list;
+          list = list->next;
+          auto used = slab->used.load(std::memory_order_relaxed);
+          slab->used.store(0, std::memory_order_relaxed);
+          if (slab->remote_num.fetch_sub(used, std::memory_order_acq_rel) ==
+              used) {
+            Release(slab);
+          }
+        }
+      }
+    }
+    Unref(this);
+  }
+
+private:
+  /// Slabs of one size class.
+  struct ClassSlabs {
+    /// Slabs that may have free blocks (the head is the one in use).
+    Slab* partial = nullptr;
+    /// Slabs without free blocks at the time they were last used.
+    Slab* full = nullptr;
+  };
+
+  /// Per size class slabs.
+  ClassSlabs classes_[kClassNum];
+  /// Per size class flag set when another thread frees a block into a slab.
+  std::atomic<bool> remote_hint_[kClassNum] = {};
+  /// Number of slabs, plus one while the owner thread is alive.
+  std::atomic<size_t> refs_{1};
+
+  /// Delete the cache when the last reference is gone.
+  static void Unref(ThreadCache* cache) {
+    if (cache->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete cache;
+    }
+  }
+
+  /// Adjust the number of used blocks of the slab and return the result.
+  static int64_t AddUsed(Slab* slab, const int64_t& diff) {
+    auto used = slab->used.load(std::memory_order_relaxed) + diff;
+    slab->used.store(used, std::memory_order_relaxed);
+    return used;
+  }
+
+  /// Take a block from the slab, or return NULL if there is none.
+  static void* Pop(Slab* slab) {
+    if (!slab->free_list) {
+      auto block_size = BlockSize(slab->idx);
+      if (slab->bump + block_size <= MemPool::kSlabSize) {
+        auto blk = reinterpret_cast<char*>(slab) + slab->bump;
+        slab->bump += block_size;
+        return blk;
+      }
+      slab->free_list =
+          slab->remote.exchange(nullptr, std::memory_order_acquire);
+      AddUsed(slab, -slab->remote_num.exchange(0, std::memory_order_acquire));
+    }
+    auto blk = slab->free_list;
+    if (blk) {
+      slab->free_list = blk->next;
+    }
+    return blk;
+  }
+
+  /// Move full slabs that got blocks back from other threads to the partial
+  /// list; return true if any.
+  bool CollectRemote(const size_t& idx) {
+    if (!remote_hint_[idx].exchange(false, std::memory_order_acquire)) {
+      return false;
+    }
+    auto& cls = classes_[idx];
+    auto found = false;
+    for (auto slab = cls.full; slab;) {
+      auto next = slab->next;
+      if (slab->remote.load(std::memory_order_relaxed)) {
+        Unlink(cls.full, slab);
+        Link(cls.partial, slab);
+        slab->full = false;
+        found = true;
+      }
+      slab = next;
+    }
+    return found;
+  }
+
+  /// Create a new slab for the size class.
+  Slab* NewSlab(const size_t& idx) {
+    auto mem = ::operator new(MemPool::kSlabSize,
+                              std::align_val_t(MemPool::kSlabSize));
+    auto slab = new (mem) Slab();
+    slab->owner = this;
+    slab->idx = idx;
+    slab->bump = kSlabHead;
+    refs_.fetch_add(1, std::memory_order_relaxed);
+
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    registry.slabs.insert(slab);
+    return slab;
+  }
+
+  /// Return the slab to the system (no live block, not in use).
+  static void Release(Slab* slab) {
+    auto owner = slab->owner;
+    {
+      auto& registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mtx);
+      registry.slabs.erase(slab);
+    }
+    slab->~Slab();
+    ::operator delete(slab, std::align_val_t(MemPool::kSlabSize));
+    Unref(owner);
+  }
+
+  /// Push the slab to the front of the list.
+  static void Link(Slab*& list, Slab* slab) {
+    slab->prev = nullptr;
+    slab->next = list;
+    if (list) {
+      list->prev = slab;
+    }
+    list = slab;
+  }
+
+  /// Insert the slab behind the head of the list (keep the one in use).
+  static void LinkBehind(Slab*& list, Slab* slab) {
+    if (!list) {
+      Link(list, slab);
+      return;
+    }
+    slab->prev = list;
+    slab->next = list->next;
+    if (list->next) {
+      list->next->prev = slab;
+    }
+    list->next = slab;
+  }
+
+  /// Remove the slab from the list.
+  static void Unlink(Slab*& list, Slab* slab) {
+    if (slab->prev) {
+      slab->prev->next = slab->next;
+    } else {
+      list = slab->next;
+    }
+    if (slab->next) {
+      slab->next->prev = slab->prev;
+    }
+    slab->prev = slab->next = nullptr;
+  }
+
+}; // class ThreadCache
+
+/// Cache of the calling thread (NULL before the first use and after exit).
+thread_local ThreadCache* tls_cache = nullptr;
+/// Whether the calling thread has given up its cache.
+thread_local bool tls_exited = false;
+
+/// Abandon the cache of the thread on exit.
+struct ThreadCacheGuard {
+  ~ThreadCacheGuard() {
+    auto cache = tls_cache;
+    tls_cache = nullptr;
+    tls_exited = true;
+    if (cache) {
+      cache->Abandon();
+    }
+  }
+};
+
+/// Return the cache of the calling thread, or NULL if it has exited.
+ThreadCache* GetLocalCache() {
+  if (!tls_cache && !tls_exited) {
+    thread_local ThreadCacheGuard guard;
+    tls_cache = new ThreadCache();
+  }
+  return tls_cache;
+}
+
+/// Cache shared (under the lock) by threads that allocate after their own
+/// cache was abandoned, e.g. in destructors running at exit.
+struct SharedCache {
+  std::mutex mtx;
+  ThreadCache* cache = new ThreadCache();
+};
+
+SharedCache& GetSharedCache() {
+  static auto shared = new SharedCache();
+  return *shared;
+}
+
+} // namespace
+
+void* MemPool::Allocate(const size_t& size) {
+  if (size == 0 || size > kMaxBlockSize) {
+    return ::operator new(size);
+  }
+
+  if (auto cache = GetLocalCache()) {
+    return cache->Allocate(ClassIdx(size));
+  }
+  auto& shared = GetSharedCache();
+  std::lock_guard<std::mutex> lock(shared.mtx);
+  return shared.cache->Allocate(ClassIdx(size));
+}
+
+void MemPool::Deallocate(void* ptr, const size_t& size) {
+  if (!ptr) {
+    return;
+  }
+  if (size == 0 || size > kMaxBlockSize) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  auto slab = SlabOf(ptr);
+  auto blk = static_cast<FreeBlock*>(ptr);
+  if (slab->owner == tls_cache) {
+    tls_cache->FreeLocal(slab, blk);
+  } else {
+    ThreadCache::FreeRemote(slab, blk);
+  }
+}
+
+size_t MemPool::LiveBlockNum() {
+  int64_t res = 0;
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mtx);
+  for (auto slab : registry.slabs) {
+    res += slab->used.load(std::memory_order_relaxed);
+    res -= slab->remote_num.load(std::memory_order_relaxed);
+  }
+  return static_cast<size_t>(res);
+}
+
+size_t MemPool::ReservedBytes() {
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mtx);
+  return registry.slabs.size() * kSlabSize;
+}
+
+} // namespace ilang
@@ -255,4 +255,12 @@ bool StrStartsWith(const std::string& str, const std::string& prefix) {
          0 == str.compare(0, prefix.size(), prefix);
 }
 
+uint64_t HashContent(const std::string& str, uint64_t seed) {
+  for (auto c : str) {
+    seed ^= static_cast<unsigned char>(c);
+    seed *= 0x100000001b3ULL;
+  }
+  return seed;
+}
+
 } // namespace ilang
@@ -0,0 +1,232 @@
+/// \file
+/// Source for the performance telemetry.
+
+#include <ilang/util/telemetry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <ilang/util/log.h>
+
+namespace ilang {
+
+namespace {
+
+/// Max number of events kept for the trace (statistics are always kept).
+static const size_t kMaxEvents = 1 << 20;
+
+/// One record in the trace.
+struct TraceEvent {
+  /// Name of the scope or gauge.
+  std::string name;
+  /// Time stamp.
+  Telemetry::TimeType ts;
+  /// Duration of a scope, or value of a gauge.
+  int64_t val;
+  /// Thread id (scope only).
+  int tid;
+  /// Set if it is a gauge sample.
+  bool is_gauge;
+};
+
+/// Statistics of a scope.
+struct ScopeStat {
+  size_t count = 0;
+  Telemetry::TimeType total = 0;
+  Telemetry::TimeType max = 0;
+};
+
+/// All records (guarded by the mutex, except the counters' values and the
+/// origin, which are read without locking).
+struct Records {
+  std::mutex mtx;
+  /// Time origin of the time stamps (ticks since the steady_clock epoch).
+  std::atomic<std::chrono::steady_clock::rep> origin{0};
+  bool origin_set = false;
+  std::vector<TraceEvent> events;
+  size_t dropped = 0;
+  std::map<std::string, ScopeStat> scopes;
+  std::map<std::string, std::unique_ptr<Telemetry::Counter>> counters;
+  std::map<std::string, int64_t> gauges;
+  std::map<std::thread::id, int> tids;
+};
+
+Records& GetRecords() {
+  static Records records;
+  return records;
+}
+
+std::chrono::steady_clock::rep NowTicks() {
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+} // namespace
+
+std::atomic<bool> Telemetry::enabled_{false};
+
+void Telemetry::Enable() {
+  auto& rec = GetRecords();
+  {
+    std::lock_guard<std::mutex> lock(rec.mtx);
+    if (!rec.origin_set) {
+      rec.origin.store(NowTicks(), std::memory_order_relaxed);
+      rec.origin_set = true;
+    }
+  }
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Telemetry::Disable() { enabled_.store(false, std::memory_order_relaxed); }
+
+void Telemetry::Reset() {
+  auto& rec = GetRecords();
+  std::lock_guard<std::mutex> lock(rec.mtx);
+  rec.origin.store(NowTicks(), std::memory_order_relaxed);
+  rec.events.clear();
+  rec.dropped = 0;
+  rec.scopes.clear();
+  rec.gauges.clear();
+  // counters are referenced by the probes, keep them
+  for (auto& it : rec.counters) {
+    it.second->Reset();
+  }
+}
+
+Telemetry::Counter& Telemetry::GetCounter(const std::string& name) {
+  auto& rec = GetRecords();
+  std::lock_guard<std::mutex> lock(rec.mtx);
+  auto& counter = rec.counters[name];
+  if (!counter) {
+    counter = std::make_unique<Counter>();
+  }
+  return *counter;
+}
+
+void Telemetry::SetGauge(const std::string& name, const int64_t& value) {
+  auto ts = Now();
+  auto& rec = GetRecords();
+  std::lock_guard<std::mutex> lock(rec.mtx);
+  rec.gauges[name] = value;
+  if (rec.events.size() < kMaxEvents) {
+    rec.events.push_back({name, ts, value, 0, true});
+  } else {
+    rec.dropped++;
+  }
+}
+
+void Telemetry::RecordScope(const char* name, const TimeType& begin,
+                            const TimeType& end) {
+  auto& rec = GetRecords();
+  std::lock_guard<std::mutex> lock(rec.mtx);
+  auto& stat = rec.scopes[name];
+  auto dur = end - begin;
+  stat.count++;
+  stat.total += dur;
+  stat.max = std::max(stat.max, dur);
+  if (rec.events.size() < kMaxEvents) {
+    auto tid = rec.tids.emplace(std::this_thread::get_id(), rec.tids.size());
+    rec.events.push_back({name, begin, dur, tid.first->second, false});
+  } else {
+    rec.dropped++;
+  }
+}
+
+Telemetry::TimeType Telemetry::Now() {
+  auto origin = GetRecords().origin.load(std::memory_order_relaxed);
+  auto dur = std::chrono::steady_clock::duration(NowTicks() - origin);
+  return std::chrono::duration_cast<std::chrono::microseconds>(dur).count();
+}
+
+bool Telemetry::ExportChromeTrace(const std::string& file_name) {
+  std::ofstream fout(file_name);
+  if (!fout.is_open()) {
+    ILA_ERROR << "Fail opening file " << file_name;
+    return false;
+  }
+
+  auto end = Now();
+  auto& rec = GetRecords();
+  std::lock_guard<std::mutex> lock(rec.mtx);
+
+  auto events = nlohmann::json::array();
+  events.push_back({{"name", "process_name"},
+                    {"ph", "M"},
+                    {"pid", 1},
+                    {"args", {{"name", "ilang"}}}});
+  for (const auto& e : rec.events) {
+    if (e.is_gauge) {
+      events.push_back({{"name", e.name},
+                        {"ph", "C"},
+                        {"ts", e.ts},
+                        {"pid", 1},
+                        {"args", {{"value", e.val}}}});
+    } else {
+      events.push_back({{"name", e.name},
+                        {"cat", e.name.substr(0, e.name.find('.'))},
+                        {"ph", "X"},
+                        {"ts", e.ts},
+                        {"dur", e.val},
+                        {"pid", 1},
+                        {"tid", e.tid}});
+    }
+  }
+  // final value of the counters
+  for (const auto& it : rec.counters) {
+    events.push_back({{"name", it.first},
+                      {"ph", "C"},
+                      {"ts", end},
+                      {"pid", 1},
+                      {"args", {{"value", it.second->value()}}}});
+  }
+
+  auto trace = nlohmann::json::object();
+  trace["traceEvents"] = events;
+  trace["displayTimeUnit"] = "ms";
+  trace["otherData"] = {{"dropped_events", rec.dropped}};
+  fout << trace.dump(1);
+  return true;
+}
+
+void Telemetry::PrintSummary(std::ostream& out) {
+  auto& rec = GetRecords();
+  std::lock_guard<std::mutex> lock(rec.mtx);
+
+  // scopes, the most time consuming first
+  std::vector<std::pair<std::string, ScopeStat>> scopes(rec.scopes.begin(),
+                                                        rec.scopes.end());
+  std::stable_sort(scopes.begin(), scopes.end(), [](auto& a, auto& b) {
+    return a.second.total > b.second.total;
+  });
+  out << fmt::format("{:<40} {:>10} {:>12} {:>12} {:>12}\n", "scope", "calls",
+                     "total (ms)", "avg (ms)", "max (ms)");
+  for (const auto& [name, stat] : scopes) {
+    out << fmt::format("{:<40} {:>10} {:>12.3f} {:>12.3f} {:>12.3f}\n", name,
+                       stat.count, stat.total / 1e3,
+                       stat.total / 1e3 / stat.count, stat.max / 1e3);
+  }
+
+  if (!rec.counters.empty()) {
+    out << fmt::format("\n{:<40} {:>10}\n", "counter", "value");
+    for (const auto& it : rec.counters) {
+      out << fmt::format("{:<40} {:>10}\n", it.first, it.second->value());
+    }
+  }
+  if (!rec.gauges.empty()) {
+    out << fmt::format("\n{:<40} {:>10}\n", "gauge", "last");
+    for (const auto& it : rec.gauges) {
+      out << fmt::format("{:<40} {:>10}\n", it.first, it.second);
+    }
+  }
+}
+
+} // namespace ilang
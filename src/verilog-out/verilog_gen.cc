@@ -14,6 +14,7 @@
 #include <ilang/util/container_shortcut.h>
 #include <ilang/util/log.h>
 #include <ilang/util/str_util.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -645,53 +646,70 @@ VerilogGenerator::vlg_name_t
 VerilogGenerator::translateBoolOp(const std::shared_ptr<ExprOp>& e) {
 
   vlg_stmt_t result_stmt;
-  std::string op_name = e->op_name();
   size_t arg_num = e->arg_num();
 
-  if (op_name == "APP") { // Function application
+  if (e->uid() == AstUidExprOp::kApplyFunc) { // Function application
     // deal with the case with a function
-    std::shared_ptr<ExprOpAppFunc> func_app_ptr_ =
-        std::dynamic_pointer_cast<ExprOpAppFunc>(e);
+    auto func_app_ptr_ = std::static_pointer_cast<ExprOpAppFunc>(e);
     result_stmt = translateApplyFunc(func_app_ptr_);
   } else if (arg_num == 1) {
-    if (op_name == "NOT")
+    switch (e->uid()) {
+    case AstUidExprOp::kNot:
       result_stmt = "~ ( " + getArg(e, 0) + " ) ";
-    else
-      ILA_ASSERT(false) << op_name << " is not supported by VerilogGenerator";
+      break;
+    default:
+      ILA_ASSERT(false) << e->op_name()
+                        << " is not supported by VerilogGenerator";
+      break;
+    };
   } else if (arg_num == 2) {
     auto arg1 = getArg(e, 0);
     auto arg2 = getArg(e, 1);
-    if (op_name == "AND")
+    switch (e->uid()) {
+    case AstUidExprOp::kAnd:
       result_stmt = " ( " + arg1 + " ) & (" + arg2 + " ) ";
-    else if (op_name == "OR")
+      break;
+    case AstUidExprOp::kOr:
       result_stmt = " ( " + arg1 + " ) | ( " + arg2 + " ) ";
-    else if (op_name == "XOR")
+      break;
+    case AstUidExprOp::kXor:
       result_stmt = " ( " + arg1 + " ) ^ ( " + arg2 + " ) ";
-    else if (op_name == "EQ")
+      break;
+    case AstUidExprOp::kEqual:
       result_stmt = " ( " + arg1 + " ) == ( " + arg2 + " ) ";
-    else if (op_name == "IMPLY")
+      break;
+    case AstUidExprOp::kImply:
       result_stmt = " ( ~ ( " + arg1 + " ) | ( " + arg2 +
                     " ) )"; // do we need to support boolean comparison?
-    else if (op_name == "LT")
+      break;
+    case AstUidExprOp::kLessThan:
       result_stmt =
           vlg_stmt_t(" $signed( ") + arg1 + " ) < $signed( " + arg2 + " ) ";
-    else if (op_name == "GT")
+      break;
+    case AstUidExprOp::kGreaterThan:
       result_stmt =
           vlg_stmt_t(" $signed( ") + arg1 + " ) > $signed( " + arg2 + " ) ";
-    else if (op_name == "ULT")
+      break;
+    case AstUidExprOp::kUnsignedLessThan:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) < ( " + arg2 + " ) ";
-    else if (op_name == "UGT")
+      break;
+    case AstUidExprOp::kUnsignedGreaterThan:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) > ( " + arg2 + " ) ";
-    else
-      ILA_ASSERT(false) << op_name << " is not supported by VerilogGenerator";
+      break;
+    default:
+      ILA_ASSERT(false) << e->op_name()
+                        << " is not supported by VerilogGenerator";
+      break;
+    };
   } else if (arg_num == 3) {
     auto arg1 = getArg(e, 0);
     auto arg2 = getArg(e, 1);
     auto arg3 = getArg(e, 2);
-    if (op_name == "ITE")
+    if (e->uid() == AstUidExprOp::kIfThenElse)
       result_stmt = " ( " + arg1 + " ) ? ( " + arg2 + " ) : ( " + arg3 + " ) ";
     else
-      ILA_ASSERT(false) << op_name << " is not supported by VerilogGenerator";
+      ILA_ASSERT(false) << e->op_name()
+                        << " is not supported by VerilogGenerator";
   }
   vlg_name_t result_var = new_id(e);
   add_wire(result_var, 1);
@@ -705,26 +723,28 @@ VerilogGenerator::vlg_name_t
 VerilogGenerator::translateBvOp(const std::shared_ptr<ExprOp>& e) {
 
   vlg_stmt_t result_stmt;
-  std::string op_name = e->op_name();
   size_t arg_num = e->arg_num();
 
-  if (op_name == "APP") { // Function application
-    // deal with the case with a function
+  if (e->uid() == AstUidExprOp::kApplyFunc) { // Function application
     // deal with the case with a function
-    std::shared_ptr<ExprOpAppFunc> func_app_ptr_ =
-        std::dynamic_pointer_cast<ExprOpAppFunc>(e);
+    auto func_app_ptr_ = std::static_pointer_cast<ExprOpAppFunc>(e);
     result_stmt = translateApplyFunc(func_app_ptr_);
   } else if (arg_num == 1) {
     vlg_name_t arg0 = getArg(e, 0);
-    if (op_name == "NEGATE") // negate : 2's complement
+    switch (e->uid()) {
+    case AstUidExprOp::kNegate: // negate : 2's complement
       result_stmt = vlg_stmt_t("( ~ ( ") + arg0 + " ) + 1'b1 )";
-    else if (op_name == "COMPLEMENT") // 1's complement
+      break;
+    case AstUidExprOp::kComplement: // 1's complement
       result_stmt = vlg_stmt_t("~ ( ") + arg0 + " )";
-    else if (op_name == "EXTRACT") {
+      break;
+    case AstUidExprOp::kExtract: {
       int hi = e->param(0);
       int lo = e->param(1);
       result_stmt = arg0 + "[" + toStr(hi) + ":" + toStr(lo) + "]";
-    } else if (op_name == "ZERO_EXTEND") {
+      break;
+    }
+    case AstUidExprOp::kZeroExtend: {
       int outw = e->param(0);
       int inw = get_width(e->arg(0));
       if (outw == inw)
@@ -732,7 +752,9 @@ VerilogGenerator::translateBvOp(const std::shared_ptr<ExprOp>& e) {
       else
         result_stmt =
             vlg_stmt_t(" {") + toStr(outw - inw) + "'d0 , " + arg0 + "} ";
-    } else if (op_name == "SIGN_EXTEND") {
+      break;
+    }
+    case AstUidExprOp::kSignedExtend: {
       int outw = e->param(0);
       int inw = get_width(e->arg(0));
       if (outw == inw)
@@ -743,52 +765,74 @@ VerilogGenerator::translateBvOp(const std::shared_ptr<ExprOp>& e) {
       } else
         result_stmt = vlg_stmt_t(" { {") + toStr(outw - inw) + "{" + arg0 +
                       "[" + toStr(inw - 1) + "]} }, " + arg0 + "} ";
-    } else if (op_name == "RIGHT_ROTATE") {
+      break;
+    }
+    case AstUidExprOp::kRotateRight: {
       // {x[i-1:0], x[w-1:i]}
       int rotw = e->param(0);
       int inw = get_width(e->arg(0));
       result_stmt = vlg_stmt_t(" { ( ") + arg0 + "[" + toStr(rotw - 1) +
                     ":0] ), ( " + arg0 + "[" + toStr(inw - 1) + ":" +
                     toStr(rotw) + "] ) } ";
-    } else if (op_name == "LEFT_ROTATE") {
+      break;
+    }
+    case AstUidExprOp::kRotateLeft: {
       // {x[w-1-i:0], x[w-1:w-i]}
       int rotw = e->param(0);
       int inw = get_width(e->arg(0));
       result_stmt = vlg_stmt_t(" { ( ") + arg0 + "[" + toStr(inw - 1 - rotw) +
                     ":0] ), ( " + arg0 + "[" + toStr(inw - 1) + ":" +
                     toStr(inw - rotw) + "] ) } ";
-    } else
-      ILA_ASSERT(false) << op_name << " is not supported by VerilogGenerator";
+      break;
+    }
+    default:
+      ILA_ASSERT(false) << e->op_name()
+                        << " is not supported by VerilogGenerator";
+      break;
+    };
   } // else if(arg_num == 1)
   else if (arg_num == 2) {
     vlg_name_t arg1 = getArg(e, 0);
     vlg_name_t arg2 = getArg(e, 1);
-    if (op_name == "AND")
+    switch (e->uid()) {
+    case AstUidExprOp::kAnd:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) & ( " + arg2 + " ) ";
-    else if (op_name == "OR")
+      break;
+    case AstUidExprOp::kOr:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) | ( " + arg2 + " ) ";
-    else if (op_name == "XOR")
+      break;
+    case AstUidExprOp::kXor:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) ^ ( " + arg2 + " ) ";
-    else if (op_name == "SHL") // only shift, use 0 on the right
+      break;
+    case AstUidExprOp::kShiftLeft: // only shift, use 0 on the right
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) << ( " + arg2 + " ) ";
-    else if (op_name == "ASHR") // arithmetic shift right
+      break;
+    case AstUidExprOp::kArithShiftRight: // arithmetic shift right
       result_stmt =
           vlg_stmt_t(" ( $signed( ") + arg1 + " ) >>> ( " + arg2 + " )) ";
-    else if (op_name == "LSHR")
+      break;
+    case AstUidExprOp::kLogicShiftRight:
       result_stmt = vlg_stmt_t(" ( ( ") + arg1 + " ) >> ( " + arg2 + " )) ";
-    else if (op_name == "ADD")
+      break;
+    case AstUidExprOp::kAdd:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) + ( " + arg2 + " ) ";
-    else if (op_name == "SUB")
+      break;
+    case AstUidExprOp::kSubtract:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) - ( " + arg2 + " ) ";
-    else if (op_name == "MUL")
+      break;
+    case AstUidExprOp::kMultiply:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) * ( " + arg2 + " ) ";
-    else if (op_name == "DIV")
+      break;
+    case AstUidExprOp::kDivide:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) / ( " + arg2 + " ) ";
-    else if (op_name == "UREM")
+      break;
+    case AstUidExprOp::kUnsignedRemainder:
       result_stmt = vlg_stmt_t(" ( ") + arg1 + " ) % ( " + arg2 + " ) ";
-    else if (op_name == "CONCAT")
+      break;
+    case AstUidExprOp::kConcatenate:
       result_stmt = vlg_stmt_t(" { ( ") + arg1 + " ) , ( " + arg2 + " ) } ";
-    else if (op_name == "LOAD") {
+      break;
+    case AstUidExprOp::kLoad: {
       // arg1 should be the memvar // arg2 should be the address
       // in the future, we may need to avoid the leaves first traverse to
       // account for the LOAD(STORE) LOAD(ITE)
@@ -824,22 +868,28 @@ VerilogGenerator::translateBvOp(const std::shared_ptr<ExprOp>& e) {
 
         ILA_DLOG("VerilogGen.translateBvOp") << "Not found.";
       }
-    } // end of else if(op_name == "LOAD")
-    else
-      ILA_ASSERT(false) << op_name << " is not supported by VerilogGenerator";
+      break;
+    } // end of case kLoad
+    default:
+      ILA_ASSERT(false) << e->op_name()
+                        << " is not supported by VerilogGenerator";
+      break;
+    };
   } // end of else if(arg_num == 2)
   else if (arg_num == 3) {
     vlg_name_t arg1 = getArg(e, 0);
     vlg_name_t arg2 = getArg(e, 1);
     vlg_name_t arg3 = getArg(e, 2);
-    if (op_name == "ITE")
+    if (e->uid() == AstUidExprOp::kIfThenElse)
       result_stmt =
           vlg_stmt_t(" ( ") + arg1 + " ) ? ( " + arg2 + " ) : ( " + arg3 + " )";
     else
-      ILA_ASSERT(false) << op_name << " is not supported by VerilogGenerator";
+      ILA_ASSERT(false) << e->op_name()
+                        << " is not supported by VerilogGenerator";
   } // else if(arg_num == 3)
   else
-    ILA_ASSERT(false) << op_name << " is not supported by VerilogGenerator";
+    ILA_ASSERT(false) << e->op_name()
+                      << " is not supported by VerilogGenerator";
 
   vlg_name_t result_var = new_id(e);
   add_wire(result_var, get_width(e));
@@ -869,9 +919,7 @@ void VerilogGenerator::ParseNonMemUpdateExpr(
       // leaves first,
       ILA_DLOG("VerilogGen.ParseNonMemUpdateExpr") << "BoolOp, leaves-first ";
       parseArg(e);
-      std::shared_ptr<ExprOp> expr_op_ptr =
-          std::dynamic_pointer_cast<ExprOp>(e);
-      ILA_NOT_NULL(expr_op_ptr);
+      auto expr_op_ptr = std::static_pointer_cast<ExprOp>(e);
       nmap[e] = translateBoolOp(expr_op_ptr);
     } else if (e->is_const()) { // bool const
       vlg_name_t bcnst =
@@ -888,9 +936,7 @@ void VerilogGenerator::ParseNonMemUpdateExpr(
       ILA_DLOG("VerilogGen.ParseNonMemUpdateExpr") << "BV: " << e->name().str();
     } else if (e->is_op()) {
       // leaves first
-      std::shared_ptr<ExprOp> expr_op_ptr =
-          std::dynamic_pointer_cast<ExprOp>(e);
-      ILA_NOT_NULL(expr_op_ptr);
+      auto expr_op_ptr = std::static_pointer_cast<ExprOp>(e);
 
       ILA_DLOG("VerilogGen.ParseNonMemUpdateExpr") << "BVop, leaves-first ";
       parseArg(e); // if not LOAD, leaf-first
@@ -980,13 +1026,12 @@ bool VerilogGenerator::CheckMemUpdateNode(const ExprPtr& e,
     // else
     return false;
   } else if (e->is_op()) {
-    std::shared_ptr<ExprOp> expr_op_ptr = std::dynamic_pointer_cast<ExprOp>(e);
-    ILA_NOT_NULL(expr_op_ptr);
-    if (expr_op_ptr->op_name() == "STORE")
+    auto expr_op_ptr = std::static_pointer_cast<ExprOp>(e);
+    if (expr_op_ptr->uid() == AstUidExprOp::kStore)
       return CheckMemUpdateNode(
           expr_op_ptr->arg(0),
           mem_var_name); // it depends if its subtree conforms to the pattern.
-    if (expr_op_ptr->op_name() == "ITE")
+    if (expr_op_ptr->uid() == AstUidExprOp::kIfThenElse)
       return CheckMemUpdateNode(expr_op_ptr->arg(1), mem_var_name) &&
              CheckMemUpdateNode(expr_op_ptr->arg(2), mem_var_name);
     return false;
@@ -1009,10 +1054,9 @@ void VerilogGenerator::VisitMemNodes(
     mem_write_t mw = {cond, writes};
     current_writes.push_back(mw);
   } else {
-    // ILA_ASSERT( e->is_op() );
-    std::shared_ptr<ExprOp> expr_op_ptr = std::dynamic_pointer_cast<ExprOp>(e);
-    ILA_NOT_NULL(expr_op_ptr);
-    if (expr_op_ptr->op_name() == "ITE") {
+    ILA_ASSERT(e->is_op());
+    auto expr_op_ptr = std::static_pointer_cast<ExprOp>(e);
+    if (expr_op_ptr->uid() == AstUidExprOp::kIfThenElse) {
       ExprPtr ctrue = asthub::And(
           cond, expr_op_ptr->arg(0)); // the writes in the true-branch conforms
                                       // to these conditions
@@ -1185,6 +1229,7 @@ void VerilogGenerator::ParseMemUpdateNode(const ExprPtr& cond, const ExprPtr& e,
 // you need to put together their update model.
 
 void VerilogGenerator::ExportIla(const InstrLvlAbsPtr& ila_ptr_) {
+  ILA_TRACE_SCOPE("verilog.export_ila");
   ILA_NOT_NULL(ila_ptr_);
 
   ILA_WARN_IF(ila_ptr_->init_num() != 0)
@@ -1310,6 +1355,7 @@ void VerilogGenerator::ExportIla(const InstrLvlAbsPtr& ila_ptr_) {
 // make sure to generate decode/valid signal output
 // internal counter
 void VerilogGenerator::ExportTopLevelInstr(const InstrPtr& instr_ptr_) {
+  ILA_TRACE_SCOPE("verilog.export_instr");
   ILA_NOT_NULL(instr_ptr_);
   ILA_WARN_IF(instr_ptr_->host()->parent())
       << "This ExportTopLevelInstr does not put flatten states and "
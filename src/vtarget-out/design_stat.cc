@@ -23,6 +23,9 @@ void DesignStatistics::StoreToFile(const std::string& fn) const {
   fout << TimeOfInvSynSeries.size() << std::endl;
   for (auto&& t : TimeOfInvSynSeries)
     fout << " " << t << std::endl;
+  fout << InvSynBackendSeries.size() << std::endl;
+  for (auto&& b : InvSynBackendSeries)
+    fout << " " << b << std::endl;
 }
 
 void DesignStatistics::LoadFromFile(const std::string& fn) {
@@ -44,6 +47,12 @@ void DesignStatistics::LoadFromFile(const std::string& fn) {
     fin >> tmp;
     TimeOfInvSynSeries.push_back(tmp);
   }
+  // not in the files stored before the backend series was added
+  std::string backend;
+  if (fin >> series) {
+    for (unsigned idx = 0; idx < series && fin >> backend; ++idx)
+      InvSynBackendSeries.push_back(backend);
+  }
 }
 
 }; // namespace ilang
\ No newline at end of file
@@ -123,17 +123,31 @@ std::set<std::string> wrapper_signals = {
 // btw, record all referred vlg name
 std::string
 VlgSglTgtGen::ModifyCondExprAndRecordVlgName(const VarExtractor::token& t) {
+  return UseResolvedToken(ResolveToken(t));
+}
+
+std::string VlgSglTgtGen::UseResolvedToken(const RfExprCache::token_t& t) {
+  if (t.type == VarExtractor::token_type::UNKN_S) {
+    ILA_WARN_IF(!IN(t.text, wrapper_signals) && !IN(t.text, vlg_wrapper.wires))
+        << "In refinement relations: unknown reference to name:" << t.text
+        << " keep unchanged.";
+  } else if (t.type == VarExtractor::token_type::VLG_S && !t.vlg_name.empty()) {
+    _all_referred_vlg_names.insert({t.vlg_name, ex_info_t(t.vlg_range)});
+  }
+  return t.text;
+}
+
+RfExprCache::token_t
+VlgSglTgtGen::ResolveToken(const VarExtractor::token& t) {
   // modify name and ...
   const auto& token_tp = t.first;
   const auto& sname = t.second;
+  RfExprCache::token_t ret = {token_tp, sname, "", ""};
 
   if (token_tp == VarExtractor::token_type::UNKN_S) {
-    ILA_WARN_IF(!IN(sname, wrapper_signals) && !IN(sname, vlg_wrapper.wires))
-        << "In refinement relations: unknown reference to name:" << sname
-        << " keep unchanged.";
-    return sname;
+    return ret; // keep unchanged
   } else if (token_tp == VarExtractor::token_type::KEEP)
-    return sname; // NC
+    return ret; // NC
   else if (token_tp == VarExtractor::token_type::NUM) {
     /*
     if (_backend == backend_selector::COSA) {
@@ -185,7 +199,7 @@ VlgSglTgtGen::ModifyCondExprAndRecordVlgName(const VarExtractor::token& t) {
       }
     }*/
     // else -- only leave it here
-    return sname; // NC
+    return ret; // NC
   } else if (token_tp == VarExtractor::token_type::ILA_S) {
     std::string quote = "";
     auto left_p = sname.find('[');
@@ -194,18 +208,22 @@ VlgSglTgtGen::ModifyCondExprAndRecordVlgName(const VarExtractor::token& t) {
     // if (_backend == backend_selector::COSA)
     //  quote = "'";
     // if it refers to ILA state
-    if (_host->state(check_s))
-      return quote + "__ILA_SO_" + check_s + quote + range_s;
+    if (_host->state(check_s)) {
+      ret.text = quote + "__ILA_SO_" + check_s + quote + range_s;
+      return ret;
+    }
     // if it uses the reference it self
     auto hierName = Split(check_s, ".");
     if (hierName.size() == 2) // maybe it contains an unnecessary head
       if ((hierName[0] == _ila_mod_inst_name || hierName[0] == "ILA") &&
-          _host->state(hierName[1]))
-        return quote + "__ILA_SO_" + hierName[1] + quote + range_s;
+          _host->state(hierName[1])) {
+        ret.text = quote + "__ILA_SO_" + hierName[1] + quote + range_s;
+        return ret;
+      }
     // should not reachable
     ILA_CHECK(false)
         << "Implementation bug: should not be reachable. token_tp: ILA_S";
-    return sname;
+    return ret;
   } else if (token_tp == VarExtractor::token_type::ILA_IN) {
     auto left_p = sname.find('[');
     auto check_s = sname.substr(0, left_p);
@@ -215,24 +233,28 @@ VlgSglTgtGen::ModifyCondExprAndRecordVlgName(const VarExtractor::token& t) {
     // if (_backend == backend_selector::COSA)
     //  quote = "'";
     // if it refers to ILA state
-    if (_host->input(check_s))
-      return quote + "__ILA_I_" + check_s + quote + range_s;
+    if (_host->input(check_s)) {
+      ret.text = quote + "__ILA_I_" + check_s + quote + range_s;
+      return ret;
+    }
     // if it uses the reference it self
     auto hierName = Split(check_s, ".");
     if (hierName.size() == 2) // maybe it contains an unnecessary head
       if ((hierName[0] == _ila_mod_inst_name || hierName[0] == "ILA") &&
-          _host->input(hierName[1]))
-        return quote + "__ILA_I_" + hierName[1] + quote + range_s;
+          _host->input(hierName[1])) {
+        ret.text = quote + "__ILA_I_" + hierName[1] + quote + range_s;
+        return ret;
+      }
     // should not reachable
     ILA_CHECK(false)
         << "Implementation bug: should not be reachable. token_tp: ILA_IN";
-    return sname;
+    return ret;
   } else if (token_tp == VarExtractor::token_type::VLG_S) {
 
     // do nothing for JasperGold
     // will not add to the all_referred name, so will not modify verilog
     if (_backend == backend_selector::JASPERGOLD)
-      return sname;
+      return ret;
 
     std::string quote = "";
     auto left_p = sname.find('[');
@@ -242,30 +264,32 @@ VlgSglTgtGen::ModifyCondExprAndRecordVlgName(const VarExtractor::token& t) {
     // if (_backend == backend_selector::COSA)
     //  quote = "'";
 
+    ret.vlg_range = range_s;
     if (vlg_info_ptr->check_hierarchical_name_type(check_s) !=
         VerilogInfo::hierarchical_name_type::NONE) {
-      _all_referred_vlg_names.insert({check_s + range_s, ex_info_t(range_s)});
+      ret.vlg_name = check_s + range_s;
       auto remove_dot_name = ReplaceAll(check_s, ".", "__DOT__");
       // Convert the check_s to
-      return quote + remove_dot_name + quote + range_underscore;
+      ret.text = quote + remove_dot_name + quote + range_underscore;
+      return ret;
     }
     if (vlg_info_ptr->check_hierarchical_name_type(_vlg_mod_inst_name + "." +
                                                    check_s) !=
         VerilogInfo::hierarchical_name_type::NONE) {
-      _all_referred_vlg_names.insert(
-          {_vlg_mod_inst_name + "." + check_s + range_s, ex_info_t(range_s)});
+      ret.vlg_name = _vlg_mod_inst_name + "." + check_s + range_s;
       auto remove_dot_name = ReplaceAll(check_s, ".", "__DOT__");
-      return quote + _vlg_mod_inst_name + "__DOT__" + remove_dot_name + quote +
-             range_underscore;
+      ret.text = quote + _vlg_mod_inst_name + "__DOT__" + remove_dot_name +
+                 quote + range_underscore;
+      return ret;
     }
     ILA_CHECK(false)
         << "Implementation bug: should not be reachable. token_type: VLG_S";
-    return sname;
+    return ret;
   }
   ILA_CHECK(false)
       << "Implementation bug: should not reachable. Caused by token_type:"
       << token_tp;
-  return sname;
+  return ret;
 }
 
 // static function
@@ -326,10 +350,30 @@ bool isEqu(const std::string& c) { return (c.find("=") != std::string::npos); }
 // Replace an expr's variable name
 std::string VlgSglTgtGen::ReplExpr(const std::string& expr,
                                    bool force_vlg_sts) {
-  return _vext.Replace(expr, force_vlg_sts,
-                       [this](const VarExtractor::token& t) {
-                         return ModifyCondExprAndRecordVlgName(t);
-                       });
+  if (_rf_expr_cache == nullptr) {
+    return _vext.Replace(expr, force_vlg_sts,
+                         [this](const VarExtractor::token& t) {
+                           return ModifyCondExprAndRecordVlgName(t);
+                         });
+  }
+
+  // tokenize and resolve only the first time it is seen by any target
+  auto key = std::make_pair(expr, force_vlg_sts);
+  auto pos = _rf_expr_cache->exprs.find(key);
+  if (pos == _rf_expr_cache->exprs.end()) {
+    RfExprCache::expr_t compiled;
+    _vext.ParseToExtract(expr, force_vlg_sts);
+    _vext.ForEachTokenReplace([this, &compiled](const VarExtractor::token& t) {
+      compiled.push_back(ResolveToken(t));
+      return t.second;
+    });
+    pos = _rf_expr_cache->exprs.emplace(key, std::move(compiled)).first;
+  }
+
+  std::string ret;
+  for (auto&& t : pos->second)
+    ret += UseResolvedToken(t);
+  return ret;
 }
 
 std::string VlgSglTgtGen::PerStateMap(const std::string& ila_state_name,
@@ -12,6 +12,7 @@
 #include <ilang/vtarget-out/inv-syn/inv_syn_cegar.h>
 #include <ilang/vtarget-out/vtarget_gen_impl.h>
 
+#include <algorithm>
 #include <memory>
 
 namespace ilang {
@@ -33,6 +34,23 @@ static std::string select_script_to_run(const std::vector<std::string>& scripts,
   return sels[0];
 }
 
+static std::string synthesis_backend_name(
+    VlgVerifTgtGenBase::synthesis_backend_selector backend) {
+  using sel = VlgVerifTgtGenBase::synthesis_backend_selector;
+  switch (backend) {
+  case sel::Z3:
+    return "z3";
+  case sel::GRAIN:
+    return "grain";
+  case sel::ABC:
+    return "abc";
+  case sel::ELDERICA:
+    return "eldarica";
+  default:
+    return "none";
+  }
+}
+
 // problem: you cannot create and keep the objs
 // so you need to keep the infos
 InvariantSynthesizerCegar::InvariantSynthesizerCegar(
@@ -85,6 +103,7 @@ bool InvariantSynthesizerCegar::check_in_bad_state() const {
 void InvariantSynthesizerCegar::GenerateInvariantVerificationTarget() {
   if (check_in_bad_state())
     return;
+  FinishVerilogAnalysis(); // release the analyzer
 
   // to send in the invariants
   advanced_parameters_t adv_param;
@@ -160,6 +179,7 @@ void InvariantSynthesizerCegar::GenerateVerificationTarget() {
   // generate a target -- based on selection
   if (check_in_bad_state())
     return;
+  FinishVerilogAnalysis(); // release the analyzer
   ILA_WARN_IF(status != cegar_status::NEXT_V)
       << "CEGAR-loop: repeated verification step.";
 
@@ -210,9 +230,36 @@ void InvariantSynthesizerCegar::GenerateSynthesisTarget() {
   // generate a target -- based on selection
   if (check_in_bad_state())
     return;
+  FinishVerilogAnalysis(); // release the analyzer
   ILA_WARN_IF(status != cegar_status::NEXT_S)
       << "CEGAR-loop: not expecting synthesis step.";
 
+  synthesis_targets.clear();
+  if (portfolio_backends.empty()) {
+    synthesis_targets.push_back(
+        GenerateSynthesisTargetOf(s_backend, _output_path));
+  } else {
+    // separate dirs, as the scripts write their results to ../
+    for (auto&& backend : portfolio_backends) {
+      auto path = os_portable_append_dir(
+          _output_path, "portfolio-" + synthesis_backend_name(backend));
+      os_portable_mkdir(path);
+      synthesis_targets.push_back(GenerateSynthesisTargetOf(backend, path));
+    }
+  }
+
+  AdoptSynthesisTarget(synthesis_targets.front());
+  runnable_script_name.clear();
+  for (auto&& target : synthesis_targets)
+    runnable_script_name.push_back(target.script);
+
+  status = cegar_status::S_RES;
+
+} // GenerateSynthesisTarget
+
+InvariantSynthesizerCegar::synthesis_target_t
+InvariantSynthesizerCegar::GenerateSynthesisTargetOf(
+    synthesis_backend_selector backend, const std::string& output_path) {
   // to send in the invariants
   advanced_parameters_t adv_param;
   adv_param._inv_obj_ptr = &inv_obj;
@@ -225,7 +272,7 @@ void InvariantSynthesizerCegar::GenerateSynthesisTarget() {
       implementation_top_module_name,   // top_module_name
       refinement_variable_mapping_path, // variable mapping
       refinement_condition_path,        // conditions
-      _output_path,                     // output path
+      output_path,                      // output path
       _host,                            // ILA
       verify_backend_selector::YOSYS,   // verification backend setting
       _vtg_config,                      // target configuration
@@ -233,22 +280,46 @@ void InvariantSynthesizerCegar::GenerateSynthesisTarget() {
       &adv_param                        // advanced parameter
   );
 
-  if (s_backend == synthesis_backend_selector::ABC) {
+  synthesis_target_t target;
+  target.backend = backend;
+  target.output_path = output_path;
+  if (backend == synthesis_backend_selector::ABC) {
     vg.GenerateInvSynTargetsAbc(_vtg_config.AbcUseGla, _vtg_config.AbcUseCorr,
                                 _vtg_config.AbcUseAiger);
-    current_inv_type = cur_inv_tp::CEGAR_ABC;
+    target.inv_type = cur_inv_tp::CEGAR_ABC;
   } else {
-    design_smt_info = vg.GenerateInvSynTargets(s_backend); // general chc
-    current_inv_type = s_backend == synthesis_backend_selector::GRAIN
-                           ? cur_inv_tp::GRAIN_CHC
-                           : cur_inv_tp::CHC;
+    target.design_smt_info = vg.GenerateInvSynTargets(backend); // general chc
+    target.inv_type = backend == synthesis_backend_selector::GRAIN
+                          ? cur_inv_tp::GRAIN_CHC
+                          : cur_inv_tp::CHC;
   }
 
-  runnable_script_name = vg.GetRunnableScriptName();
+  auto scripts = vg.GetRunnableScriptName();
+  ILA_CHECK(scripts.size() == 1) << "Expecting one synthesis script";
+  target.script = scripts.front();
+  return target;
+}
 
-  status = cegar_status::S_RES;
+void InvariantSynthesizerCegar::AdoptSynthesisTarget(
+    const synthesis_target_t& target) {
+  current_inv_type = target.inv_type;
+  synthesis_output_path = target.output_path;
+  synthesis_result_fn =
+      os_portable_append_dir(target.output_path, "__synthesis_result.txt");
+  // ABC does not provide the SMT-LIB2 information
+  if (target.design_smt_info)
+    design_smt_info = target.design_smt_info;
+  runnable_script_name = {target.script};
+}
 
-} // GenerateSynthesisTarget
+void InvariantSynthesizerCegar::SetSynthesisPortfolio(
+    const std::vector<synthesis_backend_selector>& backends) {
+  for (auto&& backend : backends) {
+    ILA_CHECK(backend != synthesis_backend_selector::NOSYN)
+        << "Cannot race NOSYN as a synthesis backend";
+  }
+  portfolio_backends = backends;
+}
 
 static int inline retrieveColonEol(const std::string& msg,
                                    const std::string& label) {
@@ -312,6 +383,7 @@ bool InvariantSynthesizerCegar::WordLevelEnhancement(
     const InvariantInCnf& incremental_cnf, bool under_test) {
   if (check_in_bad_state())
     return false;
+  FinishVerilogAnalysis(); // release the analyzer
   // to send in the invariants
   advanced_parameters_t adv_param;
   adv_param._inv_obj_ptr = &inv_obj;
@@ -444,6 +516,9 @@ void InvariantSynthesizerCegar::ExtractVerificationResult(
     return;
   }
 
+  // started when the verification is run
+  auto va = FinishVerilogAnalysis();
+
   if (pass) {
     ILA_INFO << "No counterexample has been found. CEGAR loop finishes.";
     status = cegar_status::DONE;
@@ -451,11 +526,14 @@ void InvariantSynthesizerCegar::ExtractVerificationResult(
   }
 
   // we still need to create a verilog info analyzer
-  VerilogAnalyzer va(implementation_incl_path, implementation_srcs_path,
-                     vlg_mod_inst_name, implementation_top_module_name);
+  if (!va) {
+    va = std::make_shared<VerilogAnalyzer>(
+        implementation_incl_path, implementation_srcs_path, vlg_mod_inst_name,
+        implementation_top_module_name);
+  }
 
   auto is_reg = [&](const std::string& n) -> bool {
-    if (!VerilogAnalyzerBase::is_reg(va.check_hierarchical_name_type(n)))
+    if (!VerilogAnalyzerBase::is_reg(va->check_hierarchical_name_type(n)))
       return false;
     if (design_smt_info) // if available we will use it
       return design_smt_info->is_state_name(n);
@@ -592,7 +670,8 @@ void InvariantSynthesizerCegar::ExtractSynthesisResult(
     }
     inv_obj.AddInvariantFromGrainResultFile(
         *(design_smt_info.get()), "",
-        os_portable_append_dir(_output_path, "grain.result"), true, true);
+        os_portable_append_dir(synthesis_output_path, "grain.result"), true,
+        true);
   } else if (current_inv_type == cur_inv_tp::CEGAR_ABC) {
     ILA_CHECK(inv_obj.AddInvariantFromAbcResultFile(
         _vtg_config.AbcUseAiger
@@ -678,6 +757,7 @@ bool InvariantSynthesizerCegar::RunVerifAuto(
   auto result_fn =
       os_portable_append_dir(_output_path, "__verification_result.txt");
   auto redirect_fn = os_portable_append_dir("..", "__verification_result.txt");
+  StartVerilogAnalysis();
   auto cwd = os_portable_getcwd();
   auto new_wd = os_portable_path_from_path(script_sel);
   ILA_ERROR_IF(!os_portable_chdir(new_wd))
@@ -700,6 +780,82 @@ bool InvariantSynthesizerCegar::RunVerifAuto(
   ILA_ERROR_IF(res.failure != execute_result::NONE)
       << "Running verification script " << script_sel << " results in error.";
   ILA_CHECK(os_portable_chdir(cwd));
+
+  eqcheck_time += res.seconds;
+
+  if (ReadVerificationResult(result_fn, new_wd)) {
+    verification_pass = false;
+    return false;
+  }
+  verification_pass = true;
+  status = cegar_status::DONE;
+  ILA_INFO << "No counterexample has been found. CEGAR loop finishes.";
+  return true;
+}
+
+/// run Verification of several targets
+bool InvariantSynthesizerCegar::RunVerifAutoParallel(
+    const std::vector<std::string>& script_selections, bool under_test,
+    unsigned timeout) {
+  std::vector<std::string> scripts;
+  for (auto&& sel : script_selections)
+    scripts.push_back(select_script_to_run(runnable_script_name, sel));
+  if (check_in_bad_state())
+    return true;
+
+  // each target keeps its own result file
+  std::vector<execute_job> jobs;
+  for (auto&& script : scripts) {
+    ILA_INFO << "Executing verify script:" << script;
+    jobs.push_back({{"bash", os_portable_file_name_from_path(script)},
+                    os_portable_path_from_path(script),
+                    "__verification_result.txt"});
+  }
+  StartVerilogAnalysis();
+
+  // the first counterexample is enough for this round
+  auto accept = [this, &jobs](size_t idx, const execute_result& res) {
+    ILA_ERROR_IF(res.failure != execute_result::NONE)
+        << "Running verification script " << jobs[idx].cmdargs.back()
+        << " in " << jobs[idx].work_dir << " results in error.";
+    return ReadVerificationResult(
+        os_portable_append_dir(jobs[idx].work_dir, "__verification_result.txt"),
+        jobs[idx].work_dir);
+  };
+
+  std::vector<execute_result> results(jobs.size());
+  size_t cex = jobs.size();
+  if (under_test) {
+    for (size_t idx = 0; idx < jobs.size() && cex == jobs.size(); ++idx) {
+      results[idx].subexit_normal = true;
+      results[idx].seconds = 0;
+      results[idx].ret = 0;
+      results[idx].failure = execute_result::NONE;
+      results[idx].timeout = false;
+      if (accept(idx, results[idx]))
+        cex = idx;
+    }
+  } else {
+    cex = os_portable_execute_shell_race(jobs, accept, results, timeout);
+  }
+
+  double seconds = 0;
+  for (auto&& res : results)
+    seconds = std::max(seconds, res.seconds);
+  eqcheck_time += seconds;
+
+  if (cex != jobs.size()) {
+    verification_pass = false;
+    return false;
+  }
+  verification_pass = true;
+  status = cegar_status::DONE;
+  ILA_INFO << "No counterexample has been found. CEGAR loop finishes.";
+  return true;
+}
+
+bool InvariantSynthesizerCegar::ReadVerificationResult(
+    const std::string& result_fn, const std::string& work_dir) {
   // the last line contains the result
   // above it you should have *** TRACES ***
   // the vcd file resides within the new dir
@@ -709,111 +865,160 @@ bool InvariantSynthesizerCegar::RunVerifAuto(
   ILA_ERROR_IF(has_verify_tool_unknown_cosa(result_fn))
       << "UNKNOWN Verif result";
 
-  eqcheck_time += res.seconds;
-
   auto lastLine = os_portable_read_last_line(result_fn);
   ILA_ERROR_IF(lastLine.empty()) << "Unable to extract verification result.";
   if (S_IN("Verifications with unexpected result", lastLine)) {
     ILA_INFO << "Counterexample found.";
 
     vcd_file_name = extract_vcd_name_from_cex(result_fn);
-    vcd_file_name = os_portable_append_dir(new_wd, vcd_file_name);
+    vcd_file_name = os_portable_append_dir(work_dir, vcd_file_name);
+    return true;
+  }
+  return false;
+}
 
-    verification_pass = false;
-    return false;
+void InvariantSynthesizerCegar::StartVerilogAnalysis() {
+  // only needed to extract the counterexample of the cegar loop
+  if (status != cegar_status::V_RES || vlg_mod_inst_name.empty() ||
+      vlg_analysis.valid())
+    return;
+  // the working directory may change while the analysis runs
+  auto incl_path = implementation_incl_path;
+  auto srcs_path = implementation_srcs_path;
+  for (auto* paths : {&incl_path, &srcs_path}) {
+    std::transform(paths->begin(), paths->end(), paths->begin(),
+                   os_portable_absolute_path);
   }
-  verification_pass = true;
-  status = cegar_status::DONE;
-  ILA_INFO << "No counterexample has been found. CEGAR loop finishes.";
-  return true;
+  vlg_analysis = std::async(std::launch::async, [this, incl_path, srcs_path]() {
+    return std::make_shared<VerilogAnalyzer>(incl_path, srcs_path,
+                                             vlg_mod_inst_name,
+                                             implementation_top_module_name);
+  });
+}
+
+std::shared_ptr<VerilogAnalyzer>
+InvariantSynthesizerCegar::FinishVerilogAnalysis() {
+  if (!vlg_analysis.valid())
+    return nullptr;
+  return vlg_analysis.get();
 }
 
 /// run Synthesis
-bool InvariantSynthesizerCegar::RunSynAuto(bool under_test) {
+bool InvariantSynthesizerCegar::RunSynAuto(bool under_test,
+                                           unsigned timeout) {
   if (check_in_bad_state())
     return true;
 
-  ILA_CHECK(runnable_script_name.size() == 1)
+  ILA_CHECK(!synthesis_targets.empty() &&
+            runnable_script_name.size() == synthesis_targets.size())
       << "Please run GenerateInvSynTargets function first";
-  synthesis_result_fn =
-      os_portable_append_dir(_output_path, "__synthesis_result.txt");
   auto redirect_fn = os_portable_append_dir("..", "__synthesis_result.txt");
 
-  auto cwd = os_portable_getcwd();
-  auto new_wd = os_portable_path_from_path(runnable_script_name[0]);
-  ILA_ERROR_IF(!os_portable_chdir(new_wd))
-      << "RunSynAuto: cannot change dir to:" << new_wd;
-  ILA_INFO << "Executing synthesis script:" << runnable_script_name[0];
+  std::vector<execute_job> jobs;
+  for (auto&& target : synthesis_targets) {
+    ILA_INFO << "Executing synthesis script:" << target.script;
+    jobs.push_back({{"bash", os_portable_file_name_from_path(target.script)},
+                    os_portable_path_from_path(target.script),
+                    redirect_fn});
+  }
 
-  execute_result res;
+  // the first one that finishes with a definitive answer (an inductive
+  // invariant, or a reachable counterexample) wins
+  std::vector<bool> unreadable(jobs.size(), false);
+  std::vector<bool> reachable(jobs.size(), true);
+  auto accept = [this, &unreadable, &reachable](size_t idx,
+                                                const execute_result& res) {
+    ILA_ERROR_IF(res.failure != execute_result::NONE)
+        << "Running synthesis script " << synthesis_targets[idx].script
+        << " results in error.";
+    bool reach = true;
+    bool definitive = false;
+    unreadable[idx] =
+        !ReadSynthesisResult(synthesis_targets[idx], reach, definitive);
+    reachable[idx] = reach;
+    return res.failure == execute_result::NONE && definitive;
+  };
+
+  std::vector<execute_result> results(jobs.size());
+  size_t winner = jobs.size();
   if (under_test) {
-    res.subexit_normal = true;
-    res.seconds = 0;
-    res.ret = 0;
-    res.failure = res.NONE;
-    res.timeout = false;
+    for (size_t idx = 0; idx < jobs.size() && winner == jobs.size(); ++idx) {
+      results[idx].subexit_normal = true;
+      results[idx].seconds = 0;
+      results[idx].ret = 0;
+      results[idx].failure = execute_result::NONE;
+      results[idx].timeout = false;
+      if (accept(idx, results[idx]))
+        winner = idx;
+    }
   } else {
-    res = os_portable_execute_shell(
-        {"bash", os_portable_file_name_from_path(runnable_script_name[0])},
-        redirect_fn, redirect_t::BOTH);
+    winner = os_portable_execute_shell_race(jobs, accept, results, timeout);
   }
 
-  ILA_ERROR_IF(res.failure != execute_result::NONE)
-      << "Running synthesis script " << runnable_script_name[0]
-      << " results in error.";
-  ILA_CHECK(os_portable_chdir(cwd));
-
-  inv_syn_time += res.seconds;
-  inv_syn_time_series.push_back(res.seconds);
+  double seconds = 0;
+  for (auto&& res : results)
+    seconds = std::max(seconds, res.seconds);
+  inv_syn_time += seconds;
+  inv_syn_time_series.push_back(seconds);
 
-  if (current_inv_type == CEGAR_ABC) {
-    std::stringstream sbuf;
-    std::ifstream fin(synthesis_result_fn);
-    if (!fin.is_open()) {
-      ILA_ERROR << "Unable to read the synthesis result file:"
-                << synthesis_result_fn;
+  if (winner == jobs.size()) {
+    // none of them could tell (or timeout), take it as reachable
+    AdoptSynthesisTarget(synthesis_targets.front());
+    inv_syn_backend_series.push_back("none");
+    cex_reachable = true;
+    if (std::all_of(unreadable.begin(), unreadable.end(),
+                    [](bool b) { return b; })) {
       status = cegar_status::FAILED;
       bad_state = true;
-      return true; // reachable
     }
+    return cex_reachable;
+  }
+
+  AdoptSynthesisTarget(synthesis_targets[winner]);
+  auto backend = synthesis_backend_name(synthesis_targets[winner].backend);
+  ILA_INFO_IF(synthesis_targets.size() > 1)
+      << "Synthesis backend " << backend << " finishes first.";
+  inv_syn_backend_series.push_back(backend);
+  cex_reachable = reachable[winner];
+  return cex_reachable;
+}
+
+bool InvariantSynthesizerCegar::ReadSynthesisResult(
+    const synthesis_target_t& target, bool& reachable, bool& definitive) {
+  auto result_fn =
+      os_portable_append_dir(target.output_path, "__synthesis_result.txt");
+  std::ifstream fin(result_fn);
+  definitive = false;
+  if (!fin.is_open()) {
+    ILA_ERROR << "Unable to read the synthesis result file:" << result_fn;
+    reachable = true;
+    return false;
+  }
+
+  if (target.inv_type == CEGAR_ABC) {
+    std::stringstream sbuf;
     sbuf << fin.rdbuf();
-    cex_reachable = !(S_IN("Property proved.", sbuf.str()) &&
-                      S_IN("Invariant contains ", sbuf.str()));
-  } else if (current_inv_type == GRAIN_CHC) {
+    reachable = !(S_IN("Property proved.", sbuf.str()) &&
+                  S_IN("Invariant contains ", sbuf.str()));
+    definitive = !reachable || S_IN("was asserted in frame", sbuf.str());
+  } else if (target.inv_type == GRAIN_CHC) {
     std::stringstream sbuf;
-    std::ifstream fin(synthesis_result_fn);
-    if (!fin.is_open()) {
-      ILA_ERROR << "Unable to read the synthesis result file:"
-                << synthesis_result_fn;
-      status = cegar_status::FAILED;
-      bad_state = true;
-      return true; // reachable
-    }
     sbuf << fin.rdbuf();
-    cex_reachable = !(S_IN("proved", sbuf.str()));
-    if (S_IN("unknown", sbuf.str()))
-      cex_reachable = true;
+    reachable = !(S_IN("proved", sbuf.str()));
+    definitive = !S_IN("unknown", sbuf.str());
+    if (!definitive)
+      reachable = true;
     // count cands
     total_grain_cand += retrieveColonEol(sbuf.str(), "TotalCand:");
   } else {
     std::string line;
-    { // read the result
-      std::ifstream fin(synthesis_result_fn);
-      if (!fin.is_open()) {
-        ILA_ERROR << "Unable to read the synthesis result file:"
-                  << synthesis_result_fn;
-        status = cegar_status::FAILED;
-        bad_state = true;
-        return true; // reachable
-      }
-      std::getline(fin, line);
-    } // finish file reading
-    cex_reachable = true;
+    std::getline(fin, line);
+    reachable = true;
     if (S_IN("unsat", line))
-      cex_reachable = false; // not reachable
+      reachable = false; // not reachable
+    definitive = !reachable || S_IN("sat", line);
   }
-  // else reachable
-  return cex_reachable;
+  return true;
 }
 
 // -------------------------------- MISCS
@@ -851,6 +1056,9 @@ void InvariantSynthesizerCegar::LoadPrevStatisticsState(const std::string& fn) {
   inv_syn_time_series.insert(inv_syn_time_series.end(),
                              local_info.TimeOfInvSynSeries.begin(),
                              local_info.TimeOfInvSynSeries.end());
+  inv_syn_backend_series.insert(inv_syn_backend_series.end(),
+                                local_info.InvSynBackendSeries.begin(),
+                                local_info.InvSynBackendSeries.end());
 }
 
 DesignStatistics InvariantSynthesizerCegar::GetDesignStatistics() const {
@@ -862,6 +1070,7 @@ DesignStatistics InvariantSynthesizerCegar::GetDesignStatistics() const {
   ret.TimeOfInvSynEnhance = inv_enhance_time;
   ret.TimeOfInvValidate = inv_validate_time;
   ret.TimeOfInvSynSeries = inv_syn_time_series;
+  ret.InvSynBackendSeries = inv_syn_backend_series;
 
   if (design_smt_info == nullptr) {
     ILA_ERROR << "Design information not available!";
@@ -14,6 +14,7 @@
 #include <ilang/util/fs.h>
 #include <ilang/util/log.h>
 #include <ilang/util/str_util.h>
+#include <ilang/util/telemetry.h>
 
 namespace ilang {
 
@@ -532,6 +533,7 @@ void VlgSglTgtGen::ExportAll(const std::string& wrapper_name,
                              const std::string& script_name,
                              const std::string& extra_name,
                              const std::string& mem_name) {
+  ILA_TRACE_SCOPE("vtarget.export_target");
   PreExportProcess();
   if (os_portable_mkdir(_output_path) == false)
     ILA_WARN << "Cannot create output directory:" << _output_path;
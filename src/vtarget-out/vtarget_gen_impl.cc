@@ -12,6 +12,7 @@
 #include <ilang/util/fs.h>
 #include <ilang/util/log.h>
 #include <ilang/util/str_util.h>
+#include <ilang/util/telemetry.h>
 #include <ilang/vtarget-out/vtarget_gen_cosa.h>
 #include <ilang/vtarget-out/vtarget_gen_jasper.h>
 #include <ilang/vtarget-out/vtarget_gen_relchc.h>
@@ -140,6 +141,7 @@ const VlgTgtSupplementaryInfo& VlgVerifTgtGen::GetSupplementaryInfo() const {
 }
 
 void VlgVerifTgtGen::GenerateTargets(void) {
+  ILA_TRACE_SCOPE("vtarget.generate_targets");
   if (bad_state_return())
     return;
 
@@ -198,6 +200,7 @@ void VlgVerifTgtGen::GenerateTargets(void) {
           _vlg_mod_inst_name, _ila_mod_inst_name, "wrapper", _vlg_impl_srcs,
           _vlg_impl_include_path, _vtg_config, _backend,
           target_type_t::INVARIANTS, _advanced_param_ptr);
+      target.SetRfExprCache(&rf_expr_cache);
       target.ConstructWrapper();
       target.ExportAll("wrapper.v", "ila.v", "run.sh", "problem.txt",
                        "absmem.v");
@@ -210,6 +213,7 @@ void VlgVerifTgtGen::GenerateTargets(void) {
           _vlg_mod_inst_name, _ila_mod_inst_name, "wrapper", _vlg_impl_srcs,
           _vlg_impl_include_path, _vtg_config, _backend,
           target_type_t::INVARIANTS, _advanced_param_ptr);
+      target.SetRfExprCache(&rf_expr_cache);
       target.ConstructWrapper();
       target.ExportAll("wrapper.v", "ila.v", "run.sh", "do.tcl", "absmem.v");
       target.do_not_instantiate();
@@ -223,6 +227,7 @@ void VlgVerifTgtGen::GenerateTargets(void) {
           _vlg_mod_inst_name, _ila_mod_inst_name, "wrapper", _vlg_impl_srcs,
           _vlg_impl_include_path, _vtg_config, _backend,
           target_type_t::INVARIANTS, _advanced_param_ptr);
+      target.SetRfExprCache(&rf_expr_cache);
       target.ConstructWrapper();
       target.ExportAll("wrapper.v", "ila.v", "run.sh", "__design_smt.smt2",
                        "absmem.v");
@@ -238,6 +243,7 @@ void VlgVerifTgtGen::GenerateTargets(void) {
           _vlg_impl_include_path, _vtg_config, _backend,
           target_type_t::INVARIANTS, _advanced_param_ptr,
           _chc_target_t::GENERAL_PROPERTY);
+      target.SetRfExprCache(&rf_expr_cache);
       target.ConstructWrapper();
       std::string design_file;
       if (_backend == backend_selector::ABCPDR)
@@ -287,6 +293,7 @@ void VlgVerifTgtGen::GenerateTargets(void) {
             _vlg_mod_inst_name, _ila_mod_inst_name, "wrapper", _vlg_impl_srcs,
             _vlg_impl_include_path, _vtg_config, _backend,
             target_type_t::INSTRUCTIONS, _advanced_param_ptr);
+        target.SetRfExprCache(&rf_expr_cache);
         target.ConstructWrapper();
         target.ExportAll("wrapper.v", "ila.v", "run.sh", "problem.txt",
                          "absmem.v");
@@ -299,6 +306,7 @@ void VlgVerifTgtGen::GenerateTargets(void) {
             _vlg_mod_inst_name, _ila_mod_inst_name, "wrapper", _vlg_impl_srcs,
             _vlg_impl_include_path, _vtg_config, _backend,
             target_type_t::INSTRUCTIONS, _advanced_param_ptr);
+        target.SetRfExprCache(&rf_expr_cache);
         target.ConstructWrapper();
         target.ExportAll("wrapper.v", "ila.v", "run.sh", "do.tcl", "absmem.v");
         target.do_not_instantiate();
@@ -312,6 +320,7 @@ void VlgVerifTgtGen::GenerateTargets(void) {
             _vlg_mod_inst_name, _ila_mod_inst_name, "wrapper", _vlg_impl_srcs,
             _vlg_impl_include_path, _vtg_config, _backend,
             target_type_t::INSTRUCTIONS, _advanced_param_ptr);
+        target.SetRfExprCache(&rf_expr_cache);
         target.ConstructWrapper();
         target.ExportAll("wrapper.v", "ila.v", "run.sh", "__design_smt.smt2",
                          "absmem.v");
@@ -331,6 +340,7 @@ void VlgVerifTgtGen::GenerateTargets(void) {
             _vlg_impl_include_path, _vtg_config, _backend,
             target_type_t::INSTRUCTIONS, _advanced_param_ptr,
             _chc_target_t::GENERAL_PROPERTY);
+        target.SetRfExprCache(&rf_expr_cache);
         target.ConstructWrapper();
         std::string design_file;
         if (_backend == backend_selector::ABCPDR)
@@ -477,6 +487,7 @@ VlgVerifTgtGen::GenerateInvSynTargets(synthesis_backend_selector s_backend) {
       _vlg_impl_include_path, tmp_vtg_config, _backend, s_backend,
       target_type_t::INV_SYN_DESIGN_ONLY, _advanced_param_ptr, true,
       _chc_target_t::CEX);
+  target.SetRfExprCache(&rf_expr_cache);
   target.ConstructWrapper();
   target.ExportAll("wrapper.v", "ila.v" /*USELESS*/, "run.sh", "wrapper.smt2",
                    "absmem.v" /*USELESS*/);
@@ -534,6 +545,7 @@ VlgVerifTgtGen::GenerateInvSynEnhanceTargets(const InvariantInCnf& cnf) {
       VlgVerifTgtGenBase::synthesis_backend_selector::GRAIN,
       target_type_t::INV_SYN_DESIGN_ONLY, _advanced_param_ptr, true,
       _chc_target_t::CEX);
+  target.SetRfExprCache(&rf_expr_cache);
   target.ConstructWrapper();
   target.ExportAll("wrapper.v", "ila.v" /*USELESS*/, "run.sh", "wrapper.smt2",
                    "absmem.v" /*USELESS*/, "inv_cnf.txt", cnf);
@@ -578,6 +590,7 @@ void VlgVerifTgtGen::GenerateInvSynTargetsAbc(bool useGla, bool useCorr,
       _vlg_impl_include_path, tmp_vtg_config, _backend,
       synthesis_backend_selector::ABC, target_type_t::INV_SYN_DESIGN_ONLY,
       _advanced_param_ptr, true, _chc_target_t::CEX, useGla, useCorr, useAiger);
+  target.SetRfExprCache(&rf_expr_cache);
   target.ConstructWrapper();
   target.ExportAll("wrapper.v", "ila.v" /*USELESS*/, "run.sh",
                    useAiger ? "wrapper.aig" : "wrapper.blif",
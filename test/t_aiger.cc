@@ -0,0 +1,237 @@
+/// \file
+/// Unit test for bit-blasting ILA to AIGER.
+
+#include <map>
+#include <random>
+#include <sstream>
+
+#include <ilang/ilang++.h>
+#include <ilang/target-aig/aiger_writer.h>
+#include <ilang/util/fs.h>
+
+#include "unit-include/ila_sim_test.h"
+#include "unit-include/util.h"
+
+namespace ilang {
+
+// A minimal reader and simulator of binary AIGER.
+class AigSim {
+public:
+  AigSim(const std::string& aig) {
+    std::istringstream in(aig);
+    std::string fmt;
+    in >> fmt >> max_var >> num_in >> num_latch >> num_out >> num_and;
+    ILA_ASSERT(fmt == "aig");
+    std::string rest;
+    std::getline(in, rest);
+    std::istringstream extra(rest);
+    size_t num_bad = 0;
+    size_t num_cnst = 0;
+    extra >> num_bad >> num_cnst;
+
+    for (size_t i = 0; i < num_latch; i++) {
+      std::string line;
+      std::getline(in, line);
+      next.push_back(std::stoul(line));
+    }
+    for (size_t i = 0; i < num_out + num_cnst; i++) {
+      std::string line;
+      std::getline(in, line);
+    }
+    for (size_t i = 0; i < num_and; i++) {
+      auto lhs = 2 * (num_in + num_latch + i + 1);
+      auto rhs0 = lhs - ReadDelta(in);
+      auto rhs1 = rhs0 - ReadDelta(in);
+      ands.push_back({rhs0, rhs1});
+    }
+    std::string line;
+    while (std::getline(in, line) && line != "c") {
+      auto sp = line.find(' ');
+      auto idx = std::stoul(line.substr(1, sp - 1));
+      auto var = (line[0] == 'i') ? idx + 1 : idx + num_in + 1;
+      symbols[line.substr(sp + 1)] = var;
+    }
+  }
+
+  // set the value of an input/latch variable
+  void Set(const std::string& name, const int& width, const uint64_t& val) {
+    for (int i = 0; i < width; i++) {
+      values[Var(name, width, i)] = (val >> i) & 1;
+    }
+  }
+
+  // get the next state value of a latch variable
+  uint64_t Next(const std::string& name, const int& width) {
+    std::vector<bool> vals(max_var + 1, false);
+    for (auto& [var, v] : values) {
+      vals[var] = v;
+    }
+    auto Lit = [&vals](const unsigned& l) { return vals[l >> 1] ^ (l & 1); };
+    for (size_t i = 0; i < ands.size(); i++) {
+      vals[num_in + num_latch + i + 1] =
+          Lit(ands[i].first) && Lit(ands[i].second);
+    }
+    uint64_t res = 0;
+    for (int i = 0; i < width; i++) {
+      auto latch = Var(name, width, i) - num_in - 1;
+      res |= static_cast<uint64_t>(Lit(next.at(latch))) << i;
+    }
+    return res;
+  }
+
+  size_t max_var, num_in, num_latch, num_out, num_and;
+
+private:
+  std::vector<unsigned> next;
+  std::vector<std::pair<unsigned, unsigned>> ands;
+  std::map<std::string, unsigned> symbols;
+  std::map<unsigned, bool> values;
+
+  unsigned Var(const std::string& name, const int& width, const int& i) {
+    auto sym = (width == 1) ? name : name + "[" + std::to_string(i) + "]";
+    return symbols.at(sym);
+  }
+
+  static unsigned ReadDelta(std::istream& in) {
+    unsigned x = 0;
+    for (int shift = 0;; shift += 7) {
+      auto ch = static_cast<unsigned char>(in.get());
+      x |= static_cast<unsigned>(ch & 0x7f) << shift;
+      if (!(ch & 0x80)) {
+        return x;
+      }
+    }
+  }
+};
+
+TEST(TestAiger, Operators) {
+  auto m = Ila("Blast");
+  auto a = m.NewBvInput("a", 8);
+  auto b = m.NewBvInput("b", 8);
+  auto mem = m.NewMemState("mem", 2, 8);
+
+  std::map<std::string, ExprRef> ops = {
+      {"add", a + b},
+      {"sub", a - b},
+      {"mul", a * b},
+      {"neg", -a},
+      {"sdiv", a / b},
+      {"srem", SRem(a, b)},
+      {"urem", URem(a, b)},
+      {"smod", SMod(a, b)},
+      {"shl", a << b},
+      {"lshr", Lshr(a, b)},
+      {"ashr", a >> b},
+      {"rol", LRotate(a, 3) ^ RRotate(b, 2)},
+      {"cat", Concat(Extract(a, 3, 0), Extract(b, 7, 4))},
+      {"ext", Extract(a, 6, 1).SExt(8)},
+      {"cmp", Concat(Concat(Concat(Ite(a < b, BvConst(1, 1), BvConst(0, 1)),
+                                   Ite(Ult(a, b), BvConst(1, 1),
+                                       BvConst(0, 1))),
+                            Ite(a == b, BvConst(1, 1), BvConst(0, 1))),
+                     Ite(Ugt(a, b), BvConst(1, 5), BvConst(0, 5)))},
+      {"ld", Load(mem, Extract(b, 1, 0))},
+  };
+
+  auto all = m.NewInstr("ALL");
+  all.SetDecode(BoolConst(true));
+  for (auto& [name, expr] : ops) {
+    all.SetUpdate(m.NewBvState(name, 8), expr);
+  }
+  all.SetUpdate(mem, Store(mem, Extract(a, 1, 0), b));
+
+  auto writer = AigerWriter(m.get());
+  std::stringstream out;
+  EXPECT_TRUE(writer.Write(out));
+  auto sim = AigSim(out.str());
+  EXPECT_EQ(16, sim.num_in);
+  EXPECT_EQ(8 * ops.size() + 32, sim.num_latch);
+
+  auto Ref = [](const std::string& op, const uint8_t& x, const uint8_t& y,
+                const uint8_t* words) -> uint8_t {
+    int sx = static_cast<int8_t>(x);
+    int sy = static_cast<int8_t>(y);
+    auto Rot = [](const uint8_t& v, const int& n) {
+      return static_cast<uint8_t>((v << n) | (v >> (8 - n)));
+    };
+    if (op == "add") return x + y;
+    if (op == "sub") return x - y;
+    if (op == "mul") return x * y;
+    if (op == "neg") return -x;
+    if (op == "sdiv") return y ? sx / sy : (sx < 0 ? 1 : 0xff);
+    if (op == "srem") return y ? sx % sy : x;
+    if (op == "urem") return y ? x % y : x;
+    if (op == "smod") {
+      if (!y) return x;
+      auto r = sx % sy;
+      return (r != 0 && ((r < 0) != (sy < 0))) ? r + sy : r;
+    }
+    if (op == "shl") return (y < 8) ? x << y : 0;
+    if (op == "lshr") return (y < 8) ? x >> y : 0;
+    if (op == "ashr") return (y < 8) ? sx >> y : (sx < 0 ? 0xff : 0);
+    if (op == "rol") return Rot(x, 3) ^ Rot(y, 6);
+    if (op == "cat") return ((x & 0xf) << 4) | (y >> 4);
+    if (op == "ext") return static_cast<int8_t>(x << 1) >> 2;
+    if (op == "cmp") {
+      return ((sx < sy) << 7) | ((x < y) << 6) | ((x == y) << 5) |
+             ((x > y) ? 1 : 0);
+    }
+    ILA_ASSERT(op == "ld");
+    return words[y & 3];
+  };
+
+  std::mt19937 gen(0);
+  std::vector<std::pair<uint8_t, uint8_t>> cases = {
+      {0, 0}, {0x80, 0xff}, {0x7f, 0}, {5, 8}, {0x85, 9}, {0xf0, 0x03}};
+  for (int i = 0; i < 200; i++) {
+    cases.push_back({gen() & 0xff, gen() & 0xff});
+  }
+
+  const uint8_t words[4] = {0x12, 0x34, 0x56, 0x78};
+  for (int w = 0; w < 4; w++) {
+    sim.Set("mem[" + std::to_string(w) + "]", 8, words[w]);
+  }
+  for (auto& [x, y] : cases) {
+    sim.Set("a", 8, x);
+    sim.Set("b", 8, y);
+    for (auto& it : ops) {
+      EXPECT_EQ(Ref(it.first, x, y, words), sim.Next(it.first, 8))
+          << it.first << " " << int(x) << " " << int(y);
+    }
+    // the written word and the unchanged ones
+    for (int w = 0; w < 4; w++) {
+      auto word = sim.Next("mem[" + std::to_string(w) + "]", 8);
+      EXPECT_EQ((w == (x & 3)) ? y : words[w], word);
+    }
+  }
+}
+
+TEST(TestAiger, StructuralHashing) {
+  auto GetAndNum = [](bool dup) {
+    auto m = Ila("Strash");
+    auto a = m.NewBvInput("a", 16);
+    auto b = m.NewBvInput("b", 16);
+    auto x = m.NewBvState("x", 16);
+    auto y = m.NewBvState("y", 16);
+    auto instr = m.NewInstr("MAC");
+    instr.SetDecode(BoolConst(true));
+    instr.SetUpdate(x, a * b + x);
+    instr.SetUpdate(y, dup ? (a * b + x) : y);
+    auto writer = AigerWriter(m.get());
+    std::stringstream out;
+    writer.Write(out);
+    return writer.and_num();
+  };
+  // structurally equal (but distinct) AST nodes share the gates
+  EXPECT_EQ(GetAndNum(false), GetAndNum(true));
+}
+
+TEST(TestAiger, SimModel) {
+  IlaSimTest m;
+  auto file_name = GetRandomFileName(fs::temp_directory_path());
+  // the model has memories with 32-bit address
+  EXPECT_FALSE(ExportAiger(m.model, file_name));
+  os_portable_remove_file(file_name);
+}
+
+} // namespace ilang
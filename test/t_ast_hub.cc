@@ -1,7 +1,10 @@
 /// \file
 /// Unit test for asthub
 
+#include <random>
+
 #include <ilang/ila/ast_hub.h>
+#include <ilang/target-smt/z3_expr_adapter.h>
 
 #include "unit-include/util.h"
 
@@ -129,7 +132,7 @@ TEST(Testasthub, UnaryOp) {
 #endif
 
   // Complement
-  auto bv_compl = asthub::Complement(bv_const_0);
+  auto bv_compl = asthub::Complement(bv_var);
   EXPECT_TRUE(bv_compl->is_op());
   EXPECT_FALSE(bv_compl->is_var());
   EXPECT_FALSE(bv_compl->is_const());
@@ -302,6 +305,186 @@ TEST(Testasthub, Others) {
 }
 
 using namespace asthub;
+TEST(Testasthub, ConstFold) {
+  auto bv_var = asthub::NewBvVar("bv_var", 8);
+  auto c8 = [](const BvValType& v) { return asthub::BvConst(v, 8); };
+  auto Val = [](const ExprPtr& e) {
+    EXPECT_TRUE(e->is_const());
+    auto c = std::static_pointer_cast<ExprConst>(e);
+    return e->is_bool() ? c->val_bool()->val() : c->val_bv()->val();
+  };
+
+  asthub::SetConstFolding(true);
+  asthub::ResetConstFoldNum();
+
+  // widths and wrap-around
+  EXPECT_EQ(0x01, Val(asthub::Add(c8(0xff), c8(0x02))));
+  EXPECT_EQ(0xff, Val(asthub::Sub(c8(0x00), c8(0x01))));
+  EXPECT_EQ(0xfe, Val(asthub::Negate(c8(0x02))));
+  EXPECT_EQ(0x0f, Val(asthub::Lshr(c8(0xf0), 4)));
+  EXPECT_EQ(0x00, Val(asthub::Shl(c8(0xf0), 8)));
+  EXPECT_EQ(0xff, Val(asthub::Ashr(c8(0x80), 9)));
+  EXPECT_EQ(0xab, Val(asthub::Extract(asthub::BvConst(0xabcd, 16), 15, 8)));
+  EXPECT_EQ(0xffff, Val(asthub::SExt(c8(0xff), 16)));
+  EXPECT_EQ(0x00ff, Val(asthub::ZExt(c8(0xff), 16)));
+  EXPECT_EQ(0x0f, Val(asthub::LRotate(c8(0x87), 1)));
+  EXPECT_EQ(0xc3, Val(asthub::RRotate(c8(0x87), 1)));
+  auto cat = asthub::Concat(c8(0x12), c8(0x34));
+  EXPECT_EQ(16, cat->sort()->bit_width());
+  EXPECT_EQ(0x1234, Val(cat));
+
+  // signedness
+  EXPECT_TRUE(Val(asthub::Lt(c8(0xff), c8(0x01))));
+  EXPECT_FALSE(Val(asthub::Ult(c8(0xff), c8(0x01))));
+  EXPECT_TRUE(Val(asthub::Ge(c8(0x01), c8(0x80))));
+  EXPECT_EQ(0xff, Val(asthub::SRem(c8(0xf9), c8(0x02)))); // -7 srem 2 = -1
+  EXPECT_EQ(0x01, Val(asthub::SMod(c8(0xf9), c8(0x02)))); // -7 smod 2 = 1
+  EXPECT_EQ(0x01, Val(asthub::URem(c8(0xf9), c8(0x02))));
+
+  // bool
+  auto t = asthub::BoolConst(true);
+  auto f = asthub::BoolConst(false);
+  EXPECT_FALSE(Val(asthub::And(t, f)));
+  EXPECT_TRUE(Val(asthub::Imply(f, t)));
+  EXPECT_TRUE(Val(asthub::Ne(c8(1), c8(2))));
+  auto c6 = c8(6);
+  auto c7 = c8(7);
+  EXPECT_EQ(c7, asthub::Ite(f, c6, c7));
+
+  // 64-bit limit
+  auto c64 = asthub::BvConst(~BvValType(0), 64);
+  EXPECT_EQ(0, Val(asthub::Add(c64, asthub::BvConst(1, 64))));
+  EXPECT_TRUE(asthub::Concat(c64, c8(0))->is_op());
+
+  // not folded
+  EXPECT_TRUE(asthub::Add(bv_var, c8(1))->is_op());
+  EXPECT_TRUE(asthub::URem(c8(1), c8(0))->is_op());
+  EXPECT_TRUE(asthub::Div(c8(4), c8(2))->is_op());
+
+  EXPECT_EQ(2, asthub::GetConstFoldNum(AstUidExprOp::kAdd));
+  EXPECT_EQ(2, asthub::GetConstFoldNum(AstUidExprOp::kEqual));
+  EXPECT_LT(20, asthub::GetConstFoldNum());
+
+  // disabled
+  asthub::SetConstFolding(false);
+  EXPECT_FALSE(asthub::ConstFoldingEnabled());
+  auto num = asthub::GetConstFoldNum();
+  auto add = asthub::Add(c8(1), c8(2));
+  EXPECT_TRUE(add->is_op());
+  EXPECT_EQ(num, asthub::GetConstFoldNum());
+  EXPECT_EQ(3, Val(asthub::FoldConst(AstUidExprOp::kAdd, {c8(1), c8(2)})));
+  asthub::SetConstFolding(true);
+
+  asthub::ResetConstFoldNum();
+  EXPECT_EQ(0, asthub::GetConstFoldNum());
+}
+
+TEST(Testasthub, ConstFoldZ3) {
+  // build the operations unfolded, then compare FoldConst with z3
+  auto const_folding = asthub::ConstFoldingEnabled();
+  asthub::SetConstFolding(false);
+
+  z3::context ctx;
+  Z3ExprAdapter gen(ctx);
+  auto Check = [&gen](const ExprPtr& e, bool may_skip = false) {
+    ASSERT_TRUE(e->is_op()) << e;
+    ExprPtrVec args;
+    for (size_t i = 0; i < e->arg_num(); i++) {
+      args.push_back(e->arg(i));
+    }
+    std::vector<int> params;
+    for (size_t i = 0; i < e->param_num(); i++) {
+      params.push_back(e->param(i));
+    }
+    auto folded = asthub::FoldConst(asthub::GetUidExprOp(e), args, params);
+    if (!folded) {
+      EXPECT_TRUE(may_skip) << "Not folded " << e;
+      return;
+    }
+    ASSERT_TRUE(folded->is_const());
+    EXPECT_EQ(e->sort(), folded->sort()) << e;
+    auto expected = gen.GetExpr(e).simplify();
+    auto result = gen.GetExpr(folded).simplify();
+    EXPECT_TRUE(z3::eq(expected, result)) << e << ": " << expected << " vs. "
+                                          << result;
+  };
+
+  std::mt19937_64 rng(1);
+  auto Mask = [](const int& w) {
+    return (w == 64) ? ~BvValType(0) : ((BvValType(1) << w) - 1);
+  };
+  // corner values (zero, one, all ones, signed min/max) and random ones
+  auto Values = [&rng, &Mask](const int& w) {
+    std::vector<BvValType> vals = {0, 1, Mask(w), BvValType(1) << (w - 1),
+                                   Mask(w) >> 1, rng(), rng()};
+    for (auto& v : vals) {
+      v &= Mask(w);
+    }
+    return vals;
+  };
+
+  std::vector<int> widths = {1, 2, 7, 8, 31, 63, 64};
+  for (auto i = 0; i < 4; i++) {
+    widths.push_back(1 + rng() % 64);
+  }
+  for (auto w : widths) {
+    auto vals = Values(w);
+    // shift amounts of (and beyond) the width
+    for (auto amount : {w - 1, w, w + 1}) {
+      if ((BvValType(amount) & Mask(w)) == BvValType(amount)) {
+        vals.push_back(amount);
+      }
+    }
+    for (auto va : vals) {
+      auto a = asthub::BvConst(va, w);
+      Check(asthub::Negate(a));
+      Check(asthub::Complement(a));
+      Check(asthub::Extract(a, w - 1, (w - 1) / 2));
+      Check(asthub::ZExt(a, 64));
+      Check(asthub::SExt(a, 64));
+      Check(asthub::LRotate(a, w / 3));
+      Check(asthub::RRotate(a, w / 3 + 1));
+      for (auto vb : vals) {
+        auto b = asthub::BvConst(vb, w);
+        Check(asthub::And(a, b));
+        Check(asthub::Or(a, b));
+        Check(asthub::Xor(a, b));
+        Check(asthub::Add(a, b));
+        Check(asthub::Sub(a, b));
+        Check(asthub::Mul(a, b));
+        Check(asthub::Shl(a, b));
+        Check(asthub::Lshr(a, b));
+        Check(asthub::Ashr(a, b));
+        Check(asthub::Div(a, b), true);
+        Check(asthub::URem(a, b), vb == 0);
+        Check(asthub::SRem(a, b), vb == 0);
+        Check(asthub::SMod(a, b), vb == 0);
+        Check(asthub::Eq(a, b));
+        Check(asthub::Lt(a, b));
+        Check(asthub::Gt(a, b));
+        Check(asthub::Ult(a, b));
+        Check(asthub::Ugt(a, b));
+        Check(asthub::Concat(a, b), 2 * w > 64);
+      }
+    }
+  }
+
+  for (auto va : {true, false}) {
+    auto a = asthub::BoolConst(va);
+    Check(asthub::Not(a));
+    for (auto vb : {true, false}) {
+      auto b = asthub::BoolConst(vb);
+      Check(asthub::And(a, b));
+      Check(asthub::Or(a, b));
+      Check(asthub::Xor(a, b));
+      Check(asthub::Imply(a, b));
+      Check(asthub::Eq(a, b));
+    }
+  }
+
+  asthub::SetConstFolding(const_folding);
+}
+
 TEST(Testasthub, TopEq) {
   auto x = NewBoolVar("x");
   auto y = NewBoolVar("y");
@@ -0,0 +1,373 @@
+/// \file
+/// Unit test for the BTOR2 writer.
+
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include <z3++.h>
+
+#include <ilang/ilang++.h>
+#include <ilang/target-btor/btor2_writer.h>
+#include <ilang/target-smt/z3_expr_adapter.h>
+#include <ilang/util/fs.h>
+
+#include "unit-include/ila_sim_test.h"
+#include "unit-include/util.h"
+
+namespace ilang {
+
+// count the lines with the given BTOR2 operator
+static size_t CountOp(const std::string& btor, const std::string& op) {
+  std::istringstream in(btor);
+  std::string line;
+  size_t cnt = 0;
+  while (std::getline(in, line)) {
+    std::istringstream tokens(line);
+    std::string id, tag;
+    tokens >> id >> tag;
+    cnt += (tag == op) ? 1 : 0;
+  }
+  return cnt;
+}
+
+// value of a BTOR2 node, i.e., a bit-vector (up to 64 bits) or an array
+struct BtorVal {
+  uint64_t bv = 0;
+  std::map<uint64_t, uint64_t> arr;
+};
+
+// a BTOR2 interpreter for the operators the writer emits (up to 64 bits)
+class BtorSim {
+public:
+  BtorSim(const std::string& btor) {
+    std::istringstream in(btor);
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream tokens(line);
+      Node n;
+      size_t id = 0;
+      if (line.empty() || line[0] == ';' || !(tokens >> id >> n.op)) {
+        continue;
+      }
+      for (std::string t; tokens >> t;) {
+        n.tokens.push_back(t);
+      }
+      nodes_.resize(id + 1);
+      nodes_[id] = n;
+    }
+  }
+
+  // evaluate one cycle with the named inputs and states, return the next
+  // values of the named states
+  std::map<std::string, BtorVal> Step(std::map<std::string, BtorVal> vars) {
+    std::vector<BtorVal> v(nodes_.size());
+    std::map<std::string, BtorVal> next;
+    for (size_t id = 1; id < nodes_.size(); id++) {
+      auto& n = nodes_[id];
+      auto& op = n.op;
+      auto& r = v[id];
+      if (op == "sort" || op == "output") {
+        continue;
+      } else if (op == "input" || op == "state") {
+        auto named = n.tokens.size() > 1 && vars.count(n.tokens[1]);
+        r = named ? vars[n.tokens[1]] : states_[id];
+        continue;
+      } else if (op == "init") { // e.g., the initial flag
+        if (cycle_ == 0) {
+          v[Arg(n, 1)] = v[Arg(n, 2)];
+        }
+        continue;
+      } else if (op == "next") {
+        states_[Arg(n, 1)] = v[Arg(n, 2)];
+        if (nodes_[Arg(n, 1)].tokens.size() > 1) {
+          next[nodes_[Arg(n, 1)].tokens[1]] = v[Arg(n, 2)];
+        }
+        continue;
+      } else if (op == "constraint") {
+        EXPECT_EQ(1, v[Arg(n, 0)].bv) << "constraint " << id;
+        continue;
+      } else if (op == "const") {
+        r.bv = std::stoull(n.tokens[1], nullptr, 2);
+        continue;
+      }
+
+      auto w = Width(n.sid());
+      auto m = (w >= 64) ? ~0ULL : ((1ULL << w) - 1);
+      auto aw = Width(nodes_[Arg(n, 1)].sid());
+      auto a = v[Arg(n, 1)].bv;
+      auto b = (n.tokens.size() > 2) ? v[Arg(n, 2)].bv : 0;
+      if (op == "not") {
+        r.bv = ~a & m;
+      } else if (op == "neg") {
+        r.bv = -a & m;
+      } else if (op == "and" || op == "or" || op == "xor") {
+        r.bv = (op == "and") ? (a & b) : (op == "or") ? (a | b) : (a ^ b);
+      } else if (op == "implies") {
+        r.bv = (!a || b) ? 1 : 0;
+      } else if (op == "add" || op == "sub" || op == "mul") {
+        r.bv = (op == "add") ? (a + b) : (op == "sub") ? (a - b) : (a * b);
+        r.bv &= m;
+      } else if (op == "sll" || op == "srl") {
+        r.bv = (b >= w) ? 0 : (((op == "sll") ? (a << b) : (a >> b)) & m);
+      } else if (op == "sra") {
+        auto sa = SignExt(a, w);
+        r.bv = static_cast<uint64_t>((b >= w) ? (sa >> 63) : (sa >> b)) & m;
+      } else if (op == "eq") {
+        r.bv = (a == b) ? 1 : 0;
+      } else if (op == "ult" || op == "ugt") {
+        r.bv = ((op == "ult") ? (a < b) : (a > b)) ? 1 : 0;
+      } else if (op == "slt" || op == "sgt") {
+        auto sa = SignExt(a, aw);
+        auto sb = SignExt(b, aw);
+        r.bv = ((op == "slt") ? (sa < sb) : (sa > sb)) ? 1 : 0;
+      } else if (op == "concat") {
+        r.bv = (a << Width(nodes_[Arg(n, 2)].sid())) | b;
+      } else if (op == "slice") {
+        r.bv = (a >> std::stoi(n.tokens[3])) & m;
+      } else if (op == "uext") {
+        r.bv = a;
+      } else if (op == "sext") {
+        r.bv = static_cast<uint64_t>(SignExt(a, aw)) & m;
+      } else if (op == "ite") {
+        r = v[(a != 0) ? Arg(n, 2) : Arg(n, 3)];
+      } else if (op == "read") {
+        auto& mem = v[Arg(n, 1)].arr;
+        auto pos = mem.find(b);
+        r.bv = (pos == mem.end()) ? 0 : pos->second;
+      } else if (op == "write") {
+        r = v[Arg(n, 1)];
+        r.arr[b] = v[Arg(n, 3)].bv;
+      } else {
+        ADD_FAILURE() << "Unsupported BTOR2 operator " << op;
+      }
+    }
+    cycle_++;
+    return next;
+  }
+
+private:
+  struct Node {
+    std::string op;
+    std::vector<std::string> tokens;
+    size_t sid() const { return std::stoul(tokens.at(0)); }
+  };
+
+  std::vector<Node> nodes_;
+  std::map<size_t, BtorVal> states_;
+  size_t cycle_ = 0;
+
+  size_t Arg(const Node& n, size_t i) const { return std::stoul(n.tokens[i]); }
+
+  // width of a bit-vector sort, or the data width of an array sort
+  int Width(const size_t& sid) const {
+    auto& s = nodes_.at(sid);
+    return (s.tokens[0] == "bitvec") ? std::stoi(s.tokens[1])
+                                     : Width(std::stoul(s.tokens[2]));
+  }
+
+  static int64_t SignExt(const uint64_t& v, const int& w) {
+    return (w >= 64) ? static_cast<int64_t>(v)
+                     : static_cast<int64_t>(v << (64 - w)) >> (64 - w);
+  }
+};
+
+TEST(TestBtor2, Counter) {
+  auto m = Ila("Counter");
+  auto op = m.NewBvInput("op", 2);
+  auto cnt = m.NewBvState("cnt", 8);
+  auto acc = m.NewBvState("acc", 8);
+  auto mem = m.NewMemState("mem", 4, 8);
+  auto done = m.NewBoolState("done");
+  m.SetValid(op != 3);
+  m.AddInit(cnt == 0);
+  m.AddInit(!done);
+
+  auto sum = cnt + acc;
+
+  auto inc = m.NewInstr("INC");
+  inc.SetDecode(op == 0);
+  inc.SetUpdate(cnt, sum);
+  inc.SetUpdate(acc, sum);
+
+  auto st = m.NewInstr("STORE");
+  st.SetDecode(op == 1);
+  st.SetUpdate(mem, Store(mem, Extract(cnt, 3, 0), sum));
+  st.SetUpdate(done, BoolConst(true));
+
+  auto writer = Btor2Writer(m.get());
+  std::stringstream out;
+  EXPECT_TRUE(writer.Write(out));
+  auto btor = out.str();
+
+  // states (with the initial flag), input, and next functions
+  EXPECT_EQ(5, CountOp(btor, "state"));
+  EXPECT_EQ(1, CountOp(btor, "input"));
+  EXPECT_EQ(5, CountOp(btor, "next"));
+  EXPECT_EQ(2, CountOp(btor, "constraint"));
+  EXPECT_EQ(5, CountOp(btor, "sort"));
+  EXPECT_EQ(1, CountOp(btor, "write"));
+
+  // the shared sub-expression is emitted once
+  EXPECT_EQ(1, CountOp(btor, "add"));
+
+  // one guarded update per (state, instruction) pair
+  EXPECT_EQ(4, CountOp(btor, "ite"));
+}
+
+TEST(TestBtor2, Semantics) {
+  auto m = Ila("Alu");
+  auto op = m.NewBvInput("op", 2);
+  auto data = m.NewBvInput("data", 8);
+  auto acc = m.NewBvState("acc", 8);
+  auto cnt = m.NewBvState("cnt", 8);
+  auto wide = m.NewBvState("wide", 16);
+  auto flag = m.NewBoolState("flag");
+  auto mem = m.NewMemState("mem", 4, 8);
+  m.SetValid(!(flag & (op == 3)));
+  m.AddInit(cnt == 0);
+
+  // declared first, so it takes over acc from the others
+  auto clr = m.NewInstr("CLR");
+  clr.SetDecode(data == 0);
+  clr.SetUpdate(acc, BvConst(0, 8));
+
+  auto add = m.NewInstr("ADD");
+  add.SetDecode(op == 0);
+  add.SetUpdate(acc, acc + data);
+  add.SetUpdate(flag, Ult(acc + data, acc));
+
+  auto store = m.NewInstr("STORE");
+  store.SetDecode(op == 1);
+  store.SetUpdate(mem, Store(mem, Extract(acc, 3, 0), data ^ cnt));
+  store.SetUpdate(cnt, cnt + 1);
+
+  auto load = m.NewInstr("LOAD");
+  load.SetDecode(op == 2);
+  load.SetUpdate(acc, Load(mem, Extract(data, 3, 0)) - acc);
+  load.SetUpdate(wide, Lshr(Concat(acc, data), 3));
+
+  auto mix = m.NewInstr("MIX");
+  mix.SetDecode(op == 3);
+  mix.SetUpdate(wide, (wide << 1) ^ SExt(data, 16));
+  mix.SetUpdate(flag, !flag);
+  mix.SetUpdate(acc, Ite(acc < data, acc & data, acc | (data >> 1)));
+
+  std::stringstream out;
+  ASSERT_TRUE(Btor2Writer(m.get()).Write(out));
+  auto sim = BtorSim(out.str());
+
+  // reference: the ILA functions evaluated by z3, where a state takes the
+  // update of the first valid and decoded instruction updating it
+  z3::context ctx;
+  auto gen = Z3ExprAdapter(ctx);
+  auto ila = m.get();
+  std::vector<ExprPtr> vars = {op.get(), data.get()};
+  for (size_t i = 0; i < ila->state_num(); i++) {
+    vars.push_back(ila->state(i));
+  }
+
+  auto ToZ3 = [&ctx](const ExprPtr& var, const BtorVal& val) {
+    auto sort = var->sort();
+    if (sort->is_bool()) {
+      return ctx.bool_val(val.bv != 0);
+    } else if (sort->is_bv()) {
+      return ctx.bv_val(static_cast<uint64_t>(val.bv), sort->bit_width());
+    }
+    auto res = z3::const_array(ctx.bv_sort(sort->addr_width()),
+                               ctx.bv_val(0, sort->data_width()));
+    for (auto& it : val.arr) {
+      res = z3::store(res, ctx.bv_val(static_cast<uint64_t>(it.first),
+                                      sort->addr_width()),
+                      ctx.bv_val(static_cast<uint64_t>(it.second),
+                                 sort->data_width()));
+    }
+    return res;
+  };
+  auto FromZ3 = [&ctx](const ExprPtr& var, const z3::expr& e) {
+    auto val = BtorVal();
+    auto sort = var->sort();
+    if (sort->is_bool()) {
+      val.bv = e.is_true() ? 1 : 0;
+    } else if (sort->is_bv()) {
+      val.bv = e.get_numeral_uint64();
+    } else {
+      for (uint64_t a = 0; a < (1ULL << sort->addr_width()); a++) {
+        auto addr = ctx.bv_val(static_cast<uint64_t>(a), sort->addr_width());
+        val.arr[a] = z3::select(e, addr).simplify().get_numeral_uint64();
+      }
+    }
+    return val;
+  };
+  // all entries of a memory (absent ones are zero)
+  auto Full = [](const ExprPtr& var, BtorVal val) {
+    if (var->is_mem()) {
+      for (uint64_t a = 0; a < (1ULL << var->sort()->addr_width()); a++) {
+        val.arr.emplace(a, 0);
+      }
+    }
+    return val;
+  };
+
+  uint64_t seed = 7;
+  auto Rand = [&seed](const uint64_t& mod) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (seed >> 33) % mod;
+  };
+
+  std::map<std::string, BtorVal> vals;
+  vals["acc"].bv = Rand(256);
+  vals["wide"].bv = Rand(1 << 16);
+  vals["flag"].bv = Rand(2);
+  vals["mem"].arr = {{3, Rand(256)}, {9, Rand(256)}};
+
+  for (auto cycle = 0; cycle < 40; cycle++) {
+    vals["op"].bv = Rand(4);
+    vals["data"].bv = Rand(8); // often zero, i.e., CLR overlaps
+
+    z3::expr_vector src(ctx);
+    z3::expr_vector dst(ctx);
+    for (auto& var : vars) {
+      src.push_back(gen.GetExpr(var));
+      dst.push_back(ToZ3(var, vals[var->name().str()]));
+    }
+    auto Eval = [&](const ExprPtr& e) {
+      return gen.GetExpr(e).substitute(src, dst).simplify();
+    };
+    auto valid = Eval(ila->valid()).is_true();
+
+    auto expected = vals;
+    for (size_t i = 0; i < ila->state_num(); i++) {
+      auto state = ila->state(i);
+      for (size_t k = 0; k < ila->instr_num() && valid; k++) {
+        auto instr = ila->instr(k);
+        auto update = instr->update(state);
+        if (update && Eval(instr->decode()).is_true()) {
+          expected[state->name().str()] = FromZ3(state, Eval(update));
+          break;
+        }
+      }
+    }
+
+    auto next = sim.Step(vals);
+    for (size_t i = 0; i < ila->state_num(); i++) {
+      auto state = ila->state(i);
+      auto name = state->name().str();
+      auto exp_val = Full(state, expected[name]);
+      auto btor_val = Full(state, next[name]);
+      EXPECT_EQ(exp_val.bv, btor_val.bv) << name << " at cycle " << cycle;
+      EXPECT_EQ(exp_val.arr, btor_val.arr) << name << " at cycle " << cycle;
+    }
+    vals = expected;
+  }
+}
+
+TEST(TestBtor2, SimModel) {
+  IlaSimTest m;
+  auto file_name = GetRandomFileName(fs::temp_directory_path());
+  EXPECT_TRUE(ExportBtor2(m.model, file_name));
+  EXPECT_TRUE(os_portable_exist(file_name));
+  os_portable_remove_file(file_name);
+}
+
+} // namespace ilang
@@ -3,6 +3,7 @@
 
 #include "unit-include/util.h"
 #include "z3++.h"
+#include <ilang/ila/ast_hub.h>
 #include <ilang/ilang++.h>
 
 namespace ilang {
@@ -915,4 +916,36 @@ TEST_F(TestExprOp, Ite) {
   }
 }
 
+TEST_F(TestExprOp, Dispatch) {
+  auto x = rx.get();
+  auto y = ry.get();
+  auto ops = {asthub::Add(x, y), asthub::Ult(x, y), asthub::Extract(x, 3, 0),
+              asthub::Load(mx.get(), x), asthub::Ite(fx.get(), x, y)};
+  auto uids = {AstUidExprOp::kAdd, AstUidExprOp::kUnsignedLessThan,
+               AstUidExprOp::kExtract, AstUidExprOp::kLoad,
+               AstUidExprOp::kIfThenElse};
+
+  auto uid_it = uids.begin();
+  for (const auto& e : ops) {
+    ASSERT_TRUE(e->is_op());
+    auto& op = static_cast<const ExprOp&>(*e);
+    EXPECT_EQ(*uid_it++, op.uid());
+    EXPECT_EQ(op.uid(), asthub::GetUidExprOp(e));
+    // the visitor sees the concrete type
+    auto name = DispatchExprOp(op, [](const auto& node) {
+      static_assert(!std::is_same_v<std::decay_t<decltype(node)>, ExprOp>);
+      return node.op_name();
+    });
+    EXPECT_EQ(op.op_name(), name);
+  }
+
+  auto is_ite = [](const auto& node) {
+    return std::is_same_v<std::decay_t<decltype(node)>, ExprOpIte>;
+  };
+  auto ite = asthub::Ite(fx.get(), x, y);
+  EXPECT_TRUE(DispatchExprOp(static_cast<const ExprOp&>(*ite), is_ite));
+  auto add = asthub::Add(x, y);
+  EXPECT_FALSE(DispatchExprOp(static_cast<const ExprOp&>(*add), is_ite));
+}
+
 } // namespace ilang
@@ -1,6 +1,9 @@
 /// \file
 /// Unit test for class InstrLvlAbs.
 
+#include <thread>
+#include <vector>
+
 #include <ilang/ila/instr_lvl_abs.h>
 
 #include "unit-include/util.h"
@@ -291,6 +294,46 @@ TEST(TestInstrLvlAbs, SeqTran) {
   // TODO
 }
 
+TEST(TestInstrLvlAbs, Freeze) {
+  auto ila = InstrLvlAbs::New("ila");
+  auto x = ila->NewBvState("x", 8);
+  auto in = ila->NewBvInput("in", 8);
+  auto instr = ila->NewInstr("add");
+  instr->set_decode(asthub::Eq(in, asthub::BvConst(1, 8)));
+  instr->set_update(x, asthub::Add(x, in));
+  auto child = ila->NewChild("child");
+
+  ila->Freeze();
+  EXPECT_TRUE(ila->is_frozen());
+  EXPECT_TRUE(child->is_frozen());
+  EXPECT_EQ("ila.child", child->GetRootName());
+
+  EXPECT_DEATH(ila->NewBvState("y", 8), ".*");
+  EXPECT_DEATH(ila->AddInit(asthub::Eq(x, in)), ".*");
+  EXPECT_DEATH(instr->ForceSetDecode(asthub::BoolConst(true)), ".*");
+  EXPECT_DEATH(child->NewInstr("sub"), ".*");
+
+  // concurrent lookups on the frozen model
+  std::vector<std::thread> workers;
+  std::vector<int> found(4, 0);
+  for (auto t = 0; t < 4; t++) {
+    workers.emplace_back([&ila, &found, t]() {
+      for (auto i = 0; i < 1000; i++) {
+        found[t] += (ila->state("x") != nullptr);
+        found[t] += (ila->input("in") != nullptr);
+        found[t] += (ila->instr("add") != nullptr);
+        found[t] += (ila->state("none") == nullptr);
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  for (auto cnt : found) {
+    EXPECT_EQ(4000, cnt);
+  }
+}
+
 TEST(TestInstrLvlAbs, Print) {
   InstrLvlAbs ila("ila");
   std::string msg;
@@ -1,6 +1,12 @@
 /// \file
 /// Test for Ilator
 
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <nlohmann/json.hpp>
+
 #include <ilang/ilang++.h>
 
 #include <ilang/util/fs.h>
@@ -27,6 +33,139 @@ public:
     os_portable_remove_directory(out_dir);
   }
 
+  // a self-contained model (no uninterpreted functions) for build-and-run
+  static Ila GetRunModel() {
+    auto m = Ila("Run");
+    auto op = m.NewBvInput("op", 2);
+    auto data = m.NewBvInput("data", 8);
+    auto flag = m.NewBoolState("flag");
+    auto acc = m.NewBvState("acc", 8);
+    auto wide = m.NewBvState("wide", 96);
+    auto mem = m.NewMemState("mem", 4, 8);
+
+    auto add = m.NewInstr("ADD");
+    add.SetDecode(op == 0);
+    add.SetUpdate(acc, acc + data);
+    add.SetUpdate(flag, Ult(acc + data, acc));
+
+    auto store = m.NewInstr("STORE");
+    store.SetDecode(op == 1);
+    store.SetUpdate(mem, Store(mem, Extract(acc, 3, 0), data));
+
+    auto load = m.NewInstr("LOAD");
+    load.SetDecode(op == 2);
+    load.SetUpdate(acc, Load(mem, Extract(data, 3, 0)) ^ acc);
+    load.SetUpdate(flag, !flag);
+
+    auto shift = m.NewInstr("SHIFT");
+    shift.SetDecode(op == 3);
+    shift.SetUpdate(wide, (wide << 5) + ZExt(Concat(acc, data), 96));
+    return m;
+  }
+
+  // pseudo-random trace of the run model, i.e., (op, data) for each lane
+  static std::vector<uint64_t> GetRunTrace(const int& steps, const int& lanes,
+                                           uint64_t seed = 1) {
+    std::vector<uint64_t> words;
+    for (auto i = 0; i < steps; i++) {
+      for (auto input_mask : {0x3, 0xff}) {
+        for (auto l = 0; l < lanes; l++) {
+          seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+          words.push_back((seed >> 33) & input_mask);
+        }
+      }
+    }
+    return words;
+  }
+
+  static void WriteTrace(const fs::path& file,
+                         const std::vector<uint64_t>& words) {
+    std::ofstream fw(file, std::ios::binary);
+    fw.write(reinterpret_cast<const char*>(words.data()),
+             words.size() * sizeof(uint64_t));
+  }
+
+  static std::string ReadFile(const fs::path& file) {
+    std::ifstream fr(file, std::ios::binary);
+    std::stringstream buff;
+    buff << fr.rdbuf();
+    return buff.str();
+  }
+
+  // split the states of a run model checkpoint by lanes, i.e., the states
+  // (saved as mem, wide, acc, flag) of each lane after the 32-byte header
+  static std::vector<std::string> SplitRunLanes(const std::string& ck,
+                                                const int& lanes) {
+    std::vector<std::string> res(lanes);
+    size_t pos = 32;
+    auto take = [&ck, &pos, &res](const int& l, const size_t& n) {
+      res[l] += ck.substr(pos, n);
+      pos += n;
+    };
+    for (auto l = 0; l < lanes; l++) {
+      uint64_t n = 0;
+      if (pos + sizeof(n) > ck.size()) {
+        return {};
+      }
+      std::memcpy(&n, ck.data() + pos, sizeof(n));
+      take(l, sizeof(n) + n * 2 * sizeof(uint64_t)); // (addr, data) pairs
+    }
+    for (auto words : {2, 1}) {
+      for (auto l = 0; l < lanes; l++) {
+        take(l, words * sizeof(uint64_t));
+      }
+    }
+    for (auto l = 0; l < lanes; l++) {
+      take(l, 1);
+    }
+    return (pos == ck.size()) ? res : std::vector<std::string>();
+  }
+
+  // the generated simulators are built with cmake and the host compiler
+  bool HasToolchain() {
+    auto log = (out_dir / "cmake.log").string();
+    auto res = os_portable_execute_shell({"cmake", "--version"}, log);
+    auto avail = res.failure == execute_result::NONE && res.ret == 0;
+    ILA_WARN_IF(!avail) << "cmake not found, skip building the simulator";
+    return avail;
+  }
+
+  // configure and build the generated simulator, return the executable
+  static std::string BuildSim(const fs::path& dir, const std::string& project,
+                              const std::vector<std::string>& options = {}) {
+    auto build_dir = dir / "build";
+    auto log = (dir / "build.log").string();
+    std::vector<std::string> config = {"cmake", "-S", dir.string(), "-B",
+                                       build_dir.string()};
+    config.insert(config.end(), options.begin(), options.end());
+    auto res = os_portable_execute_shell(config, log);
+    if (res.failure != execute_result::NONE || res.ret != 0) {
+      ADD_FAILURE() << "Fail configuring " << dir << "\n" << ReadFile(log);
+      return "";
+    }
+    res = os_portable_execute_shell(
+        {"cmake", "--build", build_dir.string(), "-j4"}, log);
+    if (res.failure != execute_result::NONE || res.ret != 0) {
+      ADD_FAILURE() << "Fail building " << dir << "\n" << ReadFile(log);
+      return "";
+    }
+    return (build_dir / project).string();
+  }
+
+  // run the simulator and return its standard output ("" if it fails)
+  std::string RunSim(const std::string& sim,
+                     const std::vector<std::string>& args) {
+    auto log = (out_dir / "run.log").string();
+    std::vector<std::string> cmd = {sim};
+    cmd.insert(cmd.end(), args.begin(), args.end());
+    auto res = os_portable_execute_shell(cmd, log, redirect_t::STDOUT);
+    if (res.failure != execute_result::NONE || res.ret != 0) {
+      ADD_FAILURE() << "Fail running " << sim;
+      return "";
+    }
+    return ReadFile(log);
+  }
+
   fs::path out_dir;
 
 }; // TestIlator
@@ -41,4 +180,297 @@ TEST_F(TestIlator, Optimize) {
   ExportSysCSim(m.model, out_dir, true);
 }
 
+TEST_F(TestIlator, Standalone) {
+  IlaSimTest m;
+  ExportStandaloneSim(m.model, out_dir, true);
+
+  auto bitvec = out_dir / "include" / "ilator_bitvec.h";
+  EXPECT_TRUE(os_portable_exist(bitvec.string()));
+  auto driver = out_dir / "app" / "main.cc";
+  EXPECT_TRUE(os_portable_exist(driver.string()));
+
+  // build and run a trace
+  if (!HasToolchain()) {
+    return;
+  }
+  auto sim_dir = out_dir / "run";
+  ExportStandaloneSim(GetRunModel(), sim_dir.string(), true);
+  auto sim = BuildSim(sim_dir, "Run");
+  ASSERT_FALSE(sim.empty());
+
+  auto trace = out_dir / "trace.bin";
+  WriteTrace(trace, GetRunTrace(100, 1));
+  EXPECT_EQ(0, RunSim(sim, {trace.string()}).find("100 steps x 1 lane(s)"));
+  EXPECT_EQ(0, RunSim(sim, {trace.string(), "40"}).find("40 steps"));
+}
+
+TEST_F(TestIlator, Lanes) {
+  IlaSimTest m;
+  ExportStandaloneSim(m.model, out_dir, true, 8);
+
+  auto lanes = out_dir / "include" / "ilator_lanes.h";
+  EXPECT_TRUE(os_portable_exist(lanes.string()));
+  auto bitvec = out_dir / "include" / "ilator_bitvec.h";
+  EXPECT_TRUE(os_portable_exist(bitvec.string()));
+
+  // each lane should end up where a scalar run of its own trace does
+  if (!HasToolchain()) {
+    return;
+  }
+  const int kLanes = 8;
+  const int kSteps = 200;
+  auto lanes_dir = out_dir / "lanes";
+  ExportStandaloneSim(GetRunModel(), lanes_dir.string(), true, kLanes);
+  auto lanes_sim = BuildSim(lanes_dir, "Run");
+  ASSERT_FALSE(lanes_sim.empty());
+  auto scalar_dir = out_dir / "scalar";
+  ExportStandaloneSim(GetRunModel(), scalar_dir.string(), true);
+  auto scalar_sim = BuildSim(scalar_dir, "Run");
+  ASSERT_FALSE(scalar_sim.empty());
+
+  auto words = GetRunTrace(kSteps, kLanes);
+  auto trace = out_dir / "trace.bin";
+  auto ck = out_dir / "lanes.ck";
+  WriteTrace(trace, words);
+  RunSim(lanes_sim, {trace.string(), "--save", ck.string()});
+  auto lane_states = SplitRunLanes(ReadFile(ck), kLanes);
+  ASSERT_EQ(kLanes, lane_states.size());
+  // the scalar fallback saves each lane on its own
+  auto fallback_ck = out_dir / "fallback.ck";
+  RunSim(lanes_sim, {trace.string(), "--engine", "scalar", "--save",
+                     fallback_ck.string()});
+
+  for (auto l = 0; l < kLanes; l++) {
+    std::vector<uint64_t> lane_words;
+    for (auto i = 0; i < kSteps; i++) {
+      lane_words.push_back(words[2 * kLanes * i + l]);         // op
+      lane_words.push_back(words[2 * kLanes * i + kLanes + l]); // data
+    }
+    auto lane_trace = out_dir / ("trace_" + std::to_string(l) + ".bin");
+    auto lane_ck = out_dir / ("scalar_" + std::to_string(l) + ".ck");
+    WriteTrace(lane_trace, lane_words);
+    RunSim(scalar_sim, {lane_trace.string(), "--save", lane_ck.string()});
+    auto scalar_states = ReadFile(lane_ck);
+    ASSERT_GT(scalar_states.size(), 32u);
+    EXPECT_EQ(scalar_states.substr(32), lane_states[l]) << "lane " << l;
+    auto fallback_states =
+        ReadFile(fallback_ck.string() + "." + std::to_string(l));
+    ASSERT_GT(fallback_states.size(), 32u);
+    EXPECT_EQ(scalar_states.substr(32), fallback_states.substr(32))
+        << "lane " << l;
+  }
+
+  // divergent lanes (random opcodes) fall back to scalar, uniform ones do not
+  auto fallback = std::string("[scalar fallback]");
+  auto out = RunSim(lanes_sim, {trace.string()});
+  EXPECT_NE(std::string::npos, out.find(fallback));
+  for (auto i = 0; i < kSteps; i++) {
+    for (auto l = 1; l < kLanes; l++) {
+      words[2 * kLanes * i + l] = words[2 * kLanes * i];
+    }
+  }
+  WriteTrace(trace, words);
+  out = RunSim(lanes_sim, {trace.string()});
+  EXPECT_EQ(std::string::npos, out.find(fallback));
+}
+
+TEST_F(TestIlator, NameCollision) {
+  // names that map to the same C++ identifier
+  auto m = Ila("Names");
+  auto op = m.NewBvInput("op", 1);
+  auto dot = m.NewBvState("a.b", 8);
+  auto bar = m.NewBvState("a_b", 8);
+
+  auto instr_dot = m.NewInstr("i.x");
+  instr_dot.SetDecode(op == 0);
+  instr_dot.SetUpdate(dot, dot + bar);
+
+  auto instr_bar = m.NewInstr("i_x");
+  instr_bar.SetDecode(op == 1);
+  instr_bar.SetUpdate(bar, bar - dot);
+
+  ExportStandaloneSim(m, out_dir, true);
+
+  auto header = ReadFile(out_dir / "include" / "Names.h");
+  EXPECT_NE(std::string::npos, header.find("Names_a_b;"));
+  EXPECT_NE(std::string::npos, header.find("Names_a_b_1;"));
+  EXPECT_NE(std::string::npos, header.find("decode_Names_i_x()"));
+  EXPECT_NE(std::string::npos, header.find("decode_Names_i_x_1()"));
+  EXPECT_TRUE(os_portable_exist(
+      (out_dir / "src" / "idu_Names_i_x.cc").string()));
+  EXPECT_TRUE(os_portable_exist(
+      (out_dir / "src" / "idu_Names_i_x_1.cc").string()));
+
+  if (!HasToolchain()) {
+    return;
+  }
+  EXPECT_FALSE(BuildSim(out_dir, "Names").empty());
+}
+
+TEST_F(TestIlator, Profile) {
+  IlaSimTest m;
+  ExportSysCSim(m.model, out_dir);
+
+  auto support = out_dir / "include" / "ilator_profile.h";
+  EXPECT_TRUE(os_portable_exist(support.string()));
+  auto dump = out_dir / "src" / "profile.cc";
+  EXPECT_TRUE(os_portable_exist(dump.string()));
+
+  // counters of a profiled run should follow the opcodes in the trace
+  if (!HasToolchain()) {
+    return;
+  }
+  const int kSteps = 300;
+  auto sim_dir = out_dir / "run";
+  ExportStandaloneSim(GetRunModel(), sim_dir.string(), true);
+  auto sim = BuildSim(sim_dir, "Run", {"-DILATOR_PROFILE=ON"});
+  ASSERT_FALSE(sim.empty());
+
+  auto words = GetRunTrace(kSteps, 1);
+  auto trace = out_dir / "trace.bin";
+  WriteTrace(trace, words);
+  auto profile = out_dir / "profile.json";
+#if defined(_WIN32) || defined(_WIN64)
+  _putenv_s("ILATOR_PROFILE_OUT", profile.string().c_str());
+#else
+  setenv("ILATOR_PROFILE_OUT", profile.string().c_str(), 1);
+#endif
+  RunSim(sim, {trace.string()});
+  ASSERT_TRUE(os_portable_exist(profile.string()));
+
+  std::vector<uint64_t> op_count(4, 0);
+  for (auto i = 0; i < kSteps; i++) {
+    op_count.at(words[2 * i])++;
+  }
+  auto j = nlohmann::json::parse(ReadFile(profile));
+  EXPECT_EQ("Run", j["model"].get<std::string>());
+  EXPECT_EQ(1, j["lanes"].get<int>());
+  EXPECT_EQ(kSteps, j["compute"].get<int>());
+
+  std::vector<std::string> names = {"Run.ADD", "Run.STORE", "Run.LOAD",
+                                    "Run.SHIFT"};
+  ASSERT_EQ(names.size(), j["instructions"].size());
+  for (size_t i = 0; i < names.size(); i++) {
+    EXPECT_EQ(names[i], j["instructions"][i]["name"].get<std::string>());
+    EXPECT_EQ(op_count[i], j["instructions"][i]["count"].get<uint64_t>());
+  }
+  ASSERT_EQ(1, j["memories"].size());
+  EXPECT_EQ("Run.mem", j["memories"][0]["name"].get<std::string>());
+  EXPECT_EQ(op_count[2], j["memories"][0]["read"].get<uint64_t>());
+  EXPECT_EQ(op_count[1], j["memories"][0]["write"].get<uint64_t>());
+
+  // with lanes, only the activated lanes are counted
+  const int kLanes = 4;
+  auto lanes_dir = out_dir / "lanes";
+  ExportStandaloneSim(GetRunModel(), lanes_dir.string(), true, kLanes);
+  auto lanes_sim = BuildSim(lanes_dir, "Run", {"-DILATOR_PROFILE=ON"});
+  ASSERT_FALSE(lanes_sim.empty());
+
+  words = GetRunTrace(kSteps, kLanes);
+  WriteTrace(trace, words);
+  RunSim(lanes_sim, {trace.string(), "--engine", "lanes"});
+
+  std::fill(op_count.begin(), op_count.end(), 0);
+  for (auto i = 0; i < kSteps; i++) {
+    for (auto l = 0; l < kLanes; l++) {
+      op_count.at(words[2 * kLanes * i + l])++;
+    }
+  }
+  j = nlohmann::json::parse(ReadFile(profile));
+  EXPECT_EQ(kLanes, j["lanes"].get<int>());
+  ASSERT_EQ(names.size(), j["instructions"].size());
+  for (size_t i = 0; i < names.size(); i++) {
+    EXPECT_EQ(op_count[i], j["instructions"][i]["count"].get<uint64_t>());
+  }
+  EXPECT_EQ(op_count[2], j["memories"][0]["read"].get<uint64_t>());
+  EXPECT_EQ(op_count[1], j["memories"][0]["write"].get<uint64_t>());
+}
+
+TEST_F(TestIlator, Checkpoint) {
+  IlaSimTest m;
+  ExportStandaloneSim(m.model, out_dir);
+
+  auto checkpoint = out_dir / "src" / "checkpoint.cc";
+  EXPECT_TRUE(os_portable_exist(checkpoint.string()));
+
+  // resuming from a checkpoint should end up in the same state
+  if (!HasToolchain()) {
+    return;
+  }
+  const int kSteps = 200;
+  for (auto lanes : {1, 8}) {
+    auto sim_dir = out_dir / ("run_" + std::to_string(lanes));
+    ExportStandaloneSim(GetRunModel(), sim_dir.string(), true, lanes);
+    auto sim = BuildSim(sim_dir, "Run");
+    ASSERT_FALSE(sim.empty());
+
+    auto trace = sim_dir / "trace.bin";
+    WriteTrace(trace, GetRunTrace(kSteps, lanes));
+    auto full = (sim_dir / "full.ck").string();
+    auto half = (sim_dir / "half.ck").string();
+    auto resume = (sim_dir / "resume.ck").string();
+    auto steps = std::to_string(kSteps / 2);
+    RunSim(sim, {trace.string(), "--save", full});
+    RunSim(sim, {trace.string(), steps, "--save", half});
+    RunSim(sim, {trace.string(), "--load", half, "--save", resume});
+    auto full_ck = ReadFile(full);
+    EXPECT_FALSE(full_ck.empty());
+    EXPECT_EQ(full_ck, ReadFile(resume)) << lanes << " lane(s)";
+    EXPECT_NE(full_ck, ReadFile(half)) << lanes << " lane(s)";
+
+    // truncated or padded checkpoints are rejected
+    auto half_ck = ReadFile(half);
+    auto truncated = half_ck.substr(0, half_ck.size() - 1);
+    for (auto& bad_ck : {truncated, half_ck + "x"}) {
+      auto bad = (sim_dir / "bad.ck").string();
+      std::ofstream(bad, std::ios::binary) << bad_ck;
+      auto log = (sim_dir / "bad.log").string();
+      auto res = os_portable_execute_shell({sim, trace.string(), "--load", bad},
+                                           log, redirect_t::BOTH);
+      EXPECT_NE(0, res.ret) << lanes << " lane(s)";
+    }
+  }
+}
+
+TEST_F(TestIlator, Incremental) {
+  auto GetModel = [](int step, bool with_b) {
+    auto m = Ila("Incr");
+    auto op = m.NewBvInput("op", 2);
+    auto a = m.NewBvState("a", 8);
+    auto b = m.NewBvState("b", 8);
+    auto inc_a = m.NewInstr("INC_A");
+    inc_a.SetDecode(op == 0);
+    inc_a.SetUpdate(a, a + step);
+    if (with_b) {
+      auto inc_b = m.NewInstr("INC_B");
+      inc_b.SetDecode(op == 1);
+      inc_b.SetUpdate(b, b + 1);
+    }
+    return m;
+  };
+
+  ExportStandaloneSim(GetModel(1, true), out_dir);
+  EXPECT_TRUE(os_portable_exist((out_dir / "ilator_manifest.json").string()));
+
+  // back-date all generated files
+  auto idu_a = out_dir / "src" / "idu_Incr_INC_A.cc";
+  auto idu_b = out_dir / "src" / "idu_Incr_INC_B.cc";
+  auto header = out_dir / "include" / "Incr.h";
+  auto past = fs::last_write_time(idu_a) - std::chrono::hours(1);
+  for (auto& f : {idu_a, idu_b, header}) {
+    fs::last_write_time(f, past);
+  }
+
+  // only the changed instruction is re-written
+  ExportStandaloneSim(GetModel(2, true), out_dir);
+  EXPECT_NE(past, fs::last_write_time(idu_a));
+  EXPECT_EQ(past, fs::last_write_time(idu_b));
+  EXPECT_EQ(past, fs::last_write_time(header));
+
+  // stale sources are removed
+  ExportStandaloneSim(GetModel(2, false), out_dir);
+  EXPECT_TRUE(os_portable_exist(idu_a.string()));
+  EXPECT_FALSE(os_portable_exist(idu_b.string()));
+}
+
 } // namespace ilang
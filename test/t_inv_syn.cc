@@ -144,6 +144,56 @@ TEST_F(TestVlgVerifInvSyn, SimpleCntCegar) {
 
 } // CegarPipelineExample
 
+// will not execute any external tools
+TEST_F(TestVlgVerifInvSyn, SimpleCntCegarParallel) {
+  auto ila_model = CntTest::BuildModel();
+
+  VerilogVerificationTargetGenerator::vtg_config_t cfg;
+  cfg.InvariantSynthesisReachableCheckKeepOldInvariant = false;
+  cfg.CosaAddKeep = false;
+  cfg.VerificationSettingAvoidIssueStage = true;
+  cfg.YosysSmtFlattenDatatype = false;
+  cfg.YosysSmtFlattenHierarchy = true;
+  cfg.YosysPath = "N/A";
+  cfg.CosaPyEnvironment = "N/A";
+  cfg.CosaPath = "N/A";
+  cfg.AbcPath = "N/A";
+  cfg.Z3Path = "N/A";
+  cfg.GrainPath = "N/A";
+
+  auto dirName = os_portable_append_dir(std::string(ILANG_TEST_SRC_ROOT),
+                                        P({"unit-data", "inv_syn", "cnt2"}));
+  auto refDir = os_portable_append_dir(std::string(ILANG_TEST_SRC_ROOT),
+                                       P({"unit-data", "inv_syn", "cnt2-cex"}));
+  os_portable_copy_dir(refDir, outDir);
+  // targets run in parallel keep the results in their own dir
+  os_portable_copy_file_to_dir(
+      os_portable_append_dir(outDir, "__verification_result.txt"),
+      os_portable_append_dir(outDir, "INC"));
+
+  InvariantSynthesizerCegar vg(
+      {}, // no include
+      {os_portable_append_dir(dirName, P({"verilog", "opposite.v"}))}, //
+      "opposite", // top_module_name
+      os_portable_append_dir(dirName,
+                             P({"rfmap", "vmap.json"})), // variable mapping
+      os_portable_append_dir(dirName, P({"rfmap", "cond-noinv.json"})), outDir,
+      ila_model.get(),
+      VerilogVerificationTargetGenerator::backend_selector::COSA,
+      VerilogVerificationTargetGenerator::synthesis_backend_selector::Z3, cfg);
+
+  EXPECT_FALSE(vg.in_bad_state());
+
+  vg.GenerateVerificationTarget({"1==1"});
+  EXPECT_FALSE(vg.RunVerifAutoParallel({"INC"}, true));
+  vg.ExtractVerificationResult();
+  vg.GenerateSynthesisTarget();
+  EXPECT_FALSE(vg.RunSynAuto(true));
+  vg.ExtractSynthesisResult();
+  EXPECT_FALSE(vg.in_bad_state());
+
+} // SimpleCntCegarParallel
+
 // will not execute any external tools
 TEST_F(TestVlgVerifInvSyn, SimpleCntCegarWithAssumptions) {
   auto ila_model = CntTest::BuildModel();
@@ -408,6 +458,70 @@ TEST_F(TestVlgVerifInvSyn, CegarCntAbc) {
 
 } // CegarCntAbc
 
+// will not execute any external tools
+TEST_F(TestVlgVerifInvSyn, CegarCntPortfolio) {
+  auto ila_model = CntTest::BuildModel();
+
+  VerilogVerificationTargetGenerator::vtg_config_t cfg;
+  cfg.InvariantSynthesisReachableCheckKeepOldInvariant = false;
+  cfg.CosaAddKeep = false;
+  cfg.VerificationSettingAvoidIssueStage = true;
+  cfg.YosysSmtFlattenDatatype = false;
+  cfg.YosysSmtFlattenHierarchy = true;
+  cfg.AbcUseGla = true;
+  cfg.AbcUseAiger = true;
+  cfg.AbcUseCorr = false;
+  cfg.YosysPath = "N/A";
+  cfg.CosaPyEnvironment = "N/A";
+  cfg.CosaPath = "N/A";
+  cfg.AbcPath = "N/A";
+  cfg.Z3Path = "N/A";
+  cfg.GrainPath = "N/A";
+
+  auto dirName = os_portable_append_dir(std::string(ILANG_TEST_SRC_ROOT),
+                                        {"unit-data", "inv_syn", "cnt2"});
+  auto refDir = os_portable_append_dir(std::string(ILANG_TEST_SRC_ROOT),
+                                       {"unit-data", "inv_syn", "cnt2-abc"});
+  os_portable_copy_dir(refDir, outDir);
+  // only ABC has a result, so it wins
+  auto abcDir = os_portable_append_dir(outDir, "portfolio-abc");
+  os_portable_mkdir(abcDir);
+  os_portable_copy_dir(refDir, abcDir);
+
+  InvariantSynthesizerCegar vg(
+      {}, // no include
+      {os_portable_append_dir(dirName, P({"verilog", "opposite.v"}))},
+      "opposite", // top_module_name
+      os_portable_append_dir(dirName,
+                             P({"rfmap", "vmap.json"})), // variable mapping
+      os_portable_append_dir(dirName, P({"rfmap", "cond-noinv.json"})), outDir,
+      ila_model.get(),
+      VerilogVerificationTargetGenerator::backend_selector::COSA,
+      VerilogVerificationTargetGenerator::synthesis_backend_selector::Z3, cfg);
+  vg.SetSynthesisPortfolio(
+      {VerilogVerificationTargetGenerator::synthesis_backend_selector::Z3,
+       VerilogVerificationTargetGenerator::synthesis_backend_selector::ABC});
+
+  EXPECT_FALSE(vg.in_bad_state());
+
+  vg.GenerateVerificationTarget();
+  EXPECT_FALSE(vg.RunVerifAuto("INC", "", true));
+  vg.ExtractVerificationResult();
+  vg.GenerateSynthesisTarget();
+  EXPECT_EQ(vg.GetRunnableTargetScriptName().size(), 2);
+  EXPECT_FALSE(vg.RunSynAuto(true));
+  vg.ExtractSynthesisResult();
+  EXPECT_FALSE(vg.in_bad_state());
+  EXPECT_EQ(vg.GetInvariants().NumInvariant(), 1);
+
+  auto stat_file = os_portable_append_dir(outDir, "design_stat.txt");
+  vg.GetDesignStatistics().StoreToFile(stat_file);
+  DesignStatistics design_stat;
+  design_stat.LoadFromFile(stat_file);
+  EXPECT_EQ(design_stat.InvSynBackendSeries, std::vector<std::string>{"abc"});
+
+} // CegarCntPortfolio
+
 TEST_F(TestVlgVerifInvSyn, CegarCntAbcBlif) {
   auto ila_model = CntTest::BuildModel();
 
@@ -38,6 +38,11 @@ TEST(TestKeyVec, StringString) {
   EXPECT_EQ("k1", pos->first);
   EXPECT_EQ("abc", pos->second);
 
+  // the iterator is a copy, modifying it does not change the container
+  pos.second = "zzz";
+  EXPECT_EQ("abc", kv.find("k1")->second);
+  EXPECT_EQ("abc", kv[0]);
+
   pos = kv.find("k4");
   EXPECT_EQ(pos, kv.end());
 
@@ -79,6 +84,15 @@ TEST(TestKeyVec, SymbolExpr) {
   pos = kv.find(Symbol("dummy"));
   EXPECT_EQ(pos, kv.end());
 
+  // lookup by plain name
+  EXPECT_EQ(mem_var, kv.find(std::string("mem_var"))->second);
+  EXPECT_EQ(kv.end(), kv.find(std::string("dummy")));
+  // iterators of different entries are independent
+  auto pos_bv = kv.find(bv_var->name());
+  auto pos_mem = kv.find(mem_var->name());
+  EXPECT_EQ(bv_var, pos_bv->second);
+  EXPECT_EQ(mem_var, pos_mem->second);
+
   kv.clear();
   pos = kv.find(bool_const->name());
   EXPECT_EQ(pos, kv.end());
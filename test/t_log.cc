@@ -198,4 +198,45 @@ TEST_F(TestLog, Clear) {
   EXPECT_TRUE(msg.empty());
 }
 
+TEST_F(TestLog, DebugTagId) {
+  // ids are computed at compile time
+  static_assert(DebugLog::TagId("ch0") != DebugLog::TagId("ch1"));
+  constexpr auto id = DebugLog::TagId("ch1");
+  EXPECT_EQ(id, DebugLog::TagId(std::string("ch1").c_str()));
+
+  DebugLog::Clear();
+  EXPECT_FALSE(DebugLog::Find<id>("ch1"));
+
+  DebugLog::Enable("ch1");
+  EXPECT_TRUE(DebugLog::Find<id>("ch1"));
+  EXPECT_TRUE(DebugLog::Find("ch1"));
+  EXPECT_FALSE(DebugLog::Find<DebugLog::TagId("ch0")>("ch0"));
+
+  DebugLog::Disable("ch1");
+  EXPECT_FALSE(DebugLog::Find<id>("ch1"));
+}
+
+TEST_F(TestLog, DebugRuntimeTag) {
+  std::string msg;
+  // tags that are not literals are looked up at run time
+  std::string tag = std::string("ch") + std::to_string(1);
+  const char* tag_ptr = tag.c_str();
+
+  DebugLog::Enable("ch1");
+  EXPECT_TRUE(DebugLog::Enabled(tag));
+  EXPECT_TRUE(DebugLog::Enabled(tag_ptr));
+  EXPECT_TRUE(DebugLog::Enabled("ch1"));
+  EXPECT_FALSE(DebugLog::Enabled(std::string("ch0")));
+
+  GET_STDERR_MSG((ILA_DLOG(tag) << "This should happen.\n"), msg);
+#ifndef NDEBUG
+  EXPECT_FALSE(msg.empty());
+#endif
+
+  DebugLog::Disable("ch1");
+  EXPECT_FALSE(DebugLog::Enabled(tag));
+  GET_STDERR_MSG((ILA_DLOG(tag_ptr) << "This should not happen.\n"), msg);
+  EXPECT_TRUE(msg.empty());
+}
+
 } // namespace ilang
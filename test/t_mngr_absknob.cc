@@ -1,6 +1,9 @@
 /// \file
 /// Tests for ILA manager utility -absknob
 
+#include <nlohmann/json.hpp>
+
+#include <ilang/ila-mngr/u_abs_knob.h>
 #include <ilang/ilang++.h>
 
 #include "unit-include/util.h"
@@ -40,4 +43,62 @@ TEST(TestMngrabsknob, FlattenIla) {
   EXPECT_EQ(m.instr_num(), 3);
 }
 
+TEST(TestMngrabsknob, ExprGraphStats) {
+  auto m = InstrLvlAbs::New("m");
+  auto x = m->NewBvState("x", 8);
+  auto mem = m->NewMemState("mem", 4, 8);
+  auto c1 = asthub::BvConst(1, 8);
+  auto s = asthub::Add(x, c1);
+  auto d = asthub::Eq(x, c1);
+
+  auto i0 = m->NewInstr("i0");
+  i0->set_decode(d);
+  i0->set_update(x, asthub::Add(s, s));
+  auto i1 = m->NewInstr("i1");
+  i1->set_decode(d);
+  i1->set_update(mem, asthub::Store(mem, asthub::Extract(x, 3, 0), s));
+
+  auto stats = absknob::GetExprGraphStats(m);
+  EXPECT_EQ(8, stats.unique_node_num);
+  EXPECT_EQ(20, stats.tree_node_num);
+  EXPECT_EQ(3, stats.max_depth);
+  EXPECT_EQ(0, stats.load_num);
+  EXPECT_EQ(1, stats.store_num);
+  EXPECT_EQ(2, stats.op_hist.at("VAR"));
+  EXPECT_EQ(1, stats.op_hist.at("CONST"));
+
+  auto fanout = std::map<size_t, size_t>({{0, 3}, {1, 2}, {2, 1}, {3, 2}});
+  EXPECT_EQ(fanout, stats.fanout_hist);
+
+  ASSERT_EQ(2, stats.instr_cone_size.size());
+  EXPECT_EQ("i0", stats.instr_cone_size[0].first);
+  EXPECT_EQ(5, stats.instr_cone_size[0].second);
+  EXPECT_EQ("i1", stats.instr_cone_size[1].first);
+  EXPECT_EQ(7, stats.instr_cone_size[1].second);
+
+  auto j = nlohmann::json::parse(GetExprGraphStats(Ila(m)));
+  EXPECT_EQ(8, j["unique_node_num"].get<size_t>());
+  EXPECT_EQ(3, j["fanout_hist"]["0"].get<size_t>());
+  EXPECT_EQ(2, j["instr_cone_size"].size());
+}
+
+TEST(TestMngrabsknob, ExprGraphStatsDeep) {
+  // a chain deeper than a recursive visit could handle
+  const size_t kDepth = 200000;
+  auto m = InstrLvlAbs::New("m");
+  auto x = m->NewBvState("x", 8);
+  auto c1 = asthub::BvConst(1, 8);
+  auto e = x;
+  for (size_t i = 0; i != kDepth; i++) {
+    e = asthub::Add(e, c1);
+  }
+  auto i0 = m->NewInstr("i0");
+  i0->set_update(x, e);
+
+  auto stats = absknob::GetExprGraphStats(m);
+  EXPECT_EQ(kDepth + 2, stats.unique_node_num);
+  EXPECT_EQ(kDepth + 1, stats.max_depth);
+  EXPECT_EQ(2 * kDepth + 1, stats.tree_node_num);
+}
+
 } // namespace ilang
@@ -64,4 +64,56 @@ TEST(TestPass, RBM) { ApplyPass("rbm", "rbm.json"); }
 TEST(TestPass, OC8051) { ApplyPass("oc", "oc.json"); }
 #endif
 
+Ila BuildRewriteRuleTarget() {
+  auto m = Ila("rules");
+  auto p = m.NewBoolState("p");
+  auto a = m.NewBvState("a", 8);
+  auto b = m.NewBvState("b", 8);
+  auto mem = m.NewMemState("mem", 8, 8);
+  m.SetValid(BoolConst(true));
+
+  auto instr = m.NewInstr("instr");
+  instr.SetDecode(p & p);
+  instr.SetUpdate(a, Ite(p, b, b) + Extract(Concat(a, b), 7, 0));
+  instr.SetUpdate(b, Load(Store(mem, a, b), a));
+  instr.SetUpdate(mem, Store(mem, Extract(a, 7, 0), b));
+  return m;
+}
+
+TEST(TestPass, SimplifySyntacticRules) {
+  auto ila = BuildRewriteRuleTarget();
+  EXPECT_TRUE(pass::SimplifySyntactic(ila.get()));
+
+  auto m = ila.get();
+  auto p = m->state("p");
+  auto a = m->state("a");
+  auto b = m->state("b");
+  auto mem = m->state("mem");
+  auto instr = m->instr(0);
+
+  // p & p --> p
+  EXPECT_EQ(p, instr->decode());
+
+  // ite(p, b, b) + extract(concat(a, b), 7, 0) --> b + b
+  auto a_next = instr->update(a);
+  ASSERT_TRUE(a_next->is_op());
+  EXPECT_EQ(AstUidExprOp::kAdd,
+            std::static_pointer_cast<ExprOp>(a_next)->uid());
+  EXPECT_EQ(b, a_next->arg(0));
+  EXPECT_EQ(b, a_next->arg(1));
+
+  // load(store(mem, a, b), a) --> b
+  EXPECT_EQ(b, instr->update(b));
+
+  // store(mem, extract(a, 7, 0), b) --> store(mem, a, b)
+  auto mem_next = instr->update(mem);
+  ASSERT_TRUE(mem_next->is_op());
+  EXPECT_EQ(mem, mem_next->arg(0));
+  EXPECT_EQ(a, mem_next->arg(1));
+  EXPECT_EQ(b, mem_next->arg(2));
+
+  // equivalent to the original
+  CheckIlaEqLegacy(BuildRewriteRuleTarget().get(), m);
+}
+
 }; // namespace ilang
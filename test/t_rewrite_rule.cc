@@ -0,0 +1,158 @@
+/// \file
+/// Unit test for the rule-indexed Expr rewriting.
+
+#include <ilang/ila-mngr/u_abs_knob.h>
+#include <ilang/ila-mngr/u_rewriter.h>
+#include <ilang/target-smt/z3_expr_adapter.h>
+
+#include "unit-include/util.h"
+
+namespace ilang {
+
+using namespace asthub;
+
+// check the folded constant against z3 for the (unfolded) expression
+void CheckConstFold(const ExprPtr& e, z3::solver& s, Z3ExprAdapter& gen) {
+  ASSERT_TRUE(e->is_op()) << e;
+  auto folded = absknob::Rewrite(e, RewriteRuleSet::Default());
+  ASSERT_TRUE(folded->is_const()) << e;
+
+  s.push();
+  s.add(gen.GetExpr(e) != gen.GetExpr(folded));
+  EXPECT_EQ(z3::unsat, s.check()) << e;
+  s.pop();
+}
+
+TEST(TestRewriteRule, Pattern) {
+  auto x = NewBvVar("x", 8);
+  auto c = BvConst(3, 8);
+  auto e = Add(x, c);
+
+  EXPECT_TRUE(RewritePattern::Any().Match(e));
+  EXPECT_TRUE(RewritePattern::Const().Match(c));
+  EXPECT_TRUE(RewritePattern::Const(3).Match(c));
+  EXPECT_FALSE(RewritePattern::Const(2).Match(c));
+  EXPECT_FALSE(RewritePattern::Const().Match(x));
+
+  using P = RewritePattern;
+  EXPECT_TRUE(P::Op(kAdd, {P::Any(), P::Const()}).Match(e));
+  EXPECT_FALSE(P::Op(kAdd, {P::Const()}).Match(e));
+  EXPECT_FALSE(P::Op(kSubtract).Match(e));
+  EXPECT_TRUE(P::Op(kAdd).Width(8).Match(e));
+  EXPECT_FALSE(P::Op(kAdd).Width(16).Match(e));
+}
+
+TEST(TestRewriteRule, ConstFold) {
+  // keep the constant operations for the rule (instead of the construction)
+  auto const_folding = ConstFoldingEnabled();
+  SetConstFolding(false);
+
+  z3::context c;
+  z3::solver s(c);
+  Z3ExprAdapter gen(c);
+  auto CheckFold = [&s, &gen](const ExprPtr& e) { CheckConstFold(e, s, gen); };
+
+  std::vector<BvValType> vals = {0, 1, 5, 127, 128, 200, 255};
+  for (auto a : vals) {
+    for (auto b : vals) {
+      auto ca = BvConst(a, 8);
+      auto cb = BvConst(b, 8);
+      CheckFold(Add(ca, cb));
+      CheckFold(Sub(ca, cb));
+      CheckFold(Mul(ca, cb));
+      CheckFold(And(ca, cb));
+      CheckFold(Xor(ca, cb));
+      CheckFold(Eq(ca, cb));
+      CheckFold(Lt(ca, cb));
+      CheckFold(Ugt(ca, cb));
+      CheckFold(Shl(ca, cb));
+      CheckFold(Ashr(ca, cb));
+      CheckFold(Concat(ca, cb));
+    }
+    auto ca = BvConst(a, 8);
+    CheckFold(Negate(ca));
+    CheckFold(Complement(ca));
+    CheckFold(Extract(ca, 6, 2));
+    CheckFold(SExt(ca, 16));
+    CheckFold(ZExt(ca, 64));
+  }
+  CheckFold(Imply(BoolConst(true), BoolConst(false)));
+  CheckFold(Not(Eq(BoolConst(true), BoolConst(false))));
+
+  // not folded
+  auto div = Div(BvConst(4, 8), BvConst(0, 8));
+  EXPECT_EQ(div, absknob::Rewrite(div, RewriteRuleSet::Default()));
+
+  SetConstFolding(const_folding);
+}
+
+TEST(TestRewriteRule, Standard) {
+  auto x = NewBvVar("x", 8);
+  auto y = NewBvVar("y", 8);
+  auto p = NewBoolVar("p");
+  auto q = NewBoolVar("q");
+  auto mem = NewMemVar("mem", 8, 8);
+
+  auto func = FuncObjRuleRewr();
+
+  // extract of concat
+  auto xy = Concat(x, y);
+  EXPECT_EQ(y, func.Apply(Extract(xy, 7, 0)));
+  EXPECT_EQ(x, func.Apply(Extract(xy, 15, 8)));
+  auto straddle = Extract(xy, 11, 4);
+  EXPECT_EQ(straddle, func.Apply(straddle));
+
+  // if-then-else
+  EXPECT_EQ(x, func.Apply(Ite(BoolConst(true), x, y)));
+  EXPECT_EQ(y, func.Apply(Ite(Eq(BvConst(1, 8), BvConst(2, 8)), x, y)));
+  EXPECT_EQ(x, func.Apply(Ite(p, x, x)));
+
+  // load from store
+  EXPECT_EQ(y, func.Apply(Load(Store(mem, x, y), x)));
+  auto fwd = func.Apply(Load(Store(mem, BvConst(1, 8), y), BvConst(2, 8)));
+  EXPECT_EQ(kLoad, GetUidExprOp(fwd));
+  EXPECT_EQ(mem, fwd->arg(0));
+
+  // and/or
+  EXPECT_EQ(p, func.Apply(And(p, BoolConst(true))));
+  EXPECT_TRUE(func.Apply(Or(BoolConst(true), q))->is_const());
+  EXPECT_EQ(x, func.Apply(And(x, BvConst(255, 8))));
+  EXPECT_EQ(p, func.Apply(And(p, Or(p, q))));
+  EXPECT_EQ(p, func.Apply(Or(And(q, p), p)));
+  EXPECT_EQ(p, func.Apply(Or(p, p)));
+
+  // bottom-up to a fixpoint
+  auto nested = Add(x, Extract(Concat(y, Ite(BoolConst(false), x, y)), 7, 0));
+  auto res = func.Apply(nested);
+  EXPECT_EQ(x, res->arg(0));
+  EXPECT_EQ(y, res->arg(1));
+  EXPECT_GT(func.hit_num("extract_concat"), 0);
+  EXPECT_GT(func.hit_num("ite_const_cond"), 0);
+  EXPECT_EQ(0, func.hit_num("dummy"));
+
+  // memoized (shared node rewritten once)
+  auto hits = func.hit_num();
+  EXPECT_EQ(res, func.Apply(nested));
+  EXPECT_EQ(hits, func.hit_num());
+}
+
+TEST(TestRewriteRule, Custom) {
+  using P = RewritePattern;
+  RewriteRuleSet rules;
+  // x - x --> 0
+  rules.Add("sub_self", P::Op(kSubtract), [](const ExprPtr& e) {
+    return (e->arg(0) == e->arg(1)) ? BvConst(0, e->sort()->bit_width())
+                                    : nullptr;
+  });
+  EXPECT_EQ(1, rules.size());
+  EXPECT_DEATH(rules.Add("bad", P::Any(), nullptr), ".*");
+
+  auto x = NewBvVar("x", 8);
+  auto y = NewBvVar("y", 8);
+  auto zero = absknob::Rewrite(Sub(x, x), rules);
+  EXPECT_TRUE(zero->is_const());
+  auto sub = Sub(x, y);
+  EXPECT_EQ(sub, absknob::Rewrite(sub, rules));
+}
+
+} // namespace ilang
@@ -0,0 +1,152 @@
+/// \file
+/// Unit test for SmallVec and the pooled allocation of Expr
+
+#include <thread>
+#include <vector>
+
+#include <ilang/ila/ast_hub.h>
+#include <ilang/util/container.h>
+#include <ilang/util/mem_pool.h>
+
+#include "unit-include/util.h"
+
+namespace ilang {
+
+TEST(TestSmallVec, Inline) {
+  SmallVec<int, 2> vec;
+  EXPECT_TRUE(vec.empty());
+
+  vec.push_back(1);
+  vec.push_back(2);
+  EXPECT_EQ(2, vec.size());
+  EXPECT_EQ(1, vec.at(0));
+  EXPECT_EQ(2, vec[1]);
+  EXPECT_ANY_THROW(vec.at(2));
+
+  vec = {5};
+  EXPECT_EQ(1, vec.size());
+  EXPECT_EQ(5, vec.at(0));
+
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+}
+
+TEST(TestSmallVec, Spill) {
+  std::vector<int> ref = {0, 1, 2, 3, 4};
+  SmallVec<int, 2> vec(ref);
+  EXPECT_EQ(ref.size(), vec.size());
+  for (size_t i = 0; i != ref.size(); i++) {
+    EXPECT_EQ(ref[i], vec.at(i));
+  }
+
+  for (int i = 5; i != 10; i++) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(10, vec.size());
+  EXPECT_EQ(9, vec[9]);
+
+  auto copy = vec;
+  EXPECT_EQ(vec.size(), copy.size());
+  EXPECT_TRUE(std::equal(vec.begin(), vec.end(), copy.begin()));
+
+  copy = SmallVec<int, 2>({7, 8});
+  EXPECT_EQ(2, copy.size());
+  EXPECT_EQ(8, copy[1]);
+}
+
+TEST(TestSmallVec, ExprArgs) {
+  using namespace asthub;
+
+  auto a = NewBvVar("a", 8);
+  auto b = NewBvVar("b", 8);
+  auto c = NewBvVar("c", 8);
+  auto f = Func::New("f", Sort::MakeBvSort(8),
+                     {a->sort(), b->sort(), c->sort(), a->sort()});
+
+  auto app = AppFunc(f, {a, b, c, a});
+  EXPECT_EQ(4, app->arg_num());
+  EXPECT_EQ(c, app->arg(2));
+  EXPECT_EQ(a, app->arg(3));
+  EXPECT_ANY_THROW(app->arg(4));
+
+  auto ext = Extract(a, 5, 2);
+  EXPECT_EQ(2, ext->param_num());
+  EXPECT_EQ(5, ext->param(0));
+  EXPECT_EQ(2, ext->param(1));
+}
+
+TEST(TestSmallVec, PoolReuse) {
+  using namespace asthub;
+
+  auto a = NewBvVar("a", 8);
+  auto base = MemPool::LiveBlockNum();
+  {
+    std::vector<ExprPtr> nodes;
+    for (auto i = 0; i != 100; i++) {
+      nodes.push_back(Add(a, a));
+    }
+    EXPECT_EQ(base + 100, MemPool::LiveBlockNum());
+  }
+  EXPECT_EQ(base, MemPool::LiveBlockNum());
+}
+
+TEST(TestSmallVec, Layout) {
+  // the heap pointer shares the storage with the inline elements
+  EXPECT_EQ(3 * sizeof(ExprPtr) + 8, sizeof(SmallVec<ExprPtr, 3>));
+  EXPECT_EQ(16, sizeof(SmallVec<int, 2>));
+
+  SmallVec<ExprPtr, 3> vec;
+  auto a = asthub::NewBvVar("a", 8);
+  for (auto i = 0; i != 4; i++) {
+    vec.push_back(a);
+  }
+  vec.push_back(vec[0]); // self-reference while growing
+  EXPECT_EQ(5, vec.size());
+  EXPECT_EQ(6, a.use_count());
+  vec.clear();
+  EXPECT_EQ(1, a.use_count());
+}
+
+TEST(TestSmallVec, PoolRelease) {
+  using namespace asthub;
+
+  auto a = NewBvVar("a", 8);
+  auto base = MemPool::ReservedBytes();
+  {
+    std::vector<ExprPtr> nodes;
+    for (auto i = 0; i != 10000; i++) {
+      nodes.push_back(Add(a, a));
+    }
+    EXPECT_LT(base, MemPool::ReservedBytes());
+  }
+  // only the slab in use is kept
+  EXPECT_GE(base + MemPool::kSlabSize, MemPool::ReservedBytes());
+}
+
+TEST(TestSmallVec, PoolThreadExit) {
+  using namespace asthub;
+
+  auto a = NewBvVar("a", 8);
+  auto base_live = MemPool::LiveBlockNum();
+  auto base_reserved = MemPool::ReservedBytes();
+  std::vector<ExprPtr> nodes;
+  std::thread worker([&nodes, &a]() {
+    for (auto i = 0; i != 10000; i++) {
+      nodes.push_back(Add(a, a));
+    }
+  });
+  worker.join();
+
+  // the slabs of the exited thread stay as long as their blocks are alive
+  EXPECT_EQ(base_live + 10000, MemPool::LiveBlockNum());
+  EXPECT_LT(base_reserved, MemPool::ReservedBytes());
+
+  // free from another thread, the last block releases the slab
+  nodes.resize(5000);
+  EXPECT_EQ(base_live + 5000, MemPool::LiveBlockNum());
+  nodes.clear();
+  EXPECT_EQ(base_live, MemPool::LiveBlockNum());
+  EXPECT_EQ(base_reserved, MemPool::ReservedBytes());
+}
+
+} // namespace ilang
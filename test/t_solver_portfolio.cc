@@ -0,0 +1,83 @@
+/// \file
+/// Unit test for the solver portfolio.
+
+#include <chrono>
+
+#include <ilang/ila-mngr/v_eq_check_legacy_bmc.h>
+#include <ilang/target-smt/solver_portfolio.h>
+
+#include "unit-include/eq_ilas.h"
+#include "unit-include/util.h"
+
+namespace ilang {
+
+TEST(TestSolverPortfolio, BvQuery) {
+  z3::context ctx;
+  auto x = ctx.bv_const("x", 16);
+  auto y = ctx.bv_const("y", 16);
+  auto portfolio = SolverPortfolio();
+  EXPECT_EQ(SolverPortfolio::DefaultConfigs().size(),
+            portfolio.configs().size());
+
+  z3::solver s(ctx);
+  s.add(x * y == 391);
+  s.add(z3::ugt(x, 1) && z3::ugt(y, 1));
+  s.add(z3::ult(x, 256) && z3::ult(y, 256));
+  EXPECT_EQ(z3::sat, portfolio.Check(s));
+  EXPECT_FALSE(portfolio.winner().empty());
+
+  // the model is translated back to the caller's context
+  auto m = portfolio.GetModel(ctx);
+  auto prod = m.eval(x * y).get_numeral_uint();
+  EXPECT_EQ(391, prod);
+
+  s.push();
+  s.add(x * y != y * x);
+  EXPECT_EQ(z3::unsat, portfolio.Check(s));
+  s.pop();
+  EXPECT_EQ(z3::sat, portfolio.Check(s));
+}
+
+TEST(TestSolverPortfolio, QueryTimeout) {
+  // factoring a 60-bit semiprime, way beyond the limit
+  z3::context ctx;
+  auto x = ctx.bv_const("x", 64);
+  auto y = ctx.bv_const("y", 64);
+  z3::solver s(ctx);
+  s.add(x * y == ctx.bv_val(static_cast<uint64_t>(998244359987710471ULL), 64));
+  s.add(z3::ugt(x, 1) && z3::ugt(y, 1));
+  s.add(z3::ult(x, 1 << 30) && z3::ult(y, 1 << 30));
+
+  // the query limit applies without the portfolio's
+  auto portfolio = SolverPortfolio();
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(z3::unknown, portfolio.Check(s, 50));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, std::chrono::seconds(10));
+}
+
+TEST(TestSolverPortfolio, Empty) {
+  z3::context ctx;
+  auto portfolio = SolverPortfolio(std::vector<SolverPortfolio::Config>());
+  z3::solver s(ctx);
+  s.add(ctx.bool_val(false));
+  EXPECT_EQ(z3::unknown, portfolio.Check(s));
+  EXPECT_TRUE(portfolio.winner().empty());
+}
+
+TEST(TestSolverPortfolio, LegacyBmc) {
+  EqIlaGen ila_gen;
+  auto m0 = ila_gen.GetIlaFlat1();
+  auto m1 = ila_gen.GetIlaFlat2();
+
+  LegacyBmc bmc;
+  bmc.SetPortfolio(std::make_shared<SolverPortfolio>());
+  for (auto m : {m0, m1}) {
+    auto start_i = asthub::Eq(m->input("start"), asthub::BoolConst(true));
+    auto opcode_i = asthub::Eq(m->input("opcode"), asthub::BvConst(1, 3));
+    bmc.AddInit(asthub::And(start_i, opcode_i));
+  }
+  EXPECT_EQ(z3::unsat, bmc.Check(m0, 1, m1, 1));
+}
+
+} // namespace ilang
@@ -2,9 +2,11 @@
 /// Unit test for Sort.
 
 #include "unit-include/util.h"
+
 #include <ilang/ila/ast/sort.h>
 #include <iostream>
 #include <string>
+#include <type_traits>
 
 namespace ilang {
 
@@ -93,4 +95,22 @@ TEST(TestSort, Memory) {
   EXPECT_TRUE(z.is_array());
 }
 
+TEST(TestSort, Interned) {
+  EXPECT_EQ(Sort::MakeBoolSort().get(), Sort::MakeBoolSort().get());
+  EXPECT_EQ(Sort::MakeBvSort(8).get(), Sort::MakeBvSort(8).get());
+  EXPECT_NE(Sort::MakeBvSort(8).get(), Sort::MakeBvSort(16).get());
+  EXPECT_EQ(Sort::MakeMemSort(2, 32).get(), Sort::MakeMemSort(2, 32).get());
+  EXPECT_NE(Sort::MakeMemSort(2, 32).get(), Sort::MakeMemSort(32, 2).get());
+
+  // structural comparison still holds for sorts created directly
+  SortPtr direct = std::make_shared<SortBv>(8);
+  EXPECT_TRUE(direct == Sort::MakeBvSort(8));
+  EXPECT_FALSE(direct == Sort::MakeBvSort(16));
+  EXPECT_FALSE(direct == Sort::MakeBoolSort());
+
+  // interned sorts are shared, and hence cannot be modified
+  static_assert(std::is_const<SortPtr::element_type>::value,
+                "Sort must be immutable");
+}
+
 } // namespace ilang
@@ -80,4 +80,17 @@ TEST(TestSymbol, Compare) {
   EXPECT_FALSE(post < pre);
 }
 
+TEST(TestSymbol, Intern) {
+  Symbol a("same_name");
+  Symbol b(std::string("same_name"));
+  EXPECT_NE(a.id(), b.id());
+  EXPECT_EQ(&a.str(), &b.str());
+
+  Symbol anon;
+  EXPECT_EQ("$" + std::to_string(anon.id()), anon.str());
+  Symbol anon_copy(anon);
+  EXPECT_EQ(anon, anon_copy);
+  EXPECT_FALSE(anon == a);
+}
+
 } // namespace ilang
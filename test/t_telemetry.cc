@@ -0,0 +1,97 @@
+/// \file
+/// Unit test for the performance telemetry.
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include <nlohmann/json.hpp>
+
+#include <ilang/ilang++.h>
+#include <ilang/ila-mngr/pass.h>
+#include <ilang/util/fs.h>
+#include <ilang/util/telemetry.h>
+
+#include "unit-include/ila_sim_test.h"
+#include "unit-include/util.h"
+
+namespace ilang {
+
+static void TimedScope() { ILA_TRACE_SCOPE("test.scope"); }
+
+TEST(TestTelemetry, Disabled) {
+  Telemetry::Disable();
+  Telemetry::Reset();
+  EXPECT_FALSE(Telemetry::enabled());
+
+  TimedScope();
+  ILA_COUNT("test.disabled", 1);
+  ILA_GAUGE("test.gauge", 1);
+
+  std::ostringstream out;
+  Telemetry::PrintSummary(out);
+  EXPECT_EQ(std::string::npos, out.str().find("test.scope"));
+  EXPECT_EQ(std::string::npos, out.str().find("test.disabled"));
+  EXPECT_EQ(std::string::npos, out.str().find("test.gauge"));
+}
+
+TEST(TestTelemetry, Records) {
+  Telemetry::Reset();
+  EnableTelemetry();
+  for (auto i = 0; i != 3; i++) {
+    TimedScope();
+    ILA_COUNT("test.count", 2);
+  }
+  ILA_GAUGE("test.gauge", 5);
+  ILA_GAUGE("test.gauge", 7);
+  EnableTelemetry(false);
+
+  EXPECT_EQ(6, Telemetry::GetCounter("test.count").value());
+
+  std::ostringstream out;
+  PrintTelemetrySummary(out);
+  auto summary = out.str();
+  EXPECT_NE(std::string::npos, summary.find("test.scope"));
+  EXPECT_NE(std::string::npos, summary.find("test.count"));
+  EXPECT_NE(std::string::npos, summary.find("test.gauge"));
+
+  ResetTelemetry();
+  EXPECT_EQ(0, Telemetry::GetCounter("test.count").value());
+}
+
+TEST(TestTelemetry, ChromeTrace) {
+  Telemetry::Reset();
+  EnableTelemetry();
+  IlaSimTest m;
+  pass::SimplifySyntactic(m.model.get());
+  std::ostringstream vlg;
+  m.model.ExportToVerilog(vlg);
+  EnableTelemetry(false);
+
+  auto file_name = GetRandomFileName(fs::temp_directory_path());
+  EXPECT_TRUE(ExportTelemetryTrace(file_name));
+
+  std::ifstream fin(file_name);
+  auto trace = nlohmann::json::parse(fin);
+  fin.close();
+  os_portable_remove_file(file_name);
+
+  ASSERT_TRUE(trace.contains("traceEvents"));
+  std::set<std::string> scopes;
+  auto expr_cnt = 0;
+  for (const auto& e : trace["traceEvents"]) {
+    ASSERT_TRUE(e.contains("ph"));
+    if (e["ph"] == "X") {
+      EXPECT_GE(e["dur"].get<int64_t>(), 0);
+      scopes.insert(e["name"].get<std::string>());
+    } else if (e["ph"] == "C" && e["name"] == "ast.expr") {
+      expr_cnt = e["args"]["value"].get<int>();
+    }
+  }
+  EXPECT_TRUE(scopes.count("pass.simplify_syntactic"));
+  EXPECT_TRUE(scopes.count("verilog.export_ila"));
+  EXPECT_GT(expr_cnt, 0);
+  Telemetry::Reset();
+}
+
+} // namespace ilang
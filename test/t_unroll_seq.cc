@@ -1,7 +1,9 @@
 /// \file
 /// Unit test for unrolling a sequence of instruction.
 
+#include <algorithm>
 #include <iostream>
+#include <set>
 
 #include <ilang/ila-mngr/u_unroller.h>
 
@@ -336,4 +338,109 @@ TEST_F(TestUnroll, PathMonoSolve) {
   }
 }
 
+TEST_F(TestUnroll, PathBatch) {
+  auto m = SimpleCpu("m");
+  auto pc = m->state("pc");
+  std::vector<InstrPtr> instrs = {m->instr("Load"), m->instr("Add"),
+                                  m->instr("Store")};
+
+  // all sequences up to length 3
+  std::vector<PathUnroll::InstrVec> seqs = {{}};
+  for (size_t i = 0; i < seqs.size(); i++) {
+    if (seqs[i].size() < 3) {
+      for (auto& instr : instrs) {
+        seqs.push_back(seqs[i]);
+        seqs.back().push_back(instr);
+      }
+    }
+  }
+  seqs.erase(seqs.begin());
+  // property on the end state of each sequence
+  ExprPtrVec props;
+  for (auto& seq : seqs) {
+    props.push_back(Ne(pc, BvConst(seq.size(), pc->sort()->bit_width())));
+  }
+
+  auto SetPred = [this, &m](PathUnroll* unroller) {
+    for (size_t i = 0; i != m->init_num(); i++) {
+      unroller->AddInitPred(m->init(i));
+    }
+    unroller->AddInitPred(Eq(m->state("ir"), init_mem));
+  };
+
+  auto batch = PathUnroll(ctx_);
+  SetPred(&batch);
+  z3::solver s(ctx_);
+  auto results = batch.PathAssnBatch(seqs, s);
+  auto results_prop = batch.PathAssnBatch(seqs, s, props);
+  EXPECT_EQ(0, s.assertions().size());
+
+  // same as checking each sequence individually
+  std::set<z3::check_result> observed;
+  for (size_t i = 0; i < seqs.size(); i++) {
+    auto single = PathUnroll(ctx_);
+    SetPred(&single);
+    z3::solver t(ctx_);
+    t.add(single.PathAssn(seqs[i]));
+    EXPECT_EQ(t.check(), results[i]);
+
+    auto assumptions = z3::expr_vector(ctx_);
+    assumptions.push_back(single.GetZ3Expr(props[i], seqs[i].size()));
+    EXPECT_EQ(t.check(assumptions), results_prop[i]);
+    observed.insert(results[i]);
+    observed.insert(results_prop[i]);
+  }
+  EXPECT_EQ(2, observed.size());
+
+  // no initial predicates without any step (as UnrollAssn(0))
+  seqs.insert(seqs.begin(), PathUnroll::InstrVec());
+  props.insert(props.begin(), Ne(pc, BvConst(0, pc->sort()->bit_width())));
+  auto results_empty = batch.PathAssnBatch(seqs, s, props);
+  EXPECT_EQ(z3::sat, results_empty[0]);
+  EXPECT_TRUE(std::equal(results_prop.begin(), results_prop.end(),
+                         results_empty.begin() + 1));
+}
+
+TEST_F(TestUnroll, LazyMem) {
+  auto m = SimpleCpu("m");
+  auto mem = m->state("mem");
+  std::vector<InstrPtr> seq = {m->instr("Load"), m->instr("Load"),
+                               m->instr("Add"), m->instr("Store")};
+
+  // the lazily encoded memories are only meaningful within the unrolling
+  auto Check = [this, &m, &mem, &seq](bool lazy, bool subs, bool prop) {
+    auto unroller = PathUnroll(ctx_);
+    for (size_t i = 0; i != m->init_num(); i++) {
+      unroller.AddInitPred(m->init(i));
+    }
+    unroller.AddInitPred(Eq(m->state("ir"), init_mem));
+    unroller.AddStepPred(Eq(Load(mem, 0), 3), 0);
+    unroller.AddStepPred(Eq(Load(mem, 1), 3), 0);
+    if (lazy) {
+      unroller.AddLazyMem(m->state("ir"));
+      unroller.AddLazyMem(mem);
+    }
+    auto sum = Eq(Load(mem, 2), 6);
+    unroller.AddStepPred(prop ? sum : Not(sum), seq.size());
+    auto cstr = subs ? unroller.PathSubs(seq) : unroller.PathAssn(seq);
+
+    if (lazy) {
+      // no array reasoning left in the unrolling
+      auto str = cstr.to_string();
+      EXPECT_EQ(std::string::npos, str.find("select")) << str;
+      EXPECT_EQ(std::string::npos, str.find("store")) << str;
+    }
+    z3::solver s(ctx_);
+    s.add(cstr);
+    return s.check();
+  };
+
+  for (auto subs : {true, false}) {
+    for (auto lazy : {true, false}) {
+      EXPECT_EQ(z3::unsat, Check(lazy, subs, false));
+      EXPECT_EQ(z3::sat, Check(lazy, subs, true));
+    }
+  }
+}
+
 } // namespace ilang
@@ -96,6 +96,31 @@ TEST_F(TestUnrollerSmt, z3) {
   EXPECT_EQ(res, z3::unsat);
 }
 
+TEST_F(TestUnrollerSmt, FrameConstraints) {
+  z3::context ctx;
+  Z3ExprAdapter gen(ctx);
+  auto shim = SmtShim(gen);
+
+  auto m = SimpleCpu("m");
+  auto unroller = PathUnroller<Z3ExprAdapter>(shim);
+  unroller.AssertStep(asthub::Eq(m->state("r0"), 7), 0);
+  auto exec = unroller.Unroll({m->instr("Load"), m->instr("Add")});
+
+  // one group per step and one for the end state
+  auto& frames = unroller.GetFrameConstraints();
+  EXPECT_EQ(3, frames.size());
+
+  // the conjunction is flat, and equivalent to the groups asserted separately
+  EXPECT_TRUE(exec.is_app() && exec.decl().decl_kind() == Z3_OP_AND);
+  EXPECT_EQ(frames.size(), exec.num_args());
+  z3::solver s(ctx);
+  for (const auto& f : frames) {
+    s.add(f);
+  }
+  s.add(!exec);
+  EXPECT_EQ(z3::unsat, s.check());
+}
+
 #ifdef SMTSWITCH_TEST
 TEST_F(TestUnrollerSmt, btor) {
   auto solver = smt::BoolectorSolverFactory::create(false);
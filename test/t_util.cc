@@ -207,6 +207,40 @@ TEST(TestUtil, ExecShellRedirectTimeOut) {
   EXPECT_EQ(res.timeout, true);
   // EXPECT_EQ(res.ret, 0); if timeout return value not usable
 }
+
+TEST(TestUtil, ExecShellRace) {
+  auto work_dir = os_portable_getcwd();
+  std::vector<execute_job> jobs = {{{"sleep", "10"}, work_dir, ""},
+                                   {{"false"}, work_dir, ""},
+                                   {{"true"}, work_dir, ""}};
+  auto accept = [](size_t idx, const execute_result& res) {
+    return res.failure == execute_result::NONE && res.ret == 0;
+  };
+  std::vector<execute_result> results;
+
+  auto winner = os_portable_execute_shell_race(jobs, accept, results);
+  EXPECT_EQ(winner, 2);
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_TRUE(results[0].cancelled);
+  EXPECT_FALSE(results[0].timeout);
+  EXPECT_LT(results[0].seconds, 5);
+  EXPECT_FALSE(results[2].cancelled);
+
+  // none accepted, all killed after the timeout
+  jobs.resize(1);
+  winner = os_portable_execute_shell_race(jobs, accept, results, 1);
+  EXPECT_EQ(winner, 1);
+  EXPECT_TRUE(results[0].timeout);
+  EXPECT_FALSE(results[0].cancelled);
+
+  // jobs ignoring SIGTERM are killed after the grace period
+  jobs = {{{"bash", "-c", "trap '' TERM; sleep 10"}, work_dir, ""},
+          {{"true"}, work_dir, ""}};
+  winner = os_portable_execute_shell_race(jobs, accept, results);
+  EXPECT_EQ(winner, 1);
+  EXPECT_TRUE(results[0].cancelled);
+  EXPECT_LT(results[0].seconds, 5);
+}
 #endif
 
 TEST(TestUtil, RegularExpr) {
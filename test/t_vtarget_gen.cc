@@ -1,6 +1,9 @@
 /// \file
 /// Unit test for generating Verilog verification target
 
+#include <fstream>
+#include <iterator>
+
 #include <ilang/ila/instr_lvl_abs.h>
 #include <ilang/ilang++.h>
 #include <ilang/util/fs.h>
@@ -39,6 +42,60 @@ TEST(TestVlgTargetGen, PipeExample) {
   vg.GenerateTargets();
 }
 
+TEST(TestVlgTargetGen, PipeExampleRfExprCache) {
+  auto ila_model = SimplePipe::BuildModel();
+
+  auto dirName = os_portable_append_dir(ILANG_TEST_DATA_DIR, "vpipe");
+  auto rfDir = os_portable_append_dir(dirName, "rfmap");
+
+  auto vlog = os_portable_append_dir(dirName, "simple_pipe.v");
+  auto vmap = os_portable_append_dir(rfDir, "vmap.json");
+  auto cond = os_portable_append_dir(rfDir, "cond.json");
+
+  // generate the same targets with and without the refinement-map cache
+  auto gen = [&](bool cache, const std::string& out) {
+    auto vtg_config = VerilogVerificationTargetGenerator::vtg_config_t();
+    vtg_config.CacheRefinementExprs = cache;
+
+    VerilogVerificationTargetGenerator vg(
+        {},                                   // no include
+        {vlog},                               // vlog files
+        "pipeline_v",                         // top_module_name
+        vmap,                                 // variable mapping
+        cond,                                 // instruction-mapping
+        os_portable_append_dir(dirName, out), // verification dir
+        ila_model.get(),                      // ILA model
+        VerilogVerificationTargetGenerator::backend_selector::COSA, // engine
+        vtg_config);
+
+    EXPECT_FALSE(vg.in_bad_state());
+    vg.GenerateTargets();
+  };
+  gen(true, "verify-cache");
+  gen(false, "verify-nocache");
+
+  auto read = [](const fs::path& p) {
+    std::ifstream fin(p.string());
+    return std::string(std::istreambuf_iterator<char>(fin),
+                       std::istreambuf_iterator<char>());
+  };
+
+  auto cached_dir = fs::path(os_portable_append_dir(dirName, "verify-cache"));
+  auto uncached_dir =
+      fs::path(os_portable_append_dir(dirName, "verify-nocache"));
+  unsigned compared = 0;
+  for (auto& entry : fs::recursive_directory_iterator(cached_dir)) {
+    if (entry.path().filename() != "wrapper.v")
+      continue;
+    auto rel = entry.path().string().substr(cached_dir.string().size());
+    auto other = fs::path(uncached_dir.string() + rel);
+    ASSERT_TRUE(fs::exists(other)) << other;
+    EXPECT_EQ(read(entry.path()), read(other)) << rel;
+    compared++;
+  }
+  EXPECT_GT(compared, 0u);
+}
+
 TEST(TestVlgTargetGen, PipeExampleZ3) {
   auto ila_model = SimplePipe::BuildModel();
 
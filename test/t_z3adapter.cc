@@ -74,6 +74,24 @@ TEST(TestZ3Adapter, Suffix) {
   auto result = s.check();
   EXPECT_TRUE(result == z3::sat);
 
+  // variables of the same frame are reused across calls
+  auto x_frame_1 = adapter.GetExpr(reg_x, "_frame_1_");
+  EXPECT_TRUE(z3::eq(x_frame_1, adapter.GetExpr(reg_x, "_frame_1_")));
+  EXPECT_FALSE(z3::eq(x_frame_1, adapter.GetExpr(reg_x, "_frame_2_")));
+  EXPECT_EQ("reg_x_sEp__frame_1_", x_frame_1.decl().name().str());
+
+  // a renamed variable is not served from the cache
+  auto tmp = asthub::NewBvVar("tmp", 8);
+  EXPECT_EQ("tmp_sEp__frame_1_",
+            adapter.GetExpr(tmp, "_frame_1_").decl().name().str());
+  const_cast<Symbol&>(tmp->name()).set_name("renamed");
+  EXPECT_EQ("renamed_sEp__frame_1_",
+            adapter.GetExpr(tmp, "_frame_1_").decl().name().str());
+
+  // regenerated variables are the same z3 constants
+  adapter.ClearCache();
+  EXPECT_TRUE(z3::eq(x_frame_1, adapter.GetExpr(reg_x, "_frame_1_")));
+
   DebugLog::Disable("z3_adapter");
 }
 